@@ -52,7 +52,7 @@ void AStar3D::add_point(int64_t p_id, const Vector3 &p_pos, real_t p_weight_scal
 	Point **point_entry = points.getptr(p_id);
 
 	if (!point_entry) {
-		Point *pt = memnew(Point);
+		Point *pt = point_allocator.alloc();
 		pt->id = p_id;
 		pt->pos = p_pos;
 		pt->weight_scale = p_weight_scale;
@@ -118,7 +118,7 @@ void AStar3D::remove_point(int64_t p_id) {
 		kv.value->unlinked_neighbours.erase(p->id);
 	}
 
-	memdelete(p);
+	point_allocator.free(p);
 	points.erase(p_id);
 	last_free_id = p_id;
 }
@@ -239,10 +239,11 @@ bool AStar3D::are_points_connected(int64_t p_id, int64_t p_with_id, bool bidirec
 void AStar3D::clear() {
 	last_free_id = 0;
 	for (KeyValue<int64_t, Point *> &kv : points) {
-		memdelete(kv.value);
+		point_allocator.free(kv.value);
 	}
 	segments.clear();
 	points.clear();
+	point_allocator.reset();
 }
 
 int64_t AStar3D::get_point_count() const {
@@ -307,6 +308,10 @@ Vector3 AStar3D::get_closest_position_in_segment(const Vector3 &p_point) const {
 }
 
 bool AStar3D::_solve(Point *begin_point, Point *end_point, bool p_allow_partial_path) {
+	if (bidirectional_search_enabled && !p_allow_partial_path) {
+		return _solve_bidirectional(this, begin_point, end_point);
+	}
+
 	last_closest_point = nullptr;
 	pass++;
 
@@ -385,6 +390,168 @@ bool AStar3D::_solve(Point *begin_point, Point *end_point, bool p_allow_partial_
 	return found_route;
 }
 
+template <typename T>
+bool AStar3D::_solve_bidirectional(T *p_owner, Point *begin_point, Point *end_point) {
+	last_closest_point = nullptr;
+	pass++;
+
+	if (!end_point->enabled) {
+		return false;
+	}
+
+	LocalVector<Point *> open_list;
+	LocalVector<Point *> reverse_open_list;
+	SortArray<Point *, SortPoints> sorter;
+	SortArray<Point *, SortPointsReverse> reverse_sorter;
+
+	// The point where the cheapest route found so far joins both searches.
+	Point *meeting_point = nullptr;
+	real_t meeting_cost = Math::INF;
+
+	begin_point->g_score = 0;
+	begin_point->f_score = p_owner->_estimate_cost(begin_point->id, end_point->id);
+	begin_point->open_pass = pass;
+	open_list.push_back(begin_point);
+
+	end_point->reverse_g_score = 0;
+	end_point->reverse_f_score = p_owner->_estimate_cost(begin_point->id, end_point->id);
+	end_point->reverse_open_pass = pass;
+	reverse_open_list.push_back(end_point);
+
+	while (!open_list.is_empty() && !reverse_open_list.is_empty()) {
+		// A cheaper route would need to pass through the best candidate of both searches.
+		if (meeting_point != nullptr && MAX(open_list[0]->f_score, reverse_open_list[0]->reverse_f_score) >= meeting_cost) {
+			break;
+		}
+
+		if (open_list.size() <= reverse_open_list.size()) { // Advance the search with the smaller frontier.
+			Point *p = open_list[0]; // The currently processed point.
+
+			sorter.pop_heap(0, open_list.size(), open_list.ptr()); // Remove the current point from the open list.
+			open_list.remove_at(open_list.size() - 1);
+			p->closed_pass = pass; // Mark the point as closed.
+
+			for (const KeyValue<int64_t, Point *> &kv : p->neighbors) {
+				Point *e = kv.value; // The neighbor point.
+
+				if (!e->enabled || e->closed_pass == pass) {
+					continue;
+				}
+
+				if (neighbor_filter_enabled) {
+					bool filtered;
+					if (GDVIRTUAL_CALL_PTR(p_owner, _filter_neighbor, p->id, e->id, filtered) && filtered) {
+						continue;
+					}
+				}
+
+				real_t tentative_g_score = p->g_score + p_owner->_compute_cost(p->id, e->id) * e->weight_scale;
+
+				bool new_point = false;
+
+				if (e->open_pass != pass) { // The point wasn't inside the open list.
+					e->open_pass = pass;
+					open_list.push_back(e);
+					new_point = true;
+				} else if (tentative_g_score >= e->g_score) { // The new path is worse than the previous.
+					continue;
+				}
+
+				e->prev_point = p;
+				e->g_score = tentative_g_score;
+				e->f_score = e->g_score + p_owner->_estimate_cost(e->id, end_point->id);
+
+				if (new_point) { // The position of the new points is already known.
+					sorter.push_heap(0, open_list.size() - 1, 0, e, open_list.ptr());
+				} else {
+					sorter.push_heap(0, open_list.find(e), 0, e, open_list.ptr());
+				}
+
+				if (e->reverse_open_pass == pass && e->g_score + e->reverse_g_score < meeting_cost) {
+					meeting_point = e;
+					meeting_cost = e->g_score + e->reverse_g_score;
+				}
+			}
+		} else {
+			Point *p = reverse_open_list[0]; // The currently processed point.
+
+			reverse_sorter.pop_heap(0, reverse_open_list.size(), reverse_open_list.ptr()); // Remove the current point from the open list.
+			reverse_open_list.remove_at(reverse_open_list.size() - 1);
+			p->reverse_closed_pass = pass; // Mark the point as closed.
+
+			// Points connected both ways are listed as neighbors, points only connected towards this one as unlinked neighbours.
+			for (const AHashMap<int64_t, Point *> *point_connections : { &p->neighbors, &p->unlinked_neighbours }) {
+				for (const KeyValue<int64_t, Point *> &kv : *point_connections) {
+					Point *e = kv.value; // The point leading into the current one.
+
+					if (!e->enabled || e->reverse_closed_pass == pass) {
+						continue;
+					}
+
+					if (point_connections == &p->neighbors && !e->neighbors.has(p->id)) {
+						continue;
+					}
+
+					if (neighbor_filter_enabled) {
+						bool filtered;
+						if (GDVIRTUAL_CALL_PTR(p_owner, _filter_neighbor, e->id, p->id, filtered) && filtered) {
+							continue;
+						}
+					}
+
+					real_t tentative_g_score = p->reverse_g_score + p_owner->_compute_cost(e->id, p->id) * p->weight_scale;
+
+					bool new_point = false;
+
+					if (e->reverse_open_pass != pass) { // The point wasn't inside the open list.
+						e->reverse_open_pass = pass;
+						reverse_open_list.push_back(e);
+						new_point = true;
+					} else if (tentative_g_score >= e->reverse_g_score) { // The new path is worse than the previous.
+						continue;
+					}
+
+					e->next_point = p;
+					e->reverse_g_score = tentative_g_score;
+					e->reverse_f_score = e->reverse_g_score + p_owner->_estimate_cost(begin_point->id, e->id);
+
+					if (new_point) { // The position of the new points is already known.
+						reverse_sorter.push_heap(0, reverse_open_list.size() - 1, 0, e, reverse_open_list.ptr());
+					} else {
+						reverse_sorter.push_heap(0, reverse_open_list.find(e), 0, e, reverse_open_list.ptr());
+					}
+
+					if (e->open_pass == pass && e->g_score + e->reverse_g_score < meeting_cost) {
+						meeting_point = e;
+						meeting_cost = e->g_score + e->reverse_g_score;
+					}
+				}
+			}
+		}
+	}
+
+	if (meeting_point == nullptr) {
+		return false;
+	}
+
+	// With zero cost connections the forward route of the meeting point can cross its reverse route at the same cost,
+	// join at the last such point instead so both halves never overlap.
+	Point *p = meeting_point;
+	while (p != end_point) {
+		p = p->next_point;
+		if (p->open_pass == pass && p->g_score + p->reverse_g_score <= meeting_cost) {
+			meeting_point = p;
+		}
+	}
+
+	// Chain the reverse route onto the forward one so the path reads back from the end point like a regular search.
+	for (p = meeting_point; p != end_point; p = p->next_point) {
+		p->next_point->prev_point = p;
+	}
+
+	return true;
+}
+
 real_t AStar3D::_estimate_cost(int64_t p_from_id, int64_t p_end_id) {
 	real_t scost;
 	if (GDVIRTUAL_CALL(_estimate_cost, p_from_id, p_end_id, scost)) {
@@ -539,6 +706,14 @@ void AStar3D::set_neighbor_filter_enabled(bool p_enabled) {
 	neighbor_filter_enabled = p_enabled;
 }
 
+bool AStar3D::is_bidirectional_search_enabled() const {
+	return bidirectional_search_enabled;
+}
+
+void AStar3D::set_bidirectional_search_enabled(bool p_enabled) {
+	bidirectional_search_enabled = p_enabled;
+}
+
 void AStar3D::set_point_disabled(int64_t p_id, bool p_disabled) {
 	Point **p_entry = points.getptr(p_id);
 	ERR_FAIL_COND_MSG(!p_entry, vformat("Can't set if point is disabled. Point with id: %d doesn't exist.", p_id));
@@ -573,6 +748,9 @@ void AStar3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_neighbor_filter_enabled", "enabled"), &AStar3D::set_neighbor_filter_enabled);
 	ClassDB::bind_method(D_METHOD("is_neighbor_filter_enabled"), &AStar3D::is_neighbor_filter_enabled);
 
+	ClassDB::bind_method(D_METHOD("set_bidirectional_search_enabled", "enabled"), &AStar3D::set_bidirectional_search_enabled);
+	ClassDB::bind_method(D_METHOD("is_bidirectional_search_enabled"), &AStar3D::is_bidirectional_search_enabled);
+
 	ClassDB::bind_method(D_METHOD("connect_points", "id", "to_id", "bidirectional"), &AStar3D::connect_points, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("disconnect_points", "id", "to_id", "bidirectional"), &AStar3D::disconnect_points, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("are_points_connected", "id", "to_id", "bidirectional"), &AStar3D::are_points_connected, DEFVAL(true));
@@ -593,6 +771,7 @@ void AStar3D::_bind_methods() {
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "neighbor_filter_enabled"), "set_neighbor_filter_enabled", "is_neighbor_filter_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "bidirectional_search_enabled"), "set_bidirectional_search_enabled", "is_bidirectional_search_enabled");
 }
 
 AStar3D::~AStar3D() {
@@ -650,6 +829,14 @@ void AStar2D::set_neighbor_filter_enabled(bool p_enabled) {
 	astar.neighbor_filter_enabled = p_enabled;
 }
 
+bool AStar2D::is_bidirectional_search_enabled() const {
+	return astar.bidirectional_search_enabled;
+}
+
+void AStar2D::set_bidirectional_search_enabled(bool p_enabled) {
+	astar.bidirectional_search_enabled = p_enabled;
+}
+
 void AStar2D::set_point_disabled(int64_t p_id, bool p_disabled) {
 	astar.set_point_disabled(p_id, p_disabled);
 }
@@ -841,6 +1028,10 @@ Vector<int64_t> AStar2D::get_id_path(int64_t p_from_id, int64_t p_to_id, bool p_
 }
 
 bool AStar2D::_solve(AStar3D::Point *begin_point, AStar3D::Point *end_point, bool p_allow_partial_path) {
+	if (astar.bidirectional_search_enabled && !p_allow_partial_path) {
+		return astar._solve_bidirectional(this, begin_point, end_point);
+	}
+
 	astar.last_closest_point = nullptr;
 	astar.pass++;
 
@@ -934,6 +1125,9 @@ void AStar2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_neighbor_filter_enabled", "enabled"), &AStar2D::set_neighbor_filter_enabled);
 	ClassDB::bind_method(D_METHOD("is_neighbor_filter_enabled"), &AStar2D::is_neighbor_filter_enabled);
 
+	ClassDB::bind_method(D_METHOD("set_bidirectional_search_enabled", "enabled"), &AStar2D::set_bidirectional_search_enabled);
+	ClassDB::bind_method(D_METHOD("is_bidirectional_search_enabled"), &AStar2D::is_bidirectional_search_enabled);
+
 	ClassDB::bind_method(D_METHOD("set_point_disabled", "id", "disabled"), &AStar2D::set_point_disabled, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("is_point_disabled", "id"), &AStar2D::is_point_disabled);
 
@@ -957,4 +1151,5 @@ void AStar2D::_bind_methods() {
 	GDVIRTUAL_BIND(_compute_cost, "from_id", "to_id")
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "neighbor_filter_enabled"), "set_neighbor_filter_enabled", "is_neighbor_filter_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "bidirectional_search_enabled"), "set_bidirectional_search_enabled", "is_bidirectional_search_enabled");
 }
@@ -33,6 +33,7 @@
 #include "core/object/gdvirtual.gen.inc"
 #include "core/object/ref_counted.h"
 #include "core/templates/a_hash_map.h"
+#include "core/templates/paged_allocator.h"
 
 /**
 	A* pathfinding algorithm.
@@ -61,6 +62,13 @@ class AStar3D : public RefCounted {
 		// Used for getting closest_point_of_last_pathing_call.
 		real_t abs_g_score = 0;
 		real_t abs_f_score = 0;
+
+		// Used for bidirectional pathfinding, the search from the end point follows the connections in reverse.
+		Point *next_point = nullptr;
+		real_t reverse_g_score = 0;
+		real_t reverse_f_score = 0;
+		uint64_t reverse_open_pass = 0;
+		uint64_t reverse_closed_pass = 0;
 	};
 
 	struct SortPoints {
@@ -75,6 +83,18 @@ class AStar3D : public RefCounted {
 		}
 	};
 
+	struct SortPointsReverse {
+		_FORCE_INLINE_ bool operator()(const Point *A, const Point *B) const { // Returns true when the Point A is worse than Point B.
+			if (A->reverse_f_score > B->reverse_f_score) {
+				return true;
+			} else if (A->reverse_f_score < B->reverse_f_score) {
+				return false;
+			} else {
+				return A->reverse_g_score < B->reverse_g_score; // If the f_costs are the same then prioritize the points that are further away from the end.
+			}
+		}
+	};
+
 	struct Segment {
 		Pair<int64_t, int64_t> key;
 
@@ -109,12 +129,19 @@ class AStar3D : public RefCounted {
 	uint64_t pass = 1;
 
 	AHashMap<int64_t, Point *> points;
+	// Points are allocated in pages rather than one by one, so the points of large graphs stay close in memory.
+	PagedAllocator<Point, false, 256> point_allocator;
 	HashSet<Segment, Segment> segments;
 	Point *last_closest_point = nullptr;
 	bool neighbor_filter_enabled = false;
+	bool bidirectional_search_enabled = false;
 
 	bool _solve(Point *begin_point, Point *end_point, bool p_allow_partial_path);
 
+	// Shared with AStar2D, the costs and the neighbor filter are taken from p_owner.
+	template <typename T>
+	bool _solve_bidirectional(T *p_owner, Point *begin_point, Point *end_point);
+
 protected:
 	static void _bind_methods();
 
@@ -147,6 +174,9 @@ public:
 	bool is_neighbor_filter_enabled() const;
 	void set_neighbor_filter_enabled(bool p_enabled);
 
+	bool is_bidirectional_search_enabled() const;
+	void set_bidirectional_search_enabled(bool p_enabled);
+
 	void set_point_disabled(int64_t p_id, bool p_disabled = true);
 	bool is_point_disabled(int64_t p_id) const;
 
@@ -170,6 +200,7 @@ public:
 
 class AStar2D : public RefCounted {
 	GDCLASS(AStar2D, RefCounted);
+	friend class AStar3D;
 	AStar3D astar;
 
 	bool _solve(AStar3D::Point *begin_point, AStar3D::Point *end_point, bool p_allow_partial_path);
@@ -206,6 +237,9 @@ public:
 	bool is_neighbor_filter_enabled() const;
 	void set_neighbor_filter_enabled(bool p_enabled);
 
+	bool is_bidirectional_search_enabled() const;
+	void set_bidirectional_search_enabled(bool p_enabled);
+
 	void set_point_disabled(int64_t p_id, bool p_disabled = true);
 	bool is_point_disabled(int64_t p_id) const;
 
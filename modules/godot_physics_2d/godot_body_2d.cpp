@@ -147,6 +147,14 @@ void GodotBody2D::set_active(bool p_active) {
 	} else if (get_space()) {
 		get_space()->body_remove_from_active_list(&active_list);
 	}
+
+	// Sleeping rigid bodies move to their own broadphase tree, so they stop pairing with each other.
+	bool was_sleeping = is_sleeping();
+	_set_sleeping(!active && mode >= PhysicsServer2D::BODY_MODE_RIGID);
+
+	if (was_sleeping && active && get_space()) {
+		get_space()->body_wake_up_island(this);
+	}
 }
 
 void GodotBody2D::set_param(PhysicsServer2D::BodyParameter p_param, const Variant &p_value) {
@@ -286,6 +294,9 @@ void GodotBody2D::set_mode(PhysicsServer2D::BodyMode p_mode) {
 			set_active(true);
 		}
 	}
+
+	// set_active() returns early when the active state doesn't change, so sync the sleep state here as well.
+	_set_sleeping(!active && mode >= PhysicsServer2D::BODY_MODE_RIGID);
 }
 
 PhysicsServer2D::BodyMode GodotBody2D::get_mode() const {
@@ -720,6 +731,27 @@ bool GodotBody2D::sleep_test(real_t p_step) {
 	}
 }
 
+void GodotBody2D::save_snapshot(Snapshot &r_snapshot) const {
+	r_snapshot.rid = get_self().get_id();
+	r_snapshot.transform = get_transform();
+	r_snapshot.linear_velocity = linear_velocity;
+	r_snapshot.angular_velocity = angular_velocity;
+	r_snapshot.still_time = still_time;
+	r_snapshot.active = active;
+}
+
+void GodotBody2D::restore_snapshot(const Snapshot &p_snapshot) {
+	_set_transform(p_snapshot.transform);
+	_set_inv_transform(p_snapshot.transform.affine_inverse());
+	new_transform = p_snapshot.transform;
+	_update_transform_dependent();
+
+	linear_velocity = p_snapshot.linear_velocity;
+	angular_velocity = p_snapshot.angular_velocity;
+	still_time = p_snapshot.still_time;
+	set_active(p_snapshot.active);
+}
+
 void GodotBody2D::set_state_sync_callback(const Callable &p_callable) {
 	body_state_callback = p_callable;
 }
@@ -63,7 +63,8 @@ class GodotBodyPair2D : public GodotConstraint2D {
 		real_t acc_tangent_impulse = 0.0; // accumulated tangent impulse (Pt)
 		real_t acc_bias_impulse = 0.0; // accumulated normal impulse for position bias (Pnb)
 		real_t acc_bias_impulse_center_of_mass = 0.0; // accumulated normal impulse for position bias applied to com
-		real_t mass_normal, mass_tangent = 0.0;
+		real_t mass_normal = 0.0;
+		real_t mass_tangent = 0.0;
 		real_t bias = 0.0;
 
 		real_t depth = 0.0;
@@ -89,6 +90,25 @@ class GodotBodyPair2D : public GodotConstraint2D {
 	_FORCE_INLINE_ void _contact_added_callback(const Vector2 &p_point_A, const Vector2 &p_point_B);
 
 public:
+	// Contact state used for warm starting, kept in space snapshots.
+	struct Snapshot {
+		Vector2 sep_axis;
+		Contact contacts[MAX_CONTACTS];
+		int contact_count = 0;
+		bool collided = false;
+	};
+
+	virtual GodotBodyPair2D *as_body_pair() override { return this; }
+	virtual const GodotBodyPair2D *as_body_pair() const override { return this; }
+
+	_FORCE_INLINE_ GodotBody2D *get_body_a() const { return A; }
+	_FORCE_INLINE_ GodotBody2D *get_body_b() const { return B; }
+	_FORCE_INLINE_ int get_shape_a() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_b() const { return shape_B; }
+
+	void save_snapshot(Snapshot &r_snapshot) const;
+	void restore_snapshot(const Snapshot &p_snapshot);
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
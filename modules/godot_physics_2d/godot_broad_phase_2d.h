@@ -50,6 +50,7 @@ public:
 	virtual ID create(GodotCollisionObject2D *p_object_, int p_subindex = 0, const Rect2 &p_aabb = Rect2(), bool p_static = false) = 0;
 	virtual void move(ID p_id, const Rect2 &p_aabb) = 0;
 	virtual void set_static(ID p_id, bool p_static) = 0;
+	virtual void set_sleeping(ID p_id, bool p_sleeping) = 0;
 	virtual void remove(ID p_id) = 0;
 
 	virtual GodotCollisionObject2D *get_object(ID p_id) const = 0;
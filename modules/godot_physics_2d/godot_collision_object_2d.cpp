@@ -142,11 +142,37 @@ void GodotCollisionObject2D::_set_static(bool p_static) {
 	for (int i = 0; i < get_shape_count(); i++) {
 		const Shape &s = shapes[i];
 		if (s.bpid > 0) {
-			space->get_broadphase()->set_static(s.bpid, _static);
+			_update_broadphase_tree(s.bpid);
 		}
 	}
 }
 
+void GodotCollisionObject2D::_set_sleeping(bool p_sleeping) {
+	if (_sleeping == p_sleeping) {
+		return;
+	}
+	_sleeping = p_sleeping;
+
+	if (!space) {
+		return;
+	}
+	space->add_sleeping_objects(_sleeping ? 1 : -1);
+	for (int i = 0; i < get_shape_count(); i++) {
+		const Shape &s = shapes[i];
+		if (s.bpid > 0) {
+			_update_broadphase_tree(s.bpid);
+		}
+	}
+}
+
+void GodotCollisionObject2D::_update_broadphase_tree(GodotBroadPhase2D::ID p_bpid) {
+	if (_sleeping && !_static) {
+		space->get_broadphase()->set_sleeping(p_bpid, true);
+	} else {
+		space->get_broadphase()->set_static(p_bpid, _static);
+	}
+}
+
 void GodotCollisionObject2D::_unregister_shapes() {
 	for (int i = 0; i < shapes.size(); i++) {
 		Shape &s = shapes.write[i];
@@ -177,7 +203,7 @@ void GodotCollisionObject2D::_update_shapes() {
 
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
-			space->get_broadphase()->set_static(s.bpid, _static);
+			_update_broadphase_tree(s.bpid);
 		}
 
 		space->get_broadphase()->move(s.bpid, shape_aabb);
@@ -204,7 +230,7 @@ void GodotCollisionObject2D::_update_shapes_with_motion(const Vector2 &p_motion)
 
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
-			space->get_broadphase()->set_static(s.bpid, _static);
+			_update_broadphase_tree(s.bpid);
 		}
 
 		space->get_broadphase()->move(s.bpid, shape_aabb);
@@ -217,6 +243,9 @@ void GodotCollisionObject2D::_set_space(GodotSpace2D *p_space) {
 
 	if (old_space) {
 		old_space->remove_object(this);
+		if (_sleeping) {
+			old_space->add_sleeping_objects(-1);
+		}
 
 		for (int i = 0; i < shapes.size(); i++) {
 			Shape &s = shapes.write[i];
@@ -229,6 +258,9 @@ void GodotCollisionObject2D::_set_space(GodotSpace2D *p_space) {
 
 	if (space) {
 		space->add_object(this);
+		if (_sleeping) {
+			space->add_sleeping_objects(1);
+		}
 		_update_shapes();
 	}
 }
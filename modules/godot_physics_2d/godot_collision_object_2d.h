@@ -71,10 +71,12 @@ private:
 	uint32_t collision_layer = 1;
 	real_t collision_priority = 1.0;
 	bool _static = true;
+	bool _sleeping = false;
 
 	SelfList<GodotCollisionObject2D> pending_shape_update_list;
 
 	void _update_shapes();
+	void _update_broadphase_tree(GodotBroadPhase2D::ID p_bpid);
 
 protected:
 	void _update_shapes_with_motion(const Vector2 &p_motion);
@@ -88,6 +90,7 @@ protected:
 	}
 	_FORCE_INLINE_ void _set_inv_transform(const Transform2D &p_transform) { inv_transform = p_transform; }
 	void _set_static(bool p_static);
+	void _set_sleeping(bool p_sleeping);
 
 	virtual void _shapes_changed() = 0;
 	void _set_space(GodotSpace2D *p_space);
@@ -179,6 +182,7 @@ public:
 	virtual void set_space(GodotSpace2D *p_space) = 0;
 
 	_FORCE_INLINE_ bool is_static() const { return _static; }
+	_FORCE_INLINE_ bool is_sleeping() const { return _sleeping; }
 
 	void set_pickable(bool p_pickable) { pickable = p_pickable; }
 	_FORCE_INLINE_ bool is_pickable() const { return pickable; }
@@ -32,6 +32,8 @@
 
 #include "godot_body_2d.h"
 
+class GodotBodyPair2D;
+
 class GodotConstraint2D {
 	GodotBody2D **_body_ptr;
 	int _body_count;
@@ -59,6 +61,9 @@ public:
 	_FORCE_INLINE_ void disable_collisions_between_bodies(const bool p_disabled) { disabled_collisions_between_bodies = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled_collisions_between_bodies() const { return disabled_collisions_between_bodies; }
 
+	virtual GodotBodyPair2D *as_body_pair() { return nullptr; }
+	virtual const GodotBodyPair2D *as_body_pair() const { return nullptr; }
+
 	virtual bool setup(real_t p_step) = 0;
 	virtual bool pre_solve(real_t p_step) = 0;
 	virtual void solve(real_t p_step) = 0;
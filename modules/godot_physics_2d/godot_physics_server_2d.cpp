@@ -276,6 +276,27 @@ int GodotPhysicsServer2D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+uint32_t GodotPhysicsServer2D::space_get_state_hash(RID p_space) const {
+	const GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, 0);
+	ERR_FAIL_COND_V_MSG(space->is_locked(), 0, "Space state is inaccessible while the space is being stepped.");
+	return space->get_state_hash();
+}
+
+Vector<uint8_t> GodotPhysicsServer2D::space_save_state(RID p_space) const {
+	const GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(space->is_locked(), Vector<uint8_t>(), "Space state is inaccessible while the space is being stepped.");
+	return space->save_state();
+}
+
+void GodotPhysicsServer2D::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	GodotSpace2D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL(space);
+	ERR_FAIL_COND_MSG(space->is_locked(), "Space state is inaccessible while the space is being stepped.");
+	space->restore_state(p_state);
+}
+
 PhysicsDirectSpaceState2D *GodotPhysicsServer2D::space_get_direct_state(RID p_space) {
 	GodotSpace2D *space = space_owner.get_or_null(p_space);
 	ERR_FAIL_NULL_V(space, nullptr);
@@ -1287,6 +1308,11 @@ void GodotPhysicsServer2D::init() {
 	stepper = memnew(GodotStep2D);
 }
 
+void GodotPhysicsServer2D::set_step_max_threads(int p_max_threads) {
+	ERR_FAIL_NULL(stepper);
+	stepper->set_max_threads(p_max_threads);
+}
+
 void GodotPhysicsServer2D::step(real_t p_step) {
 	if (!active) {
 		return;
@@ -1297,11 +1323,15 @@ void GodotPhysicsServer2D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	sleeping_objects = 0;
+	sleeping_collision_pairs = 0;
 	for (GodotSpace2D *E : active_spaces) {
 		stepper->step(E, p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
+		sleeping_objects += E->get_sleeping_objects();
+		sleeping_collision_pairs += E->get_sleeping_collision_pairs();
 	}
 }
 
@@ -1384,6 +1414,12 @@ int GodotPhysicsServer2D::get_process_info(ProcessInfo p_info) {
 		case INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case INFO_SLEEPING_OBJECTS: {
+			return sleeping_objects;
+		} break;
+		case INFO_SLEEPING_COLLISION_PAIRS: {
+			return sleeping_collision_pairs;
+		} break;
 	}
 
 	return 0;
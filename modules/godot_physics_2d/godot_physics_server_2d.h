@@ -49,6 +49,8 @@ class GodotPhysicsServer2D : public PhysicsServer2D {
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int sleeping_objects = 0;
+	int sleeping_collision_pairs = 0;
 
 	bool using_threads = false;
 
@@ -115,6 +117,11 @@ public:
 	virtual Vector<Vector2> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual uint32_t space_get_state_hash(RID p_space) const override;
+
+	virtual Vector<uint8_t> space_save_state(RID p_space) const override;
+	virtual void space_restore_state(RID p_space, const Vector<uint8_t> &p_state) override;
+
 	// this function only works on physics process, errors and returns null otherwise
 	virtual PhysicsDirectSpaceState2D *space_get_direct_state(RID p_space) override;
 
@@ -299,6 +306,9 @@ public:
 
 	int get_process_info(ProcessInfo p_info) override;
 
+	// Limits how many worker threads a step can use, -1 uses all of them.
+	void set_step_max_threads(int p_max_threads);
+
 	GodotPhysicsServer2D(bool p_using_threads = false);
 	~GodotPhysicsServer2D() {}
 };
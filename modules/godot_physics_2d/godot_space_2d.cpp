@@ -34,6 +34,7 @@
 #include "godot_physics_server_2d.h"
 
 #include "core/config/project_settings.h"
+#include "core/io/marshalls.h"
 #include "godot_area_pair_2d.h"
 #include "godot_body_pair_2d.h"
 
@@ -115,16 +116,14 @@ int GodotPhysicsDirectSpaceState2D::intersect_point(const PointParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V(space->locked, false);
-
+bool GodotPhysicsDirectSpaceState2D::_intersect_ray(const RayParameters &p_parameters, RayResult &r_result, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices) const {
 	Vector2 begin, end;
 	Vector2 normal;
 	begin = p_parameters.from;
 	end = p_parameters.to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_segment(begin, end, r_cull_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -135,17 +134,17 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	real_t min_d = 1e10;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
+		const GodotCollisionObject2D *col_obj = r_cull_results[i];
 
-		int shape_idx = space->intersection_query_subindex_results[i];
+		int shape_idx = r_cull_subindices[i];
 		Transform2D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
 
 		Vector2 local_from = inv_xform.xform(begin);
@@ -205,7 +204,44 @@ bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parame
 	return true;
 }
 
-int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+bool GodotPhysicsDirectSpaceState2D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V(space->locked, false);
+
+	return _intersect_ray(p_parameters, r_result, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
+bool GodotPhysicsDirectSpaceState2D::_begin_query_batch(const QueryBatch &p_batch) {
+	// Queries only read the space, and the broadphase serializes its culls, so chunks can run at the same time
+	// as long as each one has its own cull buffers.
+	return true;
+}
+
+void GodotPhysicsDirectSpaceState2D::_run_query_batch_chunk(const QueryBatch &p_batch, uint32_t p_from, uint32_t p_to) {
+	ERR_FAIL_COND(space->locked);
+
+	// The space's shared cull buffers can't be used from several threads, so each chunk gets its own.
+	LocalVector<GodotCollisionObject2D *> cull_results;
+	cull_results.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+	LocalVector<int> cull_subindices;
+	cull_subindices.resize(GodotSpace2D::INTERSECTION_QUERY_MAX);
+
+	for (uint32_t i = p_from; i < p_to; i++) {
+		const uint32_t query = p_batch.order[i];
+		switch (p_batch.type) {
+			case QUERY_BATCH_RAYS: {
+				p_batch.ray_collided[query] = _intersect_ray(p_batch.rays[query], p_batch.ray_results[query], cull_results.ptr(), cull_subindices.ptr());
+			} break;
+			case QUERY_BATCH_SHAPES: {
+				p_batch.shape_result_counts[query] = _intersect_shape(p_batch.shapes[query], p_batch.shape_results + query * p_batch.shape_result_max, p_batch.shape_result_max, cull_results.ptr(), cull_subindices.ptr());
+			} break;
+			case QUERY_BATCH_MOTIONS: {
+				_cast_motion(p_batch.shapes[query], p_batch.closest_safe[query], p_batch.closest_unsafe[query], cull_results.ptr(), cull_subindices.ptr());
+			} break;
+		}
+	}
+}
+
+int GodotPhysicsDirectSpaceState2D::_intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices) const {
 	if (p_result_max <= 0) {
 		return 0;
 	}
@@ -217,7 +253,7 @@ int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_par
 	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, r_cull_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	int cc = 0;
 
@@ -226,16 +262,16 @@ int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_par
 			break;
 		}
 
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue;
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject2D *col_obj = r_cull_results[i];
+		int shape_idx = r_cull_subindices[i];
 
 		if (!GodotCollisionSolver2D::solve(shape, p_parameters.transform, p_parameters.motion, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), Vector2(), nullptr, nullptr, nullptr, p_parameters.margin)) {
 			continue;
@@ -254,7 +290,11 @@ int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_par
 	return cc;
 }
 
-bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) {
+int GodotPhysicsDirectSpaceState2D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	return _intersect_shape(p_parameters, r_results, p_result_max, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
+bool GodotPhysicsDirectSpaceState2D::_cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices) const {
 	GodotShape2D *shape = GodotPhysicsServer2D::godot_singleton->shape_owner.get_or_null(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
 
@@ -262,22 +302,22 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 	aabb = aabb.merge(Rect2(aabb.position + p_parameters.motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace2D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->broadphase->cull_aabb(aabb, r_cull_results, GodotSpace2D::INTERSECTION_QUERY_MAX, r_cull_subindices);
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
 
 	for (int i = 0; i < amount; i++) {
-		if (!_can_collide_with(space->intersection_query_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
+		if (!_can_collide_with(r_cull_results[i], p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas)) {
 			continue;
 		}
 
-		if (p_parameters.exclude.has(space->intersection_query_results[i]->get_self())) {
+		if (p_parameters.exclude.has(r_cull_results[i]->get_self())) {
 			continue; //ignore excluded
 		}
 
-		const GodotCollisionObject2D *col_obj = space->intersection_query_results[i];
-		int shape_idx = space->intersection_query_subindex_results[i];
+		const GodotCollisionObject2D *col_obj = r_cull_results[i];
+		int shape_idx = r_cull_subindices[i];
 
 		Transform2D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
 		//test initial overlap, does it collide if going all the way?
@@ -337,6 +377,10 @@ bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parame
 	return true;
 }
 
+bool GodotPhysicsDirectSpaceState2D::cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe) {
+	return _cast_motion(p_parameters, p_closest_safe, p_closest_unsafe, space->intersection_query_results, space->intersection_query_subindex_results);
+}
+
 bool GodotPhysicsDirectSpaceState2D::collide_shape(const ShapeParameters &p_parameters, Vector2 *r_results, int p_result_max, int &r_result_count) {
 	if (p_result_max <= 0) {
 		return false;
@@ -1036,6 +1080,7 @@ void *GodotSpace2D::_broadphase_pair(GodotCollisionObject2D *A, int p_subindex_A
 
 	} else {
 		GodotBodyPair2D *b = memnew(GodotBodyPair2D(static_cast<GodotBody2D *>(A), p_subindex_A, static_cast<GodotBody2D *>(B), p_subindex_B));
+		self->body_pairs++;
 		return b;
 	}
 }
@@ -1048,6 +1093,9 @@ void GodotSpace2D::_broadphase_unpair(GodotCollisionObject2D *A, int p_subindex_
 	GodotSpace2D *self = static_cast<GodotSpace2D *>(p_self);
 	self->collision_pairs--;
 	GodotConstraint2D *c = static_cast<GodotConstraint2D *>(p_data);
+	if (c->as_body_pair()) {
+		self->body_pairs--;
+	}
 	memdelete(c);
 }
 
@@ -1063,6 +1111,39 @@ void GodotSpace2D::body_remove_from_active_list(SelfList<GodotBody2D> *p_body) {
 	active_list.remove(p_body);
 }
 
+void GodotSpace2D::body_wake_up_island(GodotBody2D *p_body) {
+	island_wake_up_stack.push_back(p_body);
+	if (waking_up_island) {
+		return; // Bodies woken up below end up here, the loop further down takes care of them.
+	}
+	waking_up_island = true;
+
+	// Pairs between sleeping bodies are dropped, so the rest of the island is found through the broadphase.
+	// Waking up every sleeping body touching a woken one right away wakes the whole island at once,
+	// instead of one contact layer per step once the pairs are created again.
+	while (!island_wake_up_stack.is_empty()) {
+		GodotBody2D *body = island_wake_up_stack[island_wake_up_stack.size() - 1];
+		island_wake_up_stack.resize(island_wake_up_stack.size() - 1);
+
+		for (int i = 0; i < body->get_shape_count(); i++) {
+			if (body->is_shape_disabled(i)) {
+				continue;
+			}
+
+			int amount = broadphase->cull_aabb(body->get_shape_aabb(i), intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+			for (int j = 0; j < amount; j++) {
+				GodotCollisionObject2D *object = intersection_query_results[j];
+				if (object->get_type() != GodotCollisionObject2D::TYPE_BODY || !object->is_sleeping() || !body->interacts_with(object)) {
+					continue;
+				}
+				static_cast<GodotBody2D *>(object)->set_active(true);
+			}
+		}
+	}
+
+	waking_up_island = false;
+}
+
 void GodotSpace2D::body_add_to_mass_properties_update_list(SelfList<GodotBody2D> *p_body) {
 	mass_properties_update_list.add(p_body);
 }
@@ -1173,6 +1254,9 @@ void GodotSpace2D::set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_v
 		case PhysicsServer2D::SPACE_PARAM_SOLVER_ITERATIONS:
 			solver_iterations = p_value;
 			break;
+		case PhysicsServer2D::SPACE_PARAM_DETERMINISTIC:
+			deterministic = p_value != 0.0;
+			break;
 	}
 }
 
@@ -1196,10 +1280,346 @@ real_t GodotSpace2D::get_param(PhysicsServer2D::SpaceParameter p_param) const {
 			return constraint_bias;
 		case PhysicsServer2D::SPACE_PARAM_SOLVER_ITERATIONS:
 			return solver_iterations;
+		case PhysicsServer2D::SPACE_PARAM_DETERMINISTIC:
+			return deterministic ? 1.0 : 0.0;
 	}
 	return 0;
 }
 
+uint32_t GodotSpace2D::get_state_hash() const {
+	// Hash each body on its own and sort the results, so the hash doesn't depend on
+	// the order in which objects were added to the space or on their addresses.
+	LocalVector<uint32_t> body_hashes;
+	body_hashes.reserve(objects.size());
+
+	for (const GodotCollisionObject2D *object : objects) {
+		if (object->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+
+		const GodotBody2D *body = static_cast<const GodotBody2D *>(object);
+		const Transform2D &xform = body->get_transform();
+		const Vector2 linear_velocity = body->get_linear_velocity();
+
+		uint32_t h = hash_murmur3_one_32(body->get_mode());
+		h = hash_murmur3_one_32(body->is_active(), h);
+		for (int i = 0; i < 3; i++) {
+			h = hash_murmur3_one_real(xform.columns[i].x, h);
+			h = hash_murmur3_one_real(xform.columns[i].y, h);
+		}
+		h = hash_murmur3_one_real(linear_velocity.x, h);
+		h = hash_murmur3_one_real(linear_velocity.y, h);
+		h = hash_murmur3_one_real(body->get_angular_velocity(), h);
+		body_hashes.push_back(hash_fmix32(h));
+	}
+
+	body_hashes.sort();
+
+	uint32_t h = hash_murmur3_one_32(body_hashes.size());
+	for (uint32_t body_hash : body_hashes) {
+		h = hash_murmur3_one_32(body_hash, h);
+	}
+	return hash_fmix32(h);
+}
+
+// State records are encoded field by field, so saved buffers carry no padding bytes
+// and only depend on the simulation values. Without a buffer, the writer only counts bytes.
+struct GodotSpace2DStateWriter {
+	uint8_t *w = nullptr;
+	uint32_t size = 0;
+
+	void put_u8(uint8_t p_value) {
+		if (w) {
+			w[size] = p_value;
+		}
+		size += 1;
+	}
+
+	void put_u32(uint32_t p_value) {
+		if (w) {
+			encode_uint32(p_value, w + size);
+		}
+		size += sizeof(uint32_t);
+	}
+
+	void put_u64(uint64_t p_value) {
+		if (w) {
+			encode_uint64(p_value, w + size);
+		}
+		size += sizeof(uint64_t);
+	}
+
+	void put_real(real_t p_value) {
+		if (w) {
+			encode_real(p_value, w + size);
+		}
+		size += sizeof(real_t);
+	}
+
+	void put_vector2(const Vector2 &p_value) {
+		put_real(p_value.x);
+		put_real(p_value.y);
+	}
+};
+
+struct GodotSpace2DStateReader {
+	const uint8_t *r = nullptr;
+
+	uint8_t get_u8() {
+		return *r++;
+	}
+
+	uint32_t get_u32() {
+		uint32_t value = decode_uint32(r);
+		r += sizeof(uint32_t);
+		return value;
+	}
+
+	uint64_t get_u64() {
+		uint64_t value = decode_uint64(r);
+		r += sizeof(uint64_t);
+		return value;
+	}
+
+	real_t get_real() {
+#ifdef REAL_T_IS_DOUBLE
+		real_t value = decode_double(r);
+#else
+		real_t value = decode_float(r);
+#endif
+		r += sizeof(real_t);
+		return value;
+	}
+
+	Vector2 get_vector2() {
+		Vector2 value;
+		value.x = get_real();
+		value.y = get_real();
+		return value;
+	}
+};
+
+static void _write_body_snapshot(GodotSpace2DStateWriter &p_writer, const GodotBody2D::Snapshot &p_snapshot) {
+	p_writer.put_u64(p_snapshot.rid);
+	p_writer.put_vector2(p_snapshot.transform.columns[0]);
+	p_writer.put_vector2(p_snapshot.transform.columns[1]);
+	p_writer.put_vector2(p_snapshot.transform.columns[2]);
+	p_writer.put_vector2(p_snapshot.linear_velocity);
+	p_writer.put_real(p_snapshot.angular_velocity);
+	p_writer.put_real(p_snapshot.still_time);
+	p_writer.put_u8(p_snapshot.active);
+}
+
+static void _read_body_snapshot(GodotSpace2DStateReader &p_reader, GodotBody2D::Snapshot &r_snapshot) {
+	r_snapshot.rid = p_reader.get_u64();
+	r_snapshot.transform.columns[0] = p_reader.get_vector2();
+	r_snapshot.transform.columns[1] = p_reader.get_vector2();
+	r_snapshot.transform.columns[2] = p_reader.get_vector2();
+	r_snapshot.linear_velocity = p_reader.get_vector2();
+	r_snapshot.angular_velocity = p_reader.get_real();
+	r_snapshot.still_time = p_reader.get_real();
+	r_snapshot.active = p_reader.get_u8();
+}
+
+// All contact slots are written, so every pair record has the same size.
+static void _write_contacts_snapshot(GodotSpace2DStateWriter &p_writer, const GodotBodyPair2D::Snapshot &p_snapshot) {
+	p_writer.put_vector2(p_snapshot.sep_axis);
+	for (const auto &c : p_snapshot.contacts) {
+		p_writer.put_vector2(c.position);
+		p_writer.put_vector2(c.normal);
+		p_writer.put_vector2(c.local_A);
+		p_writer.put_vector2(c.local_B);
+		p_writer.put_vector2(c.acc_impulse);
+		p_writer.put_real(c.acc_normal_impulse);
+		p_writer.put_real(c.acc_tangent_impulse);
+		p_writer.put_real(c.acc_bias_impulse);
+		p_writer.put_real(c.acc_bias_impulse_center_of_mass);
+		p_writer.put_real(c.mass_normal);
+		p_writer.put_real(c.mass_tangent);
+		p_writer.put_real(c.bias);
+		p_writer.put_real(c.depth);
+		p_writer.put_u8(c.active);
+		p_writer.put_u8(c.used);
+		p_writer.put_vector2(c.rA);
+		p_writer.put_vector2(c.rB);
+		p_writer.put_real(c.bounce);
+	}
+	p_writer.put_u32(p_snapshot.contact_count);
+	p_writer.put_u8(p_snapshot.collided);
+}
+
+static void _read_contacts_snapshot(GodotSpace2DStateReader &p_reader, GodotBodyPair2D::Snapshot &r_snapshot) {
+	r_snapshot.sep_axis = p_reader.get_vector2();
+	for (auto &c : r_snapshot.contacts) {
+		c.position = p_reader.get_vector2();
+		c.normal = p_reader.get_vector2();
+		c.local_A = p_reader.get_vector2();
+		c.local_B = p_reader.get_vector2();
+		c.acc_impulse = p_reader.get_vector2();
+		c.acc_normal_impulse = p_reader.get_real();
+		c.acc_tangent_impulse = p_reader.get_real();
+		c.acc_bias_impulse = p_reader.get_real();
+		c.acc_bias_impulse_center_of_mass = p_reader.get_real();
+		c.mass_normal = p_reader.get_real();
+		c.mass_tangent = p_reader.get_real();
+		c.bias = p_reader.get_real();
+		c.depth = p_reader.get_real();
+		c.active = p_reader.get_u8();
+		c.used = p_reader.get_u8();
+		c.rA = p_reader.get_vector2();
+		c.rB = p_reader.get_vector2();
+		c.bounce = p_reader.get_real();
+	}
+	r_snapshot.contact_count = MIN((int)p_reader.get_u32(), (int)std_size(r_snapshot.contacts));
+	r_snapshot.collided = p_reader.get_u8();
+}
+
+static void _write_pair_snapshot(GodotSpace2DStateWriter &p_writer, uint64_t p_rid_A, uint64_t p_rid_B, int p_shape_A, int p_shape_B, const GodotBodyPair2D::Snapshot &p_contacts) {
+	p_writer.put_u64(p_rid_A);
+	p_writer.put_u64(p_rid_B);
+	p_writer.put_u32(p_shape_A);
+	p_writer.put_u32(p_shape_B);
+	_write_contacts_snapshot(p_writer, p_contacts);
+}
+
+uint32_t GodotSpace2D::_get_body_snapshot_size() {
+	GodotSpace2DStateWriter writer;
+	_write_body_snapshot(writer, GodotBody2D::Snapshot());
+	return writer.size;
+}
+
+uint32_t GodotSpace2D::_get_pair_snapshot_size() {
+	GodotSpace2DStateWriter writer;
+	_write_pair_snapshot(writer, 0, 0, 0, 0, GodotBodyPair2D::Snapshot());
+	return writer.size;
+}
+
+Vector<uint8_t> GodotSpace2D::save_state() const {
+	LocalVector<const GodotBody2D *> bodies;
+	LocalVector<const GodotBodyPair2D *> pairs;
+
+	for (const GodotCollisionObject2D *object : objects) {
+		if (object->get_type() != GodotCollisionObject2D::TYPE_BODY) {
+			continue;
+		}
+
+		const GodotBody2D *body = static_cast<const GodotBody2D *>(object);
+		bodies.push_back(body);
+
+		for (const Pair<GodotConstraint2D *, int> &E : body->get_constraint_list()) {
+			const GodotBodyPair2D *pair = E.first->as_body_pair();
+			if (pair && pair->get_body_a() == body) {
+				pairs.push_back(pair);
+			}
+		}
+	}
+
+	const uint32_t body_size = _get_body_snapshot_size();
+	const uint32_t pair_size = _get_pair_snapshot_size();
+
+	Vector<uint8_t> state;
+	state.resize(SNAPSHOT_HEADER_SIZE + bodies.size() * body_size + pairs.size() * pair_size);
+
+	GodotSpace2DStateWriter writer;
+	writer.w = state.ptrw();
+
+	writer.put_u32(SNAPSHOT_MAGIC);
+	writer.put_u32(SNAPSHOT_VERSION);
+	writer.put_u32(bodies.size());
+	writer.put_u32(body_size);
+	writer.put_u32(pairs.size());
+	writer.put_u32(pair_size);
+
+	for (const GodotBody2D *body : bodies) {
+		GodotBody2D::Snapshot body_snapshot;
+		body->save_snapshot(body_snapshot);
+		_write_body_snapshot(writer, body_snapshot);
+	}
+
+	for (const GodotBodyPair2D *pair : pairs) {
+		GodotBodyPair2D::Snapshot contacts;
+		pair->save_snapshot(contacts);
+		_write_pair_snapshot(writer, pair->get_body_a()->get_self().get_id(), pair->get_body_b()->get_self().get_id(), pair->get_shape_a(), pair->get_shape_b(), contacts);
+	}
+
+	DEV_ASSERT(writer.size == (uint32_t)state.size());
+
+	return state;
+}
+
+void GodotSpace2D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_MSG(locked, "Can't restore the state of a space while it is being stepped.");
+	ERR_FAIL_COND_MSG(p_state.size() < (int)SNAPSHOT_HEADER_SIZE, "Invalid physics space state.");
+
+	GodotSpace2DStateReader reader;
+	reader.r = p_state.ptr();
+
+	const uint32_t magic = reader.get_u32();
+	const uint32_t version = reader.get_u32();
+	const uint32_t body_count = reader.get_u32();
+	const uint32_t body_size = reader.get_u32();
+	const uint32_t pair_count = reader.get_u32();
+	const uint32_t pair_size = reader.get_u32();
+
+	ERR_FAIL_COND_MSG(magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION, "Invalid physics space state.");
+	ERR_FAIL_COND_MSG(body_size != _get_body_snapshot_size() || pair_size != _get_pair_snapshot_size(), "Physics space state was saved by an incompatible build.");
+	ERR_FAIL_COND_MSG((uint64_t)p_state.size() != SNAPSHOT_HEADER_SIZE + (uint64_t)body_count * body_size + (uint64_t)pair_count * pair_size, "Invalid physics space state.");
+
+	HashMap<uint64_t, GodotBody2D *> bodies;
+	for (GodotCollisionObject2D *object : objects) {
+		if (object->get_type() == GodotCollisionObject2D::TYPE_BODY) {
+			bodies.insert(object->get_self().get_id(), static_cast<GodotBody2D *>(object));
+		}
+	}
+
+	// Bodies that were removed since the state was saved are skipped.
+	for (uint32_t i = 0; i < body_count; i++) {
+		GodotBody2D::Snapshot body_snapshot;
+		_read_body_snapshot(reader, body_snapshot);
+
+		GodotBody2D **body = bodies.getptr(body_snapshot.rid);
+		if (body) {
+			(*body)->restore_snapshot(body_snapshot);
+		}
+	}
+
+	// Let the broadphase create the pairs for the restored transforms, then reset
+	// every contact cache so pairs missing from the state start from scratch.
+	update();
+
+	GodotBodyPair2D::Snapshot empty_contacts;
+	for (const KeyValue<uint64_t, GodotBody2D *> &E : bodies) {
+		for (const Pair<GodotConstraint2D *, int> &C : E.value->get_constraint_list()) {
+			GodotBodyPair2D *pair = C.first->as_body_pair();
+			if (pair && pair->get_body_a() == E.value) {
+				pair->restore_snapshot(empty_contacts);
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < pair_count; i++) {
+		const uint64_t rid_A = reader.get_u64();
+		const uint64_t rid_B = reader.get_u64();
+		const int shape_A = reader.get_u32();
+		const int shape_B = reader.get_u32();
+		GodotBodyPair2D::Snapshot contacts;
+		_read_contacts_snapshot(reader, contacts);
+
+		GodotBody2D **body_A = bodies.getptr(rid_A);
+		if (!body_A) {
+			continue;
+		}
+
+		for (const Pair<GodotConstraint2D *, int> &C : (*body_A)->get_constraint_list()) {
+			GodotBodyPair2D *pair = C.first->as_body_pair();
+			if (pair && pair->get_body_a() == *body_A && pair->get_shape_a() == shape_A && pair->get_shape_b() == shape_B && pair->get_body_b()->get_self().get_id() == rid_B) {
+				pair->restore_snapshot(contacts);
+				break;
+			}
+		}
+	}
+}
+
 void GodotSpace2D::lock() {
 	locked = true;
 }
@@ -1226,6 +1646,7 @@ GodotSpace2D::GodotSpace2D() {
 	contact_max_allowed_penetration = GLOBAL_GET("physics/2d/solver/contact_max_allowed_penetration");
 	contact_bias = GLOBAL_GET("physics/2d/solver/default_contact_bias");
 	constraint_bias = GLOBAL_GET("physics/2d/solver/default_constraint_bias");
+	deterministic = GLOBAL_GET("physics/2d/solver/deterministic");
 
 	broadphase = GodotBroadPhase2D::create_func();
 	broadphase->set_pair_callback(_broadphase_pair, this);
@@ -32,6 +32,7 @@
 
 #include "godot_area_2d.h"
 #include "godot_body_2d.h"
+#include "godot_body_pair_2d.h"
 #include "godot_broad_phase_2d.h"
 #include "godot_collision_object_2d.h"
 
@@ -40,6 +41,14 @@
 class GodotPhysicsDirectSpaceState2D : public PhysicsDirectSpaceState2D {
 	GDCLASS(GodotPhysicsDirectSpaceState2D, PhysicsDirectSpaceState2D);
 
+	bool _intersect_ray(const RayParameters &p_parameters, RayResult &r_result, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices) const;
+	int _intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices) const;
+	bool _cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, GodotCollisionObject2D **r_cull_results, int *r_cull_subindices) const;
+
+protected:
+	virtual bool _begin_query_batch(const QueryBatch &p_batch) override;
+	virtual void _run_query_batch_chunk(const QueryBatch &p_batch, uint32_t p_from, uint32_t p_to) override;
+
 public:
 	GodotSpace2D *space = nullptr;
 
@@ -99,6 +108,8 @@ private:
 	real_t contact_bias = 0.0;
 	real_t constraint_bias = 0.0;
 
+	bool deterministic = false;
+
 	enum {
 		INTERSECTION_QUERY_MAX = 2048
 	};
@@ -106,6 +117,9 @@ private:
 	GodotCollisionObject2D *intersection_query_results[INTERSECTION_QUERY_MAX];
 	int intersection_query_subindex_results[INTERSECTION_QUERY_MAX];
 
+	LocalVector<GodotBody2D *> island_wake_up_stack;
+	bool waking_up_island = false;
+
 	real_t body_linear_velocity_sleep_threshold = 0.0;
 	real_t body_angular_velocity_sleep_threshold = 0.0;
 	real_t body_time_to_sleep = 0.0;
@@ -117,6 +131,9 @@ private:
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int body_pairs = 0;
+	int sleeping_objects = 0;
+	int sleeping_collision_pairs = 0;
 
 	int _cull_aabb_for_body(GodotBody2D *p_body, const Rect2 &p_aabb);
 
@@ -125,6 +142,14 @@ private:
 
 	friend class GodotPhysicsDirectSpaceState2D;
 
+	static constexpr uint32_t SNAPSHOT_MAGIC = 0x32535047; // "GPS2"
+	static constexpr uint32_t SNAPSHOT_VERSION = 2;
+	// Magic, version, then the count and record size of bodies and pairs.
+	static constexpr uint32_t SNAPSHOT_HEADER_SIZE = 6 * sizeof(uint32_t);
+
+	static uint32_t _get_body_snapshot_size();
+	static uint32_t _get_pair_snapshot_size();
+
 public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
@@ -135,6 +160,7 @@ public:
 	const SelfList<GodotBody2D>::List &get_active_body_list() const;
 	void body_add_to_active_list(SelfList<GodotBody2D> *p_body);
 	void body_remove_from_active_list(SelfList<GodotBody2D> *p_body);
+	void body_wake_up_island(GodotBody2D *p_body);
 	void body_add_to_mass_properties_update_list(SelfList<GodotBody2D> *p_body);
 	void body_remove_from_mass_properties_update_list(SelfList<GodotBody2D> *p_body);
 	void area_add_to_moved_list(SelfList<GodotArea2D> *p_area);
@@ -162,6 +188,7 @@ public:
 	_FORCE_INLINE_ real_t get_body_linear_velocity_sleep_threshold() const { return body_linear_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_angular_velocity_sleep_threshold() const { return body_angular_velocity_sleep_threshold; }
 	_FORCE_INLINE_ real_t get_body_time_to_sleep() const { return body_time_to_sleep; }
+	_FORCE_INLINE_ bool is_deterministic() const { return deterministic; }
 
 	void update();
 	void setup();
@@ -177,6 +204,11 @@ public:
 	void set_param(PhysicsServer2D::SpaceParameter p_param, real_t p_value);
 	real_t get_param(PhysicsServer2D::SpaceParameter p_param) const;
 
+	uint32_t get_state_hash() const;
+
+	Vector<uint8_t> save_state() const;
+	void restore_state(const Vector<uint8_t> &p_state);
+
 	void set_island_count(int p_island_count) { island_count = p_island_count; }
 	int get_island_count() const { return island_count; }
 
@@ -184,6 +216,13 @@ public:
 	int get_active_objects() const { return active_objects; }
 
 	int get_collision_pairs() const { return collision_pairs; }
+	int get_body_pairs() const { return body_pairs; }
+
+	void add_sleeping_objects(int p_count) { sleeping_objects += p_count; }
+	int get_sleeping_objects() const { return sleeping_objects; }
+
+	void set_sleeping_collision_pairs(int p_sleeping_collision_pairs) { sleeping_collision_pairs = p_sleeping_collision_pairs; }
+	int get_sleeping_collision_pairs() const { return sleeping_collision_pairs; }
 
 	bool test_body_motion(GodotBody2D *p_body, const PhysicsServer2D::MotionParameters &p_parameters, PhysicsServer2D::MotionResult *r_result);
 
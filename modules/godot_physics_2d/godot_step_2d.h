@@ -40,6 +40,9 @@ class GodotStep2D {
 	int iterations = 0;
 	real_t delta = 0.0;
 
+	// Number of worker tasks used by the parallel phases, -1 uses all worker threads.
+	int max_threads = -1;
+
 	LocalVector<LocalVector<GodotBody2D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint2D *>> constraint_islands;
 	LocalVector<GodotConstraint2D *> all_constraints;
@@ -52,6 +55,10 @@ class GodotStep2D {
 
 public:
 	void step(GodotSpace2D *p_space, real_t p_delta);
+
+	void set_max_threads(int p_max_threads) { max_threads = p_max_threads; }
+	int get_max_threads() const { return max_threads; }
+
 	GodotStep2D();
 	~GodotStep2D();
 };
@@ -0,0 +1,207 @@
+/**************************************************************************/
+/*  test_godot_physics_server_2d.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_2d.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestGodotPhysicsServer2D {
+
+TEST_CASE("[Physics][GodotPhysicsServer2D] Batched space queries") {
+	TestUtils::ScopedServer<GodotPhysicsServer2D> server;
+
+	// Rays and shapes cast down on a floor with a row of boxes on it, the first rays miss everything.
+	LocalVector<RID> rids;
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+	rids.push_back(space);
+
+	RID floor_shape = server->rectangle_shape_create();
+	server->shape_set_data(floor_shape, Vector2(20, 1));
+	rids.push_back(floor_shape);
+	RID floor = server->body_create();
+	server->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+	server->body_add_shape(floor, floor_shape);
+	server->body_set_state(floor, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(0, 1)));
+	server->body_set_space(floor, space);
+	rids.push_back(floor);
+
+	RID box_shape = server->rectangle_shape_create();
+	server->shape_set_data(box_shape, Vector2(0.5, 0.5));
+	rids.push_back(box_shape);
+	for (int i = 0; i < 5; i++) {
+		RID box = server->body_create();
+		server->body_set_mode(box, PhysicsServer2D::BODY_MODE_STATIC);
+		server->body_add_shape(box, box_shape);
+		server->body_set_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0, Vector2(i * 3.0 - 6.0, -0.5)));
+		server->body_set_space(box, space);
+		rids.push_back(box);
+	}
+
+	PhysicsDirectSpaceState2D *space_state = server->space_get_direct_state(space);
+	REQUIRE(space_state);
+
+	const int ray_count = 100;
+	LocalVector<PhysicsDirectSpaceState2D::RayParameters> parameters;
+	parameters.resize(ray_count);
+	for (int i = 0; i < ray_count; i++) {
+		parameters[i].from = Vector2(i * 0.5 - 30.0, -5);
+		parameters[i].to = Vector2(i * 0.5 - 30.0, 5);
+	}
+
+	SUBCASE("Batched ray queries should match single ray queries") {
+		LocalVector<PhysicsDirectSpaceState2D::RayResult> results;
+		results.resize(ray_count);
+		LocalVector<bool> collided;
+		collided.resize(ray_count);
+		const int hits = space_state->intersect_rays(parameters.ptr(), ray_count, results.ptr(), collided.ptr());
+
+		int expected_hits = 0;
+		for (int i = 0; i < ray_count; i++) {
+			PhysicsDirectSpaceState2D::RayResult expected;
+			const bool expected_collided = space_state->intersect_ray(parameters[i], expected);
+			CHECK_MESSAGE(collided[i] == expected_collided, vformat("Ray %d collided differently when batched.", i));
+			if (!expected_collided || !collided[i]) {
+				continue;
+			}
+			expected_hits++;
+			CHECK_MESSAGE(results[i].position.is_equal_approx(expected.position), vformat("Ray %d hit a different position when batched.", i));
+			CHECK_MESSAGE(results[i].normal.is_equal_approx(expected.normal), vformat("Ray %d hit a different normal when batched.", i));
+			CHECK_MESSAGE(results[i].rid == expected.rid, vformat("Ray %d hit a different body when batched.", i));
+			CHECK_MESSAGE(results[i].shape == expected.shape, vformat("Ray %d hit a different shape when batched.", i));
+		}
+		CHECK_EQ(hits, expected_hits);
+		CHECK(hits > 0);
+		CHECK(hits < ray_count);
+	}
+
+	SUBCASE("The script binding should fill the result object") {
+		Array queries;
+		for (int i = 0; i < ray_count; i++) {
+			queries.push_back(PhysicsRayQueryParameters2D::create(parameters[i].from, parameters[i].to, UINT32_MAX, TypedArray<RID>()));
+		}
+		Ref<PhysicsRayQueryResult2D> result;
+		result.instantiate();
+		const int hits = space_state->call("intersect_rays", queries, result);
+		REQUIRE_EQ(result->get_ray_count(), ray_count);
+
+		int expected_hits = 0;
+		for (int i = 0; i < ray_count; i++) {
+			PhysicsDirectSpaceState2D::RayResult expected;
+			const bool expected_collided = space_state->intersect_ray(parameters[i], expected);
+			CHECK_MESSAGE(result->is_colliding(i) == expected_collided, vformat("Ray %d collided differently when batched from scripts.", i));
+			if (expected_collided) {
+				expected_hits++;
+				CHECK(result->get_position(i).is_equal_approx(expected.position));
+				CHECK_EQ(result->get_collider_rid(i), expected.rid);
+			} else {
+				CHECK_EQ(result->get_collider_rid(i), RID());
+			}
+		}
+		CHECK_EQ(hits, expected_hits);
+	}
+
+	SUBCASE("Batched shape queries should match single shape queries") {
+		RID circle_shape = server->circle_shape_create();
+		server->shape_set_data(circle_shape, 0.4);
+		rids.push_back(circle_shape);
+
+		LocalVector<PhysicsDirectSpaceState2D::ShapeParameters> shape_parameters;
+		shape_parameters.resize(ray_count);
+		for (int i = 0; i < ray_count; i++) {
+			shape_parameters[i].shape_rid = circle_shape;
+			shape_parameters[i].transform.set_origin(Vector2(i * 0.5 - 30.0, -0.5));
+		}
+
+		const int result_max = 4;
+		LocalVector<PhysicsDirectSpaceState2D::ShapeResult> results;
+		results.resize(ray_count * result_max);
+		LocalVector<int> result_counts;
+		result_counts.resize(ray_count);
+		const int total = space_state->intersect_shapes(shape_parameters.ptr(), ray_count, results.ptr(), result_max, result_counts.ptr());
+
+		int expected_total = 0;
+		for (int i = 0; i < ray_count; i++) {
+			PhysicsDirectSpaceState2D::ShapeResult expected[result_max];
+			const int expected_count = space_state->intersect_shape(shape_parameters[i], expected, result_max);
+			expected_total += expected_count;
+			REQUIRE_MESSAGE(result_counts[i] == expected_count, vformat("Shape query %d found a different number of results when batched.", i));
+			for (int j = 0; j < expected_count; j++) {
+				CHECK_MESSAGE(results[i * result_max + j].rid == expected[j].rid, vformat("Shape query %d found a different body when batched.", i));
+			}
+		}
+		CHECK_EQ(total, expected_total);
+		CHECK(total > 0);
+		CHECK(total < ray_count);
+	}
+
+	SUBCASE("Batched motion casts should match single motion casts") {
+		RID circle_shape = server->circle_shape_create();
+		server->shape_set_data(circle_shape, 0.4);
+		rids.push_back(circle_shape);
+
+		LocalVector<PhysicsDirectSpaceState2D::ShapeParameters> shape_parameters;
+		shape_parameters.resize(ray_count);
+		for (int i = 0; i < ray_count; i++) {
+			shape_parameters[i].shape_rid = circle_shape;
+			shape_parameters[i].transform.set_origin(Vector2(i * 0.5 - 30.0, -3));
+			shape_parameters[i].motion = Vector2(0, 5);
+		}
+
+		LocalVector<real_t> closest_safe;
+		closest_safe.resize(ray_count);
+		LocalVector<real_t> closest_unsafe;
+		closest_unsafe.resize(ray_count);
+		const int hits = space_state->cast_motions(shape_parameters.ptr(), ray_count, closest_safe.ptr(), closest_unsafe.ptr());
+
+		int expected_hits = 0;
+		for (int i = 0; i < ray_count; i++) {
+			real_t expected_safe = 1.0;
+			real_t expected_unsafe = 1.0;
+			space_state->cast_motion(shape_parameters[i], expected_safe, expected_unsafe);
+			if (expected_unsafe < 1.0) {
+				expected_hits++;
+			}
+			CHECK_MESSAGE(Math::is_equal_approx(closest_safe[i], expected_safe), vformat("Motion cast %d stopped at a different fraction when batched.", i));
+			CHECK_MESSAGE(Math::is_equal_approx(closest_unsafe[i], expected_unsafe), vformat("Motion cast %d stopped at a different fraction when batched.", i));
+		}
+		CHECK_EQ(hits, expected_hits);
+		CHECK(hits > 0);
+	}
+
+	for (int i = (int)rids.size() - 1; i >= 0; i--) {
+		server->free_rid(rids[i]);
+	}
+}
+
+} // namespace TestGodotPhysicsServer2D
@@ -0,0 +1,199 @@
+/**************************************************************************/
+/*  test_godot_step_2d.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_2d.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestGodotStep2D {
+
+// A pile of boxes dropped on the floor.
+struct BoxPile {
+	GodotPhysicsServer2D *server = nullptr;
+	RID space;
+	RID floor_shape;
+	RID floor;
+	RID box_shape;
+	LocalVector<RID> boxes;
+
+	explicit BoxPile(GodotPhysicsServer2D *p_server) {
+		server = p_server;
+
+		space = server->space_create();
+		server->space_set_param(space, PhysicsServer2D::SPACE_PARAM_DETERMINISTIC, 1.0);
+		server->space_set_active(space, true);
+
+		floor_shape = server->world_boundary_shape_create();
+		Array floor_data;
+		floor_data.push_back(Vector2(0, -1));
+		floor_data.push_back(0.0);
+		server->shape_set_data(floor_shape, floor_data);
+		floor = server->body_create();
+		server->body_set_mode(floor, PhysicsServer2D::BODY_MODE_STATIC);
+		server->body_add_shape(floor, floor_shape);
+		server->body_set_space(floor, space);
+
+		box_shape = server->rectangle_shape_create();
+		server->shape_set_data(box_shape, Vector2(8, 8));
+
+		for (int i = 0; i < 64; i++) {
+			RID box = server->body_create();
+			server->body_set_mode(box, PhysicsServer2D::BODY_MODE_RIGID);
+			server->body_add_shape(box, box_shape);
+			server->body_set_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM, Transform2D(0.1 * i, Vector2((i % 8) * 17.0 + (i / 8) * 3.0, -20.0 - (i / 8) * 17.0)));
+			server->body_set_space(box, space);
+			boxes.push_back(box);
+		}
+	}
+
+	// Steps the simulation and returns the space state hash after each step.
+	LocalVector<uint32_t> simulate(int p_steps) {
+		LocalVector<uint32_t> hashes;
+		for (int i = 0; i < p_steps; i++) {
+			server->step(1.0 / 60.0);
+			hashes.push_back(server->space_get_state_hash(space));
+		}
+		return hashes;
+	}
+
+	~BoxPile() {
+		for (const RID &box : boxes) {
+			server->free_rid(box);
+		}
+		server->free_rid(box_shape);
+		server->free_rid(floor);
+		server->free_rid(floor_shape);
+		server->free_rid(space);
+	}
+};
+
+static LocalVector<uint32_t> simulate_box_pile(GodotPhysicsServer2D *p_server, int p_max_threads) {
+	p_server->set_step_max_threads(p_max_threads);
+
+	LocalVector<uint32_t> hashes;
+	{
+		BoxPile pile(p_server);
+		hashes = pile.simulate(120);
+	}
+
+	p_server->set_step_max_threads(-1);
+
+	return hashes;
+}
+
+TEST_CASE("[Physics][GodotStep2D] Deterministic mode doesn't depend on thread count") {
+	TestUtils::ScopedServer<GodotPhysicsServer2D> server;
+
+	LocalVector<uint32_t> single_thread_hashes = simulate_box_pile(server.get(), 1);
+	LocalVector<uint32_t> multi_thread_hashes = simulate_box_pile(server.get(), -1);
+
+	REQUIRE(single_thread_hashes.size() == multi_thread_hashes.size());
+	for (uint32_t i = 0; i < single_thread_hashes.size(); i++) {
+		CHECK_MESSAGE(single_thread_hashes[i] == multi_thread_hashes[i], vformat("State hash diverged at step %d.", i));
+	}
+
+	// The boxes should have moved, otherwise the hashes trivially match.
+	CHECK(single_thread_hashes[0] != single_thread_hashes[single_thread_hashes.size() - 1]);
+}
+
+TEST_CASE("[Physics][GodotStep2D] Restoring a saved state rolls back the simulation") {
+	TestUtils::ScopedServer<GodotPhysicsServer2D> server;
+
+	BoxPile pile(server.get());
+
+	pile.simulate(60);
+	const uint32_t saved_hash = server->space_get_state_hash(pile.space);
+	const Vector<uint8_t> state = server->space_save_state(pile.space);
+	REQUIRE_FALSE(state.is_empty());
+
+	// Saving the same state twice must give the same bytes.
+	CHECK(server->space_save_state(pile.space) == state);
+
+	pile.simulate(30);
+	LocalVector<Vector2> first_origins;
+	for (const RID &box : pile.boxes) {
+		first_origins.push_back(Transform2D(server->body_get_state(box, PhysicsServer2D::BODY_STATE_TRANSFORM)).get_origin());
+	}
+	CHECK(server->space_get_state_hash(pile.space) != saved_hash);
+
+	server->space_restore_state(pile.space, state);
+	CHECK(server->space_get_state_hash(pile.space) == saved_hash);
+
+	// The broadphase pairing history isn't part of the state, so recreated pairs may be solved in a different order.
+	// Resimulating is only expected to follow the original run closely, not bit for bit.
+	pile.simulate(30);
+	for (uint32_t i = 0; i < pile.boxes.size(); i++) {
+		const Vector2 origin = Transform2D(server->body_get_state(pile.boxes[i], PhysicsServer2D::BODY_STATE_TRANSFORM)).get_origin();
+		CHECK_MESSAGE(origin.distance_to(first_origins[i]) < 1.0, vformat("Box %d ended up at %s instead of %s after restoring.", i, origin, first_origins[i]));
+	}
+
+	const uint32_t current_hash = server->space_get_state_hash(pile.space);
+
+	ERR_PRINT_OFF;
+	Vector<uint8_t> invalid_state = state;
+	invalid_state.resize(invalid_state.size() - 1);
+	server->space_restore_state(pile.space, invalid_state);
+	ERR_PRINT_ON;
+
+	// An invalid state must leave the space untouched.
+	CHECK(server->space_get_state_hash(pile.space) == current_hash);
+}
+
+TEST_CASE("[Physics][GodotStep2D] Sleeping bodies stop pairing with each other") {
+	TestUtils::ScopedServer<GodotPhysicsServer2D> server;
+
+	BoxPile pile(server.get());
+
+	for (int i = 0; i < 1800; i++) {
+		pile.simulate(1);
+		if (server->get_process_info(PhysicsServer2D::INFO_ACTIVE_OBJECTS) == 0) {
+			break;
+		}
+	}
+	REQUIRE(server->get_process_info(PhysicsServer2D::INFO_ACTIVE_OBJECTS) == 0);
+	CHECK(server->get_process_info(PhysicsServer2D::INFO_SLEEPING_OBJECTS) == (int)pile.boxes.size());
+
+	// Only the pairs between the boxes and the floor are left, and none of them is processed.
+	const int collision_pairs = server->get_process_info(PhysicsServer2D::INFO_COLLISION_PAIRS);
+	CHECK(collision_pairs > 0);
+	CHECK(collision_pairs < (int)pile.boxes.size());
+	CHECK(server->get_process_info(PhysicsServer2D::INFO_SLEEPING_COLLISION_PAIRS) == collision_pairs);
+
+	// Waking up one box restores its pairs with the sleeping boxes around it.
+	server->body_apply_central_impulse(pile.boxes[pile.boxes.size() - 1], Vector2(0, -100));
+	pile.simulate(1);
+	CHECK(server->get_process_info(PhysicsServer2D::INFO_SLEEPING_OBJECTS) < (int)pile.boxes.size());
+	CHECK(server->get_process_info(PhysicsServer2D::INFO_ACTIVE_OBJECTS) > 0);
+}
+
+} // namespace TestGodotStep2D
@@ -188,6 +188,14 @@ void GodotBody3D::set_active(bool p_active) {
 	} else if (get_space()) {
 		get_space()->body_remove_from_active_list(&active_list);
 	}
+
+	// Sleeping rigid bodies move to their own broadphase tree, so they stop pairing with each other.
+	bool was_sleeping = is_sleeping();
+	_set_sleeping(!active && mode >= PhysicsServer3D::BODY_MODE_RIGID);
+
+	if (was_sleeping && active && get_space()) {
+		get_space()->body_wake_up_island(this);
+	}
 }
 
 void GodotBody3D::set_param(PhysicsServer3D::BodyParameter p_param, const Variant &p_value) {
@@ -337,6 +345,9 @@ void GodotBody3D::set_mode(PhysicsServer3D::BodyMode p_mode) {
 			set_active(true);
 		}
 	}
+
+	// set_active() returns early when the active state doesn't change, so sync the sleep state here as well.
+	_set_sleeping(!active && mode >= PhysicsServer3D::BODY_MODE_RIGID);
 }
 
 PhysicsServer3D::BodyMode GodotBody3D::get_mode() const {
@@ -610,6 +621,7 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	prev_angular_velocity = angular_velocity;
 
 	Vector3 motion;
+	real_t rotation = 0.0;
 	bool do_motion = false;
 
 	if (mode == PhysicsServer3D::BODY_MODE_KINEMATIC) {
@@ -654,6 +666,7 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 
 		if (continuous_cd) {
 			motion = linear_velocity * p_step;
+			rotation = angular_velocity.length() * p_step;
 			do_motion = true;
 		}
 	}
@@ -664,13 +677,24 @@ void GodotBody3D::integrate_forces(real_t p_step) {
 	biased_angular_velocity = Vector3();
 	biased_linear_velocity = Vector3();
 
-	if (do_motion) { //shapes temporarily extend for raycast
-		_update_shapes_with_motion(motion);
-	}
+	// Moving the shapes touches the broadphase, which is not thread-safe, so defer it to update_integrated_motion().
+	integrated_motion_pending = do_motion;
+	integrated_motion = motion;
+	integrated_rotation = rotation;
 
 	contact_count = 0;
 }
 
+void GodotBody3D::update_integrated_motion() {
+	if (!integrated_motion_pending) {
+		return;
+	}
+	integrated_motion_pending = false;
+
+	//shapes temporarily extend for raycast
+	_update_shapes_with_motion(integrated_motion, integrated_rotation);
+}
+
 void GodotBody3D::integrate_velocities(real_t p_step) {
 	if (mode == PhysicsServer3D::BODY_MODE_STATIC) {
 		return;
@@ -799,6 +823,27 @@ bool GodotBody3D::sleep_test(real_t p_step) {
 	}
 }
 
+void GodotBody3D::save_snapshot(Snapshot &r_snapshot) const {
+	r_snapshot.rid = get_self().get_id();
+	r_snapshot.transform = get_transform();
+	r_snapshot.linear_velocity = linear_velocity;
+	r_snapshot.angular_velocity = angular_velocity;
+	r_snapshot.still_time = still_time;
+	r_snapshot.active = active;
+}
+
+void GodotBody3D::restore_snapshot(const Snapshot &p_snapshot) {
+	_set_transform(p_snapshot.transform);
+	_set_inv_transform(p_snapshot.transform.affine_inverse());
+	new_transform = p_snapshot.transform;
+	_update_transform_dependent();
+
+	linear_velocity = p_snapshot.linear_velocity;
+	angular_velocity = p_snapshot.angular_velocity;
+	still_time = p_snapshot.still_time;
+	set_active(p_snapshot.active);
+}
+
 void GodotBody3D::set_state_sync_callback(const Callable &p_callable) {
 	body_state_callback = p_callable;
 }
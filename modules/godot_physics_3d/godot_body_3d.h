@@ -107,6 +107,11 @@ class GodotBody3D : public GodotCollisionObject3D {
 	bool can_sleep = true;
 	bool first_time_kinematic = false;
 
+	// Motion computed by integrate_forces(), applied to the broadphase later on the stepping thread.
+	bool integrated_motion_pending = false;
+	Vector3 integrated_motion;
+	real_t integrated_rotation = 0.0;
+
 	void _mass_properties_changed();
 	virtual void _shapes_changed() override;
 	Transform3D new_transform;
@@ -150,6 +155,19 @@ class GodotBody3D : public GodotCollisionObject3D {
 	friend class GodotPhysicsDirectBodyState3D; // i give up, too many functions to expose
 
 public:
+	// Simulation state kept in space snapshots.
+	struct Snapshot {
+		uint64_t rid = 0;
+		Transform3D transform;
+		Vector3 linear_velocity;
+		Vector3 angular_velocity;
+		real_t still_time = 0.0;
+		bool active = false;
+	};
+
+	void save_snapshot(Snapshot &r_snapshot) const;
+	void restore_snapshot(const Snapshot &p_snapshot);
+
 	void set_state_sync_callback(const Callable &p_callable);
 	void set_force_integration_callback(const Callable &p_callable, const Variant &p_udata = Variant());
 
@@ -317,6 +335,7 @@ public:
 	bool is_axis_locked(PhysicsServer3D::BodyAxis p_axis) const;
 
 	void integrate_forces(real_t p_step);
+	void update_integrated_motion();
 	void integrate_velocities(real_t p_step);
 
 	_FORCE_INLINE_ Vector3 get_velocity_in_local_point(const Vector3 &rel_pos) const {
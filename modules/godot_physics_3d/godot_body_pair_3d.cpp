@@ -42,8 +42,34 @@ void GodotBodyPair3D::_contact_added_callback(const Vector3 &p_point_A, int p_in
 }
 
 void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal) {
-	Vector3 local_A = A->get_inv_transform().basis.xform(p_point_A);
-	Vector3 local_B = B->get_inv_transform().basis.xform(p_point_B - offset_B);
+	Vector3 point_A = p_point_A;
+	Vector3 point_B = p_point_B;
+	Vector3 contact_normal;
+
+	if (speculative_margin_A > 0.0 || speculative_margin_B > 0.0) {
+		// The grown shape only touches the other one here, so the direction of the normal can't be trusted.
+		if (point_A.is_equal_approx(point_B)) {
+			return;
+		}
+
+		// The points lie on the grown shape, move them back onto the actual surfaces.
+		// This makes the depth negative for contacts that are only speculative.
+		point_A += normal * speculative_margin_A;
+		point_B -= normal * speculative_margin_B;
+		contact_normal = -normal;
+
+		// The shape was grown in every direction, only keep the contacts that the bodies can reach
+		// by moving along the normal within the step.
+		real_t gap = (point_B - point_A).dot(contact_normal);
+		if (gap > 0.0 && gap > speculative_rotation - speculative_motion.dot(contact_normal)) {
+			return;
+		}
+	} else {
+		contact_normal = (point_A - point_B).normalized();
+	}
+
+	Vector3 local_A = A->get_inv_transform().basis.xform(point_A);
+	Vector3 local_B = B->get_inv_transform().basis.xform(point_B - offset_B);
 
 	int new_index = contact_count;
 
@@ -54,7 +80,7 @@ void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_ind
 	contact.index_B = p_index_B;
 	contact.local_A = local_A;
 	contact.local_B = local_B;
-	contact.normal = (p_point_A - p_point_B).normalized();
+	contact.normal = contact_normal;
 	contact.used = true;
 
 	// Attempt to determine if the contact will be reused.
@@ -159,95 +185,35 @@ void GodotBodyPair3D::validate_contacts() {
 	}
 }
 
-// `_test_ccd` prevents tunneling by slowing down a high velocity body that is about to collide so
-// that next frame it will be at an appropriate location to collide (i.e. slight overlap).
-// WARNING: The way velocity is adjusted down to cause a collision means the momentum will be
-// weaker than it should for a bounce!
-// Process: Only proceed if body A's motion is high relative to its size.
-// Cast forward along motion vector to see if A is going to enter/pass B's collider next frame, only proceed if it does.
-// Adjust the velocity of A down so that it will just slightly intersect the collider instead of blowing right past it.
-bool GodotBodyPair3D::_test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B) {
-	GodotShape3D *shape_A_ptr = p_A->get_shape(p_shape_A);
-
-	Vector3 motion = p_A->get_linear_velocity() * p_step;
-	real_t mlen = motion.length();
-	if (mlen < CMP_EPSILON) {
-		return false;
-	}
-
-	Vector3 mnormal = motion / mlen;
-
-	real_t min = 0.0, max = 0.0;
-	shape_A_ptr->project_range(mnormal, p_xform_A, min, max);
+// Speculative contacts prevent tunneling by letting the solver see contacts before the shapes touch.
+// The solver allows the bodies to close the remaining gap during the step, but not more, so a fast body
+// stops at the surface instead of passing through it. Angular velocity is accounted for as well,
+// so long thin bodies that spin quickly are handled too.
+void GodotBodyPair3D::_compute_speculative_sweep(real_t p_step, const Transform3D &p_xform_A, const Transform3D &p_xform_B) {
+	speculative_motion = (B->get_linear_velocity() - A->get_linear_velocity()) * p_step;
+
+	// A rotating shape can sweep as far as its farthest point from the center.
+	const GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
+	const GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
+	speculative_rotation = A->get_angular_velocity().length() * p_step * p_xform_A.xform(shape_A_ptr->get_aabb()).size.length() * 0.5;
+	speculative_rotation += B->get_angular_velocity().length() * p_step * p_xform_B.xform(shape_B_ptr->get_aabb()).size.length() * 0.5;
+}
 
-	// Did it move enough in this direction to even attempt raycast?
-	// Let's say it should move more than 1/3 the size of the object in that axis.
-	bool fast_object = mlen > (max - min) * 0.3;
-	if (!fast_object) {
-		return false; // moving slow enough that there's no chance of tunneling.
+void GodotBodyPair3D::_report_contact(const Contact &p_contact, const Vector3 &p_global_A, const Vector3 &p_global_B, const Vector3 &p_offset_A, real_t p_depth) {
+	if (!A->can_report_contacts() && !B->can_report_contacts()) {
+		return;
 	}
 
-	// A is moving fast enough that tunneling might occur. See if it's really about to collide.
-
-	// Roughly predict body B's position in the next frame (ignoring collisions).
-	Transform3D predicted_xform_B = p_xform_B.translated(p_B->get_linear_velocity() * p_step);
-
-	// Support points are the farthest forward points on A in the direction of the motion vector.
-	// i.e. the candidate points of which one should hit B first if any collision does occur.
-	static const int max_supports = 16;
-	Vector3 supports_A[max_supports];
-	int support_count_A;
-	GodotShape3D::FeatureType support_type_A;
-	// Convert mnormal into body A's local xform because get_supports requires (and returns) local coordinates.
-	shape_A_ptr->get_supports(p_xform_A.basis.xform_inv(mnormal).normalized(), max_supports, supports_A, support_count_A, support_type_A);
-
-	// Cast a segment from each support point of A in the motion direction.
-	int segment_support_idx = -1;
-	float segment_hit_length = FLT_MAX;
-	Vector3 segment_hit_local;
-	for (int i = 0; i < support_count_A; i++) {
-		supports_A[i] = p_xform_A.xform(supports_A[i]);
-
-		Vector3 from = supports_A[i];
-		Vector3 to = from + motion;
-
-		Transform3D from_inv = predicted_xform_B.affine_inverse();
-
-		// Back up 10% of the per-frame motion behind the support point and use that as the beginning of our cast.
-		// At high speeds, this may mean we're actually casting from well behind the body instead of inside it, which is odd.
-		// But it still works out.
-		Vector3 local_from = from_inv.xform(from - motion * 0.1);
-		Vector3 local_to = from_inv.xform(to);
-
-		Vector3 rpos, rnorm;
-		int fi = -1;
-		if (p_B->get_shape(p_shape_B)->intersect_segment(local_from, local_to, rpos, rnorm, fi, true)) {
-			float hit_length = local_from.distance_to(rpos);
-			if (hit_length < segment_hit_length) {
-				segment_support_idx = i;
-				segment_hit_length = hit_length;
-				segment_hit_local = rpos;
-			}
-		}
-	}
+	Vector3 crB = B->get_angular_velocity().cross(p_contact.rB) + B->get_linear_velocity();
+	Vector3 crA = A->get_angular_velocity().cross(p_contact.rA) + A->get_linear_velocity();
 
-	if (segment_support_idx == -1) {
-		// There was no hit. Since the segment is the length of per-frame motion, this means the bodies will not
-		// actually collide yet on next frame. We'll probably check again next frame once they're closer.
-		return false;
+	if (A->can_report_contacts()) {
+		A->add_contact(p_global_A + p_offset_A, -p_contact.normal, p_depth, shape_A, crA, p_global_B + p_offset_A, shape_B, B->get_instance_id(), B->get_self(), crB, p_contact.acc_impulse);
 	}
 
-	Vector3 hitpos = predicted_xform_B.xform(segment_hit_local);
-
-	real_t newlen = hitpos.distance_to(supports_A[segment_support_idx]);
-	// Adding 1% of body length to the distance between collision and support point
-	// should cause body A's support point to arrive just within B's collider next frame.
-	newlen += (max - min) * 0.01;
-	// FIXME: This doesn't always work well when colliding with a triangle face of a trimesh shape.
-
-	p_A->set_linear_velocity((mnormal * newlen) / p_step);
-
-	return true;
+	if (B->can_report_contacts()) {
+		B->add_contact(p_global_B + p_offset_A, p_contact.normal, p_depth, shape_B, crB, p_global_A + p_offset_A, shape_A, A->get_instance_id(), A->get_self(), crA, -p_contact.acc_impulse);
+	}
 }
 
 real_t combine_bounce(GodotBody3D *A, GodotBody3D *B) {
@@ -259,7 +225,10 @@ real_t combine_friction(GodotBody3D *A, GodotBody3D *B) {
 }
 
 bool GodotBodyPair3D::setup(real_t p_step) {
-	check_ccd = false;
+	speculative_margin_A = 0.0;
+	speculative_margin_B = 0.0;
+	speculative_motion = Vector3();
+	speculative_rotation = 0.0;
 
 	if (!A->interacts_with(B) || A->has_exception(B->get_self()) || B->has_exception(A->get_self())) {
 		collided = false;
@@ -294,45 +263,39 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 	GodotShape3D *shape_A_ptr = A->get_shape(shape_A);
 	GodotShape3D *shape_B_ptr = B->get_shape(shape_B);
 
-	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis);
+	bool use_ccd = (A->is_continuous_collision_detection_enabled() && collide_A) || (B->is_continuous_collision_detection_enabled() && collide_B);
+	if (use_ccd && !report_contacts_only) {
+		PhysicsServer3D::ShapeType type_A = shape_A_ptr->get_type();
+		PhysicsServer3D::ShapeType type_B = shape_B_ptr->get_type();
 
-	if (!collided) {
-		if (A->is_continuous_collision_detection_enabled() && collide_A) {
-			check_ccd = true;
-			return true;
-		}
+		// World boundaries can't be tunneled through and rays grow along their length, so neither needs speculative contacts.
+		bool can_grow = type_A != PhysicsServer3D::SHAPE_WORLD_BOUNDARY && type_A != PhysicsServer3D::SHAPE_SEPARATION_RAY &&
+				type_B != PhysicsServer3D::SHAPE_WORLD_BOUNDARY && type_B != PhysicsServer3D::SHAPE_SEPARATION_RAY;
 
-		if (B->is_continuous_collision_detection_enabled() && collide_B) {
-			check_ccd = true;
-			return true;
-		}
+		if (can_grow) {
+			_compute_speculative_sweep(p_step, xform_A, xform_B);
 
-		return false;
+			// solve_static() can only grow a shape uniformly, so the margin covers the sweep in every direction.
+			// contact_added_callback() then drops the contacts that lie outside of the motion.
+			real_t margin = speculative_motion.length() + speculative_rotation;
+
+			// Concave shapes can't be grown, so always grow the convex one.
+			if (shape_A_ptr->is_concave()) {
+				speculative_margin_B = margin;
+			} else {
+				speculative_margin_A = margin;
+			}
+		}
 	}
 
-	return true;
+	// When one of the shapes is concave, solve_static() grows the convex one by the first margin.
+	collided = GodotCollisionSolver3D::solve_static(shape_A_ptr, xform_A, shape_B_ptr, xform_B, _contact_added_callback, this, &sep_axis, speculative_margin_A + speculative_margin_B);
+
+	return collided;
 }
 
 bool GodotBodyPair3D::pre_solve(real_t p_step) {
 	if (!collided) {
-		if (check_ccd) {
-			const Vector3 &offset_A = A->get_transform().get_origin();
-			Transform3D xform_Au = Transform3D(A->get_transform().basis, Vector3());
-			Transform3D xform_A = xform_Au * A->get_shape_transform(shape_A);
-
-			Transform3D xform_Bu = B->get_transform();
-			xform_Bu.origin -= offset_A;
-			Transform3D xform_B = xform_Bu * B->get_shape_transform(shape_B);
-
-			if (A->is_continuous_collision_detection_enabled() && collide_A) {
-				_test_ccd(p_step, A, shape_A, xform_A, B, shape_B, xform_B);
-			}
-
-			if (B->is_continuous_collision_detection_enabled() && collide_B) {
-				_test_ccd(p_step, B, shape_B, xform_B, A, shape_A, xform_A);
-			}
-		}
-
 		return false;
 	}
 
@@ -381,7 +344,55 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 		Vector3 axis = global_A - global_B;
 		real_t depth = axis.dot(c.normal);
 
-		if (depth <= 0.0) {
+		c.speculative = depth <= 0.0;
+		if (c.speculative) {
+			if (report_contacts_only || -depth >= speculative_margin_A + speculative_margin_B) {
+				continue;
+			}
+
+			c.rA = global_A - A->get_center_of_mass();
+			c.rB = global_B - B->get_center_of_mass() - offset_B;
+
+			Vector3 crA = A->get_angular_velocity().cross(c.rA);
+			Vector3 crB = B->get_angular_velocity().cross(c.rB);
+			Vector3 dv = B->get_linear_velocity() + crB - A->get_linear_velocity() - crA;
+			real_t approach = dv.dot(c.normal);
+			bool gap_closes = approach * p_step < depth;
+
+			// Bodies stopped by a speculative contact rest right at the surface without penetrating,
+			// so report the contact once the gap closes, or when it's within the allowed penetration.
+			if (gap_closes || -depth <= max_penetration) {
+				_report_contact(c, global_A, global_B, offset_A, depth);
+			}
+
+			Vector3 inertia_A = inv_inertia_tensor_A.xform(c.rA.cross(c.normal));
+			Vector3 inertia_B = inv_inertia_tensor_B.xform(c.rB.cross(c.normal));
+			real_t kNormal = inv_mass_A + inv_mass_B;
+			kNormal += c.normal.dot(inertia_A.cross(c.rA)) + c.normal.dot(inertia_B.cross(c.rB));
+			c.mass_normal = 1.0f / kNormal;
+
+			// Let the bodies approach until they touch, without any position correction.
+			// Speculative contacts don't warm start, as they are not expected to survive the step.
+			c.bias = 0.0;
+			c.bounce = -depth * inv_dt;
+
+			// If the bodies close the gap within this step, the next step only sees them already stopped
+			// against each other, so restitution has to be applied from the approach velocity right here.
+			// The bounced velocity is kept, while the biased velocity pulls the bodies back by the part of
+			// the step spent before the impact, so they turn around at the contact point and not before.
+			real_t bounce = combine_bounce(A, B);
+			if (bounce && gap_closes) {
+				c.bounce = bounce * approach;
+				c.bias = (1.0 + bounce) * depth * inv_dt;
+			}
+			c.depth = depth;
+			c.acc_normal_impulse = 0.0;
+			c.acc_tangent_impulse = Vector3();
+			c.acc_bias_impulse = 0.0;
+			c.acc_bias_impulse_center_of_mass = 0.0;
+
+			c.active = true;
+			do_process = true;
 			continue;
 		}
 
@@ -411,18 +422,7 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 
 		// contact query reporting...
 
-		if (A->can_report_contacts() || B->can_report_contacts()) {
-			Vector3 crB = B->get_angular_velocity().cross(c.rB) + B->get_linear_velocity();
-			Vector3 crA = A->get_angular_velocity().cross(c.rA) + A->get_linear_velocity();
-
-			if (A->can_report_contacts()) {
-				A->add_contact(global_A + offset_A, -c.normal, depth, shape_A, crA, global_B + offset_A, shape_B, B->get_instance_id(), B->get_self(), crB, c.acc_impulse);
-			}
-
-			if (B->can_report_contacts()) {
-				B->add_contact(global_B + offset_A, c.normal, depth, shape_B, crB, global_A + offset_A, shape_A, A->get_instance_id(), A->get_self(), crA, -c.acc_impulse);
-			}
-		}
+		_report_contact(c, global_A, global_B, offset_A, depth);
 
 		if (report_contacts_only) {
 			collided = false;
@@ -483,7 +483,25 @@ void GodotBodyPair3D::solve(real_t p_step) {
 
 		real_t vbn = dbv.dot(c.normal);
 
-		if (Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
+		// Speculative contacts aren't touching, so there is no penetration to resolve.
+		// When they bounce, the biased velocity has to match exactly, even if it pulls the bodies together.
+		if (c.speculative) {
+			if (c.bias != 0.0 && Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
+				real_t jbn = (-vbn + c.bias) * c.mass_normal;
+				c.acc_bias_impulse += jbn;
+
+				Vector3 jb = c.normal * jbn;
+
+				if (collide_A) {
+					A->apply_bias_impulse(-jb, c.rA + A->get_center_of_mass(), max_bias_av);
+				}
+				if (collide_B) {
+					B->apply_bias_impulse(jb, c.rB + B->get_center_of_mass(), max_bias_av);
+				}
+
+				c.active = true;
+			}
+		} else if (Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
 			real_t jbn = (-vbn + c.bias) * c.mass_normal;
 			real_t jbnOld = c.acc_bias_impulse;
 			c.acc_bias_impulse = MAX(jbnOld + jbn, 0.0f);
@@ -595,6 +613,24 @@ void GodotBodyPair3D::solve(real_t p_step) {
 	}
 }
 
+void GodotBodyPair3D::save_snapshot(Snapshot &r_snapshot) const {
+	r_snapshot.sep_axis = sep_axis;
+	for (int i = 0; i < contact_count; i++) {
+		r_snapshot.contacts[i] = contacts[i];
+	}
+	r_snapshot.contact_count = contact_count;
+	r_snapshot.collided = collided;
+}
+
+void GodotBodyPair3D::restore_snapshot(const Snapshot &p_snapshot) {
+	sep_axis = p_snapshot.sep_axis;
+	contact_count = CLAMP(p_snapshot.contact_count, 0, (int)MAX_CONTACTS);
+	for (int i = 0; i < contact_count; i++) {
+		contacts[i] = p_snapshot.contacts[i];
+	}
+	collided = p_snapshot.collided;
+}
+
 GodotBodyPair3D::GodotBodyPair3D(GodotBody3D *p_A, int p_shape_A, GodotBody3D *p_B, int p_shape_B) :
 		GodotBodyContact3D(_arr, 2) {
 	A = p_A;
@@ -816,7 +852,8 @@ bool GodotBodySoftBodyPair3D::pre_solve(real_t p_step) {
 		do_process = true;
 
 		if (body_collides) {
-			body->set_active(true);
+			// Setup runs on worker threads, waking up touches the space and broadphase.
+			body->get_space()->body_defer_wake_up(body);
 		}
 
 		c.bounce = body->get_bounce();
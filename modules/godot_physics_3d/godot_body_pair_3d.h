@@ -55,12 +55,12 @@ protected:
 		real_t depth = 0.0;
 		bool active = false;
 		bool used = false;
+		bool speculative = false; // Not touching yet, only keeps the bodies from closing the gap in a single step.
 		Vector3 rA, rB; // Offset in world orientation with respect to center of mass
 	};
 
 	Vector3 sep_axis;
 	bool collided = false;
-	bool check_ccd = false;
 
 	GodotSpace3D *space = nullptr;
 
@@ -93,6 +93,13 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 
 	Vector3 offset_B; //use local A coordinates to avoid numerical issues on collision detection
 
+	// Distance the convex shape is grown by to find speculative contacts, covering how much the bodies can approach each other in one step.
+	real_t speculative_margin_A = 0.0;
+	real_t speculative_margin_B = 0.0;
+	// Relative motion of B with respect to A over the step, and how far rotation can move the surfaces on top of it.
+	Vector3 speculative_motion;
+	real_t speculative_rotation = 0.0;
+
 	Contact contacts[MAX_CONTACTS];
 	int contact_count = 0;
 
@@ -101,9 +108,29 @@ class GodotBodyPair3D : public GodotBodyContact3D {
 	void contact_added_callback(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal);
 
 	void validate_contacts();
-	bool _test_ccd(real_t p_step, GodotBody3D *p_A, int p_shape_A, const Transform3D &p_xform_A, GodotBody3D *p_B, int p_shape_B, const Transform3D &p_xform_B);
+	void _compute_speculative_sweep(real_t p_step, const Transform3D &p_xform_A, const Transform3D &p_xform_B);
+	void _report_contact(const Contact &p_contact, const Vector3 &p_global_A, const Vector3 &p_global_B, const Vector3 &p_offset_A, real_t p_depth);
 
 public:
+	// Contact state used for warm starting, kept in space snapshots.
+	struct Snapshot {
+		Vector3 sep_axis;
+		Contact contacts[MAX_CONTACTS];
+		int contact_count = 0;
+		bool collided = false;
+	};
+
+	virtual GodotBodyPair3D *as_body_pair() override { return this; }
+	virtual const GodotBodyPair3D *as_body_pair() const override { return this; }
+
+	_FORCE_INLINE_ GodotBody3D *get_body_a() const { return A; }
+	_FORCE_INLINE_ GodotBody3D *get_body_b() const { return B; }
+	_FORCE_INLINE_ int get_shape_a() const { return shape_A; }
+	_FORCE_INLINE_ int get_shape_b() const { return shape_B; }
+
+	void save_snapshot(Snapshot &r_snapshot) const;
+	void restore_snapshot(const Snapshot &p_snapshot);
+
 	virtual bool setup(real_t p_step) override;
 	virtual bool pre_solve(real_t p_step) override;
 	virtual void solve(real_t p_step) override;
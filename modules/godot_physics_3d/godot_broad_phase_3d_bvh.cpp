@@ -34,7 +34,7 @@
 
 GodotBroadPhase3DBVH::ID GodotBroadPhase3DBVH::create(GodotCollisionObject3D *p_object, int p_subindex, const AABB &p_aabb, bool p_static) {
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
-	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
+	uint32_t tree_collision_mask = p_static ? (TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING) : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING);
 	ID oid = bvh.create(p_object, true, tree_id, tree_collision_mask, p_aabb, p_subindex); // Pair everything, don't care?
 	return oid + 1;
 }
@@ -47,7 +47,16 @@ void GodotBroadPhase3DBVH::move(ID p_id, const AABB &p_aabb) {
 void GodotBroadPhase3DBVH::set_static(ID p_id, bool p_static) {
 	ERR_FAIL_COND(!p_id);
 	uint32_t tree_id = p_static ? TREE_STATIC : TREE_DYNAMIC;
-	uint32_t tree_collision_mask = p_static ? TREE_FLAG_DYNAMIC : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC);
+	uint32_t tree_collision_mask = p_static ? (TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING) : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING);
+	bvh.set_tree(p_id - 1, tree_id, tree_collision_mask, false);
+}
+
+void GodotBroadPhase3DBVH::set_sleeping(ID p_id, bool p_sleeping) {
+	ERR_FAIL_COND(!p_id);
+	// Sleeping objects still pair with static and dynamic ones, so anything moving can wake them up,
+	// but pairs between two sleeping objects are dropped and they are never checked against each other.
+	uint32_t tree_id = p_sleeping ? TREE_SLEEPING : TREE_DYNAMIC;
+	uint32_t tree_collision_mask = p_sleeping ? (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC) : (TREE_FLAG_STATIC | TREE_FLAG_DYNAMIC | TREE_FLAG_SLEEPING);
 	bvh.set_tree(p_id - 1, tree_id, tree_collision_mask, false);
 }
 
@@ -66,7 +75,7 @@ GodotCollisionObject3D *GodotBroadPhase3DBVH::get_object(ID p_id) const {
 bool GodotBroadPhase3DBVH::is_static(ID p_id) const {
 	ERR_FAIL_COND_V(!p_id, false);
 	uint32_t tree_id = bvh.get_tree_id(p_id - 1);
-	return tree_id == 0;
+	return tree_id == TREE_STATIC;
 }
 
 int GodotBroadPhase3DBVH::get_subindex(ID p_id) const {
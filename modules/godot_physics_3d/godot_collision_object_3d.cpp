@@ -137,11 +137,37 @@ void GodotCollisionObject3D::_set_static(bool p_static) {
 	for (int i = 0; i < get_shape_count(); i++) {
 		const Shape &s = shapes[i];
 		if (s.bpid > 0) {
-			space->get_broadphase()->set_static(s.bpid, _static);
+			_update_broadphase_tree(s.bpid);
 		}
 	}
 }
 
+void GodotCollisionObject3D::_set_sleeping(bool p_sleeping) {
+	if (_sleeping == p_sleeping) {
+		return;
+	}
+	_sleeping = p_sleeping;
+
+	if (!space) {
+		return;
+	}
+	space->add_sleeping_objects(_sleeping ? 1 : -1);
+	for (int i = 0; i < get_shape_count(); i++) {
+		const Shape &s = shapes[i];
+		if (s.bpid > 0) {
+			_update_broadphase_tree(s.bpid);
+		}
+	}
+}
+
+void GodotCollisionObject3D::_update_broadphase_tree(GodotBroadPhase3D::ID p_bpid) {
+	if (_sleeping && !_static) {
+		space->get_broadphase()->set_sleeping(p_bpid, true);
+	} else {
+		space->get_broadphase()->set_static(p_bpid, _static);
+	}
+}
+
 void GodotCollisionObject3D::_unregister_shapes() {
 	for (int i = 0; i < shapes.size(); i++) {
 		Shape &s = shapes.write[i];
@@ -175,14 +201,14 @@ void GodotCollisionObject3D::_update_shapes() {
 
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
-			space->get_broadphase()->set_static(s.bpid, _static);
+			_update_broadphase_tree(s.bpid);
 		}
 
 		space->get_broadphase()->move(s.bpid, shape_aabb);
 	}
 }
 
-void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion) {
+void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion, real_t p_rotation) {
 	if (!space) {
 		return;
 	}
@@ -197,12 +223,16 @@ void GodotCollisionObject3D::_update_shapes_with_motion(const Vector3 &p_motion)
 		AABB shape_aabb = s.shape->get_aabb();
 		Transform3D xform = transform * s.xform;
 		shape_aabb = xform.xform(shape_aabb);
+		if (p_rotation > 0.0) {
+			// Rotating moves the far ends of the shape by up to the angle times their distance to the center.
+			shape_aabb.grow_by(MIN(p_rotation, (real_t)Math::PI) * shape_aabb.size.length() * 0.5);
+		}
 		shape_aabb.merge_with(AABB(shape_aabb.position + p_motion, shape_aabb.size)); //use motion
 		s.aabb_cache = shape_aabb;
 
 		if (s.bpid == 0) {
 			s.bpid = space->get_broadphase()->create(this, i, shape_aabb, _static);
-			space->get_broadphase()->set_static(s.bpid, _static);
+			_update_broadphase_tree(s.bpid);
 		}
 
 		space->get_broadphase()->move(s.bpid, shape_aabb);
@@ -215,6 +245,9 @@ void GodotCollisionObject3D::_set_space(GodotSpace3D *p_space) {
 
 	if (old_space) {
 		old_space->remove_object(this);
+		if (_sleeping) {
+			old_space->add_sleeping_objects(-1);
+		}
 
 		for (int i = 0; i < shapes.size(); i++) {
 			Shape &s = shapes.write[i];
@@ -227,6 +260,9 @@ void GodotCollisionObject3D::_set_space(GodotSpace3D *p_space) {
 
 	if (space) {
 		space->add_object(this);
+		if (_sleeping) {
+			space->add_sleeping_objects(1);
+		}
 		_update_shapes();
 	}
 }
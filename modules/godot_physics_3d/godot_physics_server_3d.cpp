@@ -214,6 +214,20 @@ int GodotPhysicsServer3D::space_get_contact_count(RID p_space) const {
 	return space->get_debug_contact_count();
 }
 
+Vector<uint8_t> GodotPhysicsServer3D::space_save_state(RID p_space) const {
+	const GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(space->is_locked(), Vector<uint8_t>(), "Space state is inaccessible while the space is being stepped.");
+	return space->save_state();
+}
+
+void GodotPhysicsServer3D::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	GodotSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL(space);
+	ERR_FAIL_COND_MSG(space->is_locked(), "Space state is inaccessible while the space is being stepped.");
+	space->restore_state(p_state);
+}
+
 RID GodotPhysicsServer3D::area_create() {
 	GodotArea3D *area = memnew(GodotArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -1681,14 +1695,63 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	sleeping_objects = 0;
+	sleeping_collision_pairs = 0;
+
+	if (active_spaces.size() > 1) {
+		// The space with the most active bodies, usually the main world, keeps the multithreaded stepper and is
+		// stepped on this thread. The other spaces are stepped alongside it, one task each.
+		GodotSpace3D *main_space = nullptr;
+		stepping_spaces.clear();
+		for (GodotSpace3D *E : active_spaces) {
+			if (!main_space) {
+				main_space = E;
+			} else if (E->get_active_objects() > main_space->get_active_objects()) {
+				stepping_spaces.push_back(main_space);
+				main_space = E;
+			} else {
+				stepping_spaces.push_back(E);
+			}
+		}
+
+		while (space_steppers.size() < stepping_spaces.size()) {
+			GodotStep3D *space_stepper = memnew(GodotStep3D);
+			space_stepper->set_multithreaded(false);
+			space_steppers.push_back(space_stepper);
+		}
+
+		stepping_delta = p_step;
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotPhysicsServer3D::_step_space, nullptr, stepping_spaces.size(), -1, true, SNAME("Physics3DStepSpaces"));
+		stepper->step(main_space, p_step);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		// Spaces don't share any state during the step, so only gather the results, in a fixed order.
+		stepping_spaces.push_back(main_space);
+		for (GodotSpace3D *E : stepping_spaces) {
+			island_count += E->get_island_count();
+			active_objects += E->get_active_objects();
+			collision_pairs += E->get_collision_pairs();
+			sleeping_objects += E->get_sleeping_objects();
+			sleeping_collision_pairs += E->get_sleeping_collision_pairs();
+		}
+		return;
+	}
+
 	for (GodotSpace3D *E : active_spaces) {
 		stepper->step(E, p_step);
 		island_count += E->get_island_count();
 		active_objects += E->get_active_objects();
 		collision_pairs += E->get_collision_pairs();
+		sleeping_objects += E->get_sleeping_objects();
+		sleeping_collision_pairs += E->get_sleeping_collision_pairs();
 	}
 }
 
+void GodotPhysicsServer3D::_step_space(uint32_t p_index, void *p_userdata) {
+	space_steppers[p_index]->step(stepping_spaces[p_index], stepping_delta);
+}
+
 void GodotPhysicsServer3D::sync() {
 	doing_sync = true;
 }
@@ -1749,6 +1812,10 @@ void GodotPhysicsServer3D::end_sync() {
 
 void GodotPhysicsServer3D::finish() {
 	memdelete(stepper);
+	for (GodotStep3D *space_stepper : space_steppers) {
+		memdelete(space_stepper);
+	}
+	space_steppers.clear();
 }
 
 int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
@@ -1762,6 +1829,12 @@ int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
 		case INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case INFO_SLEEPING_OBJECTS: {
+			return sleeping_objects;
+		} break;
+		case INFO_SLEEPING_COLLISION_PAIRS: {
+			return sleeping_collision_pairs;
+		} break;
 	}
 
 	return 0;
@@ -47,6 +47,8 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int sleeping_objects = 0;
+	int sleeping_collision_pairs = 0;
 
 	bool using_threads = false;
 	bool doing_sync = false;
@@ -55,6 +57,13 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	GodotStep3D *stepper = nullptr;
 	HashSet<GodotSpace3D *> active_spaces;
 
+	// Independent spaces are stepped in parallel, each with its own single-threaded stepper.
+	LocalVector<GodotStep3D *> space_steppers;
+	LocalVector<GodotSpace3D *> stepping_spaces;
+	real_t stepping_delta = 0.0;
+
+	void _step_space(uint32_t p_index, void *p_userdata = nullptr);
+
 	mutable RID_PtrOwner<GodotShape3D, true> shape_owner;
 	mutable RID_PtrOwner<GodotSpace3D, true> space_owner;
 	mutable RID_PtrOwner<GodotArea3D, true> area_owner;
@@ -116,6 +125,9 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual Vector<uint8_t> space_save_state(RID p_space) const override;
+	virtual void space_restore_state(RID p_space, const Vector<uint8_t> &p_state) override;
+
 	/* AREA API */
 
 	virtual RID area_create() override;
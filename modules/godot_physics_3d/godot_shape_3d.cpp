@@ -823,16 +823,21 @@ void GodotConvexPolygonShape3D::project_range(const Vector3 &p_normal, const Tra
 		r_min = p_normal.dot(p_transform.xform(get_support(-n)));
 		r_max = p_normal.dot(p_transform.xform(get_support(n)));
 	} else {
-		for (uint32_t i = 0; i < vertex_count; i++) {
-			real_t d = p_normal.dot(p_transform.xform(vrts[i]));
-
-			if (i == 0 || d > r_max) {
-				r_max = d;
-			}
-			if (i == 0 || d < r_min) {
-				r_min = d;
-			}
+		// Project the normal into local space once instead of transforming
+		// every vertex.
+		Vector3 local_normal = p_transform.basis.xform_inv(p_normal);
+		real_t distance = p_normal.dot(p_transform.origin);
+
+		real_t local_min = local_normal.dot(vrts[0]);
+		real_t local_max = local_min;
+		for (uint32_t i = 1; i < vertex_count; i++) {
+			real_t d = local_normal.dot(vrts[i]);
+			local_min = MIN(local_min, d);
+			local_max = MAX(local_max, d);
 		}
+
+		r_min = distance + local_min;
+		r_max = distance + local_max;
 	}
 }
 
@@ -845,6 +850,22 @@ Vector3 GodotConvexPolygonShape3D::get_support(const Vector3 &p_normal) const {
 	// Get the array of vertices
 	const Vector3 *const vertices_array = mesh.vertices.ptr();
 
+	// If every vertex is an extreme vertex, scan them in memory order instead
+	// of going through the index list.
+	if (extreme_vertices.size() == mesh.vertices.size()) {
+		const uint32_t vertex_count = mesh.vertices.size();
+		uint32_t best_index = 0;
+		real_t best_support = p_normal.dot(vertices_array[0]);
+		for (uint32_t i = 1; i < vertex_count; i++) {
+			real_t s = p_normal.dot(vertices_array[i]);
+			if (s > best_support) {
+				best_index = i;
+				best_support = s;
+			}
+		}
+		return vertices_array[best_index];
+	}
+
 	// Start with an initial assumption of the first extreme vertex.
 	int best_vertex = extreme_vertices[0];
 	real_t max_support = p_normal.dot(vertices_array[best_vertex]);
@@ -858,11 +879,6 @@ Vector3 GodotConvexPolygonShape3D::get_support(const Vector3 &p_normal) const {
 		}
 	}
 
-	// If we checked all vertices in the mesh then we're done.
-	if (extreme_vertices.size() == mesh.vertices.size()) {
-		return vertices_array[best_vertex];
-	}
-
 	// Move along the surface until we reach the true support vertex.
 	int last_vertex = -1;
 	while (true) {
@@ -1155,18 +1171,15 @@ GodotConvexPolygonShape3D::GodotConvexPolygonShape3D() {
 /********** FACE POLYGON *************/
 
 void GodotFaceShape3D::project_range(const Vector3 &p_normal, const Transform3D &p_transform, real_t &r_min, real_t &r_max) const {
-	for (int i = 0; i < 3; i++) {
-		Vector3 v = p_transform.xform(vertex[i]);
-		real_t d = p_normal.dot(v);
+	Vector3 local_normal = p_transform.basis.xform_inv(p_normal);
+	real_t distance = p_normal.dot(p_transform.origin);
 
-		if (i == 0 || d > r_max) {
-			r_max = d;
-		}
+	real_t d0 = local_normal.dot(vertex[0]);
+	real_t d1 = local_normal.dot(vertex[1]);
+	real_t d2 = local_normal.dot(vertex[2]);
 
-		if (i == 0 || d < r_min) {
-			r_min = d;
-		}
-	}
+	r_min = distance + MIN(d0, MIN(d1, d2));
+	r_max = distance + MAX(d0, MAX(d1, d2));
 }
 
 Vector3 GodotFaceShape3D::get_support(const Vector3 &p_normal) const {
@@ -1330,41 +1343,41 @@ Vector3 GodotConcavePolygonShape3D::get_support(const Vector3 &p_normal) const {
 	return vptr[vert_support_idx];
 }
 
-void GodotConcavePolygonShape3D::_cull_segment(int p_idx, _SegmentCullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
+void GodotConcavePolygonShape3D::_cull_segment(_SegmentCullParams *p_params) const {
+	int idx = 0;
+	while (idx < p_params->bvh_count) {
+		const BVH *params_bvh = &p_params->bvh[idx];
 
-	if (!params_bvh->aabb.intersects_segment(p_params->from, p_params->to)) {
-		return;
-	}
+		if (!_get_bvh_aabb(*params_bvh).intersects_segment(p_params->from, p_params->to)) {
+			idx = params_bvh->escape_index;
+			continue;
+		}
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-
-		Vector3 res;
-		Vector3 normal;
-		int face_index = params_bvh->face_index;
-		if (face->intersect_segment(p_params->from, p_params->to, res, normal, face_index, true)) {
-			real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
-			if ((d > 0) && (d < p_params->min_d)) {
-				p_params->min_d = d;
-				p_params->result = res;
-				p_params->normal = normal;
-				p_params->face_index = face_index;
-				p_params->collisions++;
+		if (params_bvh->face_index >= 0) {
+			const Face *f = &p_params->faces[params_bvh->face_index];
+			GodotFaceShape3D *face = p_params->face;
+			face->normal = f->normal;
+			face->vertex[0] = p_params->vertices[f->indices[0]];
+			face->vertex[1] = p_params->vertices[f->indices[1]];
+			face->vertex[2] = p_params->vertices[f->indices[2]];
+
+			Vector3 res;
+			Vector3 normal;
+			int face_index = params_bvh->face_index;
+			if (face->intersect_segment(p_params->from, p_params->to, res, normal, face_index, true)) {
+				real_t d = p_params->dir.dot(res) - p_params->dir.dot(p_params->from);
+				if ((d > 0) && (d < p_params->min_d)) {
+					p_params->min_d = d;
+					p_params->result = res;
+					p_params->normal = normal;
+					p_params->face_index = face_index;
+					p_params->collisions++;
+				}
 			}
 		}
-	} else {
-		if (params_bvh->left >= 0) {
-			_cull_segment(params_bvh->left, p_params);
-		}
-		if (params_bvh->right >= 0) {
-			_cull_segment(params_bvh->right, p_params);
-		}
+
+		// Either a leaf, whose escape index is the next node, or a branch to descend into.
+		idx++;
 	}
 }
 
@@ -1389,11 +1402,12 @@ bool GodotConcavePolygonShape3D::intersect_segment(const Vector3 &p_begin, const
 	params.faces = fr;
 	params.vertices = vr;
 	params.bvh = br;
+	params.bvh_count = bvh.size();
 
 	params.face = &face;
 
 	// cull
-	_cull_segment(0, &params);
+	_cull_segment(&params);
 
 	if (params.collisions > 0) {
 		r_result = params.result;
@@ -1413,38 +1427,32 @@ Vector3 GodotConcavePolygonShape3D::get_closest_point_to(const Vector3 &p_point)
 	return Vector3();
 }
 
-bool GodotConcavePolygonShape3D::_cull(int p_idx, _CullParams *p_params) const {
-	const BVH *params_bvh = &p_params->bvh[p_idx];
-
-	if (!p_params->aabb.intersects(params_bvh->aabb)) {
-		return false;
-	}
+void GodotConcavePolygonShape3D::_cull(_CullParams *p_params) const {
+	int idx = 0;
+	while (idx < p_params->bvh_count) {
+		const BVH *params_bvh = &p_params->bvh[idx];
 
-	if (params_bvh->face_index >= 0) {
-		const Face *f = &p_params->faces[params_bvh->face_index];
-		GodotFaceShape3D *face = p_params->face;
-		face->normal = f->normal;
-		face->vertex[0] = p_params->vertices[f->indices[0]];
-		face->vertex[1] = p_params->vertices[f->indices[1]];
-		face->vertex[2] = p_params->vertices[f->indices[2]];
-		if (p_params->callback(p_params->userdata, face)) {
-			return true;
-		}
-	} else {
-		if (params_bvh->left >= 0) {
-			if (_cull(params_bvh->left, p_params)) {
-				return true;
-			}
+		if (params_bvh->min[0] > p_params->max[0] || params_bvh->max[0] < p_params->min[0] ||
+				params_bvh->min[1] > p_params->max[1] || params_bvh->max[1] < p_params->min[1] ||
+				params_bvh->min[2] > p_params->max[2] || params_bvh->max[2] < p_params->min[2]) {
+			idx = params_bvh->escape_index;
+			continue;
 		}
 
-		if (params_bvh->right >= 0) {
-			if (_cull(params_bvh->right, p_params)) {
-				return true;
+		if (params_bvh->face_index >= 0) {
+			const Face *f = &p_params->faces[params_bvh->face_index];
+			GodotFaceShape3D *face = p_params->face;
+			face->normal = f->normal;
+			face->vertex[0] = p_params->vertices[f->indices[0]];
+			face->vertex[1] = p_params->vertices[f->indices[1]];
+			face->vertex[2] = p_params->vertices[f->indices[2]];
+			if (p_params->callback(p_params->userdata, face)) {
+				return;
 			}
 		}
-	}
 
-	return false;
+		idx++;
+	}
 }
 
 void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callback, void *p_userdata, bool p_invert_backface_collision) const {
@@ -1453,7 +1461,10 @@ void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_
 		return;
 	}
 
-	AABB local_aabb = p_local_aabb;
+	// Quantized bounds are clamped to the shape, so reject queries outside of it first.
+	if (!get_aabb().intersects(p_local_aabb)) {
+		return;
+	}
 
 	// unlock data
 	const Face *fr = faces.ptr();
@@ -1465,16 +1476,21 @@ void GodotConcavePolygonShape3D::cull(const AABB &p_local_aabb, QueryCallback p_
 	face.invert_backface_collision = p_invert_backface_collision;
 
 	_CullParams params;
-	params.aabb = local_aabb;
+	const Vector3 aabb_end = p_local_aabb.get_end();
+	for (int i = 0; i < 3; i++) {
+		params.min[i] = _quantize_bvh_floor(p_local_aabb.position[i], i);
+		params.max[i] = _quantize_bvh_ceil(aabb_end[i], i);
+	}
 	params.face = &face;
 	params.faces = fr;
 	params.vertices = vr;
 	params.bvh = br;
+	params.bvh_count = bvh.size();
 	params.callback = p_callback;
 	params.userdata = p_userdata;
 
 	// cull
-	_cull(0, &params);
+	_cull(&params);
 }
 
 Vector3 GodotConcavePolygonShape3D::get_moment_of_inertia(real_t p_mass) const {
@@ -1571,26 +1587,26 @@ _Volume_BVH *_volume_build_bvh(_Volume_BVH_Element *p_elements, int p_size, int
 void GodotConcavePolygonShape3D::_fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx) {
 	int idx = p_idx;
 
-	p_bvh_array[idx].aabb = p_bvh_tree->aabb;
+	// Round outwards by an extra step, so dequantized bounds still contain the faces despite floating-point error.
+	const Vector3 aabb_end = p_bvh_tree->aabb.get_end();
+	for (int i = 0; i < 3; i++) {
+		p_bvh_array[idx].min[i] = MAX(_quantize_bvh_floor(p_bvh_tree->aabb.position[i], i), 1) - 1;
+		p_bvh_array[idx].max[i] = MIN(_quantize_bvh_ceil(aabb_end[i], i), BVH_QUANTIZATION_MAX - 1) + 1;
+	}
 	p_bvh_array[idx].face_index = p_bvh_tree->face_index;
-	//printf("%p - %i: %i(%p)  -- %p:%p\n",%p_bvh_array[idx],p_idx,p_bvh_array[i]->face_index,&p_bvh_tree->face_index,p_bvh_tree->left,p_bvh_tree->right);
 
 	if (p_bvh_tree->left) {
-		p_bvh_array[idx].left = ++p_idx;
+		++p_idx;
 		_fill_bvh(p_bvh_tree->left, p_bvh_array, p_idx);
-
-	} else {
-		p_bvh_array[p_idx].left = -1;
 	}
 
 	if (p_bvh_tree->right) {
-		p_bvh_array[idx].right = ++p_idx;
+		++p_idx;
 		_fill_bvh(p_bvh_tree->right, p_bvh_array, p_idx);
-
-	} else {
-		p_bvh_array[p_idx].right = -1;
 	}
 
+	p_bvh_array[idx].escape_index = p_idx + 1;
+
 	memdelete(p_bvh_tree);
 }
 
@@ -1646,6 +1662,20 @@ void GodotConcavePolygonShape3D::_setup(const Vector<Vector3> &p_faces, bool p_b
 
 	BVH *bvh_arrayw2 = bvh.ptrw();
 
+	// Quantize relative to slightly padded bounds, so nodes on the boundary don't get clamped.
+	const AABB quantization_aabb = _aabb.grow(_aabb.get_longest_axis_size() * 0.0001);
+	bvh_quantization_origin = quantization_aabb.position;
+	for (int i = 0; i < 3; i++) {
+		if (quantization_aabb.size[i] > 0.0) {
+			bvh_quantization_scale[i] = BVH_QUANTIZATION_MAX / quantization_aabb.size[i];
+			bvh_quantization_inv_scale[i] = quantization_aabb.size[i] / BVH_QUANTIZATION_MAX;
+		} else {
+			// Degenerate mesh, every node covers the whole range.
+			bvh_quantization_scale[i] = 0.0;
+			bvh_quantization_inv_scale[i] = 0.0;
+		}
+	}
+
 	int idx = 0;
 	_fill_bvh(bvh_tree, bvh_arrayw2, idx);
 
@@ -2042,8 +2072,30 @@ void GodotHeightMapShape3D::cull(const AABB &p_local_aabb, QueryCallback p_callb
 	face.backface_collision = !p_invert_backface_collision;
 	face.invert_backface_collision = p_invert_backface_collision;
 
+	// Skip cells that are entirely above or below the query, which is most of them for
+	// bodies resting on the terrain. Chunk bounds reject whole runs of cells at once.
+	const real_t aabb_min_y = local_aabb.position.y;
+	const real_t aabb_max_y = local_aabb.position.y + local_aabb.size.y;
+
 	for (int z = start_z; z < end_z; z++) {
 		for (int x = start_x; x < end_x; x++) {
+			if (!bounds_grid.is_empty()) {
+				const Range &chunk = _get_bounds_chunk(x / BOUNDS_CHUNK_SIZE, z / BOUNDS_CHUNK_SIZE);
+				if (chunk.max < aabb_min_y || chunk.min > aabb_max_y) {
+					// Continue with the first cell of the next chunk.
+					x = (x / BOUNDS_CHUNK_SIZE + 1) * BOUNDS_CHUNK_SIZE - 1;
+					continue;
+				}
+			}
+
+			const real_t h00 = _get_height(x, z);
+			const real_t h10 = _get_height(x + 1, z);
+			const real_t h01 = _get_height(x, z + 1);
+			const real_t h11 = _get_height(x + 1, z + 1);
+			if (MAX(MAX(h00, h10), MAX(h01, h11)) < aabb_min_y || MIN(MIN(h00, h10), MIN(h01, h11)) > aabb_max_y) {
+				continue;
+			}
+
 			// First triangle.
 			_get_point(x, z, face.vertex[0]);
 			_get_point(x + 1, z, face.vertex[1]);
@@ -315,23 +315,50 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 	Vector<Face> faces;
 	Vector<Vector3> vertices;
 
+	// Nodes are stored in depth-first order, so the first child of a branch is
+	// always the next node and the tree can be walked without a stack.
 	struct BVH {
-		AABB aabb;
-		int left = 0;
-		int right = 0;
-
-		int face_index = 0;
+		// Bounds quantized to the shape's AABB and rounded outwards.
+		uint16_t min[3] = {};
+		uint16_t max[3] = {};
+		// Next node to visit once this node's subtree is done or skipped.
+		int escape_index = 0;
+		int face_index = -1;
 	};
 
 	Vector<BVH> bvh;
 
+	static const uint32_t BVH_QUANTIZATION_MAX = 65535;
+
+	Vector3 bvh_quantization_origin;
+	Vector3 bvh_quantization_scale;
+	Vector3 bvh_quantization_inv_scale;
+
+	_FORCE_INLINE_ uint16_t _quantize_bvh_floor(real_t p_value, int p_axis) const {
+		real_t q = Math::floor((p_value - bvh_quantization_origin[p_axis]) * bvh_quantization_scale[p_axis]);
+		return (uint16_t)CLAMP(q, (real_t)0.0, (real_t)BVH_QUANTIZATION_MAX);
+	}
+
+	_FORCE_INLINE_ uint16_t _quantize_bvh_ceil(real_t p_value, int p_axis) const {
+		real_t q = Math::ceil((p_value - bvh_quantization_origin[p_axis]) * bvh_quantization_scale[p_axis]);
+		return (uint16_t)CLAMP(q, (real_t)0.0, (real_t)BVH_QUANTIZATION_MAX);
+	}
+
+	_FORCE_INLINE_ AABB _get_bvh_aabb(const BVH &p_node) const {
+		Vector3 from(p_node.min[0], p_node.min[1], p_node.min[2]);
+		Vector3 to(p_node.max[0], p_node.max[1], p_node.max[2]);
+		return AABB(bvh_quantization_origin + from * bvh_quantization_inv_scale, (to - from) * bvh_quantization_inv_scale);
+	}
+
 	struct _CullParams {
-		AABB aabb;
+		uint16_t min[3] = {};
+		uint16_t max[3] = {};
 		QueryCallback callback = nullptr;
 		void *userdata = nullptr;
 		const Face *faces = nullptr;
 		const Vector3 *vertices = nullptr;
 		const BVH *bvh = nullptr;
+		int bvh_count = 0;
 		GodotFaceShape3D *face = nullptr;
 	};
 
@@ -342,6 +369,7 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 		const Face *faces = nullptr;
 		const Vector3 *vertices = nullptr;
 		const BVH *bvh = nullptr;
+		int bvh_count = 0;
 		GodotFaceShape3D *face = nullptr;
 
 		Vector3 result;
@@ -353,8 +381,8 @@ struct GodotConcavePolygonShape3D : public GodotConcaveShape3D {
 
 	bool backface_collision = false;
 
-	void _cull_segment(int p_idx, _SegmentCullParams *p_params) const;
-	bool _cull(int p_idx, _CullParams *p_params) const;
+	void _cull_segment(_SegmentCullParams *p_params) const;
+	void _cull(_CullParams *p_params) const;
 
 	void _fill_bvh(_Volume_BVH *p_bvh_tree, BVH *p_bvh_array, int &p_idx);
 
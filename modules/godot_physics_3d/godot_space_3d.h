@@ -32,15 +32,25 @@
 
 #include "godot_area_3d.h"
 #include "godot_body_3d.h"
+#include "godot_body_pair_3d.h"
 #include "godot_broad_phase_3d.h"
 #include "godot_collision_object_3d.h"
 #include "godot_soft_body_3d.h"
 
+#include "core/os/mutex.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
 	GDCLASS(GodotPhysicsDirectSpaceState3D, PhysicsDirectSpaceState3D);
 
+	bool _intersect_ray(const RayParameters &p_parameters, RayResult &r_result, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices) const;
+	int _intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices) const;
+	bool _cast_motion(const ShapeParameters &p_parameters, real_t &p_closest_safe, real_t &p_closest_unsafe, ShapeRestInfo *r_info, GodotCollisionObject3D **r_cull_results, int *r_cull_subindices) const;
+
+protected:
+	virtual bool _begin_query_batch(const QueryBatch &p_batch) override;
+	virtual void _run_query_batch_chunk(const QueryBatch &p_batch, uint32_t p_from, uint32_t p_to) override;
+
 public:
 	GodotSpace3D *space = nullptr;
 
@@ -102,6 +112,13 @@ private:
 	GodotCollisionObject3D *intersection_query_results[INTERSECTION_QUERY_MAX];
 	int intersection_query_subindex_results[INTERSECTION_QUERY_MAX];
 
+	LocalVector<GodotBody3D *> island_wake_up_stack;
+	bool waking_up_island = false;
+
+	// Wake-ups requested from worker threads during the step, applied once back on the stepping thread.
+	Mutex deferred_wake_up_mutex;
+	LocalVector<GodotBody3D *> deferred_wake_ups;
+
 	real_t body_linear_velocity_sleep_threshold = 0.0;
 	real_t body_angular_velocity_sleep_threshold = 0.0;
 	real_t body_time_to_sleep = 0.0;
@@ -113,6 +130,9 @@ private:
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int body_pairs = 0;
+	int sleeping_objects = 0;
+	int sleeping_collision_pairs = 0;
 
 	RID static_global_body;
 
@@ -123,6 +143,14 @@ private:
 
 	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb);
 
+	static constexpr uint32_t SNAPSHOT_MAGIC = 0x33535047; // "GPS3"
+	static constexpr uint32_t SNAPSHOT_VERSION = 2;
+	// Magic, version, then the count and record size of bodies and pairs.
+	static constexpr uint32_t SNAPSHOT_HEADER_SIZE = 6 * sizeof(uint32_t);
+
+	static uint32_t _get_body_snapshot_size();
+	static uint32_t _get_pair_snapshot_size();
+
 public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
@@ -133,6 +161,9 @@ public:
 	const SelfList<GodotBody3D>::List &get_active_body_list() const;
 	void body_add_to_active_list(SelfList<GodotBody3D> *p_body);
 	void body_remove_from_active_list(SelfList<GodotBody3D> *p_body);
+	void body_wake_up_island(GodotBody3D *p_body);
+	void body_defer_wake_up(GodotBody3D *p_body);
+	void flush_deferred_wake_ups();
 	void body_add_to_mass_properties_update_list(SelfList<GodotBody3D> *p_body);
 	void body_remove_from_mass_properties_update_list(SelfList<GodotBody3D> *p_body);
 
@@ -178,6 +209,9 @@ public:
 	void set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_value);
 	real_t get_param(PhysicsServer3D::SpaceParameter p_param) const;
 
+	Vector<uint8_t> save_state() const;
+	void restore_state(const Vector<uint8_t> &p_state);
+
 	void set_island_count(int p_island_count) { island_count = p_island_count; }
 	int get_island_count() const { return island_count; }
 
@@ -185,6 +219,13 @@ public:
 	int get_active_objects() const { return active_objects; }
 
 	int get_collision_pairs() const { return collision_pairs; }
+	int get_body_pairs() const { return body_pairs; }
+
+	void add_sleeping_objects(int p_count) { sleeping_objects += p_count; }
+	int get_sleeping_objects() const { return sleeping_objects; }
+
+	void set_sleeping_collision_pairs(int p_sleeping_collision_pairs) { sleeping_collision_pairs = p_sleeping_collision_pairs; }
+	int get_sleeping_collision_pairs() const { return sleeping_collision_pairs; }
 
 	GodotPhysicsDirectSpaceState3D *get_direct_state();
 
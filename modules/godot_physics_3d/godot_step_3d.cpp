@@ -32,7 +32,6 @@
 
 #include "godot_joint_3d.h"
 
-#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #define BODY_ISLAND_COUNT_RESERVE 128
@@ -40,6 +39,7 @@
 #define ISLAND_COUNT_RESERVE 128
 #define ISLAND_SIZE_RESERVE 512
 #define CONSTRAINT_COUNT_RESERVE 1024
+#define INTEGRATE_FORCES_PARALLEL_MIN_BODIES 64
 
 void GodotStep3D::_populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island) {
 	p_body->set_island_step(_step);
@@ -112,6 +112,10 @@ void GodotStep3D::_populate_island_soft_body(GodotSoftBody3D *p_soft_body, Local
 	}
 }
 
+void GodotStep3D::_integrate_forces(uint32_t p_body_index, void *p_userdata) {
+	active_bodies[p_body_index]->integrate_forces(delta);
+}
+
 void GodotStep3D::_setup_constraint(uint32_t p_constraint_index, void *p_userdata) {
 	GodotConstraint3D *constraint = all_constraints[p_constraint_index];
 	constraint->setup(delta);
@@ -185,6 +189,8 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	p_space->lock(); // can't access space during this
 
+	_step = step_counter.increment();
+
 	p_space->setup(); //update inertias, etc
 
 	p_space->set_last_step(p_delta);
@@ -203,13 +209,30 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	int active_count = 0;
 
+	active_bodies.clear();
 	const SelfList<GodotBody3D> *b = body_list->first();
 	while (b) {
-		b->self()->integrate_forces(p_delta);
+		active_bodies.push_back(b->self());
 		b = b->next();
 		active_count++;
 	}
 
+	// Force integration only touches per-body state, so it can run in parallel.
+	// It's cheap per body, so small spaces don't make up for the cost of dispatching a group task.
+	uint32_t active_body_count = active_bodies.size();
+	if (active_body_count >= INTEGRATE_FORCES_PARALLEL_MIN_BODIES) {
+		_run_tasks(&GodotStep3D::_integrate_forces, active_body_count, SNAME("Physics3DIntegrateForces"));
+	} else {
+		for (uint32_t body_index = 0; body_index < active_body_count; ++body_index) {
+			_integrate_forces(body_index);
+		}
+	}
+
+	// Moving shapes in the broadphase must stay on this thread.
+	for (uint32_t body_index = 0; body_index < active_body_count; ++body_index) {
+		active_bodies[body_index]->update_integrated_motion();
+	}
+
 	/* UPDATE SOFT BODY MOTION */
 
 	const SelfList<GodotSoftBody3D> *sb = soft_body_list->first();
@@ -335,6 +358,15 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	p_space->set_island_count((int)island_count);
 
+	// Body pairs that weren't reached from any active body belong to sleeping islands.
+	int awake_body_pairs = 0;
+	for (const GodotConstraint3D *constraint : all_constraints) {
+		if (constraint->as_body_pair()) {
+			awake_body_pairs++;
+		}
+	}
+	p_space->set_sleeping_collision_pairs(p_space->get_body_pairs() - awake_body_pairs);
+
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
 		p_space->set_elapsed_time(GodotSpace3D::ELAPSED_TIME_GENERATE_ISLANDS, profile_endtime - profile_begtime);
@@ -344,8 +376,8 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	/* SETUP CONSTRAINTS / PROCESS COLLISIONS */
 
 	uint32_t total_constraint_count = all_constraints.size();
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_setup_constraint, nullptr, total_constraint_count, -1, true, SNAME("Physics3DConstraintSetup"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	_run_tasks(&GodotStep3D::_setup_constraint, total_constraint_count, SNAME("Physics3DConstraintSetup"));
+	p_space->flush_deferred_wake_ups();
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -364,8 +396,7 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 
 	// WARNING: `_solve_island` modifies the constraint islands for optimization purpose,
 	// their content is not reliable after these calls and shouldn't be used anymore.
-	group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotStep3D::_solve_island, nullptr, island_count, -1, true, SNAME("Physics3DConstraintSolveIslands"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	_run_tasks(&GodotStep3D::_solve_island, island_count, SNAME("Physics3DConstraintSolveIslands"));
 
 	{ //profile
 		profile_endtime = OS::get_singleton()->get_ticks_usec();
@@ -405,9 +436,10 @@ void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
 	all_constraints.clear();
 
 	p_space->unlock();
-	_step++;
 }
 
+SafeNumeric<uint64_t> GodotStep3D::step_counter;
+
 GodotStep3D::GodotStep3D() {
 	body_islands.reserve(BODY_ISLAND_COUNT_RESERVE);
 	constraint_islands.reserve(ISLAND_COUNT_RESERVE);
@@ -32,10 +32,17 @@
 
 #include "godot_space_3d.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class GodotStep3D {
-	uint64_t _step = 1;
+	// Shared by all steppers, so island markers left on an object by one space are never mistaken for another's.
+	static SafeNumeric<uint64_t> step_counter;
+
+	uint64_t _step = 0;
+
+	bool multithreaded = true;
 
 	int iterations = 0;
 	real_t delta = 0.0;
@@ -43,15 +50,34 @@ class GodotStep3D {
 	LocalVector<LocalVector<GodotBody3D *>> body_islands;
 	LocalVector<LocalVector<GodotConstraint3D *>> constraint_islands;
 	LocalVector<GodotConstraint3D *> all_constraints;
+	LocalVector<GodotBody3D *> active_bodies;
 
 	void _populate_island(GodotBody3D *p_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
 	void _populate_island_soft_body(GodotSoftBody3D *p_soft_body, LocalVector<GodotBody3D *> &p_body_island, LocalVector<GodotConstraint3D *> &p_constraint_island);
+	void _integrate_forces(uint32_t p_body_index, void *p_userdata = nullptr);
 	void _setup_constraint(uint32_t p_constraint_index, void *p_userdata = nullptr);
 	void _pre_solve_island(LocalVector<GodotConstraint3D *> &p_constraint_island) const;
 	void _solve_island(uint32_t p_island_index, void *p_userdata = nullptr);
 	void _check_suspend(const LocalVector<GodotBody3D *> &p_body_island) const;
 
+	template <typename M>
+	void _run_tasks(M p_method, uint32_t p_elements, const StringName &p_description) {
+		if (!multithreaded) {
+			for (uint32_t i = 0; i < p_elements; i++) {
+				(this->*p_method)(i, nullptr);
+			}
+			return;
+		}
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, p_method, nullptr, p_elements, -1, true, p_description);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
+
 public:
+	// Disabled when the stepper itself runs on a worker thread, where waiting for nested group tasks could starve the pool.
+	void set_multithreaded(bool p_enabled) { multithreaded = p_enabled; }
+	bool is_multithreaded() const { return multithreaded; }
+
 	void step(GodotSpace3D *p_space, real_t p_delta);
 	GodotStep3D();
 	~GodotStep3D();
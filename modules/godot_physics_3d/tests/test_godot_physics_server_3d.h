@@ -0,0 +1,332 @@
+/**************************************************************************/
+/*  test_godot_physics_server_3d.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_3d.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestGodotPhysicsServer3D {
+
+// A floor and a row of box characters above it, at increasing heights.
+static RID create_motion_batch_scene(PhysicsServer3D *p_server, LocalVector<RID> &r_rids, LocalVector<RID> &r_characters) {
+	RID space = p_server->space_create();
+	p_server->space_set_active(space, true);
+	r_rids.push_back(space);
+
+	RID floor_shape = p_server->box_shape_create();
+	p_server->shape_set_data(floor_shape, Vector3(50, 1, 50));
+	r_rids.push_back(floor_shape);
+	RID floor = p_server->body_create();
+	p_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	p_server->body_add_shape(floor, floor_shape);
+	p_server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+	p_server->body_set_space(floor, space);
+	r_rids.push_back(floor);
+
+	RID box_shape = p_server->box_shape_create();
+	p_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	r_rids.push_back(box_shape);
+	for (int i = 0; i < 8; i++) {
+		RID character = p_server->body_create();
+		p_server->body_set_mode(character, PhysicsServer3D::BODY_MODE_KINEMATIC);
+		p_server->body_add_shape(character, box_shape);
+		p_server->body_set_state(character, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(i * 3.0, 1.0 + i * 0.25, 0)));
+		p_server->body_set_space(character, space);
+		r_characters.push_back(character);
+	}
+
+	return space;
+}
+
+static void free_motion_batch_scene(PhysicsServer3D *p_server, const LocalVector<RID> &p_rids, const LocalVector<RID> &p_characters) {
+	for (const RID &character : p_characters) {
+		p_server->free_rid(character);
+	}
+	for (int i = (int)p_rids.size() - 1; i >= 0; i--) {
+		p_server->free_rid(p_rids[i]);
+	}
+}
+
+static void check_motion_batch(PhysicsServer3D *p_server) {
+	LocalVector<RID> rids;
+	LocalVector<RID> characters;
+	create_motion_batch_scene(p_server, rids, characters);
+
+	// Even characters fall far enough to hit the floor, odd ones move sideways without hitting anything.
+	LocalVector<PhysicsServer3D::MotionQuery> queries;
+	queries.resize(characters.size());
+	for (uint32_t i = 0; i < characters.size(); i++) {
+		queries[i].body = characters[i];
+		queries[i].parameters.from = p_server->body_get_state(characters[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		queries[i].parameters.motion = i % 2 == 0 ? Vector3(0, -3, 0) : Vector3(0, 0, 1);
+	}
+
+	SUBCASE("Batched motion tests should match single motion tests") {
+		p_server->body_test_motion_batch(queries.ptr(), queries.size());
+		for (uint32_t i = 0; i < queries.size(); i++) {
+			PhysicsServer3D::MotionResult result;
+			const bool collided = p_server->body_test_motion(queries[i].body, queries[i].parameters, &result);
+			CHECK_MESSAGE(queries[i].collided == collided, vformat("Motion %d collided differently when batched.", i));
+			CHECK_MESSAGE(queries[i].collided == (i % 2 == 0), vformat("Motion %d collided unexpectedly.", i));
+			CHECK_MESSAGE(queries[i].result.travel.is_equal_approx(result.travel), vformat("Motion %d traveled differently when batched.", i));
+		}
+	}
+
+	SUBCASE("The script binding should return whether each motion collided, with or without results") {
+		Array bodies;
+		Array parameters;
+		Array results;
+		for (uint32_t i = 0; i < queries.size(); i++) {
+			Ref<PhysicsTestMotionParameters3D> motion_parameters;
+			motion_parameters.instantiate();
+			motion_parameters->set_from(queries[i].parameters.from);
+			motion_parameters->set_motion(queries[i].parameters.motion);
+			bodies.push_back(queries[i].body);
+			parameters.push_back(motion_parameters);
+			// Only ask for the details of every other motion.
+			if (i % 4 == 0) {
+				Ref<PhysicsTestMotionResult3D> motion_result;
+				motion_result.instantiate();
+				results.push_back(motion_result);
+			} else {
+				results.push_back(Variant());
+			}
+		}
+
+		const Array collided_without_results = p_server->call("body_test_motion_batch", bodies, parameters);
+		const Array collided = p_server->call("body_test_motion_batch", bodies, parameters, results);
+		REQUIRE_EQ(collided_without_results.size(), (int)queries.size());
+		REQUIRE_EQ(collided.size(), (int)queries.size());
+		for (uint32_t i = 0; i < queries.size(); i++) {
+			CHECK_EQ(bool(collided_without_results[i]), i % 2 == 0);
+			CHECK_EQ(bool(collided[i]), i % 2 == 0);
+		}
+
+		Ref<PhysicsTestMotionResult3D> first_result = results[0];
+		CHECK_EQ(first_result->get_collision_count(), 1);
+		CHECK_EQ(first_result->get_collider_rid(), rids[2]);
+	}
+
+	SUBCASE("Sliding motions should continue along the surfaces they hit") {
+		for (uint32_t i = 0; i < queries.size(); i++) {
+			queries[i].parameters.motion = Vector3(2, -3, 0);
+		}
+		p_server->body_slide_motion_batch(queries.ptr(), queries.size(), 4);
+		for (uint32_t i = 0; i < queries.size(); i++) {
+			CHECK_MESSAGE(queries[i].collided, vformat("Sliding motion %d didn't hit the floor.", i));
+			CHECK_MESSAGE(Math::abs(queries[i].result.travel.x - 2.0) < 0.01, vformat("Sliding motion %d stopped at the floor instead of sliding along it.", i));
+			CHECK_MESSAGE(queries[i].result.remainder.is_zero_approx(), vformat("Sliding motion %d has motion left over.", i));
+		}
+	}
+
+	free_motion_batch_scene(p_server, rids, characters);
+}
+
+// Rays and shapes cast down on a floor with a row of boxes on it, the first rays miss everything.
+static void check_query_batch(PhysicsServer3D *p_server) {
+	LocalVector<RID> rids;
+	RID space = p_server->space_create();
+	p_server->space_set_active(space, true);
+	rids.push_back(space);
+
+	RID floor_shape = p_server->box_shape_create();
+	p_server->shape_set_data(floor_shape, Vector3(20, 1, 20));
+	rids.push_back(floor_shape);
+	RID floor = p_server->body_create();
+	p_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	p_server->body_add_shape(floor, floor_shape);
+	p_server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -1, 0)));
+	p_server->body_set_space(floor, space);
+	rids.push_back(floor);
+
+	RID box_shape = p_server->box_shape_create();
+	p_server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+	rids.push_back(box_shape);
+	for (int i = 0; i < 5; i++) {
+		RID box = p_server->body_create();
+		p_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_STATIC);
+		p_server->body_add_shape(box, box_shape);
+		p_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(i * 3.0 - 6.0, 0.5, 0)));
+		p_server->body_set_space(box, space);
+		rids.push_back(box);
+	}
+
+	PhysicsDirectSpaceState3D *space_state = p_server->space_get_direct_state(space);
+	REQUIRE(space_state);
+
+	const int ray_count = 100;
+	LocalVector<PhysicsDirectSpaceState3D::RayParameters> parameters;
+	parameters.resize(ray_count);
+	for (int i = 0; i < ray_count; i++) {
+		parameters[i].from = Vector3(i * 0.5 - 30.0, 5, 0.25);
+		parameters[i].to = Vector3(i * 0.5 - 30.0, -5, 0.25);
+	}
+
+	SUBCASE("Batched ray queries should match single ray queries") {
+		LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+		results.resize(ray_count);
+		LocalVector<bool> collided;
+		collided.resize(ray_count);
+		const int hits = space_state->intersect_rays(parameters.ptr(), ray_count, results.ptr(), collided.ptr());
+
+		int expected_hits = 0;
+		for (int i = 0; i < ray_count; i++) {
+			PhysicsDirectSpaceState3D::RayResult expected;
+			const bool expected_collided = space_state->intersect_ray(parameters[i], expected);
+			CHECK_MESSAGE(collided[i] == expected_collided, vformat("Ray %d collided differently when batched.", i));
+			if (!expected_collided || !collided[i]) {
+				continue;
+			}
+			expected_hits++;
+			CHECK_MESSAGE(results[i].position.is_equal_approx(expected.position), vformat("Ray %d hit a different position when batched.", i));
+			CHECK_MESSAGE(results[i].normal.is_equal_approx(expected.normal), vformat("Ray %d hit a different normal when batched.", i));
+			CHECK_MESSAGE(results[i].rid == expected.rid, vformat("Ray %d hit a different body when batched.", i));
+			CHECK_MESSAGE(results[i].shape == expected.shape, vformat("Ray %d hit a different shape when batched.", i));
+		}
+		CHECK_EQ(hits, expected_hits);
+		CHECK(hits > 0);
+		CHECK(hits < ray_count);
+	}
+
+	SUBCASE("The script binding should fill the result object") {
+		Array queries;
+		for (int i = 0; i < ray_count; i++) {
+			queries.push_back(PhysicsRayQueryParameters3D::create(parameters[i].from, parameters[i].to, UINT32_MAX, TypedArray<RID>()));
+		}
+		Ref<PhysicsRayQueryResult3D> result;
+		result.instantiate();
+		const int hits = space_state->call("intersect_rays", queries, result);
+		REQUIRE_EQ(result->get_ray_count(), ray_count);
+
+		int expected_hits = 0;
+		for (int i = 0; i < ray_count; i++) {
+			PhysicsDirectSpaceState3D::RayResult expected;
+			const bool expected_collided = space_state->intersect_ray(parameters[i], expected);
+			CHECK_MESSAGE(result->is_colliding(i) == expected_collided, vformat("Ray %d collided differently when batched from scripts.", i));
+			if (expected_collided) {
+				expected_hits++;
+				CHECK(result->get_position(i).is_equal_approx(expected.position));
+				CHECK_EQ(result->get_collider_rid(i), expected.rid);
+			} else {
+				CHECK_EQ(result->get_collider_rid(i), RID());
+			}
+		}
+		CHECK_EQ(hits, expected_hits);
+	}
+
+	SUBCASE("Batched shape queries should match single shape queries") {
+		RID sphere_shape = p_server->sphere_shape_create();
+		p_server->shape_set_data(sphere_shape, 0.4);
+		rids.push_back(sphere_shape);
+
+		LocalVector<PhysicsDirectSpaceState3D::ShapeParameters> shape_parameters;
+		shape_parameters.resize(ray_count);
+		for (int i = 0; i < ray_count; i++) {
+			shape_parameters[i].shape_rid = sphere_shape;
+			shape_parameters[i].transform.origin = Vector3(i * 0.5 - 30.0, 0.5, 0.25);
+		}
+
+		const int result_max = 4;
+		LocalVector<PhysicsDirectSpaceState3D::ShapeResult> results;
+		results.resize(ray_count * result_max);
+		LocalVector<int> result_counts;
+		result_counts.resize(ray_count);
+		const int total = space_state->intersect_shapes(shape_parameters.ptr(), ray_count, results.ptr(), result_max, result_counts.ptr());
+
+		int expected_total = 0;
+		for (int i = 0; i < ray_count; i++) {
+			PhysicsDirectSpaceState3D::ShapeResult expected[result_max];
+			const int expected_count = space_state->intersect_shape(shape_parameters[i], expected, result_max);
+			expected_total += expected_count;
+			REQUIRE_MESSAGE(result_counts[i] == expected_count, vformat("Shape query %d found a different number of results when batched.", i));
+			for (int j = 0; j < expected_count; j++) {
+				CHECK_MESSAGE(results[i * result_max + j].rid == expected[j].rid, vformat("Shape query %d found a different body when batched.", i));
+			}
+		}
+		CHECK_EQ(total, expected_total);
+		CHECK(total > 0);
+		CHECK(total < ray_count);
+	}
+
+	SUBCASE("Batched motion casts should match single motion casts") {
+		RID sphere_shape = p_server->sphere_shape_create();
+		p_server->shape_set_data(sphere_shape, 0.4);
+		rids.push_back(sphere_shape);
+
+		LocalVector<PhysicsDirectSpaceState3D::ShapeParameters> shape_parameters;
+		shape_parameters.resize(ray_count);
+		for (int i = 0; i < ray_count; i++) {
+			shape_parameters[i].shape_rid = sphere_shape;
+			shape_parameters[i].transform.origin = Vector3(i * 0.5 - 30.0, 3, 0.25);
+			shape_parameters[i].motion = Vector3(0, -5, 0);
+		}
+
+		LocalVector<real_t> closest_safe;
+		closest_safe.resize(ray_count);
+		LocalVector<real_t> closest_unsafe;
+		closest_unsafe.resize(ray_count);
+		const int hits = space_state->cast_motions(shape_parameters.ptr(), ray_count, closest_safe.ptr(), closest_unsafe.ptr());
+
+		int expected_hits = 0;
+		for (int i = 0; i < ray_count; i++) {
+			real_t expected_safe = 1.0;
+			real_t expected_unsafe = 1.0;
+			space_state->cast_motion(shape_parameters[i], expected_safe, expected_unsafe);
+			if (expected_unsafe < 1.0) {
+				expected_hits++;
+			}
+			CHECK_MESSAGE(Math::is_equal_approx(closest_safe[i], expected_safe), vformat("Motion cast %d stopped at a different fraction when batched.", i));
+			CHECK_MESSAGE(Math::is_equal_approx(closest_unsafe[i], expected_unsafe), vformat("Motion cast %d stopped at a different fraction when batched.", i));
+		}
+		CHECK_EQ(hits, expected_hits);
+		CHECK(hits > 0);
+	}
+
+	for (int i = (int)rids.size() - 1; i >= 0; i--) {
+		p_server->free_rid(rids[i]);
+	}
+}
+
+TEST_CASE("[Physics][GodotPhysicsServer3D] Batched motion tests") {
+	TestUtils::ScopedServer<GodotPhysicsServer3D> server;
+
+	check_motion_batch(server.get());
+}
+
+TEST_CASE("[Physics][GodotPhysicsServer3D] Batched space queries") {
+	TestUtils::ScopedServer<GodotPhysicsServer3D> server;
+
+	check_query_batch(server.get());
+}
+
+} // namespace TestGodotPhysicsServer3D
@@ -0,0 +1,298 @@
+/**************************************************************************/
+/*  test_godot_shape_3d.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_shape_3d.h"
+
+#include "core/math/random_pcg.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotShape3D {
+
+static Transform3D random_transform(RandomPCG &p_rng) {
+	Basis basis = Basis::from_euler(Vector3(p_rng.random(-Math::PI, Math::PI), p_rng.random(-Math::PI, Math::PI), p_rng.random(-Math::PI, Math::PI)));
+	basis.scale(Vector3(p_rng.random(0.25f, 4.0f), p_rng.random(0.25f, 4.0f), p_rng.random(0.25f, 4.0f)));
+	return Transform3D(basis, Vector3(p_rng.random(-100.0f, 100.0f), p_rng.random(-100.0f, 100.0f), p_rng.random(-100.0f, 100.0f)));
+}
+
+static Vector3 random_direction(RandomPCG &p_rng) {
+	return Vector3(p_rng.random(-1.0f, 1.0f), p_rng.random(-1.0f, 1.0f), p_rng.random(-1.0f, 1.0f)).normalized();
+}
+
+// Reference projection which transforms every vertex into world space.
+static void reference_project_range(const Vector3 *p_vertices, int p_count, const Vector3 &p_normal, const Transform3D &p_transform, real_t &r_min, real_t &r_max) {
+	for (int i = 0; i < p_count; i++) {
+		real_t d = p_normal.dot(p_transform.xform(p_vertices[i]));
+		if (i == 0 || d < r_min) {
+			r_min = d;
+		}
+		if (i == 0 || d > r_max) {
+			r_max = d;
+		}
+	}
+}
+
+// Checks project_range() and get_support() of a convex polygon against the projection of every vertex.
+static void check_convex_polygon_projection(const GodotConvexPolygonShape3D &p_shape, RandomPCG &p_rng) {
+	const Geometry3D::MeshData &mesh = p_shape.get_mesh();
+
+	for (int i = 0; i < 256; i++) {
+		Transform3D xform = random_transform(p_rng);
+		Vector3 normal = random_direction(p_rng);
+
+		real_t min = 0.0, max = 0.0;
+		p_shape.project_range(normal, xform, min, max);
+
+		real_t expected_min = 0.0, expected_max = 0.0;
+		reference_project_range(mesh.vertices.ptr(), mesh.vertices.size(), normal, xform, expected_min, expected_max);
+
+		CHECK(min == doctest::Approx(expected_min).epsilon(1e-4));
+		CHECK(max == doctest::Approx(expected_max).epsilon(1e-4));
+
+		// Ties may pick different vertices, so only the support distance is compared.
+		real_t support = normal.dot(p_shape.get_support(normal));
+		real_t expected_support = 0.0, unused = 0.0;
+		reference_project_range(mesh.vertices.ptr(), mesh.vertices.size(), normal, Transform3D(), unused, expected_support);
+
+		CHECK(support == doctest::Approx(expected_support).epsilon(1e-4));
+	}
+}
+
+TEST_CASE("[Physics][GodotShape3D] Convex polygon with few vertices matches per-vertex projection") {
+	RandomPCG rng(1234);
+
+	// Every vertex of a box is one of its extreme vertices, so project_range() scans all of them
+	// and get_support() does too, without walking the hull.
+	Vector<Vector3> points;
+	for (int i = 0; i < 8; i++) {
+		points.push_back(Vector3((i & 1) ? 1.0 : -1.0, (i & 2) ? 2.0 : -2.0, (i & 4) ? 0.5 : -0.5));
+	}
+
+	GodotConvexPolygonShape3D shape;
+	shape.set_data(points);
+	REQUIRE(shape.get_mesh().vertices.size() == 8);
+
+	check_convex_polygon_projection(shape, rng);
+}
+
+TEST_CASE("[Physics][GodotShape3D] Convex polygon with many vertices matches per-vertex projection") {
+	RandomPCG rng(5678);
+
+	// More vertices than three times the 26 possible extreme vertices, so project_range() uses
+	// get_support(), which walks the hull from the closest extreme vertex.
+	Vector<Vector3> points;
+	const int point_count = 200;
+	for (int i = 0; i < point_count; i++) {
+		real_t y = 1.0 - 2.0 * (i + 0.5) / point_count;
+		real_t radius = Math::sqrt(1.0 - y * y);
+		real_t angle = i * Math::PI * (3.0 - Math::sqrt(5.0));
+		points.push_back(Vector3(Math::cos(angle) * radius, y, Math::sin(angle) * radius) * 2.0);
+	}
+
+	GodotConvexPolygonShape3D shape;
+	shape.set_data(points);
+	REQUIRE(shape.get_mesh().vertices.size() > 3 * 26);
+
+	check_convex_polygon_projection(shape, rng);
+}
+
+TEST_CASE("[Physics][GodotShape3D] Face project_range matches per-vertex projection") {
+	RandomPCG rng(4321);
+
+	GodotFaceShape3D face;
+	for (int i = 0; i < 256; i++) {
+		for (int j = 0; j < 3; j++) {
+			face.vertex[j] = Vector3(rng.random(-10.0f, 10.0f), rng.random(-10.0f, 10.0f), rng.random(-10.0f, 10.0f));
+		}
+		Transform3D xform = random_transform(rng);
+		Vector3 normal = random_direction(rng);
+
+		real_t min = 0.0, max = 0.0;
+		face.project_range(normal, xform, min, max);
+
+		real_t expected_min = 0.0, expected_max = 0.0;
+		reference_project_range(face.vertex, 3, normal, xform, expected_min, expected_max);
+
+		CHECK(min == doctest::Approx(expected_min).epsilon(1e-4));
+		CHECK(max == doctest::Approx(expected_max).epsilon(1e-4));
+	}
+}
+
+static bool collect_face(void *p_userdata, GodotShape3D *p_convex) {
+	LocalVector<Face3> *faces = static_cast<LocalVector<Face3> *>(p_userdata);
+	const GodotFaceShape3D *face = static_cast<const GodotFaceShape3D *>(p_convex);
+	faces->push_back(Face3(face->vertex[0], face->vertex[1], face->vertex[2]));
+	return false;
+}
+
+static bool has_face(const LocalVector<Face3> &p_faces, const Face3 &p_face) {
+	for (const Face3 &face : p_faces) {
+		if (face.vertex[0] == p_face.vertex[0] && face.vertex[1] == p_face.vertex[1] && face.vertex[2] == p_face.vertex[2]) {
+			return true;
+		}
+	}
+	return false;
+}
+
+TEST_CASE("[Physics][GodotShape3D] Concave polygon cull and intersect_segment match brute force") {
+	RandomPCG rng(5678);
+
+	PackedVector3Array points;
+	LocalVector<Face3> faces;
+	for (int i = 0; i < 1024; i++) {
+		Vector3 center(rng.random(-50.0f, 50.0f), rng.random(-5.0f, 5.0f), rng.random(-50.0f, 50.0f));
+		Face3 face;
+		for (int j = 0; j < 3; j++) {
+			face.vertex[j] = center + Vector3(rng.random(-3.0f, 3.0f), rng.random(-3.0f, 3.0f), rng.random(-3.0f, 3.0f));
+			points.push_back(face.vertex[j]);
+		}
+		faces.push_back(face);
+	}
+
+	Dictionary data;
+	data["faces"] = points;
+	data["backface_collision"] = false;
+
+	GodotConcavePolygonShape3D shape;
+	shape.set_data(data);
+
+	for (int i = 0; i < 128; i++) {
+		AABB query(Vector3(rng.random(-60.0f, 60.0f), rng.random(-10.0f, 10.0f), rng.random(-60.0f, 60.0f)), Vector3(rng.random(0.1f, 8.0f), rng.random(0.1f, 8.0f), rng.random(0.1f, 8.0f)));
+
+		LocalVector<Face3> culled;
+		shape.cull(query, collect_face, &culled, false);
+
+		for (const Face3 &face : faces) {
+			if (face.get_aabb().intersects(query)) {
+				CHECK_MESSAGE(has_face(culled, face), "Cull missed a face overlapping the query.");
+			}
+		}
+	}
+
+	GodotFaceShape3D face_shape;
+	face_shape.backface_collision = true;
+	for (int i = 0; i < 128; i++) {
+		Vector3 from(rng.random(-60.0f, 60.0f), 20.0, rng.random(-60.0f, 60.0f));
+		Vector3 to(rng.random(-60.0f, 60.0f), -20.0, rng.random(-60.0f, 60.0f));
+		Vector3 dir = (to - from).normalized();
+
+		bool expected_hit = false;
+		real_t expected_d = 1e20;
+		Vector3 expected_point;
+		for (const Face3 &face : faces) {
+			face_shape.vertex[0] = face.vertex[0];
+			face_shape.vertex[1] = face.vertex[1];
+			face_shape.vertex[2] = face.vertex[2];
+			face_shape.normal = face.get_plane().normal;
+
+			Vector3 point, normal;
+			int face_index = 0;
+			if (face_shape.intersect_segment(from, to, point, normal, face_index, true)) {
+				real_t d = dir.dot(point - from);
+				if (d > 0 && d < expected_d) {
+					expected_hit = true;
+					expected_d = d;
+					expected_point = point;
+				}
+			}
+		}
+
+		Vector3 point, normal;
+		int face_index = 0;
+		bool hit = shape.intersect_segment(from, to, point, normal, face_index, true);
+		CHECK(hit == expected_hit);
+		if (hit && expected_hit) {
+			CHECK(point.is_equal_approx(expected_point));
+		}
+	}
+}
+
+TEST_CASE("[Physics][GodotShape3D] Height map cull reports every overlapping triangle") {
+	RandomPCG rng(8765);
+
+	// Larger than a bounds chunk, so the chunk rejection is exercised.
+	const int width = 40;
+	const int depth = 36;
+	Vector<real_t> heights;
+	real_t min_height = 0.0;
+	real_t max_height = 0.0;
+	for (int z = 0; z < depth; z++) {
+		for (int x = 0; x < width; x++) {
+			real_t h = Math::sin(x * 0.3) * 4.0 + Math::cos(z * 0.2) * 3.0 + rng.random(-0.5f, 0.5f);
+			heights.push_back(h);
+			min_height = MIN(min_height, h);
+			max_height = MAX(max_height, h);
+		}
+	}
+
+	Dictionary data;
+	data["width"] = width;
+	data["depth"] = depth;
+	data["heights"] = heights;
+	data["min_height"] = min_height;
+	data["max_height"] = max_height;
+
+	GodotHeightMapShape3D shape;
+	shape.set_data(data);
+
+	// Triangles in the shape's local space, centered on the origin.
+	auto get_point = [&](int p_x, int p_z) {
+		return Vector3(p_x - 0.5 * (width - 1), heights[p_z * width + p_x], p_z - 0.5 * (depth - 1));
+	};
+	LocalVector<Face3> faces;
+	for (int z = 0; z < depth - 1; z++) {
+		for (int x = 0; x < width - 1; x++) {
+			faces.push_back(Face3(get_point(x, z), get_point(x + 1, z), get_point(x, z + 1)));
+			faces.push_back(Face3(get_point(x + 1, z), get_point(x + 1, z + 1), get_point(x, z + 1)));
+		}
+	}
+
+	for (int i = 0; i < 128; i++) {
+		AABB query(Vector3(rng.random(-25.0f, 25.0f), rng.random(-10.0f, 10.0f), rng.random(-25.0f, 25.0f)), Vector3(rng.random(0.1f, 20.0f), rng.random(0.1f, 4.0f), rng.random(0.1f, 20.0f)));
+
+		LocalVector<Face3> culled;
+		shape.cull(query, collect_face, &culled, false);
+
+		for (const Face3 &face : faces) {
+			if (face.get_aabb().intersects(query)) {
+				CHECK_MESSAGE(has_face(culled, face), "Cull missed a triangle overlapping the query.");
+			}
+		}
+	}
+
+	// Nothing to report above the terrain.
+	LocalVector<Face3> culled;
+	shape.cull(AABB(Vector3(-10, max_height + 1.0, -10), Vector3(20, 2, 20)), collect_face, &culled, false);
+	CHECK(culled.is_empty());
+}
+
+} // namespace TestGodotShape3D
@@ -0,0 +1,400 @@
+/**************************************************************************/
+/*  test_godot_step_3d.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../godot_physics_server_3d.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestGodotStep3D {
+
+// Creates a space with a pile of boxes on the floor.
+static RID create_box_pile(GodotPhysicsServer3D *p_server, RID p_floor_shape, RID p_box_shape, LocalVector<RID> &r_bodies, int p_box_count = 27) {
+	RID space = p_server->space_create();
+	p_server->space_set_active(space, true);
+
+	RID floor = p_server->body_create();
+	p_server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	p_server->body_add_shape(floor, p_floor_shape);
+	p_server->body_set_space(floor, space);
+	r_bodies.push_back(floor);
+
+	for (int i = 0; i < p_box_count; i++) {
+		RID box = p_server->body_create();
+		p_server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+		p_server->body_add_shape(box, p_box_shape);
+		p_server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis::from_euler(Vector3(0.1 * i, 0.2 * i, 0.0)), Vector3((i % 3) * 1.1, 1.0 + (i / 9) * 1.1, ((i / 3) % 3) * 1.1)));
+		p_server->body_set_space(box, space);
+		r_bodies.push_back(box);
+	}
+
+	return space;
+}
+
+TEST_CASE("[Physics][GodotStep3D] Stepping spaces in parallel matches stepping them alone") {
+	TestUtils::ScopedServer<GodotPhysicsServer3D> server;
+
+	RID floor_shape = server->world_boundary_shape_create();
+	server->shape_set_data(floor_shape, Plane(Vector3(0, 1, 0), 0));
+	RID box_shape = server->box_shape_create();
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	const int step_count = 60;
+
+	// A lone space is stepped by the regular stepper.
+	LocalVector<RID> reference_bodies;
+	RID reference_space = create_box_pile(server.get(), floor_shape, box_shape, reference_bodies);
+	for (int i = 0; i < step_count; i++) {
+		server->step(1.0 / 60.0);
+	}
+	server->space_set_active(reference_space, false);
+
+	// Several identical spaces are stepped in parallel.
+	const int space_count = 4;
+	LocalVector<RID> spaces;
+	LocalVector<LocalVector<RID>> bodies;
+	bodies.resize(space_count);
+	for (int i = 0; i < space_count; i++) {
+		spaces.push_back(create_box_pile(server.get(), floor_shape, box_shape, bodies[i]));
+	}
+	for (int i = 0; i < step_count; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	for (int i = 0; i < space_count; i++) {
+		for (uint32_t j = 0; j < reference_bodies.size(); j++) {
+			Transform3D expected = server->body_get_state(reference_bodies[j], PhysicsServer3D::BODY_STATE_TRANSFORM);
+			Transform3D transform = server->body_get_state(bodies[i][j], PhysicsServer3D::BODY_STATE_TRANSFORM);
+			CHECK_MESSAGE(transform == expected, vformat("Body %d in space %d diverged from the lone space.", j, i));
+		}
+	}
+
+	for (int i = 0; i < space_count; i++) {
+		for (const RID &body : bodies[i]) {
+			server->free_rid(body);
+		}
+		server->free_rid(spaces[i]);
+	}
+	for (const RID &body : reference_bodies) {
+		server->free_rid(body);
+	}
+	server->free_rid(reference_space);
+	server->free_rid(box_shape);
+	server->free_rid(floor_shape);
+}
+
+TEST_CASE("[Physics][GodotStep3D] Parallel force integration matches stepping on a single thread") {
+	TestUtils::ScopedServer<GodotPhysicsServer3D> server;
+
+	RID floor_shape = server->world_boundary_shape_create();
+	server->shape_set_data(floor_shape, Plane(Vector3(0, 1, 0), 0));
+	RID box_shape = server->box_shape_create();
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	// Both spaces have enough bodies for the forces to be integrated in parallel by the multithreaded stepper,
+	// which only steps one of them, while the other one is stepped on a single thread.
+	LocalVector<RID> bodies[2];
+	RID spaces[2];
+	for (int i = 0; i < 2; i++) {
+		spaces[i] = create_box_pile(server.get(), floor_shape, box_shape, bodies[i], 135);
+	}
+	for (int i = 0; i < 60; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	for (uint32_t i = 0; i < bodies[0].size(); i++) {
+		Transform3D expected = server->body_get_state(bodies[0][i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		Transform3D transform = server->body_get_state(bodies[1][i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK_MESSAGE(transform == expected, vformat("Body %d diverged between the parallel and the single-threaded step.", i));
+	}
+
+	for (int i = 0; i < 2; i++) {
+		for (const RID &body : bodies[i]) {
+			server->free_rid(body);
+		}
+		server->free_rid(spaces[i]);
+	}
+	server->free_rid(box_shape);
+	server->free_rid(floor_shape);
+}
+
+TEST_CASE("[Physics][GodotStep3D] Restoring a saved state rolls back the simulation") {
+	TestUtils::ScopedServer<GodotPhysicsServer3D> server;
+
+	RID floor_shape = server->world_boundary_shape_create();
+	server->shape_set_data(floor_shape, Plane(Vector3(0, 1, 0), 0));
+	RID box_shape = server->box_shape_create();
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	LocalVector<RID> bodies;
+	RID space = create_box_pile(server.get(), floor_shape, box_shape, bodies);
+
+	for (int i = 0; i < 30; i++) {
+		server->step(1.0 / 60.0);
+	}
+	LocalVector<Transform3D> saved_transforms;
+	for (const RID &body : bodies) {
+		saved_transforms.push_back(server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM));
+	}
+	const Vector<uint8_t> state = server->space_save_state(space);
+	REQUIRE_FALSE(state.is_empty());
+
+	// Saving the same state twice must give the same bytes.
+	CHECK(server->space_save_state(space) == state);
+
+	for (int i = 0; i < 30; i++) {
+		server->step(1.0 / 60.0);
+	}
+	LocalVector<Transform3D> first_transforms;
+	for (const RID &body : bodies) {
+		first_transforms.push_back(server->body_get_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM));
+	}
+
+	server->space_restore_state(space, state);
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		Transform3D transform = server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		CHECK_MESSAGE(transform.is_equal_approx(saved_transforms[i]), vformat("Body %d wasn't moved back to its saved transform.", i));
+	}
+
+	// As in 2D, pairs recreated by the broadphase may be solved in a different order, so resimulating
+	// is only expected to follow the original run closely.
+	for (int i = 0; i < 30; i++) {
+		server->step(1.0 / 60.0);
+	}
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		Vector3 origin = Transform3D(server->body_get_state(bodies[i], PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+		CHECK_MESSAGE(origin.distance_to(first_transforms[i].origin) < 0.5, vformat("Body %d ended up at %s instead of %s after restoring.", i, origin, first_transforms[i].origin));
+	}
+
+	const Vector<uint8_t> current_state = server->space_save_state(space);
+
+	ERR_PRINT_OFF;
+	Vector<uint8_t> invalid_state = state;
+	invalid_state.resize(invalid_state.size() - 1);
+	server->space_restore_state(space, invalid_state);
+	ERR_PRINT_ON;
+
+	// An invalid state must leave the space untouched.
+	CHECK(server->space_save_state(space) == current_state);
+
+	for (const RID &body : bodies) {
+		server->free_rid(body);
+	}
+	server->free_rid(space);
+	server->free_rid(box_shape);
+	server->free_rid(floor_shape);
+}
+
+TEST_CASE("[Physics][GodotStep3D] Continuous collision detection stops fast bodies at thin walls") {
+	TestUtils::ScopedServer<GodotPhysicsServer3D> server;
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	// A thin box wall and a trimesh wall, both at x = 5.
+	RID box_wall_shape = server->box_shape_create();
+	server->shape_set_data(box_wall_shape, Vector3(0.01, 10.0, 5.0));
+	RID box_wall = server->body_create();
+	server->body_set_mode(box_wall, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(box_wall, box_wall_shape);
+	server->body_set_state(box_wall, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(5.01, 0.0, -5.0)));
+	server->body_set_space(box_wall, space);
+
+	RID mesh_wall_shape = server->concave_polygon_shape_create();
+	PackedVector3Array faces = {
+		Vector3(5, -10, 0), Vector3(5, 10, 0), Vector3(5, 10, 10),
+		Vector3(5, -10, 0), Vector3(5, 10, 10), Vector3(5, -10, 10)
+	};
+	Dictionary mesh_data;
+	mesh_data["faces"] = faces;
+	mesh_data["backface_collision"] = true;
+	server->shape_set_data(mesh_wall_shape, mesh_data);
+	RID mesh_wall = server->body_create();
+	server->body_set_mode(mesh_wall, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(mesh_wall, mesh_wall_shape);
+	server->body_set_space(mesh_wall, space);
+
+	// Fast spinning rods cover many times their own length in a single step.
+	RID bullet_shape = server->box_shape_create();
+	server->shape_set_data(bullet_shape, Vector3(0.02, 0.02, 0.2));
+	LocalVector<RID> bullets;
+	for (int i = 0; i < 64; i++) {
+		RID bullet = server->body_create();
+		server->body_set_mode(bullet, PhysicsServer3D::BODY_MODE_RIGID);
+		server->body_add_shape(bullet, bullet_shape);
+		server->body_set_enable_continuous_collision_detection(bullet, true);
+		server->body_set_state(bullet, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0.0, (i / 8) - 4.0, ((i % 8) - 4.0) * 1.2 + 0.5)));
+		server->body_set_state(bullet, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(300.0 + i, 0.0, 0.0));
+		server->body_set_state(bullet, PhysicsServer3D::BODY_STATE_ANGULAR_VELOCITY, Vector3(0.0, 20.0, 0.0));
+		server->body_set_space(bullet, space);
+		bullets.push_back(bullet);
+	}
+
+	for (int i = 0; i < 30; i++) {
+		server->step(1.0 / 60.0);
+	}
+
+	for (uint32_t i = 0; i < bullets.size(); i++) {
+		const Vector3 origin = Transform3D(server->body_get_state(bullets[i], PhysicsServer3D::BODY_STATE_TRANSFORM)).origin;
+		CHECK_MESSAGE(origin.x < 5.0, vformat("Bullet %d tunneled through the wall and ended up at %s.", i, origin));
+	}
+
+	for (const RID &bullet : bullets) {
+		server->free_rid(bullet);
+	}
+	server->free_rid(bullet_shape);
+	server->free_rid(mesh_wall);
+	server->free_rid(mesh_wall_shape);
+	server->free_rid(box_wall);
+	server->free_rid(box_wall_shape);
+	server->free_rid(space);
+}
+
+TEST_CASE("[Physics][GodotStep3D] Continuous collision detection keeps the bounce of fast bodies") {
+	TestUtils::ScopedServer<GodotPhysicsServer3D> server;
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+	server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 10.0);
+	server->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY_VECTOR, Vector3(0.0, -1.0, 0.0));
+	server->area_set_param(space, PhysicsServer3D::AREA_PARAM_LINEAR_DAMP, 0.0);
+
+	RID floor_shape = server->box_shape_create();
+	server->shape_set_data(floor_shape, Vector3(10.0, 0.01, 10.0));
+	RID floor = server->body_create();
+	server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(floor, floor_shape);
+	server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0.0, -0.01, 0.0)));
+	server->body_set_space(floor, space);
+
+	// The sphere covers more than its own diameter per step, so only the speculative contact ever catches it.
+	const real_t bounce = 0.8;
+	const real_t speed = 40.0;
+	RID sphere_shape = server->sphere_shape_create();
+	server->shape_set_data(sphere_shape, 0.25);
+	RID sphere = server->body_create();
+	server->body_set_mode(sphere, PhysicsServer3D::BODY_MODE_RIGID);
+	server->body_add_shape(sphere, sphere_shape);
+	server->body_set_param(sphere, PhysicsServer3D::BODY_PARAM_BOUNCE, bounce);
+	server->body_set_enable_continuous_collision_detection(sphere, true);
+	server->body_set_max_contacts_reported(sphere, 4);
+	server->body_set_state(sphere, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0.0, 2.0, 0.0)));
+	server->body_set_state(sphere, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY, Vector3(0.0, -speed, 0.0));
+	server->body_set_space(sphere, space);
+
+	real_t peak = 0.0;
+	bool bounced = false;
+	bool reported = false;
+	for (int i = 0; i < 300; i++) {
+		server->step(1.0 / 60.0);
+		const real_t height = Transform3D(server->body_get_state(sphere, PhysicsServer3D::BODY_STATE_TRANSFORM)).origin.y;
+		const real_t velocity = Vector3(server->body_get_state(sphere, PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY)).y;
+		CHECK_MESSAGE(height > 0.0, vformat("The sphere tunneled through the floor and ended up at height %f.", height));
+		// Speculative contacts stop the sphere right at the surface, so they have to be reported too.
+		reported = reported || server->body_get_direct_state(sphere)->get_contact_count() > 0;
+		bounced = bounced || velocity > 0.0;
+		if (bounced) {
+			peak = MAX(peak, height);
+		}
+	}
+
+	// Without losses the sphere would rise to (bounce * speed)^2 / (2 * gravity) = 51.2 units.
+	const real_t expected_peak = Math::pow(bounce * speed, (real_t)2.0) / 20.0;
+	CHECK_MESSAGE(peak > expected_peak * 0.5, vformat("The sphere only bounced up to %f, expected close to %f.", peak, expected_peak));
+	CHECK_MESSAGE(reported, "The contacts with the floor should be reported.");
+
+	server->free_rid(sphere);
+	server->free_rid(sphere_shape);
+	server->free_rid(floor);
+	server->free_rid(floor_shape);
+	server->free_rid(space);
+}
+
+TEST_CASE("[Physics][GodotStep3D] Sleeping bodies stop pairing with each other") {
+	TestUtils::ScopedServer<GodotPhysicsServer3D> server;
+
+	// A small floor, since a world boundary would pair with every box in the column.
+	RID floor_shape = server->box_shape_create();
+	server->shape_set_data(floor_shape, Vector3(2.0, 0.1, 2.0));
+	RID box_shape = server->box_shape_create();
+	server->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+	RID space = server->space_create();
+	server->space_set_active(space, true);
+
+	RID floor = server->body_create();
+	server->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+	server->body_add_shape(floor, floor_shape);
+	server->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0.0, -0.1, 0.0)));
+	server->body_set_space(floor, space);
+
+	// A single column, so all the boxes end up in the same island.
+	LocalVector<RID> boxes;
+	for (int i = 0; i < 6; i++) {
+		RID box = server->body_create();
+		server->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+		server->body_add_shape(box, box_shape);
+		server->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0.0, 0.5 + i, 0.0)));
+		server->body_set_space(box, space);
+		boxes.push_back(box);
+	}
+
+	for (int i = 0; i < 1800; i++) {
+		server->step(1.0 / 60.0);
+		if (server->get_process_info(PhysicsServer3D::INFO_ACTIVE_OBJECTS) == 0) {
+			break;
+		}
+	}
+	REQUIRE(server->get_process_info(PhysicsServer3D::INFO_ACTIVE_OBJECTS) == 0);
+	CHECK(server->get_process_info(PhysicsServer3D::INFO_SLEEPING_OBJECTS) == (int)boxes.size());
+
+	// Only the pair between the bottom box and the floor is left, and it isn't processed.
+	CHECK(server->get_process_info(PhysicsServer3D::INFO_COLLISION_PAIRS) == 1);
+	CHECK(server->get_process_info(PhysicsServer3D::INFO_SLEEPING_COLLISION_PAIRS) == 1);
+
+	// Waking up the top box wakes up the whole column right away, not one box per step.
+	server->body_apply_central_impulse(boxes[boxes.size() - 1], Vector3(1, 0, 0));
+	server->step(1.0 / 60.0);
+	CHECK(server->get_process_info(PhysicsServer3D::INFO_SLEEPING_OBJECTS) == 0);
+	CHECK(server->get_process_info(PhysicsServer3D::INFO_ACTIVE_OBJECTS) == (int)boxes.size());
+	CHECK(server->get_process_info(PhysicsServer3D::INFO_COLLISION_PAIRS) == (int)boxes.size());
+
+	for (const RID &box : boxes) {
+		server->free_rid(box);
+	}
+	server->free_rid(floor);
+	server->free_rid(space);
+	server->free_rid(box_shape);
+	server->free_rid(floor_shape);
+}
+
+} // namespace TestGodotStep3D
@@ -53,6 +53,10 @@
 #include "spaces/jolt_physics_direct_space_state_3d.h"
 #include "spaces/jolt_space_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+
+#include "Jolt/Physics/PhysicsSettings.h"
+
 JoltPhysicsServer3D::JoltPhysicsServer3D(bool p_on_separate_thread) :
 		on_separate_thread(p_on_separate_thread) {
 	singleton = this;
@@ -267,6 +271,22 @@ int JoltPhysicsServer3D::space_get_contact_count(RID p_space) const {
 #endif
 }
 
+Vector<uint8_t> JoltPhysicsServer3D::space_save_state(RID p_space) const {
+	JoltSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL_V(space, Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), Vector<uint8_t>(), "Space state is inaccessible while the space is being stepped.");
+
+	return space->save_state();
+}
+
+void JoltPhysicsServer3D::space_restore_state(RID p_space, const Vector<uint8_t> &p_state) {
+	JoltSpace3D *space = space_owner.get_or_null(p_space);
+	ERR_FAIL_NULL(space);
+	ERR_FAIL_COND_MSG(space->is_stepping(), "Space state is inaccessible while the space is being stepped.");
+
+	space->restore_state(p_state);
+}
+
 RID JoltPhysicsServer3D::area_create() {
 	JoltArea3D *area = memnew(JoltArea3D);
 	RID rid = area_owner.make_rid(area);
@@ -965,6 +985,50 @@ bool JoltPhysicsServer3D::body_test_motion(RID p_body, const MotionParameters &p
 	return space->get_direct_state()->body_test_motion(*body, p_parameters, r_result);
 }
 
+void JoltPhysicsServer3D::body_test_motion_batch(MotionQuery *r_queries, int p_count) {
+	ERR_FAIL_COND(p_count < 0);
+	if (p_count == 0) {
+		return;
+	}
+
+	// Anything that modifies the spaces happens here, so that the tests themselves only read from them.
+	testing_bodies.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		JoltBody3D *body = body_owner.get_or_null(r_queries[i].body);
+		JoltSpace3D *space = body != nullptr ? body->get_space() : nullptr;
+
+		if (body == nullptr) {
+			ERR_PRINT(vformat("Motion query %d refers to an invalid body.", i));
+		} else if (space == nullptr) {
+			ERR_PRINT(vformat("Motion query %d refers to a body that is not in a space.", i));
+			body = nullptr;
+		} else {
+			space->flush_pending_objects();
+			space->get_direct_state();
+		}
+
+		testing_bodies[i] = body;
+		r_queries[i].collided = false;
+	}
+
+	testing_queries = r_queries;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &JoltPhysicsServer3D::_test_body_motion, nullptr, p_count, -1, true, SNAME("JoltBodyTestMotionBatch"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	testing_queries = nullptr;
+}
+
+void JoltPhysicsServer3D::_test_body_motion(uint32_t p_index, void *p_userdata) {
+	JoltBody3D *body = testing_bodies[p_index];
+	if (body == nullptr) {
+		return;
+	}
+
+	MotionQuery &query = testing_queries[p_index];
+	query.collided = body->get_space()->get_direct_state()->body_test_motion(*body, query.parameters, &query.result);
+}
+
 PhysicsDirectBodyState3D *JoltPhysicsServer3D::body_get_direct_state(RID p_body) {
 	ERR_FAIL_COND_V_MSG((on_separate_thread && !doing_sync), nullptr, "Body state is inaccessible right now, wait for iteration or physics process notification.");
 
@@ -1619,6 +1683,25 @@ void JoltPhysicsServer3D::step(real_t p_step) {
 		return;
 	}
 
+	if (active_spaces.size() > 1) {
+		stepping_spaces.clear();
+		for (JoltSpace3D *active_space : active_spaces) {
+			stepping_spaces.push_back(active_space);
+		}
+
+		stepping_delta = (float)p_step;
+
+		job_system->pre_step();
+
+		// Every space in flight holds one of the job system's barriers until its update is done, so don't step more at once than there are barriers.
+		const int task_count = MIN((int)stepping_spaces.size(), JPH::cMaxPhysicsBarriers);
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &JoltPhysicsServer3D::_step_space, nullptr, stepping_spaces.size(), task_count, true, SNAME("JoltStepSpaces"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		job_system->post_step();
+		return;
+	}
+
 	for (JoltSpace3D *active_space : active_spaces) {
 		job_system->pre_step();
 
@@ -1628,6 +1711,10 @@ void JoltPhysicsServer3D::step(real_t p_step) {
 	}
 }
 
+void JoltPhysicsServer3D::_step_space(uint32_t p_index, void *p_userdata) {
+	stepping_spaces[p_index]->step(stepping_delta);
+}
+
 void JoltPhysicsServer3D::sync() {
 	doing_sync = true;
 }
@@ -55,6 +55,12 @@ class JoltPhysicsServer3D final : public PhysicsServer3D {
 
 	HashSet<JoltSpace3D *> active_spaces;
 
+	LocalVector<JoltSpace3D *> stepping_spaces;
+	float stepping_delta = 0.0f;
+
+	LocalVector<JoltBody3D *> testing_bodies;
+	MotionQuery *testing_queries = nullptr;
+
 	JoltJobSystem *job_system = nullptr;
 
 	bool on_separate_thread = false;
@@ -62,6 +68,9 @@ class JoltPhysicsServer3D final : public PhysicsServer3D {
 	bool flushing_queries = false;
 	bool doing_sync = false;
 
+	void _step_space(uint32_t p_index, void *p_userdata = nullptr);
+	void _test_body_motion(uint32_t p_index, void *p_userdata = nullptr);
+
 public:
 	enum HingeJointParamJolt {
 		HINGE_JOINT_LIMIT_SPRING_FREQUENCY = 100,
@@ -162,6 +171,9 @@ public:
 	virtual PackedVector3Array space_get_contacts(RID p_space) const override;
 	virtual int space_get_contact_count(RID p_space) const override;
 
+	virtual Vector<uint8_t> space_save_state(RID p_space) const override;
+	virtual void space_restore_state(RID p_space, const Vector<uint8_t> &p_state) override;
+
 	virtual RID area_create() override;
 
 	virtual void area_set_space(RID p_area, RID p_space) override;
@@ -295,6 +307,7 @@ public:
 	virtual void body_set_ray_pickable(RID p_body, bool p_enable) override;
 
 	virtual bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result) override;
+	virtual void body_test_motion_batch(MotionQuery *r_queries, int p_count) override;
 
 	virtual PhysicsDirectBodyState3D *body_get_direct_state(RID p_body) override;
 
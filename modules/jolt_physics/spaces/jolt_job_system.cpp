@@ -162,7 +162,9 @@ void JoltJobSystem::_reclaim_jobs() {
 JoltJobSystem::JoltJobSystem() :
 		JPH::JobSystemWithBarrier(JPH::cMaxPhysicsBarriers),
 		thread_count(MAX(1, WorkerThreadPool::get_singleton()->get_thread_count())) {
-	jobs.Init(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsJobs);
+	// When spaces are stepped in parallel, up to one update per barrier can be creating jobs at the
+	// same time, so the pool is sized for that many updates. Pages are only allocated once used.
+	jobs.Init(JPH::cMaxPhysicsJobs * JPH::cMaxPhysicsBarriers, JPH::cMaxPhysicsJobs);
 }
 
 void JoltJobSystem::pre_step() {
@@ -461,11 +461,7 @@ JoltPhysicsDirectSpaceState3D::JoltPhysicsDirectSpaceState3D(JoltSpace3D *p_spac
 		space(p_space) {
 }
 
-bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
-	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_ray must not be called while the physics space is being stepped.");
-
-	space->flush_pending_objects();
-
+bool JoltPhysicsDirectSpaceState3D::_intersect_ray_impl(const RayParameters &p_parameters, RayResult &r_result) {
 	const JoltQueryFilter3D query_filter(*this, p_parameters.collision_mask, p_parameters.collide_with_bodies, p_parameters.collide_with_areas, p_parameters.exclude, p_parameters.pick_ray);
 
 	const JPH::RVec3 from = to_jolt_r(p_parameters.from);
@@ -524,6 +520,41 @@ bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_paramet
 	return true;
 }
 
+bool JoltPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parameters, RayResult &r_result) {
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_ray must not be called while the physics space is being stepped.");
+
+	space->flush_pending_objects();
+
+	return _intersect_ray_impl(p_parameters, r_result);
+}
+
+bool JoltPhysicsDirectSpaceState3D::_begin_query_batch(const QueryBatch &p_batch) {
+	space->flush_pending_objects();
+
+	// Jolt's narrow-phase queries are safe to run concurrently once the pending objects are flushed.
+	return true;
+}
+
+void JoltPhysicsDirectSpaceState3D::_run_query_batch_chunk(const QueryBatch &p_batch, uint32_t p_from, uint32_t p_to) {
+	ERR_FAIL_COND_MSG(space->is_stepping(), "Batched queries must not be run while the physics space is being stepped.");
+
+	for (uint32_t i = p_from; i < p_to; i++) {
+		const uint32_t query = p_batch.order[i];
+
+		switch (p_batch.type) {
+			case QUERY_BATCH_RAYS: {
+				p_batch.ray_collided[query] = _intersect_ray_impl(p_batch.rays[query], p_batch.ray_results[query]);
+			} break;
+			case QUERY_BATCH_SHAPES: {
+				p_batch.shape_result_counts[query] = _intersect_shape_impl(p_batch.shapes[query], p_batch.shape_results + query * p_batch.shape_result_max, p_batch.shape_result_max);
+			} break;
+			case QUERY_BATCH_MOTIONS: {
+				_cast_motion_query_impl(p_batch.shapes[query], p_batch.closest_safe[query], p_batch.closest_unsafe[query]);
+			} break;
+		}
+	}
+}
+
 int JoltPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_point must not be called while the physics space is being stepped.");
 
@@ -562,15 +593,11 @@ int JoltPhysicsDirectSpaceState3D::intersect_point(const PointParameters &p_para
 	return hit_count;
 }
 
-int JoltPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
-	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_shape must not be called while the physics space is being stepped.");
-
+int JoltPhysicsDirectSpaceState3D::_intersect_shape_impl(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
 	if (p_result_max == 0) {
 		return 0;
 	}
 
-	space->flush_pending_objects();
-
 	JoltShape3D *shape = JoltPhysicsServer3D::get_singleton()->get_shape(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, 0);
 
@@ -619,12 +646,15 @@ int JoltPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_para
 	return hit_count;
 }
 
-bool JoltPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &r_closest_safe, real_t &r_closest_unsafe, ShapeRestInfo *r_info) {
-	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "cast_motion must not be called while the physics space is being stepped.");
-	ERR_FAIL_COND_V_MSG(r_info != nullptr, false, "Providing rest info as part of cast_motion is not supported when using Jolt Physics.");
+int JoltPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_parameters, ShapeResult *r_results, int p_result_max) {
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "intersect_shape must not be called while the physics space is being stepped.");
 
 	space->flush_pending_objects();
 
+	return _intersect_shape_impl(p_parameters, r_results, p_result_max);
+}
+
+bool JoltPhysicsDirectSpaceState3D::_cast_motion_query_impl(const ShapeParameters &p_parameters, real_t &r_closest_safe, real_t &r_closest_unsafe) {
 	JoltShape3D *shape = JoltPhysicsServer3D::get_singleton()->get_shape(p_parameters.shape_rid);
 	ERR_FAIL_NULL_V(shape, false);
 
@@ -650,6 +680,15 @@ bool JoltPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_paramet
 	return true;
 }
 
+bool JoltPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parameters, real_t &r_closest_safe, real_t &r_closest_unsafe, ShapeRestInfo *r_info) {
+	ERR_FAIL_COND_V_MSG(space->is_stepping(), false, "cast_motion must not be called while the physics space is being stepped.");
+	ERR_FAIL_COND_V_MSG(r_info != nullptr, false, "Providing rest info as part of cast_motion is not supported when using Jolt Physics.");
+
+	space->flush_pending_objects();
+
+	return _cast_motion_query_impl(p_parameters, r_closest_safe, r_closest_unsafe);
+}
+
 bool JoltPhysicsDirectSpaceState3D::collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) {
 	r_result_count = 0;
 
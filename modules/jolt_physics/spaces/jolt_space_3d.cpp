@@ -52,6 +52,7 @@
 #include "Jolt/Physics/Collision/CollideShapeVsShapePerLeaf.h"
 #include "Jolt/Physics/Collision/CollisionCollectorImpl.h"
 #include "Jolt/Physics/PhysicsScene.h"
+#include "Jolt/Physics/StateRecorderImpl.h"
 
 namespace {
 
@@ -475,6 +476,33 @@ void JoltSpace3D::flush_pending_objects() {
 	}
 }
 
+Vector<uint8_t> JoltSpace3D::save_state() {
+	flush_pending_objects();
+
+	JPH::StateRecorderImpl recorder;
+	physics_system->SaveState(recorder);
+
+	const std::string data = recorder.GetData();
+
+	Vector<uint8_t> state;
+	state.resize(data.size());
+	memcpy(state.ptrw(), data.data(), data.size());
+	return state;
+}
+
+void JoltSpace3D::restore_state(const Vector<uint8_t> &p_state) {
+	ERR_FAIL_COND_MSG(p_state.is_empty(), "Invalid physics space state.");
+
+	flush_pending_objects();
+
+	// Jolt restores bodies by their ID, so the state only applies to the same set of bodies that it was saved from.
+	JPH::StateRecorderImpl recorder;
+	recorder.WriteBytes(p_state.ptr(), p_state.size());
+	recorder.Rewind();
+
+	ERR_FAIL_COND_MSG(!physics_system->RestoreState(recorder), vformat("Failed to restore the state of physics space with RID '%d'. The bodies in the space must match the ones in the saved state.", rid.get_id()));
+}
+
 void JoltSpace3D::set_is_object_sleeping(const JPH::BodyID &p_jolt_id, bool p_enable) {
 	if (p_enable) {
 		if (pending_objects_awake.erase_unordered(p_jolt_id)) {
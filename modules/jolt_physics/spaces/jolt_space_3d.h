@@ -136,6 +136,9 @@ public:
 	void remove_object(const JPH::BodyID &p_jolt_id);
 	void flush_pending_objects();
 
+	Vector<uint8_t> save_state();
+	void restore_state(const Vector<uint8_t> &p_state);
+
 	void set_is_object_sleeping(const JPH::BodyID &p_jolt_id, bool p_enable);
 
 	void enqueue_call_queries(SelfList<JoltBody3D> *p_body);
@@ -448,6 +448,13 @@ RID GodotNavigationServer2D::map_get_closest_point_owner(RID p_map, const Vector
 	return map->get_closest_point_owner(p_point);
 }
 
+Vector2 GodotNavigationServer2D::map_get_flow_direction(RID p_map, const Vector2 &p_target_position, const Vector2 &p_position, uint32_t p_navigation_layers) const {
+	const NavMap2D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, Vector2());
+
+	return map->get_flow_direction(p_target_position, p_position, p_navigation_layers);
+}
+
 Vector2 GodotNavigationServer2D::map_get_random_point(RID p_map, uint32_t p_navigation_layers, bool p_uniformly) const {
 	const NavMap2D *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL_V(map, Vector2());
@@ -1374,6 +1381,28 @@ void GodotNavigationServer2D::query_path(const Ref<NavigationPathQueryParameters
 	NavMeshQueries2D::map_query_path(map, p_query_parameters, p_query_result, p_callback);
 }
 
+void GodotNavigationServer2D::query_path_batch(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results) {
+	ERR_FAIL_COND_MSG(p_query_parameters.size() != p_query_results.size(), "The number of query parameters and query results must match.");
+
+	// Group the queries per map, each map runs its queries in parallel.
+	HashMap<NavMap2D *, LocalVector<uint32_t>> map_query_indices;
+	for (int i = 0; i < p_query_parameters.size(); i++) {
+		const Ref<NavigationPathQueryParameters2D> query_parameters = p_query_parameters[i];
+		const Ref<NavigationPathQueryResult2D> query_result = p_query_results[i];
+		ERR_CONTINUE(query_parameters.is_null());
+		ERR_CONTINUE(query_result.is_null());
+
+		NavMap2D *map = map_owner.get_or_null(query_parameters->get_map());
+		ERR_CONTINUE(map == nullptr);
+
+		map_query_indices[map].push_back(i);
+	}
+
+	for (const KeyValue<NavMap2D *, LocalVector<uint32_t>> &E : map_query_indices) {
+		NavMeshQueries2D::map_query_path_batch(E.key, p_query_parameters, p_query_results, E.value);
+	}
+}
+
 RID GodotNavigationServer2D::source_geometry_parser_create() {
 	RWLockWrite write_lock(geometry_parser_rwlock);
 
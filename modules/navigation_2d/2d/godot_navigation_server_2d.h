@@ -132,6 +132,7 @@ public:
 	virtual Vector2 map_get_closest_point(RID p_map, const Vector2 &p_point) const override;
 
 	virtual RID map_get_closest_point_owner(RID p_map, const Vector2 &p_point) const override;
+	virtual Vector2 map_get_flow_direction(RID p_map, const Vector2 &p_target_position, const Vector2 &p_position, uint32_t p_navigation_layers = 1) const override;
 
 	virtual TypedArray<RID> map_get_links(RID p_map) const override;
 	virtual TypedArray<RID> map_get_regions(RID p_map) const override;
@@ -321,6 +322,7 @@ public:
 	virtual uint32_t obstacle_get_avoidance_layers(RID p_obstacle) const override;
 
 	virtual void query_path(const Ref<NavigationPathQueryParameters2D> &p_query_parameters, Ref<NavigationPathQueryResult2D> p_query_result, const Callable &p_callback = Callable()) override;
+	virtual void query_path_batch(const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results) override;
 
 	COMMAND_1(free_rid, RID, p_object);
 
@@ -87,6 +87,13 @@ struct NavMapIteration2D {
 
 	HashMap<NavRegion2D *, Ref<NavRegionIteration2D>> region_ptr_to_region_iteration;
 
+	// The flow fields of recently queried targets, built on demand and dropped with the iteration.
+	mutable Nav2D::FlowFieldGraph flow_field_graph;
+	mutable SafeFlag flow_field_graph_built;
+	mutable Mutex flow_field_graph_mutex;
+	mutable HashMap<Nav2D::FlowFieldKey, Ref<Nav2D::FlowField>, Nav2D::FlowFieldKey> flow_fields;
+	mutable Mutex flow_fields_mutex;
+
 	LocalVector<NavMeshQueries2D::PathQuerySlot> path_query_slots;
 	Mutex path_query_slots_mutex;
 	Semaphore path_query_slots_semaphore;
@@ -100,6 +107,9 @@ struct NavMapIteration2D {
 		navbases_polygons_external_connections.clear();
 		navlink_polygons.clear();
 		region_ptr_to_region_iteration.clear();
+		flow_field_graph.clear();
+		flow_field_graph_built.clear();
+		flow_fields.clear();
 	}
 };
 
@@ -41,6 +41,24 @@ using namespace Nav2D;
 
 #define THREE_POINTS_CROSS_PRODUCT(m_a, m_b, m_c) (-((m_c) - (m_a)).cross((m_b) - (m_a)))
 
+// Calls `p_visitor` with every internal and external connection that leaves the polygon.
+template <typename Visitor>
+static void _polygon_visit_connections(const NavMapIteration2D &p_map_iteration, const Polygon &p_polygon, Visitor p_visitor) {
+	const LocalVector<LocalVector<Connection>> &internal_connections = p_polygon.owner->get_internal_connections();
+	if (p_polygon.id < internal_connections.size()) {
+		for (const Connection &connection : internal_connections[p_polygon.id]) {
+			p_visitor(connection);
+		}
+	}
+
+	const LocalVector<LocalVector<Connection>> *external_connections = p_map_iteration.navbases_polygons_external_connections.getptr(p_polygon.owner);
+	if (external_connections && p_polygon.id < external_connections->size()) {
+		for (const Connection &connection : (*external_connections)[p_polygon.id]) {
+			p_visitor(connection);
+		}
+	}
+}
+
 bool NavMeshQueries2D::emit_callback(const Callable &p_callback) {
 	ERR_FAIL_COND_V(!p_callback.is_valid(), false);
 
@@ -150,93 +168,121 @@ void NavMeshQueries2D::map_query_path(NavMap2D *p_map, const Ref<NavigationPathQ
 	ERR_FAIL_COND(p_query_parameters.is_null());
 	ERR_FAIL_COND(p_query_result.is_null());
 
-	using namespace NavigationDefaults2D;
-
 	NavMeshQueries2D::NavMeshPathQueryTask2D query_task;
-	query_task.start_position = p_query_parameters->get_start_position();
-	query_task.target_position = p_query_parameters->get_target_position();
-	query_task.navigation_layers = p_query_parameters->get_navigation_layers();
+	query_task_set_parameters(query_task, p_query_parameters);
 	query_task.callback = p_callback;
 
+	p_map->query_path(query_task);
+
+	query_task_get_result(query_task, p_query_result);
+
+	if (query_task.callback.is_valid()) {
+		if (emit_callback(query_task.callback)) {
+			query_task.status = NavMeshPathQueryTask2D::TaskStatus::CALLBACK_DISPATCHED;
+		} else {
+			query_task.status = NavMeshPathQueryTask2D::TaskStatus::CALLBACK_FAILED;
+		}
+	}
+}
+
+void NavMeshQueries2D::map_query_path_batch(NavMap2D *p_map, const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results, const LocalVector<uint32_t> &p_query_indices) {
+	ERR_FAIL_NULL(p_map);
+
+	LocalVector<NavMeshPathQueryTask2D> query_tasks;
+	query_tasks.resize(p_query_indices.size());
+	for (uint32_t i = 0; i < p_query_indices.size(); i++) {
+		query_task_set_parameters(query_tasks[i], p_query_parameters[p_query_indices[i]]);
+	}
+
+	p_map->query_path_batch(query_tasks);
+
+	for (uint32_t i = 0; i < p_query_indices.size(); i++) {
+		query_task_get_result(query_tasks[i], p_query_results[p_query_indices[i]]);
+	}
+}
+
+void NavMeshQueries2D::query_task_set_parameters(NavMeshPathQueryTask2D &r_query_task, const Ref<NavigationPathQueryParameters2D> &p_query_parameters) {
+	using namespace NavigationDefaults2D;
+
+	r_query_task.start_position = p_query_parameters->get_start_position();
+	r_query_task.target_position = p_query_parameters->get_target_position();
+	r_query_task.navigation_layers = p_query_parameters->get_navigation_layers();
+
 	const TypedArray<RID> &_excluded_regions = p_query_parameters->get_excluded_regions();
 	const TypedArray<RID> &_included_regions = p_query_parameters->get_included_regions();
 
 	uint32_t _excluded_region_count = _excluded_regions.size();
 	uint32_t _included_region_count = _included_regions.size();
 
-	query_task.exclude_regions = _excluded_region_count > 0;
-	query_task.include_regions = _included_region_count > 0;
+	r_query_task.exclude_regions = _excluded_region_count > 0;
+	r_query_task.include_regions = _included_region_count > 0;
 
-	if (query_task.exclude_regions) {
-		query_task.excluded_regions.resize(_excluded_region_count);
+	if (r_query_task.exclude_regions) {
+		r_query_task.excluded_regions.resize(_excluded_region_count);
 		for (uint32_t i = 0; i < _excluded_region_count; i++) {
-			query_task.excluded_regions[i] = _excluded_regions[i];
+			r_query_task.excluded_regions[i] = _excluded_regions[i];
 		}
 	}
 
-	if (query_task.include_regions) {
-		query_task.included_regions.resize(_included_region_count);
+	if (r_query_task.include_regions) {
+		r_query_task.included_regions.resize(_included_region_count);
 		for (uint32_t i = 0; i < _included_region_count; i++) {
-			query_task.included_regions[i] = _included_regions[i];
+			r_query_task.included_regions[i] = _included_regions[i];
 		}
 	}
 
 	switch (p_query_parameters->get_pathfinding_algorithm()) {
 		case NavigationPathQueryParameters2D::PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR: {
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathfindingAlgorithm - fallback to default");
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 	}
 
 	switch (p_query_parameters->get_path_postprocessing()) {
 		case NavigationPathQueryParameters2D::PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 		case NavigationPathQueryParameters2D::PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
 		} break;
 		case NavigationPathQueryParameters2D::PathPostProcessing::PATH_POSTPROCESSING_NONE: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathPostProcessing - fallback to default");
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 	}
 
-	query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
-	query_task.simplify_path = p_query_parameters->get_simplify_path();
-	query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
-	query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
-	query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
-	query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
-	query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
-	query_task.status = NavMeshPathQueryTask2D::TaskStatus::QUERY_STARTED;
-
-	p_map->query_path(query_task);
+	r_query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
+	r_query_task.simplify_path = p_query_parameters->get_simplify_path();
+	r_query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
+	r_query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
+	r_query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
+	r_query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
+	r_query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
+	r_query_task.status = NavMeshPathQueryTask2D::TaskStatus::QUERY_STARTED;
+}
 
+void NavMeshQueries2D::query_task_get_result(const NavMeshPathQueryTask2D &p_query_task, Ref<NavigationPathQueryResult2D> p_query_result) {
 	p_query_result->set_data(
-			query_task.path_points,
-			query_task.path_meta_point_types,
-			query_task.path_meta_point_rids,
-			query_task.path_meta_point_owners);
-	p_query_result->set_path_length(query_task.path_length);
-
-	if (query_task.callback.is_valid()) {
-		if (emit_callback(query_task.callback)) {
-			query_task.status = NavMeshPathQueryTask2D::TaskStatus::CALLBACK_DISPATCHED;
-		} else {
-			query_task.status = NavMeshPathQueryTask2D::TaskStatus::CALLBACK_FAILED;
-		}
-	}
+			p_query_task.path_points,
+			p_query_task.path_meta_point_types,
+			p_query_task.path_meta_point_rids,
+			p_query_task.path_meta_point_owners);
+	p_query_result->set_path_length(p_query_task.path_length);
 }
 
 void NavMeshQueries2D::_query_task_find_start_end_positions(NavMeshPathQueryTask2D &p_query_task, const NavMapIteration2D &p_map_iteration) {
-	real_t begin_d = FLT_MAX;
-	real_t end_d = FLT_MAX;
+	_query_task_find_closest_polygon(p_query_task, p_map_iteration, p_query_task.start_position, p_query_task.begin_polygon, p_query_task.begin_position);
+	_query_task_find_closest_polygon(p_query_task, p_map_iteration, p_query_task.target_position, p_query_task.end_polygon, p_query_task.end_position);
+}
+
+void NavMeshQueries2D::_query_task_find_closest_polygon(const NavMeshPathQueryTask2D &p_query_task, const NavMapIteration2D &p_map_iteration, const Vector2 &p_point, const Polygon *&r_polygon, Vector2 &r_position) {
+	real_t closest_distance = FLT_MAX;
 
 	const LocalVector<Ref<NavRegionIteration2D>> &regions = p_map_iteration.region_iterations;
 
@@ -245,31 +291,22 @@ void NavMeshQueries2D::_query_task_find_start_end_positions(NavMeshPathQueryTask
 			continue;
 		}
 
-		// Find the initial poly and the end poly on this map.
 		for (const Polygon &p : region->get_navmesh_polygons()) {
 			// Only consider the polygon if it in a region with compatible layers.
 			if ((p_query_task.navigation_layers & p.owner->get_navigation_layers()) == 0) {
 				continue;
 			}
 
-			// For each triangle check the distance between the origin/destination.
+			// For each triangle check the distance to the point.
 			for (uint32_t point_id = 2; point_id < p.vertices.size(); point_id++) {
 				const Triangle2 triangle(p.vertices[0], p.vertices[point_id - 1], p.vertices[point_id]);
 
-				Vector2 point = triangle.get_closest_point_to(p_query_task.start_position);
-				real_t distance_to_point = point.distance_to(p_query_task.start_position);
-				if (distance_to_point < begin_d) {
-					begin_d = distance_to_point;
-					p_query_task.begin_polygon = &p;
-					p_query_task.begin_position = point;
-				}
-
-				point = triangle.get_closest_point_to(p_query_task.target_position);
-				distance_to_point = point.distance_to(p_query_task.target_position);
-				if (distance_to_point < end_d) {
-					end_d = distance_to_point;
-					p_query_task.end_polygon = &p;
-					p_query_task.end_position = point;
+				const Vector2 point = triangle.get_closest_point_to(p_point);
+				const real_t distance_to_point = point.distance_to(p_point);
+				if (distance_to_point < closest_distance) {
+					closest_distance = distance_to_point;
+					r_polygon = &p;
+					r_position = point;
 				}
 			}
 		}
@@ -1016,6 +1053,214 @@ Vector2 NavMeshQueries2D::map_iteration_get_random_point(const NavMapIteration2D
 	}
 }
 
+Vector2 NavMeshQueries2D::map_iteration_get_flow_direction(const NavMapIteration2D &p_map_iteration, const Vector2 &p_target_position, const Vector2 &p_position, uint32_t p_navigation_layers) {
+	// Flow fields only filter polygons by navigation layers, the other task parameters stay unused.
+	NavMeshPathQueryTask2D query_task;
+	query_task.navigation_layers = p_navigation_layers;
+
+	const Polygon *polygon = nullptr;
+	Vector2 position;
+	_query_task_find_closest_polygon(query_task, p_map_iteration, p_position, polygon, position);
+	if (!polygon) {
+		return Vector2();
+	}
+
+	const Polygon *target_polygon = nullptr;
+	Vector2 target_position;
+	_query_task_find_closest_polygon(query_task, p_map_iteration, p_target_position, target_polygon, target_position);
+	if (!target_polygon) {
+		return Vector2();
+	}
+
+	if (!p_map_iteration.flow_field_graph_built.is_set()) {
+		MutexLock graph_lock(p_map_iteration.flow_field_graph_mutex);
+		if (!p_map_iteration.flow_field_graph_built.is_set()) {
+			_map_iteration_build_flow_field_graph(p_map_iteration, p_map_iteration.flow_field_graph);
+			p_map_iteration.flow_field_graph_built.set();
+		}
+	}
+	const FlowFieldGraph &graph = p_map_iteration.flow_field_graph;
+
+	FlowFieldKey flow_field_key;
+	flow_field_key.target_polygon = target_polygon;
+	flow_field_key.navigation_layers = p_navigation_layers;
+
+	// The cache lock only covers the lookup, evicted flow fields stay alive for the queries still using them.
+	Ref<FlowField> flow_field;
+	{
+		MutexLock lock(p_map_iteration.flow_fields_mutex);
+		const Ref<FlowField> *cached_flow_field = p_map_iteration.flow_fields.getptr(flow_field_key);
+		if (cached_flow_field) {
+			flow_field = *cached_flow_field;
+		} else {
+			if (p_map_iteration.flow_fields.size() >= (uint32_t)FLOW_FIELD_CACHE_SIZE) {
+				p_map_iteration.flow_fields.remove(p_map_iteration.flow_fields.begin());
+			}
+			flow_field.instantiate();
+			p_map_iteration.flow_fields.insert(flow_field_key, flow_field);
+		}
+	}
+
+	// All agents that share a target polygon sample the same flow field, only the first one pays for building it.
+	// The routes lead to the target position of that first query, the others only use their own once on the target polygon.
+	if (!flow_field->built.is_set()) {
+		MutexLock build_lock(flow_field->build_mutex);
+		if (!flow_field->built.is_set()) {
+			_map_iteration_build_flow_field(p_map_iteration, query_task, target_polygon, target_position, *flow_field.ptr());
+			flow_field->built.set();
+		}
+	}
+
+	const uint32_t *polygon_offset = graph.navbase_polygon_offsets.getptr(polygon->owner);
+	ERR_FAIL_NULL_V(polygon_offset, Vector2());
+	uint32_t polygon_id = *polygon_offset + polygon->id;
+
+	// Follow the exits that the position already reached, e.g. when standing on the edge shared with the next polygon.
+	for (uint32_t i = 0; i < graph.polygons.size(); i++) {
+		if (polygon_id == flow_field->target_polygon_id) {
+			return (target_position - position).normalized();
+		}
+		if (flow_field->polygon_costs[polygon_id] == FLT_MAX) {
+			// The target can not be reached from here.
+			return Vector2();
+		}
+
+		const Vector2 direction = flow_field->polygon_exits[polygon_id] - position;
+		if (!direction.is_zero_approx()) {
+			return direction.normalized();
+		}
+		polygon_id = flow_field->polygon_next_ids[polygon_id];
+	}
+
+	return Vector2();
+}
+
+void NavMeshQueries2D::_map_iteration_build_flow_field_graph(const NavMapIteration2D &p_map_iteration, FlowFieldGraph &r_graph) {
+	r_graph.clear();
+
+	// Map polygon ids follow the same order as the ids used by the path query slots.
+	for (const Ref<NavRegionIteration2D> &region : p_map_iteration.region_iterations) {
+		r_graph.navbase_polygon_offsets[region.ptr()] = r_graph.polygons.size();
+		for (const Polygon &polygon : region->navmesh_polygons) {
+			r_graph.polygons.push_back(&polygon);
+		}
+	}
+	for (const Polygon &polygon : p_map_iteration.navlink_polygons) {
+		r_graph.navbase_polygon_offsets[polygon.owner] = r_graph.polygons.size();
+		r_graph.polygons.push_back(&polygon);
+	}
+
+	const uint32_t polygon_count = r_graph.polygons.size();
+
+	// Count the connections leading into each polygon first, then place them with a counting sort.
+	LocalVector<uint32_t> &incoming_offsets = r_graph.incoming_offsets;
+	incoming_offsets.resize_initialized(polygon_count + 1);
+
+	for (const Polygon *polygon : r_graph.polygons) {
+		_polygon_visit_connections(p_map_iteration, *polygon, [&](const Connection &p_connection) {
+			const uint32_t *to_polygon_offset = r_graph.navbase_polygon_offsets.getptr(p_connection.polygon->owner);
+			ERR_FAIL_NULL(to_polygon_offset);
+			incoming_offsets[*to_polygon_offset + p_connection.polygon->id + 1]++;
+		});
+	}
+
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		incoming_offsets[polygon_id + 1] += incoming_offsets[polygon_id];
+	}
+
+	const uint32_t connection_count = incoming_offsets[polygon_count];
+	r_graph.incoming_polygon_ids.resize(connection_count);
+	r_graph.incoming_pathway_starts.resize(connection_count);
+	r_graph.incoming_pathway_ends.resize(connection_count);
+
+	LocalVector<uint32_t> incoming_cursors;
+	incoming_cursors.resize(polygon_count);
+	memcpy(incoming_cursors.ptr(), incoming_offsets.ptr(), polygon_count * sizeof(uint32_t));
+
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		_polygon_visit_connections(p_map_iteration, *r_graph.polygons[polygon_id], [&](const Connection &p_connection) {
+			const uint32_t *to_polygon_offset = r_graph.navbase_polygon_offsets.getptr(p_connection.polygon->owner);
+			ERR_FAIL_NULL(to_polygon_offset);
+			const uint32_t incoming_index = incoming_cursors[*to_polygon_offset + p_connection.polygon->id]++;
+			r_graph.incoming_polygon_ids[incoming_index] = polygon_id;
+			r_graph.incoming_pathway_starts[incoming_index] = p_connection.pathway_start;
+			r_graph.incoming_pathway_ends[incoming_index] = p_connection.pathway_end;
+		});
+	}
+}
+
+void NavMeshQueries2D::_map_iteration_build_flow_field(const NavMapIteration2D &p_map_iteration, const NavMeshPathQueryTask2D &p_query_task, const Polygon *p_target_polygon, const Vector2 &p_target_position, FlowField &r_flow_field) {
+	const FlowFieldGraph &graph = p_map_iteration.flow_field_graph;
+	const uint32_t polygon_count = graph.polygons.size();
+
+	LocalVector<NavigationPoly> navigation_polys;
+	navigation_polys.resize(polygon_count);
+	for (NavigationPoly &navigation_poly : navigation_polys) {
+		navigation_poly.reset();
+	}
+
+	const uint32_t *target_polygon_offset = graph.navbase_polygon_offsets.getptr(p_target_polygon->owner);
+	if (target_polygon_offset) {
+		r_flow_field.target_polygon_id = *target_polygon_offset + p_target_polygon->id;
+
+		NavigationPoly &target_navigation_poly = navigation_polys[r_flow_field.target_polygon_id];
+		target_navigation_poly.poly = p_target_polygon;
+		target_navigation_poly.entry = p_target_position;
+		target_navigation_poly.traveled_distance = 0.0;
+
+		Heap<NavigationPoly *, NavPolyTravelCostGreaterThan, NavPolyHeapIndexer> traversable_polys;
+		traversable_polys.push(&target_navigation_poly);
+
+		// This is Dijkstra's algorithm from the target backwards along the connections.
+		// The entry of each polygon is the point where it is left towards the target.
+		while (!traversable_polys.is_empty()) {
+			const NavigationPoly *least_cost_poly = traversable_polys.pop();
+			const uint32_t least_cost_id = least_cost_poly - navigation_polys.ptr();
+			const NavBaseIteration2D *least_cost_owner = least_cost_poly->poly->owner;
+
+			for (uint32_t incoming_index = graph.incoming_offsets[least_cost_id]; incoming_index < graph.incoming_offsets[least_cost_id + 1]; incoming_index++) {
+				const uint32_t neighbor_id = graph.incoming_polygon_ids[incoming_index];
+				const Polygon *neighbor_polygon = graph.polygons[neighbor_id];
+				if (!_query_task_is_connection_owner_usable(p_query_task, neighbor_polygon->owner)) {
+					continue;
+				}
+
+				const Vector2 new_entry = Geometry2D::get_closest_point_to_segment(least_cost_poly->entry, graph.incoming_pathway_starts[incoming_index], graph.incoming_pathway_ends[incoming_index]);
+				real_t new_traveled_distance = least_cost_poly->entry.distance_to(new_entry) * least_cost_owner->get_travel_cost() + least_cost_poly->traveled_distance;
+				if (neighbor_polygon->owner != least_cost_owner) {
+					new_traveled_distance += least_cost_owner->get_enter_cost();
+				}
+
+				NavigationPoly &neighbor_poly = navigation_polys[neighbor_id];
+				if (new_traveled_distance < neighbor_poly.traveled_distance) {
+					neighbor_poly.back_navigation_poly_id = least_cost_id;
+					neighbor_poly.traveled_distance = new_traveled_distance;
+					neighbor_poly.entry = new_entry;
+
+					if (neighbor_poly.traversable_poly_index != traversable_polys.INVALID_INDEX) {
+						traversable_polys.shift(neighbor_poly.traversable_poly_index);
+					} else {
+						neighbor_poly.poly = neighbor_polygon;
+						traversable_polys.push(&neighbor_poly);
+					}
+				}
+			}
+		}
+	} else {
+		r_flow_field.target_polygon_id = UINT32_MAX;
+	}
+
+	r_flow_field.polygon_costs.resize(polygon_count);
+	r_flow_field.polygon_exits.resize(polygon_count);
+	r_flow_field.polygon_next_ids.resize(polygon_count);
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		const NavigationPoly &navigation_poly = navigation_polys[polygon_id];
+		r_flow_field.polygon_costs[polygon_id] = navigation_poly.traveled_distance;
+		r_flow_field.polygon_exits[polygon_id] = navigation_poly.entry;
+		r_flow_field.polygon_next_ids[polygon_id] = navigation_poly.back_navigation_poly_id == -1 ? UINT32_MAX : (uint32_t)navigation_poly.back_navigation_poly_id;
+	}
+}
+
 Vector2 NavMeshQueries2D::polygons_get_closest_point(const LocalVector<Polygon> &p_polygons, const Vector2 &p_point) {
 	ClosestPointQueryResult cp = polygons_get_closest_point_info(p_polygons, p_point);
 	return cp.point;
@@ -134,12 +134,20 @@ public:
 	static RID map_iteration_get_closest_point_owner(const NavMapIteration2D &p_map_iteration, const Vector2 &p_point);
 	static Nav2D::ClosestPointQueryResult map_iteration_get_closest_point_info(const NavMapIteration2D &p_map_iteration, const Vector2 &p_point);
 	static Vector2 map_iteration_get_random_point(const NavMapIteration2D &p_map_iteration, uint32_t p_navigation_layers, bool p_uniformly);
+	static Vector2 map_iteration_get_flow_direction(const NavMapIteration2D &p_map_iteration, const Vector2 &p_target_position, const Vector2 &p_position, uint32_t p_navigation_layers);
+	static void _map_iteration_build_flow_field_graph(const NavMapIteration2D &p_map_iteration, Nav2D::FlowFieldGraph &r_graph);
+	static void _map_iteration_build_flow_field(const NavMapIteration2D &p_map_iteration, const NavMeshPathQueryTask2D &p_query_task, const Nav2D::Polygon *p_target_polygon, const Vector2 &p_target_position, Nav2D::FlowField &r_flow_field);
 
 	static void map_query_path(NavMap2D *p_map, const Ref<NavigationPathQueryParameters2D> &p_query_parameters, Ref<NavigationPathQueryResult2D> p_query_result, const Callable &p_callback);
+	static void map_query_path_batch(NavMap2D *p_map, const TypedArray<NavigationPathQueryParameters2D> &p_query_parameters, const TypedArray<NavigationPathQueryResult2D> &p_query_results, const LocalVector<uint32_t> &p_query_indices);
+
+	static void query_task_set_parameters(NavMeshPathQueryTask2D &r_query_task, const Ref<NavigationPathQueryParameters2D> &p_query_parameters);
+	static void query_task_get_result(const NavMeshPathQueryTask2D &p_query_task, Ref<NavigationPathQueryResult2D> p_query_result);
 
 	static void query_task_map_iteration_get_path(NavMeshPathQueryTask2D &p_query_task, const NavMapIteration2D &p_map_iteration);
 	static void _query_task_push_back_point_with_metadata(NavMeshPathQueryTask2D &p_query_task, const Vector2 &p_point, const Nav2D::Polygon *p_point_polygon);
 	static void _query_task_find_start_end_positions(NavMeshPathQueryTask2D &p_query_task, const NavMapIteration2D &p_map_iteration);
+	static void _query_task_find_closest_polygon(const NavMeshPathQueryTask2D &p_query_task, const NavMapIteration2D &p_map_iteration, const Vector2 &p_point, const Nav2D::Polygon *&r_polygon, Vector2 &r_position);
 	static void _query_task_build_path_corridor(NavMeshPathQueryTask2D &p_query_task, const NavMapIteration2D &p_map_iteration);
 	static void _query_task_post_process_corridorfunnel(NavMeshPathQueryTask2D &p_query_task);
 	static void _query_task_post_process_edgecentered(NavMeshPathQueryTask2D &p_query_task);
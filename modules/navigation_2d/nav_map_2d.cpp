@@ -159,6 +159,76 @@ void NavMap2D::query_path(NavMeshQueries2D::NavMeshPathQueryTask2D &p_query_task
 	map_iteration.path_query_slots_semaphore.post();
 }
 
+void NavMap2D::query_path_batch(LocalVector<NavMeshQueries2D::NavMeshPathQueryTask2D> &p_query_tasks) {
+	if (iteration_id == 0 || p_query_tasks.is_empty()) {
+		return;
+	}
+
+	// All queries of the batch use the same map iteration.
+	GET_MAP_ITERATION();
+
+	// Wait for one free slot, then take the other free slots without waiting so concurrent batches can't lock each other out.
+	map_iteration.path_query_slots_semaphore.wait();
+	uint32_t slot_count = 1;
+	while (slot_count < p_query_tasks.size() && map_iteration.path_query_slots_semaphore.try_wait()) {
+		slot_count++;
+	}
+
+	QueryPathBatch batch;
+	batch.map_iteration = &map_iteration;
+	batch.query_tasks = p_query_tasks.ptr();
+	batch.query_task_count = p_query_tasks.size();
+
+	map_iteration.path_query_slots_mutex.lock();
+	for (NavMeshQueries2D::PathQuerySlot &p_path_query_slot : map_iteration.path_query_slots) {
+		if (batch.path_query_slots.size() == slot_count) {
+			break;
+		}
+		if (!p_path_query_slot.in_use) {
+			p_path_query_slot.in_use = true;
+			batch.path_query_slots.push_back(&p_path_query_slot);
+		}
+	}
+	map_iteration.path_query_slots_mutex.unlock();
+
+	if (batch.path_query_slots.size() < slot_count) {
+		map_iteration.path_query_slots_semaphore.post(slot_count - batch.path_query_slots.size());
+		slot_count = batch.path_query_slots.size();
+		ERR_FAIL_COND_MSG(slot_count == 0, "No unused NavMap2D path query slot found! This should never happen :(.");
+	}
+
+	if (slot_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap2D::_query_path_batch_task, &batch, slot_count, -1, true, SNAME("NavMapQueryPathBatch2D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_query_path_batch_task(0, &batch);
+	}
+
+	map_iteration.path_query_slots_mutex.lock();
+	for (NavMeshQueries2D::PathQuerySlot *path_query_slot : batch.path_query_slots) {
+		path_query_slot->in_use = false;
+	}
+	map_iteration.path_query_slots_mutex.unlock();
+
+	map_iteration.path_query_slots_semaphore.post(slot_count);
+}
+
+void NavMap2D::_query_path_batch_task(uint32_t p_index, QueryPathBatch *p_batch) {
+	NavMeshQueries2D::PathQuerySlot *path_query_slot = p_batch->path_query_slots[p_index];
+
+	// Every slot keeps taking the next pending query until the batch is done.
+	uint32_t query_task_index = p_batch->next_query_task.postincrement();
+	while (query_task_index < p_batch->query_task_count) {
+		NavMeshQueries2D::NavMeshPathQueryTask2D &query_task = p_batch->query_tasks[query_task_index];
+		query_task.path_query_slot = path_query_slot;
+
+		NavMeshQueries2D::query_task_map_iteration_get_path(query_task, *p_batch->map_iteration);
+
+		query_task.path_query_slot = nullptr;
+		query_task_index = p_batch->next_query_task.postincrement();
+	}
+}
+
 Vector2 NavMap2D::get_closest_point(const Vector2 &p_point) const {
 	if (iteration_id == 0) {
 		NAVMAP_ITERATION_ZERO_ERROR_MSG();
@@ -181,6 +251,17 @@ RID NavMap2D::get_closest_point_owner(const Vector2 &p_point) const {
 	return NavMeshQueries2D::map_iteration_get_closest_point_owner(map_iteration, p_point);
 }
 
+Vector2 NavMap2D::get_flow_direction(const Vector2 &p_target_position, const Vector2 &p_position, uint32_t p_navigation_layers) const {
+	if (iteration_id == 0) {
+		NAVMAP_ITERATION_ZERO_ERROR_MSG();
+		return Vector2();
+	}
+
+	GET_MAP_ITERATION_CONST();
+
+	return NavMeshQueries2D::map_iteration_get_flow_direction(map_iteration, p_target_position, p_position, p_navigation_layers);
+}
+
 ClosestPointQueryResult NavMap2D::get_closest_point_info(const Vector2 &p_point) const {
 	GET_MAP_ITERATION_CONST();
 
@@ -499,13 +580,13 @@ void NavMap2D::_update_rvo_obstacles_tree() {
 }
 
 void NavMap2D::_update_rvo_agents_tree() {
-	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
-	std::vector<RVO2D::Agent2D *> raw_agents;
-	raw_agents.reserve(active_avoidance_agents.size());
-	for (NavAgent2D *agent : active_avoidance_agents) {
-		raw_agents.push_back(agent->get_rvo_agent());
+	LocalVector<Vector3> positions;
+	positions.resize(active_avoidance_agents.size());
+	for (uint32_t i = 0; i < active_avoidance_agents.size(); i++) {
+		const RVO2D::Vector2 &position = active_avoidance_agents[i]->get_rvo_agent()->position_;
+		positions[i] = Vector3(position.x(), 0.0, position.y());
 	}
-	rvo_simulation.kdTree_->buildAgentTree(raw_agents);
+	avoidance_agent_grid.build(positions);
 }
 
 void NavMap2D::_update_rvo_simulation() {
@@ -517,8 +598,25 @@ void NavMap2D::_update_rvo_simulation() {
 	}
 }
 
+void NavMap2D::_compute_rvo_agent_neighbors(RVO2D::Agent2D *p_agent) {
+	p_agent->obstacleNeighbors_.clear();
+	const float obstacle_range = p_agent->timeHorizonObst_ * p_agent->maxSpeed_ + p_agent->radius_;
+	rvo_simulation.kdTree_->computeObstacleNeighbors(p_agent, obstacle_range * obstacle_range);
+
+	p_agent->agentNeighbors_.clear();
+	if (p_agent->maxNeighbors_ == 0) {
+		return;
+	}
+
+	// Same results as the kd-tree query: the agent keeps the closest neighbors and shrinks the range once it has enough of them.
+	float range_sq = p_agent->neighborDist_ * p_agent->neighborDist_;
+	avoidance_agent_grid.query(Vector3(p_agent->position_.x(), 0.0, p_agent->position_.y()), range_sq, [&](uint32_t p_index) {
+		p_agent->insertAgentNeighbor(active_avoidance_agents[p_index]->get_rvo_agent(), range_sq);
+	});
+}
+
 void NavMap2D::compute_single_avoidance_step(uint32_t p_index, NavAgent2D **p_agent) {
-	(*(p_agent + p_index))->get_rvo_agent()->computeNeighbors(&rvo_simulation);
+	_compute_rvo_agent_neighbors((*(p_agent + p_index))->get_rvo_agent());
 	(*(p_agent + p_index))->get_rvo_agent()->computeNewVelocity(&rvo_simulation);
 	(*(p_agent + p_index))->get_rvo_agent()->update(&rvo_simulation);
 	(*(p_agent + p_index))->update();
@@ -533,7 +631,7 @@ void NavMap2D::step(double p_delta_time) {
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
 			for (NavAgent2D *agent : active_avoidance_agents) {
-				agent->get_rvo_agent()->computeNeighbors(&rvo_simulation);
+				_compute_rvo_agent_neighbors(agent->get_rvo_agent());
 				agent->get_rvo_agent()->computeNewVelocity(&rvo_simulation);
 				agent->get_rvo_agent()->update(&rvo_simulation);
 				agent->update();
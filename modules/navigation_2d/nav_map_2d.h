@@ -37,6 +37,7 @@
 
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
+#include "servers/nav_agent_grid.h"
 #include "servers/navigation_2d/navigation_constants_2d.h"
 
 #include <KdTree2d.h>
@@ -79,6 +80,9 @@ class NavMap2D : public NavRid2D {
 	/// Avoidance controlled agents.
 	LocalVector<NavAgent2D *> active_avoidance_agents;
 
+	/// Grid used instead of the RVO kd-tree to find the avoidance agent neighbors.
+	NavAgentGrid avoidance_agent_grid;
+
 	/// dirty flag when one of the agent's arrays are modified.
 	bool agents_dirty = true;
 
@@ -143,6 +147,15 @@ class NavMap2D : public NavRid2D {
 	bool iteration_building = false;
 	bool iteration_ready = false;
 
+	struct QueryPathBatch {
+		NavMapIteration2D *map_iteration = nullptr;
+		LocalVector<NavMeshQueries2D::PathQuerySlot *> path_query_slots;
+		NavMeshQueries2D::NavMeshPathQueryTask2D *query_tasks = nullptr;
+		uint32_t query_task_count = 0;
+		SafeNumeric<uint32_t> next_query_task;
+	};
+	void _query_path_batch_task(uint32_t p_index, QueryPathBatch *p_batch);
+
 	void _build_iteration();
 	void _sync_iteration();
 
@@ -181,10 +194,12 @@ public:
 	const Vector2 &get_merge_rasterizer_cell_size() const;
 
 	void query_path(NavMeshQueries2D::NavMeshPathQueryTask2D &p_query_task);
+	void query_path_batch(LocalVector<NavMeshQueries2D::NavMeshPathQueryTask2D> &p_query_tasks);
 
 	Vector2 get_closest_point(const Vector2 &p_point) const;
 	Nav2D::ClosestPointQueryResult get_closest_point_info(const Vector2 &p_point) const;
 	RID get_closest_point_owner(const Vector2 &p_point) const;
+	Vector2 get_flow_direction(const Vector2 &p_target_position, const Vector2 &p_position, uint32_t p_navigation_layers) const;
 
 	void add_region(NavRegion2D *p_region);
 	void remove_region(NavRegion2D *p_region);
@@ -265,6 +280,7 @@ private:
 	void _update_rvo_simulation();
 	void _update_rvo_obstacles_tree();
 	void _update_rvo_agents_tree();
+	void _compute_rvo_agent_neighbors(RVO2D::Agent2D *p_agent);
 
 	void _update_merge_rasterizer_cell_dimensions();
 };
@@ -32,9 +32,11 @@
 
 #include "core/math/vector3.h"
 #include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hashfuncs.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "servers/navigation_2d/navigation_constants_2d.h"
 
 class NavBaseIteration2D;
@@ -170,6 +172,64 @@ struct NavPolyHeapIndexer {
 	}
 };
 
+struct FlowFieldKey {
+	/// Flow fields are shared by every target position on the same polygon, only the direction on the target polygon itself points at the exact target.
+	const Polygon *target_polygon = nullptr;
+	uint32_t navigation_layers = 0;
+
+	static uint32_t hash(const FlowFieldKey &p_key) {
+		uint32_t h = hash_murmur3_one_64((uint64_t)p_key.target_polygon);
+		h = hash_murmur3_one_32(p_key.navigation_layers, h);
+		return hash_fmix32(h);
+	}
+
+	bool operator==(const FlowFieldKey &p_key) const {
+		return target_polygon == p_key.target_polygon && navigation_layers == p_key.navigation_layers;
+	}
+};
+
+struct FlowFieldGraph {
+	/// Polygon of each map polygon id.
+	LocalVector<const Polygon *> polygons;
+
+	/// Map polygon id of the first polygon of each navigation region or link.
+	HashMap<const NavBaseIteration2D *, uint32_t> navbase_polygon_offsets;
+
+	/// Connections leading into each map polygon. The connections into polygon `i` are stored from `incoming_offsets[i]` to `incoming_offsets[i + 1]`.
+	LocalVector<uint32_t> incoming_offsets;
+	LocalVector<uint32_t> incoming_polygon_ids;
+	LocalVector<Vector2> incoming_pathway_starts;
+	LocalVector<Vector2> incoming_pathway_ends;
+
+	void clear() {
+		polygons.clear();
+		navbase_polygon_offsets.clear();
+		incoming_offsets.clear();
+		incoming_polygon_ids.clear();
+		incoming_pathway_starts.clear();
+		incoming_pathway_ends.clear();
+	}
+};
+
+class FlowField : public RefCounted {
+public:
+	/// Held while the flow field is built, so queries for the same target wait for it without blocking other targets.
+	Mutex build_mutex;
+	SafeFlag built;
+
+	/// Travel cost from each map polygon to the target, FLT_MAX if the target can not be reached from the polygon.
+	LocalVector<real_t> polygon_costs;
+
+	/// Point on the connection pathway where each map polygon is left towards the target.
+	LocalVector<Vector2> polygon_exits;
+
+	/// Map polygon id of the polygon entered through the exit of each map polygon.
+	LocalVector<uint32_t> polygon_next_ids;
+
+	/// Map polygon id of the target polygon.
+	uint32_t target_polygon_id = UINT32_MAX;
+};
+
 struct ClosestPointQueryResult {
 	Vector2 point;
 	RID owner;
@@ -234,6 +234,34 @@ real_t GodotNavigationServer3D::map_get_link_connection_radius(RID p_map) const
 	return map->get_link_connection_radius();
 }
 
+COMMAND_2(map_set_use_hierarchical_pathfinding, RID, p_map, bool, p_enabled) {
+	NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_use_hierarchical_pathfinding(p_enabled);
+}
+
+bool GodotNavigationServer3D::map_get_use_hierarchical_pathfinding(RID p_map) const {
+	const NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, false);
+
+	return map->get_use_hierarchical_pathfinding();
+}
+
+COMMAND_2(map_set_use_path_cache, RID, p_map, bool, p_enabled) {
+	NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL(map);
+
+	map->set_use_path_cache(p_enabled);
+}
+
+bool GodotNavigationServer3D::map_get_use_path_cache(RID p_map) const {
+	const NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, false);
+
+	return map->get_use_path_cache();
+}
+
 Vector<Vector3> GodotNavigationServer3D::map_get_path(RID p_map, Vector3 p_origin, Vector3 p_destination, bool p_optimize, uint32_t p_navigation_layers) {
 	const NavMap3D *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL_V(map, Vector<Vector3>());
@@ -287,6 +315,13 @@ RID GodotNavigationServer3D::map_get_closest_point_owner(RID p_map, const Vector
 	return map->get_closest_point_owner(p_point);
 }
 
+Vector3 GodotNavigationServer3D::map_get_flow_direction(RID p_map, const Vector3 &p_target_position, const Vector3 &p_position, uint32_t p_navigation_layers) const {
+	const NavMap3D *map = map_owner.get_or_null(p_map);
+	ERR_FAIL_NULL_V(map, Vector3());
+
+	return map->get_flow_direction(p_target_position, p_position, p_navigation_layers);
+}
+
 TypedArray<RID> GodotNavigationServer3D::map_get_links(RID p_map) const {
 	TypedArray<RID> link_rids;
 	const NavMap3D *map = map_owner.get_or_null(p_map);
@@ -1403,6 +1438,8 @@ void GodotNavigationServer3D::physics_process(double p_delta_time) {
 	int _new_pm_edge_connection_count = 0;
 	int _new_pm_edge_free_count = 0;
 	int _new_pm_obstacle_count = 0;
+	int _new_pm_path_cache_hit_count = 0;
+	int _new_pm_path_cache_miss_count = 0;
 
 	MutexLock lock(operations_mutex);
 	for (uint32_t i(0); i < active_maps.size(); i++) {
@@ -1419,6 +1456,8 @@ void GodotNavigationServer3D::physics_process(double p_delta_time) {
 		_new_pm_edge_connection_count += active_maps[i]->get_pm_edge_connection_count();
 		_new_pm_edge_free_count += active_maps[i]->get_pm_edge_free_count();
 		_new_pm_obstacle_count += active_maps[i]->get_pm_obstacle_count();
+		_new_pm_path_cache_hit_count += active_maps[i]->get_pm_path_cache_hit_count();
+		_new_pm_path_cache_miss_count += active_maps[i]->get_pm_path_cache_miss_count();
 	}
 
 	pm_region_count = _new_pm_region_count;
@@ -1430,6 +1469,9 @@ void GodotNavigationServer3D::physics_process(double p_delta_time) {
 	pm_edge_connection_count = _new_pm_edge_connection_count;
 	pm_edge_free_count = _new_pm_edge_free_count;
 	pm_obstacle_count = _new_pm_obstacle_count;
+	pm_path_cache_hit_count = _new_pm_path_cache_hit_count;
+	pm_path_cache_miss_count = _new_pm_path_cache_miss_count;
+	pm_baked_tile_count = NavMeshGenerator3D::take_baked_tile_count();
 }
 
 void GodotNavigationServer3D::init() {
@@ -1457,6 +1499,28 @@ void GodotNavigationServer3D::query_path(const Ref<NavigationPathQueryParameters
 	NavMeshQueries3D::map_query_path(map, p_query_parameters, p_query_result, p_callback);
 }
 
+void GodotNavigationServer3D::query_path_batch(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results) {
+	ERR_FAIL_COND_MSG(p_query_parameters.size() != p_query_results.size(), "The number of query parameters and query results must match.");
+
+	// Group the queries per map, each map runs its queries in parallel.
+	HashMap<NavMap3D *, LocalVector<uint32_t>> map_query_indices;
+	for (int i = 0; i < p_query_parameters.size(); i++) {
+		const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+		const Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+		ERR_CONTINUE(query_parameters.is_null());
+		ERR_CONTINUE(query_result.is_null());
+
+		NavMap3D *map = map_owner.get_or_null(query_parameters->get_map());
+		ERR_CONTINUE(map == nullptr);
+
+		map_query_indices[map].push_back(i);
+	}
+
+	for (const KeyValue<NavMap3D *, LocalVector<uint32_t>> &E : map_query_indices) {
+		NavMeshQueries3D::map_query_path_batch(E.key, p_query_parameters, p_query_results, E.value);
+	}
+}
+
 RID GodotNavigationServer3D::source_geometry_parser_create() {
 	RWLockWrite write_lock(geometry_parser_rwlock);
 
@@ -1544,6 +1608,15 @@ int GodotNavigationServer3D::get_process_info(ProcessInfo p_info) const {
 		case INFO_OBSTACLE_COUNT: {
 			return pm_obstacle_count;
 		} break;
+		case INFO_PATH_CACHE_HIT_COUNT: {
+			return pm_path_cache_hit_count;
+		} break;
+		case INFO_PATH_CACHE_MISS_COUNT: {
+			return pm_path_cache_miss_count;
+		} break;
+		case INFO_BAKED_TILE_COUNT: {
+			return pm_baked_tile_count;
+		} break;
 	}
 
 	return 0;
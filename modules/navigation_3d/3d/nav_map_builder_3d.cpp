@@ -37,6 +37,7 @@
 #include "nav_region_iteration_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/templates/sort_array.h"
 
 using namespace Nav3D;
 
@@ -72,9 +73,20 @@ void NavMapBuilder3D::build_navmap_iteration(NavMapIterationBuild3D &r_build) {
 
 	_build_step_navlink_connections(r_build);
 
+	_build_step_polygon_external_connections(r_build);
+
+	_build_step_polygon_bvh(r_build);
+
+	_build_step_hierarchy(r_build);
+
 	_build_update_map_iteration(r_build);
 }
 
+void NavMapBuilder3D::_build_add_external_connection(NavMapIterationBuild3D &r_build, const Polygon *p_polygon, const Connection &p_connection) {
+	r_build.iter_external_connection_polygon_ids.push_back(r_build.map_iteration->navbase_polygon_offsets[p_polygon->owner] + p_polygon->id);
+	r_build.iter_external_connections.push_back(p_connection);
+}
+
 void NavMapBuilder3D::_build_step_gather_region_polygons(NavMapIterationBuild3D &r_build) {
 	PerformanceData &performance_data = r_build.performance_data;
 	NavMapIteration3D *map_iteration = r_build.map_iteration;
@@ -82,7 +94,7 @@ void NavMapBuilder3D::_build_step_gather_region_polygons(NavMapIterationBuild3D
 	const LocalVector<Ref<NavRegionIteration3D>> &regions = map_iteration->region_iterations;
 	HashMap<const NavBaseIteration3D *, LocalVector<Connection>> &region_external_connections = map_iteration->external_region_connections;
 
-	map_iteration->navbases_polygons_external_connections.clear();
+	map_iteration->navbase_polygon_offsets.clear();
 
 	// Remove regions connections.
 	region_external_connections.clear();
@@ -90,12 +102,10 @@ void NavMapBuilder3D::_build_step_gather_region_polygons(NavMapIterationBuild3D
 	// Copy all region polygons in the map.
 	int polygon_count = 0;
 	for (const Ref<NavRegionIteration3D> &region : regions) {
-		const uint32_t polygons_size = region->navmesh_polygons.size();
-		polygon_count += polygons_size;
+		map_iteration->navbase_polygon_offsets[region.ptr()] = polygon_count;
+		polygon_count += region->navmesh_polygons.size();
 
 		region_external_connections[region.ptr()] = LocalVector<Connection>();
-		map_iteration->navbases_polygons_external_connections[region.ptr()] = LocalVector<LocalVector<Connection>>();
-		map_iteration->navbases_polygons_external_connections[region.ptr()].resize(polygons_size);
 	}
 
 	performance_data.pm_polygon_count = polygon_count;
@@ -165,10 +175,6 @@ void NavMapBuilder3D::_build_step_merge_edge_connection_pairs(NavMapIterationBui
 	free_edges.clear();
 	free_edges.reserve(free_edges_count);
 
-	NavMapIteration3D *map_iteration = r_build.map_iteration;
-
-	HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Nav3D::Connection>>> &navbases_polygons_external_connections = map_iteration->navbases_polygons_external_connections;
-
 	for (const KeyValue<EdgeKey, EdgeConnectionPair> &pair_it : connection_pairs_map) {
 		const EdgeConnectionPair &pair = pair_it.value;
 		if (pair.size == 2) {
@@ -176,8 +182,8 @@ void NavMapBuilder3D::_build_step_merge_edge_connection_pairs(NavMapIterationBui
 			const Connection &c1 = pair.connections[0];
 			const Connection &c2 = pair.connections[1];
 
-			navbases_polygons_external_connections[c1.polygon->owner][c1.polygon->id].push_back(c2);
-			navbases_polygons_external_connections[c2.polygon->owner][c2.polygon->id].push_back(c1);
+			_build_add_external_connection(r_build, c1.polygon, c2);
+			_build_add_external_connection(r_build, c2.polygon, c1);
 			performance_data.pm_edge_connection_count += 1;
 
 		} else {
@@ -198,8 +204,6 @@ void NavMapBuilder3D::_build_step_edge_connection_margin_connections(NavMapItera
 	LocalVector<Connection> &free_edges = r_build.iter_free_edges;
 	HashMap<const NavBaseIteration3D *, LocalVector<Connection>> &region_external_connections = map_iteration->external_region_connections;
 
-	HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Nav3D::Connection>>> &navbases_polygons_external_connections = map_iteration->navbases_polygons_external_connections;
-
 	// Find the compatible near edges.
 	//
 	// Note:
@@ -264,7 +268,7 @@ void NavMapBuilder3D::_build_step_edge_connection_margin_connections(NavMapItera
 
 			// Add the connection to the region_connection map.
 			region_external_connections[free_edge.polygon->owner].push_back(new_connection);
-			navbases_polygons_external_connections[free_edge.polygon->owner][free_edge.polygon->id].push_back(new_connection);
+			_build_add_external_connection(r_build, free_edge.polygon, new_connection);
 			performance_data.pm_edge_connection_count += 1;
 		}
 	}
@@ -281,7 +285,6 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 
 	real_t link_connection_radius_sqr = link_connection_radius * link_connection_radius;
 
-	HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Nav3D::Connection>>> &navbases_polygons_external_connections = map_iteration->navbases_polygons_external_connections;
 	LocalVector<Nav3D::Polygon> &navlink_polygons = map_iteration->navlink_polygons;
 	navlink_polygons.clear();
 	navlink_polygons.resize(links.size());
@@ -289,6 +292,7 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 
 	// Search for polygons within range of a nav link.
 	for (const Ref<NavLinkIteration3D> &link : links) {
+		map_iteration->navbase_polygon_offsets[link.ptr()] = polygon_count;
 		polygon_count++;
 		Polygon &new_polygon = navlink_polygons[navlink_index++];
 
@@ -360,15 +364,14 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 				entry_connection.edge = -1;
 				entry_connection.pathway_start = new_polygon.vertices[0];
 				entry_connection.pathway_end = new_polygon.vertices[1];
-				navbases_polygons_external_connections[closest_start_polygon->owner][closest_start_polygon->id].push_back(entry_connection);
+				_build_add_external_connection(r_build, closest_start_polygon, entry_connection);
 
 				Connection exit_connection;
 				exit_connection.polygon = closest_end_polygon;
 				exit_connection.edge = -1;
 				exit_connection.pathway_start = new_polygon.vertices[2];
 				exit_connection.pathway_end = new_polygon.vertices[3];
-				navbases_polygons_external_connections[link.ptr()].push_back(LocalVector<Nav3D::Connection>());
-				navbases_polygons_external_connections[link.ptr()][new_polygon.id].push_back(exit_connection);
+				_build_add_external_connection(r_build, &new_polygon, exit_connection);
 			}
 
 			// If the link is bi-directional, create connections from the end to the start.
@@ -378,15 +381,14 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 				entry_connection.edge = -1;
 				entry_connection.pathway_start = new_polygon.vertices[2];
 				entry_connection.pathway_end = new_polygon.vertices[3];
-				navbases_polygons_external_connections[closest_end_polygon->owner][closest_end_polygon->id].push_back(entry_connection);
+				_build_add_external_connection(r_build, closest_end_polygon, entry_connection);
 
 				Connection exit_connection;
 				exit_connection.polygon = closest_start_polygon;
 				exit_connection.edge = -1;
 				exit_connection.pathway_start = new_polygon.vertices[0];
 				exit_connection.pathway_end = new_polygon.vertices[1];
-				navbases_polygons_external_connections[link.ptr()].push_back(LocalVector<Nav3D::Connection>());
-				navbases_polygons_external_connections[link.ptr()][new_polygon.id].push_back(exit_connection);
+				_build_add_external_connection(r_build, &new_polygon, exit_connection);
 			}
 		}
 	}
@@ -394,6 +396,377 @@ void NavMapBuilder3D::_build_step_navlink_connections(NavMapIterationBuild3D &r_
 	r_build.polygon_count = polygon_count;
 }
 
+void NavMapBuilder3D::_build_step_polygon_external_connections(NavMapIterationBuild3D &r_build) {
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+
+	const LocalVector<uint32_t> &connection_polygon_ids = r_build.iter_external_connection_polygon_ids;
+	const LocalVector<Connection> &connections = r_build.iter_external_connections;
+	const uint32_t polygon_count = r_build.polygon_count;
+
+	PolygonConnections &external_connections = map_iteration->polygon_external_connections;
+	external_connections.clear();
+
+	// Count the connections of each polygon first, then place them with a counting sort that keeps the order they were found in.
+	LocalVector<uint32_t> &offsets = external_connections.offsets;
+	offsets.resize_initialized(polygon_count + 1);
+
+	for (uint32_t polygon_id : connection_polygon_ids) {
+		offsets[polygon_id + 1]++;
+	}
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		offsets[polygon_id + 1] += offsets[polygon_id];
+	}
+
+	external_connections.connections.resize(connections.size());
+
+	LocalVector<uint32_t> &cursors = r_build.iter_external_connection_cursors;
+	cursors.resize(polygon_count);
+	if (polygon_count > 0) {
+		memcpy(cursors.ptr(), offsets.ptr(), polygon_count * sizeof(uint32_t));
+	}
+
+	for (uint32_t i = 0; i < connections.size(); i++) {
+		external_connections.connections[cursors[connection_polygon_ids[i]]++] = connections[i];
+	}
+}
+
+void NavMapBuilder3D::_build_step_polygon_bvh(NavMapIterationBuild3D &r_build) {
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+
+	PolygonBVH &bvh = map_iteration->polygon_bvh;
+	bvh.clear();
+
+	struct BVHItem {
+		AABB aabb;
+		Vector3 center;
+		const Polygon *polygon = nullptr;
+		uint32_t polygon_id = 0;
+	};
+
+	struct BVHItemCenterComparator {
+		int axis = 0;
+
+		bool operator()(const BVHItem &p_a, const BVHItem &p_b) const {
+			return p_a.center[axis] < p_b.center[axis];
+		}
+	};
+
+	struct BVHBuildRange {
+		uint32_t node = 0;
+		uint32_t begin = 0;
+		uint32_t end = 0;
+	};
+
+	constexpr uint32_t BVH_LEAF_POLYGON_COUNT = 4;
+
+	LocalVector<BVHItem> items;
+	items.reserve(r_build.polygon_count);
+
+	// Map polygon ids follow the same order as the ids used by the path query slots.
+	uint32_t polygon_id = 0;
+	for (const Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
+		for (const Polygon &polygon : region->navmesh_polygons) {
+			if (polygon.vertices.size() < 3) {
+				polygon_id++;
+				continue;
+			}
+
+			BVHItem item;
+			item.aabb.position = polygon.vertices[0];
+			for (uint32_t i = 1; i < polygon.vertices.size(); i++) {
+				item.aabb.expand_to(polygon.vertices[i]);
+			}
+			// Navigation mesh polygons are often flat, avoid boxes without volume for the segment tests.
+			item.aabb.grow_by(CMP_EPSILON);
+			item.center = item.aabb.get_center();
+			item.polygon = &polygon;
+			item.polygon_id = polygon_id++;
+			items.push_back(item);
+		}
+	}
+
+	if (items.is_empty()) {
+		return;
+	}
+
+	bvh.nodes.reserve(2 * (items.size() / BVH_LEAF_POLYGON_COUNT) + 1);
+	bvh.polygons.reserve(items.size());
+	bvh.polygon_ids.reserve(items.size());
+
+	SortArray<BVHItem, BVHItemCenterComparator> sorter;
+
+	LocalVector<BVHBuildRange> build_ranges;
+	bvh.nodes.push_back(PolygonBVHNode());
+	build_ranges.push_back({ 0, 0, items.size() });
+
+	// Split the polygons at the median of their centers on the longest axis until the leaves are small enough.
+	while (!build_ranges.is_empty()) {
+		const BVHBuildRange range = build_ranges[build_ranges.size() - 1];
+		build_ranges.resize(build_ranges.size() - 1);
+
+		AABB aabb = items[range.begin].aabb;
+		AABB center_aabb = AABB(items[range.begin].center, Vector3());
+		for (uint32_t i = range.begin + 1; i < range.end; i++) {
+			aabb.merge_with(items[i].aabb);
+			center_aabb.expand_to(items[i].center);
+		}
+		bvh.nodes[range.node].aabb = aabb;
+
+		const uint32_t count = range.end - range.begin;
+		if (count <= BVH_LEAF_POLYGON_COUNT) {
+			bvh.nodes[range.node].first = bvh.polygons.size();
+			bvh.nodes[range.node].count = count;
+			for (uint32_t i = range.begin; i < range.end; i++) {
+				bvh.polygons.push_back(items[i].polygon);
+				bvh.polygon_ids.push_back(items[i].polygon_id);
+			}
+			continue;
+		}
+
+		const uint32_t middle = range.begin + count / 2;
+		sorter.compare.axis = center_aabb.get_longest_axis_index();
+		sorter.nth_element(range.begin, range.end, middle, items.ptr());
+
+		const uint32_t first_child = bvh.nodes.size();
+		bvh.nodes[range.node].first = first_child;
+		bvh.nodes.push_back(PolygonBVHNode());
+		bvh.nodes.push_back(PolygonBVHNode());
+
+		build_ranges.push_back({ first_child, range.begin, middle });
+		build_ranges.push_back({ first_child + 1, middle, range.end });
+	}
+}
+
+void NavMapBuilder3D::_build_step_hierarchy(NavMapIterationBuild3D &r_build) {
+	NavMapIteration3D *map_iteration = r_build.map_iteration;
+
+	Hierarchy &hierarchy = map_iteration->hierarchy;
+	hierarchy.clear();
+
+	if (!r_build.use_hierarchical_pathfinding) {
+		return;
+	}
+
+	const PolygonConnections &polygon_external_connections = map_iteration->polygon_external_connections;
+	HashMap<const NavBaseIteration3D *, uint32_t> &navbase_polygon_offsets = map_iteration->navbase_polygon_offsets;
+
+	// Map polygon ids follow the same order as the ids used by the path query slots.
+	LocalVector<const Polygon *> polygons;
+	polygons.reserve(r_build.polygon_count);
+
+	for (const Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
+		for (const Polygon &polygon : region->navmesh_polygons) {
+			polygons.push_back(&polygon);
+		}
+	}
+	for (const Polygon &polygon : map_iteration->navlink_polygons) {
+		polygons.push_back(&polygon);
+	}
+
+	const uint32_t polygon_count = polygons.size();
+
+	// Flatten the internal and external connections of every polygon.
+	LocalVector<uint32_t> neighbor_offsets;
+	LocalVector<uint32_t> neighbor_ids;
+	LocalVector<Vector3> neighbor_pathway_centers;
+	LocalVector<Vector3> polygon_centers;
+	neighbor_offsets.resize(polygon_count + 1);
+	polygon_centers.resize(polygon_count);
+
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		const Polygon *polygon = polygons[polygon_id];
+		neighbor_offsets[polygon_id] = neighbor_ids.size();
+
+		Vector3 center;
+		for (const Vector3 &vertex : polygon->vertices) {
+			center += vertex;
+		}
+		if (!polygon->vertices.is_empty()) {
+			center /= polygon->vertices.size();
+		}
+		polygon_centers[polygon_id] = center;
+
+		const LocalVector<LocalVector<Connection>> &internal_connections = polygon->owner->get_internal_connections();
+		if (polygon->id < internal_connections.size()) {
+			for (const Connection &connection : internal_connections[polygon->id]) {
+				neighbor_ids.push_back(navbase_polygon_offsets[connection.polygon->owner] + connection.polygon->id);
+				neighbor_pathway_centers.push_back((connection.pathway_start + connection.pathway_end) * 0.5);
+			}
+		}
+
+		for (const Connection &connection : polygon_external_connections.get_polygon_connections(polygon_id)) {
+			neighbor_ids.push_back(navbase_polygon_offsets[connection.polygon->owner] + connection.polygon->id);
+			neighbor_pathway_centers.push_back((connection.pathway_start + connection.pathway_end) * 0.5);
+		}
+	}
+	neighbor_offsets[polygon_count] = neighbor_ids.size();
+
+	// Group connected polygons of the same region or link into clusters, growing each cluster breadth-first.
+	LocalVector<uint32_t> &polygon_clusters = hierarchy.polygon_clusters;
+	polygon_clusters.resize(polygon_count);
+	for (uint32_t &polygon_cluster : polygon_clusters) {
+		polygon_cluster = UINT32_MAX;
+	}
+
+	const uint32_t cluster_polygon_count = NavigationDefaults3D::HIERARCHY_CLUSTER_POLYGON_COUNT;
+
+	for (uint32_t seed_id = 0; seed_id < polygon_count; seed_id++) {
+		if (polygon_clusters[seed_id] != UINT32_MAX) {
+			continue;
+		}
+
+		const uint32_t cluster_id = hierarchy.clusters.size();
+		hierarchy.clusters.push_back(HierarchyCluster());
+		HierarchyCluster &cluster = hierarchy.clusters[cluster_id];
+		cluster.owner = polygons[seed_id]->owner;
+		cluster.polygons.push_back(seed_id);
+		polygon_clusters[seed_id] = cluster_id;
+
+		for (uint32_t i = 0; i < cluster.polygons.size() && cluster.polygons.size() < cluster_polygon_count; i++) {
+			const uint32_t polygon_id = cluster.polygons[i];
+			for (uint32_t n = neighbor_offsets[polygon_id]; n < neighbor_offsets[polygon_id + 1]; n++) {
+				const uint32_t neighbor_id = neighbor_ids[n];
+				if (polygon_clusters[neighbor_id] != UINT32_MAX || polygons[neighbor_id]->owner != cluster.owner) {
+					continue;
+				}
+				polygon_clusters[neighbor_id] = cluster_id;
+				cluster.polygons.push_back(neighbor_id);
+				if (cluster.polygons.size() >= cluster_polygon_count) {
+					break;
+				}
+			}
+		}
+	}
+
+	// Merge all connections from one cluster to another into a single entrance.
+	HashMap<uint64_t, uint32_t> entrance_ids;
+	LocalVector<uint32_t> entrance_pathway_counts;
+	LocalVector<LocalVector<uint32_t>> entrance_exit_polygons;
+	LocalVector<LocalVector<uint32_t>> entrance_entry_polygons;
+
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		const uint32_t from_cluster = polygon_clusters[polygon_id];
+		for (uint32_t n = neighbor_offsets[polygon_id]; n < neighbor_offsets[polygon_id + 1]; n++) {
+			const uint32_t to_cluster = polygon_clusters[neighbor_ids[n]];
+			if (from_cluster == to_cluster) {
+				continue;
+			}
+
+			const uint64_t entrance_key = (uint64_t(from_cluster) << 32) | to_cluster;
+			HashMap<uint64_t, uint32_t>::Iterator entrance_it = entrance_ids.find(entrance_key);
+			if (!entrance_it) {
+				entrance_it = entrance_ids.insert(entrance_key, hierarchy.entrances.size());
+
+				HierarchyEntrance new_entrance;
+				new_entrance.from_cluster = from_cluster;
+				new_entrance.to_cluster = to_cluster;
+				hierarchy.entrances.push_back(new_entrance);
+				entrance_pathway_counts.push_back(0);
+				entrance_exit_polygons.push_back(LocalVector<uint32_t>());
+				entrance_entry_polygons.push_back(LocalVector<uint32_t>());
+			}
+
+			const uint32_t entrance_id = entrance_it->value;
+			hierarchy.entrances[entrance_id].position += neighbor_pathway_centers[n];
+			entrance_pathway_counts[entrance_id] += 1;
+			entrance_exit_polygons[entrance_id].push_back(polygon_id);
+			entrance_entry_polygons[entrance_id].push_back(neighbor_ids[n]);
+		}
+	}
+
+	for (uint32_t entrance_id = 0; entrance_id < hierarchy.entrances.size(); entrance_id++) {
+		HierarchyEntrance &entrance = hierarchy.entrances[entrance_id];
+		entrance.position /= entrance_pathway_counts[entrance_id];
+
+		HierarchyCluster &to_cluster = hierarchy.clusters[entrance.to_cluster];
+		entrance.to_cluster_entrance_index = to_cluster.entrances_in.size();
+		to_cluster.entrances_in.push_back(entrance_id);
+		hierarchy.clusters[entrance.from_cluster].entrances_out.push_back(entrance_id);
+	}
+
+	// Precompute the travel cost between the entrances of each cluster with a Dijkstra search over the cluster polygons.
+	LocalVector<uint32_t> polygon_local_ids;
+	polygon_local_ids.resize(polygon_count);
+	LocalVector<real_t> local_distances;
+	LocalVector<bool> local_visited;
+
+	for (HierarchyCluster &cluster : hierarchy.clusters) {
+		const uint32_t entrances_in_count = cluster.entrances_in.size();
+		const uint32_t entrances_out_count = cluster.entrances_out.size();
+		cluster.entrance_costs.resize(entrances_in_count * entrances_out_count);
+		if (cluster.entrance_costs.is_empty()) {
+			continue;
+		}
+
+		const uint32_t cluster_id = polygon_clusters[cluster.polygons[0]];
+		const uint32_t local_count = cluster.polygons.size();
+		const real_t travel_cost = cluster.owner->get_travel_cost();
+
+		for (uint32_t local_id = 0; local_id < local_count; local_id++) {
+			polygon_local_ids[cluster.polygons[local_id]] = local_id;
+		}
+		local_distances.resize(local_count);
+		local_visited.resize(local_count);
+
+		for (uint32_t in_index = 0; in_index < entrances_in_count; in_index++) {
+			const uint32_t entrance_in_id = cluster.entrances_in[in_index];
+			const Vector3 &entrance_in_position = hierarchy.entrances[entrance_in_id].position;
+
+			for (uint32_t local_id = 0; local_id < local_count; local_id++) {
+				local_distances[local_id] = FLT_MAX;
+				local_visited[local_id] = false;
+			}
+			for (uint32_t polygon_id : entrance_entry_polygons[entrance_in_id]) {
+				const uint32_t local_id = polygon_local_ids[polygon_id];
+				local_distances[local_id] = MIN(local_distances[local_id], entrance_in_position.distance_to(polygon_centers[polygon_id]) * travel_cost);
+			}
+
+			// Clusters are small, so a linear scan for the closest polygon is good enough.
+			while (true) {
+				uint32_t closest_local_id = UINT32_MAX;
+				real_t closest_distance = FLT_MAX;
+				for (uint32_t local_id = 0; local_id < local_count; local_id++) {
+					if (!local_visited[local_id] && local_distances[local_id] < closest_distance) {
+						closest_distance = local_distances[local_id];
+						closest_local_id = local_id;
+					}
+				}
+				if (closest_local_id == UINT32_MAX) {
+					break;
+				}
+				local_visited[closest_local_id] = true;
+
+				const uint32_t polygon_id = cluster.polygons[closest_local_id];
+				for (uint32_t n = neighbor_offsets[polygon_id]; n < neighbor_offsets[polygon_id + 1]; n++) {
+					const uint32_t neighbor_id = neighbor_ids[n];
+					if (polygon_clusters[neighbor_id] != cluster_id) {
+						continue;
+					}
+					const uint32_t neighbor_local_id = polygon_local_ids[neighbor_id];
+					const real_t distance = closest_distance + polygon_centers[polygon_id].distance_to(polygon_centers[neighbor_id]) * travel_cost;
+					if (distance < local_distances[neighbor_local_id]) {
+						local_distances[neighbor_local_id] = distance;
+					}
+				}
+			}
+
+			for (uint32_t out_index = 0; out_index < entrances_out_count; out_index++) {
+				const uint32_t entrance_out_id = cluster.entrances_out[out_index];
+				const Vector3 &entrance_out_position = hierarchy.entrances[entrance_out_id].position;
+
+				real_t entrance_cost = FLT_MAX;
+				for (uint32_t polygon_id : entrance_exit_polygons[entrance_out_id]) {
+					const real_t polygon_distance = local_distances[polygon_local_ids[polygon_id]];
+					if (polygon_distance != FLT_MAX) {
+						entrance_cost = MIN(entrance_cost, polygon_distance + polygon_centers[polygon_id].distance_to(entrance_out_position) * travel_cost);
+					}
+				}
+				cluster.entrance_costs[in_index * entrances_out_count + out_index] = entrance_cost;
+			}
+		}
+	}
+}
+
 void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_build) {
 	NavMapIteration3D *map_iteration = r_build.map_iteration;
 
@@ -413,6 +786,13 @@ void NavMapBuilder3D::_build_update_map_iteration(NavMapIterationBuild3D &r_buil
 		p_path_query_slot.poly_to_id.clear();
 		p_path_query_slot.poly_to_id.reserve(total_polygon_count);
 
+		p_path_query_slot.traversable_hierarchy_nodes.clear();
+		p_path_query_slot.hierarchy_nodes.clear();
+		p_path_query_slot.hierarchy_nodes.resize(map_iteration->hierarchy.entrances.size());
+		p_path_query_slot.hierarchy_cluster_stamps.clear();
+		p_path_query_slot.hierarchy_cluster_stamps.resize_initialized(map_iteration->hierarchy.clusters.size());
+		p_path_query_slot.hierarchy_stamp = 0;
+
 		int polygon_id = 0;
 		for (Ref<NavRegionIteration3D> &region : map_iteration->region_iterations) {
 			for (const Polygon &polygon : region->navmesh_polygons) {
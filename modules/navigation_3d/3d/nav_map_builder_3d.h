@@ -35,11 +35,16 @@
 struct NavMapIterationBuild3D;
 
 class NavMapBuilder3D {
+	static void _build_add_external_connection(NavMapIterationBuild3D &r_build, const Nav3D::Polygon *p_polygon, const Nav3D::Connection &p_connection);
+
 	static void _build_step_gather_region_polygons(NavMapIterationBuild3D &r_build);
 	static void _build_step_find_edge_connection_pairs(NavMapIterationBuild3D &r_build);
 	static void _build_step_merge_edge_connection_pairs(NavMapIterationBuild3D &r_build);
 	static void _build_step_edge_connection_margin_connections(NavMapIterationBuild3D &r_build);
 	static void _build_step_navlink_connections(NavMapIterationBuild3D &r_build);
+	static void _build_step_polygon_external_connections(NavMapIterationBuild3D &r_build);
+	static void _build_step_polygon_bvh(NavMapIterationBuild3D &r_build);
+	static void _build_step_hierarchy(NavMapIterationBuild3D &r_build);
 	static void _build_update_map_iteration(NavMapIterationBuild3D &r_build);
 
 public:
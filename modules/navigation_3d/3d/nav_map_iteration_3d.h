@@ -45,6 +45,7 @@ struct NavMapIteration3D;
 struct NavMapIterationBuild3D {
 	Vector3 merge_rasterizer_cell_size;
 	bool use_edge_connections = true;
+	bool use_hierarchical_pathfinding = false;
 	real_t edge_connection_margin;
 	real_t link_connection_radius;
 	Nav3D::PerformanceData performance_data;
@@ -54,6 +55,11 @@ struct NavMapIterationBuild3D {
 	HashMap<Nav3D::EdgeKey, Nav3D::EdgeConnectionPair, Nav3D::EdgeKey> iter_connection_pairs_map;
 	LocalVector<Nav3D::Connection> iter_free_edges;
 
+	// External connections in the order the build steps find them, with the map polygon id they leave from.
+	LocalVector<uint32_t> iter_external_connection_polygon_ids;
+	LocalVector<Nav3D::Connection> iter_external_connections;
+	LocalVector<uint32_t> iter_external_connection_cursors;
+
 	NavMapIteration3D *map_iteration = nullptr;
 
 	int navmesh_polygon_count = 0;
@@ -63,6 +69,8 @@ struct NavMapIterationBuild3D {
 
 		iter_connection_pairs_map.clear();
 		iter_free_edges.clear();
+		iter_external_connection_polygon_ids.clear();
+		iter_external_connections.clear();
 		polygon_count = 0;
 		free_edge_count = 0;
 
@@ -83,12 +91,36 @@ struct NavMapIteration3D {
 
 	// The edge connections that the map builds on top with the edge connection margin.
 	HashMap<const NavBaseIteration3D *, LocalVector<Nav3D::Connection>> external_region_connections;
-	HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Nav3D::Connection>>> navbases_polygons_external_connections;
+
+	// Map polygon id of the first polygon of each region and link, the ids follow the order used by the path query slots.
+	HashMap<const NavBaseIteration3D *, uint32_t> navbase_polygon_offsets;
+
+	// The external connections of every polygon indexed by map polygon id.
+	// Cleared without freeing so that rebuilding this iteration slot reuses the storage.
+	Nav3D::PolygonConnections polygon_external_connections;
 
 	LocalVector<Nav3D::Polygon> navlink_polygons;
 
 	HashMap<NavRegion3D *, Ref<NavRegionIteration3D>> region_ptr_to_region_iteration;
 
+	// Bounding volume hierarchy over all region polygons for closest point and segment queries.
+	Nav3D::PolygonBVH polygon_bvh;
+
+	// The polygon clusters used by hierarchical pathfinding, empty if not used by the map.
+	Nav3D::Hierarchy hierarchy;
+
+	// The flow fields of recently queried targets, built on demand and dropped with the iteration.
+	mutable Nav3D::FlowFieldGraph flow_field_graph;
+	mutable SafeFlag flow_field_graph_built;
+	mutable Mutex flow_field_graph_mutex;
+	mutable HashMap<Nav3D::FlowFieldKey, Ref<Nav3D::FlowField>, Nav3D::FlowFieldKey> flow_fields;
+	mutable Mutex flow_fields_mutex;
+
+	// The polygon corridors of recent path queries, only used when the map has the path cache enabled.
+	bool use_path_cache = false;
+	mutable HashMap<Nav3D::PathCacheKey, LocalVector<Nav3D::NavigationPoly>, Nav3D::PathCacheKey> path_cache;
+	mutable Mutex path_cache_mutex;
+
 	LocalVector<NavMeshQueries3D::PathQuerySlot> path_query_slots;
 	Mutex path_query_slots_mutex;
 	Semaphore path_query_slots_semaphore;
@@ -100,9 +132,16 @@ struct NavMapIteration3D {
 		region_iterations.clear();
 		link_iterations.clear();
 		external_region_connections.clear();
-		navbases_polygons_external_connections.clear();
+		navbase_polygon_offsets.clear();
+		polygon_external_connections.clear();
 		navlink_polygons.clear();
 		region_ptr_to_region_iteration.clear();
+		polygon_bvh.clear();
+		hierarchy.clear();
+		flow_field_graph.clear();
+		flow_field_graph_built.clear();
+		flow_fields.clear();
+		path_cache.clear();
 	}
 };
 
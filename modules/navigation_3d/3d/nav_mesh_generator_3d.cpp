@@ -48,6 +48,9 @@ bool NavMeshGenerator3D::baking_use_high_priority_threads = true;
 HashMap<Ref<NavigationMesh>, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tasks;
 LocalVector<NavMeshGeometryParser3D *> NavMeshGenerator3D::generator_parsers;
+Mutex NavMeshGenerator3D::tile_cache_mutex;
+HashMap<ObjectID, NavMeshGenerator3D::NavMeshTileCache3D> NavMeshGenerator3D::tile_caches;
+SafeNumeric<uint32_t> NavMeshGenerator3D::baked_tile_count;
 
 static const char *_navmesh_bake_state_msgs[(size_t)NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_MAX] = {
 	"",
@@ -86,6 +89,20 @@ NavMeshGenerator3D::~NavMeshGenerator3D() {
 }
 
 void NavMeshGenerator3D::sync() {
+	{
+		// Drop the tiles of navigation meshes that were freed.
+		MutexLock tile_cache_lock(tile_cache_mutex);
+		LocalVector<ObjectID> freed_navigation_meshes;
+		for (const KeyValue<ObjectID, NavMeshTileCache3D> &E : tile_caches) {
+			if (!ObjectDB::get_instance(E.key)) {
+				freed_navigation_meshes.push_back(E.key);
+			}
+		}
+		for (const ObjectID &navigation_mesh_id : freed_navigation_meshes) {
+			tile_caches.erase(navigation_mesh_id);
+		}
+	}
+
 	if (generator_tasks.is_empty()) {
 		return;
 	}
@@ -119,6 +136,12 @@ void NavMeshGenerator3D::sync() {
 	}
 }
 
+uint32_t NavMeshGenerator3D::take_baked_tile_count() {
+	uint32_t count = baked_tile_count.get();
+	baked_tile_count.sub(count);
+	return count;
+}
+
 void NavMeshGenerator3D::cleanup() {
 	MutexLock baking_navmesh_lock(baking_navmesh_mutex);
 	{
@@ -133,6 +156,10 @@ void NavMeshGenerator3D::cleanup() {
 		}
 		generator_tasks.clear();
 
+		tile_cache_mutex.lock();
+		tile_caches.clear();
+		tile_cache_mutex.unlock();
+
 		generator_parsers_rwlock.write_lock();
 		generator_parsers.clear();
 		generator_parsers_rwlock.write_unlock();
@@ -296,171 +323,121 @@ void NavMeshGenerator3D::generator_parse_source_geometry_data(const Ref<Navigati
 
 	bool recurse_children = p_navigation_mesh->get_source_geometry_mode() != NavigationMesh::SOURCE_GEOMETRY_GROUPS_EXPLICIT;
 
+	// The parsers run on the main thread and only snapshot the geometry with its transform,
+	// the collected vertices are transformed when the geometry is first read, usually by the bake task.
+	p_source_geometry_data->begin_deferred_geometry(use_threads);
+
 	for (Node *parse_node : parse_nodes) {
 		generator_parse_geometry_node(p_navigation_mesh, p_source_geometry_data, parse_node, recurse_children);
 	}
-}
-
-void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGeneratorTask3D *p_generator_task) {
-	Ref<NavigationMesh> p_navigation_mesh = p_generator_task->navigation_mesh;
-	const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data = p_generator_task->source_geometry_data;
-
-	if (p_navigation_mesh.is_null() || p_source_geometry_data.is_null()) {
-		return;
-	}
-
-	Vector<float> source_geometry_vertices;
-	Vector<int> source_geometry_indices;
-	Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> projected_obstructions;
-
-	p_source_geometry_data->get_data(
-			source_geometry_vertices,
-			source_geometry_indices,
-			projected_obstructions);
-
-	if (source_geometry_vertices.size() < 3 || source_geometry_indices.size() < 3) {
-		return;
-	}
-
-	rcHeightfield *hf = nullptr;
-	rcCompactHeightfield *chf = nullptr;
-	rcContourSet *cset = nullptr;
-	rcPolyMesh *poly_mesh = nullptr;
-	rcPolyMeshDetail *detail_mesh = nullptr;
-	rcContext ctx;
-
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CONFIGURATION; // step #1
-
-	const float *verts = source_geometry_vertices.ptr();
-	const int nverts = source_geometry_vertices.size() / 3;
-	const int *tris = source_geometry_indices.ptr();
-	const int ntris = source_geometry_indices.size() / 3;
 
-	float bmin[3], bmax[3];
-	rcCalcBounds(verts, nverts, bmin, bmax);
-
-	rcConfig cfg;
-	memset(&cfg, 0, sizeof(cfg));
-
-	cfg.cs = p_navigation_mesh->get_cell_size();
-	cfg.ch = p_navigation_mesh->get_cell_height();
-	if (p_navigation_mesh->get_border_size() > 0.0) {
-		cfg.borderSize = (int)Math::ceil(p_navigation_mesh->get_border_size() / cfg.cs);
-	}
-	cfg.walkableSlopeAngle = p_navigation_mesh->get_agent_max_slope();
-	cfg.walkableHeight = (int)Math::ceil(p_navigation_mesh->get_agent_height() / cfg.ch);
-	cfg.walkableClimb = (int)Math::floor(p_navigation_mesh->get_agent_max_climb() / cfg.ch);
-	cfg.walkableRadius = (int)Math::ceil(p_navigation_mesh->get_agent_radius() / cfg.cs);
-	cfg.maxEdgeLen = (int)(p_navigation_mesh->get_edge_max_length() / p_navigation_mesh->get_cell_size());
-	cfg.maxSimplificationError = p_navigation_mesh->get_edge_max_error();
-	cfg.minRegionArea = (int)(p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size());
-	cfg.mergeRegionArea = (int)(p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size());
-	cfg.maxVertsPerPoly = (int)p_navigation_mesh->get_vertices_per_polygon();
-	cfg.detailSampleDist = MAX(p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance(), 0.1f);
-	cfg.detailSampleMaxError = p_navigation_mesh->get_cell_height() * p_navigation_mesh->get_detail_sample_max_error();
+	p_source_geometry_data->end_deferred_geometry();
+}
 
-	if (p_navigation_mesh->get_border_size() > 0.0 && !Math::is_zero_approx(Math::fmod(p_navigation_mesh->get_border_size(), p_navigation_mesh->get_cell_size()))) {
-		WARN_PRINT("Property border_size is ceiled to cell_size voxel units and loses precision.");
-	}
-	if (!Math::is_equal_approx((float)cfg.walkableHeight * cfg.ch, p_navigation_mesh->get_agent_height())) {
+static void _generator_init_config(const Ref<NavigationMesh> &p_navigation_mesh, rcConfig &r_cfg) {
+	r_cfg.cs = p_navigation_mesh->get_cell_size();
+	r_cfg.ch = p_navigation_mesh->get_cell_height();
+	r_cfg.walkableSlopeAngle = p_navigation_mesh->get_agent_max_slope();
+	r_cfg.walkableHeight = (int)Math::ceil(p_navigation_mesh->get_agent_height() / r_cfg.ch);
+	r_cfg.walkableClimb = (int)Math::floor(p_navigation_mesh->get_agent_max_climb() / r_cfg.ch);
+	r_cfg.walkableRadius = (int)Math::ceil(p_navigation_mesh->get_agent_radius() / r_cfg.cs);
+	r_cfg.maxEdgeLen = (int)(p_navigation_mesh->get_edge_max_length() / p_navigation_mesh->get_cell_size());
+	r_cfg.maxSimplificationError = p_navigation_mesh->get_edge_max_error();
+	r_cfg.minRegionArea = (int)(p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size());
+	r_cfg.mergeRegionArea = (int)(p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size());
+	r_cfg.maxVertsPerPoly = (int)p_navigation_mesh->get_vertices_per_polygon();
+	r_cfg.detailSampleDist = MAX(p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance(), 0.1f);
+	r_cfg.detailSampleMaxError = p_navigation_mesh->get_cell_height() * p_navigation_mesh->get_detail_sample_max_error();
+
+	if (!Math::is_equal_approx((float)r_cfg.walkableHeight * r_cfg.ch, p_navigation_mesh->get_agent_height())) {
 		WARN_PRINT("Property agent_height is ceiled to cell_height voxel units and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.walkableClimb * cfg.ch, p_navigation_mesh->get_agent_max_climb())) {
+	if (!Math::is_equal_approx((float)r_cfg.walkableClimb * r_cfg.ch, p_navigation_mesh->get_agent_max_climb())) {
 		WARN_PRINT("Property agent_max_climb is floored to cell_height voxel units and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.walkableRadius * cfg.cs, p_navigation_mesh->get_agent_radius())) {
+	if (!Math::is_equal_approx((float)r_cfg.walkableRadius * r_cfg.cs, p_navigation_mesh->get_agent_radius())) {
 		WARN_PRINT("Property agent_radius is ceiled to cell_size voxel units and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.maxEdgeLen * cfg.cs, p_navigation_mesh->get_edge_max_length())) {
+	if (!Math::is_equal_approx((float)r_cfg.maxEdgeLen * r_cfg.cs, p_navigation_mesh->get_edge_max_length())) {
 		WARN_PRINT("Property edge_max_length is rounded to cell_size voxel units and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.minRegionArea, p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size())) {
+	if (!Math::is_equal_approx((float)r_cfg.minRegionArea, p_navigation_mesh->get_region_min_size() * p_navigation_mesh->get_region_min_size())) {
 		WARN_PRINT("Property region_min_size is converted to int and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.mergeRegionArea, p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size())) {
+	if (!Math::is_equal_approx((float)r_cfg.mergeRegionArea, p_navigation_mesh->get_region_merge_size() * p_navigation_mesh->get_region_merge_size())) {
 		WARN_PRINT("Property region_merge_size is converted to int and loses precision.");
 	}
-	if (!Math::is_equal_approx((float)cfg.maxVertsPerPoly, p_navigation_mesh->get_vertices_per_polygon())) {
+	if (!Math::is_equal_approx((float)r_cfg.maxVertsPerPoly, p_navigation_mesh->get_vertices_per_polygon())) {
 		WARN_PRINT("Property vertices_per_polygon is converted to int and loses precision.");
 	}
 	if (p_navigation_mesh->get_cell_size() * p_navigation_mesh->get_detail_sample_distance() < 0.1f) {
 		WARN_PRINT("Property detail_sample_distance is clamped to 0.1 world units as the resulting value from multiplying with cell_size is too low.");
 	}
+}
 
-	cfg.bmin[0] = bmin[0];
-	cfg.bmin[1] = bmin[1];
-	cfg.bmin[2] = bmin[2];
-	cfg.bmax[0] = bmax[0];
-	cfg.bmax[1] = bmax[1];
-	cfg.bmax[2] = bmax[2];
-
-	AABB baking_aabb = p_navigation_mesh->get_filter_baking_aabb();
-	if (baking_aabb.has_volume()) {
-		Vector3 baking_aabb_offset = p_navigation_mesh->get_filter_baking_aabb_offset();
-		cfg.bmin[0] = baking_aabb.position[0] + baking_aabb_offset.x;
-		cfg.bmin[1] = baking_aabb.position[1] + baking_aabb_offset.y;
-		cfg.bmin[2] = baking_aabb.position[2] + baking_aabb_offset.z;
-		cfg.bmax[0] = cfg.bmin[0] + baking_aabb.size[0];
-		cfg.bmax[1] = cfg.bmin[1] + baking_aabb.size[1];
-		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
-	}
+static bool _generator_bake_polygons(const Ref<NavigationMesh> &p_navigation_mesh, rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions, NavMeshGenerator3D::NavMeshBakeState &r_bake_state, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+	rcContext ctx;
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CALC_GRID_SIZE; // step #2
-	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CALC_GRID_SIZE; // step #2
+	rcCalcGridSize(p_cfg.bmin, p_cfg.bmax, p_cfg.cs, &p_cfg.width, &p_cfg.height);
 
 	// ~30000000 seems to be around sweetspot where Editor baking breaks
-	if ((cfg.width * cfg.height) > 30000000 && GLOBAL_GET("navigation/baking/use_crash_prevention_checks")) {
-		ERR_FAIL_MSG("Baking interrupted."
-					 "\nNavigationMesh baking process would likely crash the engine."
-					 "\nSource geometry is suspiciously big for the current Cell Size and Cell Height in the NavMesh Resource bake settings."
-					 "\nIf baking does not crash the engine or fail, the resulting NavigationMesh will create serious pathfinding performance issues."
-					 "\nIt is advised to increase Cell Size and/or Cell Height in the NavMesh Resource bake settings or reduce the size / scale of the source geometry."
-					 "\nIf you would like to try baking anyway, disable the 'navigation/baking/use_crash_prevention_checks' project setting.");
-		return;
+	if ((p_cfg.width * p_cfg.height) > 30000000 && GLOBAL_GET("navigation/baking/use_crash_prevention_checks")) {
+		ERR_FAIL_V_MSG(false, "Baking interrupted."
+							  "\nNavigationMesh baking process would likely crash the engine."
+							  "\nSource geometry is suspiciously big for the current Cell Size and Cell Height in the NavMesh Resource bake settings."
+							  "\nIf baking does not crash the engine or fail, the resulting NavigationMesh will create serious pathfinding performance issues."
+							  "\nIt is advised to increase Cell Size and/or Cell Height in the NavMesh Resource bake settings or reduce the size / scale of the source geometry."
+							  "\nIf you would like to try baking anyway, disable the 'navigation/baking/use_crash_prevention_checks' project setting.");
 	}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CREATE_HEIGHTFIELD; // step #3
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CREATE_HEIGHTFIELD; // step #3
 	hf = rcAllocHeightfield();
 
-	ERR_FAIL_NULL(hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+	ERR_FAIL_NULL_V(hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *hf, p_cfg.width, p_cfg.height, p_cfg.bmin, p_cfg.bmax, p_cfg.cs, p_cfg.ch), false);
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_MARK_WALKABLE_TRIANGLES; // step #4
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_MARK_WALKABLE_TRIANGLES; // step #4
 	{
 		Vector<unsigned char> tri_areas;
-		tri_areas.resize(ntris);
+		tri_areas.resize(p_ntris);
 
-		ERR_FAIL_COND(tri_areas.is_empty());
+		ERR_FAIL_COND_V(tri_areas.is_empty(), false);
 
-		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
+		memset(tri_areas.ptrw(), 0, p_ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, p_cfg.walkableSlopeAngle, p_verts, p_nverts, p_tris, p_ntris, tri_areas.ptrw());
 
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, p_verts, p_nverts, p_tris, tri_areas.ptr(), p_ntris, *hf, p_cfg.walkableClimb), false);
 	}
 
 	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
-		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *hf);
+		rcFilterLowHangingWalkableObstacles(&ctx, p_cfg.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_ledge_spans()) {
-		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf);
+		rcFilterLedgeSpans(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_walkable_low_height_spans()) {
-		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
+		rcFilterWalkableLowHeightSpans(&ctx, p_cfg.walkableHeight, *hf);
 	}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CONSTRUCT_COMPACT_HEIGHTFIELD; // step #5
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CONSTRUCT_COMPACT_HEIGHTFIELD; // step #5
 
 	chf = rcAllocCompactHeightfield();
 
-	ERR_FAIL_NULL(chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
+	ERR_FAIL_NULL_V(chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf, *chf), false);
 
 	rcFreeHeightField(hf);
 	hf = nullptr;
 
 	// Add obstacles to the source geometry. Those will be affected by e.g. agent_radius.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
 			if (projected_obstruction.carve) {
 				continue;
 			}
@@ -475,13 +452,13 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGenerat
 		}
 	}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_ERODE_WALKABLE_AREA; // step #6
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_ERODE_WALKABLE_AREA; // step #6
 
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, p_cfg.walkableRadius, *chf), false);
 
 	// Carve obstacles to the eroded geometry. Those will NOT be affected by e.g. agent_radius because that step is already done.
-	if (!projected_obstructions.is_empty()) {
-		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : projected_obstructions) {
+	if (!p_projected_obstructions.is_empty()) {
+		for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
 			if (!projected_obstruction.carve) {
 				continue;
 			}
@@ -496,43 +473,40 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGenerat
 		}
 	}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_SAMPLE_PARTITIONING; // step #7
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_SAMPLE_PARTITIONING; // step #7
 
 	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
 	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
 	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea));
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea), false);
 	}
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CREATING_CONTOURS; // step #8
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CREATING_CONTOURS; // step #8
 
 	cset = rcAllocContourSet();
 
-	ERR_FAIL_NULL(cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
+	ERR_FAIL_NULL_V(cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *chf, p_cfg.maxSimplificationError, p_cfg.maxEdgeLen, *cset), false);
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CREATING_POLYMESH; // step #9
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CREATING_POLYMESH; // step #9
 
 	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_NULL(poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
+	ERR_FAIL_NULL_V(poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *cset, p_cfg.maxVertsPerPoly, *poly_mesh), false);
 
 	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_NULL(detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
+	ERR_FAIL_NULL_V(detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, p_cfg.detailSampleDist, p_cfg.detailSampleMaxError, *detail_mesh), false);
 
 	rcFreeCompactHeightfield(chf);
 	chf = nullptr;
 	rcFreeContourSet(cset);
 	cset = nullptr;
 
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CONVERTING_NATIVE_NAVMESH; // step #10
-
-	Vector<Vector3> nav_vertices;
-	Vector<Vector<int>> nav_polygons;
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_CONVERTING_NATIVE_NAVMESH; // step #10
 
 	HashMap<Vector3, int> recast_vertex_to_native_index;
 	LocalVector<int> recast_index_to_native_index;
@@ -546,7 +520,7 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGenerat
 			int new_index = recast_vertex_to_native_index.size();
 			recast_index_to_native_index[i] = new_index;
 			recast_vertex_to_native_index[vertex] = new_index;
-			nav_vertices.push_back(vertex);
+			r_vertices.push_back(vertex);
 		} else {
 			recast_index_to_native_index[i] = *existing_index_ptr;
 		}
@@ -570,22 +544,579 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGenerat
 			nav_indices.write[1] = recast_index_to_native_index[index2];
 			nav_indices.write[2] = recast_index_to_native_index[index3];
 
-			nav_polygons.push_back(nav_indices);
+			r_polygons.push_back(nav_indices);
 		}
 	}
 
-	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
-
-	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_BAKE_CLEANUP; // step #11
+	r_bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_BAKE_CLEANUP; // step #11
 
 	rcFreePolyMesh(poly_mesh);
 	poly_mesh = nullptr;
 	rcFreePolyMeshDetail(detail_mesh);
 	detail_mesh = nullptr;
 
+	return true;
+}
+
+struct NavMeshTileBake3D {
+	Vector2i coords;
+	// Tile bounds on the XZ plane, without the border.
+	Rect2 rect;
+	float min_height = FLT_MAX;
+	float max_height = -FLT_MAX;
+	uint32_t hash = 0;
+	// Source geometry triangles overlapping the tile including its border.
+	LocalVector<int> triangles;
+
+	bool baked = false;
+	Vector<Vector3> vertices;
+	Vector<Vector<int>> polygons;
+};
+
+struct NavMeshTileBakeBatch3D {
+	Ref<NavigationMesh> navigation_mesh;
+	rcConfig config;
+	const float *vertices = nullptr;
+	int vertex_count = 0;
+	const int *source_indices = nullptr;
+	const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> *projected_obstructions = nullptr;
+	LocalVector<NavMeshTileBake3D> *tiles = nullptr;
+	LocalVector<uint32_t> dirty_tiles;
+};
+
+static uint32_t _generator_get_tile_settings_hash(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_cfg, float p_tile_size) {
+	uint32_t hash = hash_murmur3_one_float(p_tile_size);
+	hash = hash_murmur3_one_float(p_cfg.cs, hash);
+	hash = hash_murmur3_one_float(p_cfg.ch, hash);
+	hash = hash_murmur3_one_32(p_cfg.borderSize, hash);
+	hash = hash_murmur3_one_float(p_cfg.walkableSlopeAngle, hash);
+	hash = hash_murmur3_one_32(p_cfg.walkableHeight, hash);
+	hash = hash_murmur3_one_32(p_cfg.walkableClimb, hash);
+	hash = hash_murmur3_one_32(p_cfg.walkableRadius, hash);
+	hash = hash_murmur3_one_32(p_cfg.maxEdgeLen, hash);
+	hash = hash_murmur3_one_float(p_cfg.maxSimplificationError, hash);
+	hash = hash_murmur3_one_32(p_cfg.minRegionArea, hash);
+	hash = hash_murmur3_one_32(p_cfg.mergeRegionArea, hash);
+	hash = hash_murmur3_one_32(p_cfg.maxVertsPerPoly, hash);
+	hash = hash_murmur3_one_float(p_cfg.detailSampleDist, hash);
+	hash = hash_murmur3_one_float(p_cfg.detailSampleMaxError, hash);
+	hash = hash_murmur3_one_32(p_navigation_mesh->get_sample_partition_type(), hash);
+	hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_low_hanging_obstacles(), hash);
+	hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_ledge_spans(), hash);
+	hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_walkable_low_height_spans(), hash);
+	return hash;
+}
+
+static void _generator_bake_tile(void *p_arg, uint32_t p_index) {
+	NavMeshTileBakeBatch3D *batch = static_cast<NavMeshTileBakeBatch3D *>(p_arg);
+	NavMeshTileBake3D &tile = (*batch->tiles)[batch->dirty_tiles[p_index]];
+
+	rcConfig cfg = batch->config;
+	const float border = cfg.borderSize * cfg.cs;
+	cfg.bmin[0] = tile.rect.position.x - border;
+	cfg.bmin[1] = tile.min_height;
+	cfg.bmin[2] = tile.rect.position.y - border;
+	cfg.bmax[0] = tile.rect.position.x + tile.rect.size.x + border;
+	cfg.bmax[1] = tile.max_height;
+	cfg.bmax[2] = tile.rect.position.y + tile.rect.size.y + border;
+
+	Vector<int> tile_indices;
+	tile_indices.resize(tile.triangles.size() * 3);
+	int *tile_indices_ptrw = tile_indices.ptrw();
+	const int *source_indices = batch->source_indices;
+	for (uint32_t i = 0; i < tile.triangles.size(); i++) {
+		const int *triangle = &source_indices[tile.triangles[i] * 3];
+		tile_indices_ptrw[i * 3 + 0] = triangle[0];
+		tile_indices_ptrw[i * 3 + 1] = triangle[1];
+		tile_indices_ptrw[i * 3 + 2] = triangle[2];
+	}
+
+	NavMeshGenerator3D::NavMeshBakeState bake_state = NavMeshGenerator3D::NavMeshBakeState::BAKE_STATE_NONE;
+	tile.baked = _generator_bake_polygons(batch->navigation_mesh, cfg, batch->vertices, batch->vertex_count, tile_indices.ptr(), tile.triangles.size(), *batch->projected_obstructions, bake_state, tile.vertices, tile.polygons);
+}
+
+void NavMeshGenerator3D::generator_bake_from_source_geometry_data(NavMeshGeneratorTask3D *p_generator_task) {
+	Ref<NavigationMesh> p_navigation_mesh = p_generator_task->navigation_mesh;
+	const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data = p_generator_task->source_geometry_data;
+
+	if (p_navigation_mesh.is_null() || p_source_geometry_data.is_null()) {
+		return;
+	}
+
+	Vector<float> source_geometry_vertices;
+	Vector<int> source_geometry_indices;
+	Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> projected_obstructions;
+
+	p_source_geometry_data->get_data(
+			source_geometry_vertices,
+			source_geometry_indices,
+			projected_obstructions);
+
+	if (source_geometry_vertices.size() < 3 || source_geometry_indices.size() < 3) {
+		return;
+	}
+
+	if (p_navigation_mesh->get_tile_size() > 0.0) {
+		generator_bake_tiles(p_generator_task, source_geometry_vertices, source_geometry_indices, projected_obstructions);
+		return;
+	}
+
+	{
+		MutexLock tile_cache_lock(tile_cache_mutex);
+		tile_caches.erase(p_navigation_mesh->get_instance_id());
+	}
+
+	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CONFIGURATION; // step #1
+
+	const float *verts = source_geometry_vertices.ptr();
+	const int nverts = source_geometry_vertices.size() / 3;
+	const int *tris = source_geometry_indices.ptr();
+	const int ntris = source_geometry_indices.size() / 3;
+
+	float bmin[3], bmax[3];
+	rcCalcBounds(verts, nverts, bmin, bmax);
+
+	rcConfig cfg;
+	memset(&cfg, 0, sizeof(cfg));
+
+	_generator_init_config(p_navigation_mesh, cfg);
+
+	if (p_navigation_mesh->get_border_size() > 0.0) {
+		cfg.borderSize = (int)Math::ceil(p_navigation_mesh->get_border_size() / cfg.cs);
+	}
+	if (p_navigation_mesh->get_border_size() > 0.0 && !Math::is_zero_approx(Math::fmod(p_navigation_mesh->get_border_size(), p_navigation_mesh->get_cell_size()))) {
+		WARN_PRINT("Property border_size is ceiled to cell_size voxel units and loses precision.");
+	}
+
+	cfg.bmin[0] = bmin[0];
+	cfg.bmin[1] = bmin[1];
+	cfg.bmin[2] = bmin[2];
+	cfg.bmax[0] = bmax[0];
+	cfg.bmax[1] = bmax[1];
+	cfg.bmax[2] = bmax[2];
+
+	AABB baking_aabb = p_navigation_mesh->get_filter_baking_aabb();
+	if (baking_aabb.has_volume()) {
+		Vector3 baking_aabb_offset = p_navigation_mesh->get_filter_baking_aabb_offset();
+		cfg.bmin[0] = baking_aabb.position[0] + baking_aabb_offset.x;
+		cfg.bmin[1] = baking_aabb.position[1] + baking_aabb_offset.y;
+		cfg.bmin[2] = baking_aabb.position[2] + baking_aabb_offset.z;
+		cfg.bmax[0] = cfg.bmin[0] + baking_aabb.size[0];
+		cfg.bmax[1] = cfg.bmin[1] + baking_aabb.size[1];
+		cfg.bmax[2] = cfg.bmin[2] + baking_aabb.size[2];
+	}
+
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+
+	if (!_generator_bake_polygons(p_navigation_mesh, cfg, verts, nverts, tris, ntris, projected_obstructions, p_generator_task->bake_state, nav_vertices, nav_polygons)) {
+		return;
+	}
+
+	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+
 	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_BAKE_FINISHED; // step #12
 }
 
+void NavMeshGenerator3D::generator_bake_tiles(NavMeshGeneratorTask3D *p_generator_task, const Vector<float> &p_source_geometry_vertices, const Vector<int> &p_source_geometry_indices, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions) {
+	Ref<NavigationMesh> p_navigation_mesh = p_generator_task->navigation_mesh;
+
+	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CONFIGURATION; // step #1
+
+	const float *verts = p_source_geometry_vertices.ptr();
+	const int nverts = p_source_geometry_vertices.size() / 3;
+	const int *tris = p_source_geometry_indices.ptr();
+	const int ntris = p_source_geometry_indices.size() / 3;
+
+	NavMeshTileBakeBatch3D batch;
+	batch.navigation_mesh = p_navigation_mesh;
+	batch.vertices = verts;
+	batch.vertex_count = nverts;
+	batch.source_indices = tris;
+	batch.projected_obstructions = &p_projected_obstructions;
+
+	rcConfig &cfg = batch.config;
+	memset(&cfg, 0, sizeof(cfg));
+
+	_generator_init_config(p_navigation_mesh, cfg);
+
+	// Tiles are aligned to the cell grid so that the vertices on shared tile edges line up.
+	const float tile_size = MAX(Math::ceil(p_navigation_mesh->get_tile_size() / cfg.cs), 1.0f) * cfg.cs;
+
+	// Each tile is baked with enough context around it for the agent radius erosion to match at the tile edges.
+	cfg.borderSize = cfg.walkableRadius + 3;
+	if (p_navigation_mesh->get_border_size() > 0.0) {
+		cfg.borderSize = MAX(cfg.borderSize, (int)Math::ceil(p_navigation_mesh->get_border_size() / cfg.cs));
+	}
+	const float border = cfg.borderSize * cfg.cs;
+
+	float bmin[3], bmax[3];
+	rcCalcBounds(verts, nverts, bmin, bmax);
+	Rect2 baking_rect = Rect2(bmin[0], bmin[2], bmax[0] - bmin[0], bmax[2] - bmin[2]);
+
+	AABB baking_aabb = p_navigation_mesh->get_filter_baking_aabb();
+	const bool has_baking_aabb = baking_aabb.has_volume();
+	if (has_baking_aabb) {
+		baking_aabb.position += p_navigation_mesh->get_filter_baking_aabb_offset();
+		baking_rect = Rect2(baking_aabb.position.x, baking_aabb.position.z, baking_aabb.size.x, baking_aabb.size.z);
+	}
+
+	const int tile_x_min = (int)Math::floor(baking_rect.position.x / tile_size);
+	const int tile_z_min = (int)Math::floor(baking_rect.position.y / tile_size);
+	const int tile_x_count = MAX((int)Math::ceil((baking_rect.position.x + baking_rect.size.x) / tile_size) - tile_x_min, 1);
+	const int tile_z_count = MAX((int)Math::ceil((baking_rect.position.y + baking_rect.size.y) / tile_size) - tile_z_min, 1);
+
+	ERR_FAIL_COND_MSG((int64_t)tile_x_count * tile_z_count > 1000000, "Baking interrupted. NavigationMesh tile_size is too small for the size of the source geometry.");
+
+	LocalVector<NavMeshTileBake3D> tiles;
+	tiles.resize(tile_x_count * tile_z_count);
+
+	const uint32_t settings_hash = _generator_get_tile_settings_hash(p_navigation_mesh, cfg, tile_size);
+
+	for (int z = 0; z < tile_z_count; z++) {
+		for (int x = 0; x < tile_x_count; x++) {
+			NavMeshTileBake3D &tile = tiles[z * tile_x_count + x];
+			tile.coords = Vector2i(tile_x_min + x, tile_z_min + z);
+			tile.rect = Rect2(tile.coords.x * tile_size, tile.coords.y * tile_size, tile_size, tile_size).intersection(baking_rect);
+			tile.hash = hash_murmur3_one_real(tile.rect.position.x, settings_hash);
+			tile.hash = hash_murmur3_one_real(tile.rect.position.y, tile.hash);
+			tile.hash = hash_murmur3_one_real(tile.rect.size.x, tile.hash);
+			tile.hash = hash_murmur3_one_real(tile.rect.size.y, tile.hash);
+		}
+	}
+
+	// Assign every source triangle to the tiles it overlaps, including their border, and hash it into them.
+	for (int i = 0; i < ntris; i++) {
+		float triangle_verts[9];
+		float min_x = FLT_MAX, min_y = FLT_MAX, min_z = FLT_MAX;
+		float max_x = -FLT_MAX, max_y = -FLT_MAX, max_z = -FLT_MAX;
+		for (int j = 0; j < 3; j++) {
+			const float *v = &verts[tris[i * 3 + j] * 3];
+			triangle_verts[j * 3 + 0] = v[0];
+			triangle_verts[j * 3 + 1] = v[1];
+			triangle_verts[j * 3 + 2] = v[2];
+			min_x = MIN(min_x, v[0]);
+			min_y = MIN(min_y, v[1]);
+			min_z = MIN(min_z, v[2]);
+			max_x = MAX(max_x, v[0]);
+			max_y = MAX(max_y, v[1]);
+			max_z = MAX(max_z, v[2]);
+		}
+
+		const int x_begin = MAX((int)Math::floor((min_x - border) / tile_size) - tile_x_min, 0);
+		const int x_end = MIN((int)Math::floor((max_x + border) / tile_size) - tile_x_min, tile_x_count - 1);
+		const int z_begin = MAX((int)Math::floor((min_z - border) / tile_size) - tile_z_min, 0);
+		const int z_end = MIN((int)Math::floor((max_z + border) / tile_size) - tile_z_min, tile_z_count - 1);
+
+		for (int z = z_begin; z <= z_end; z++) {
+			for (int x = x_begin; x <= x_end; x++) {
+				NavMeshTileBake3D &tile = tiles[z * tile_x_count + x];
+				tile.triangles.push_back(i);
+				tile.min_height = MIN(tile.min_height, min_y);
+				tile.max_height = MAX(tile.max_height, max_y);
+				tile.hash = hash_murmur3_buffer(triangle_verts, sizeof(triangle_verts), tile.hash);
+			}
+		}
+	}
+
+	for (const NavigationMeshSourceGeometryData3D::ProjectedObstruction &projected_obstruction : p_projected_obstructions) {
+		if (projected_obstruction.vertices.is_empty() || projected_obstruction.vertices.size() % 3 != 0) {
+			continue;
+		}
+
+		float min_x = FLT_MAX, min_z = FLT_MAX;
+		float max_x = -FLT_MAX, max_z = -FLT_MAX;
+		for (int j = 0; j < projected_obstruction.vertices.size(); j += 3) {
+			min_x = MIN(min_x, projected_obstruction.vertices[j + 0]);
+			min_z = MIN(min_z, projected_obstruction.vertices[j + 2]);
+			max_x = MAX(max_x, projected_obstruction.vertices[j + 0]);
+			max_z = MAX(max_z, projected_obstruction.vertices[j + 2]);
+		}
+
+		const int x_begin = MAX((int)Math::floor((min_x - border) / tile_size) - tile_x_min, 0);
+		const int x_end = MIN((int)Math::floor((max_x + border) / tile_size) - tile_x_min, tile_x_count - 1);
+		const int z_begin = MAX((int)Math::floor((min_z - border) / tile_size) - tile_z_min, 0);
+		const int z_end = MIN((int)Math::floor((max_z + border) / tile_size) - tile_z_min, tile_z_count - 1);
+
+		for (int z = z_begin; z <= z_end; z++) {
+			for (int x = x_begin; x <= x_end; x++) {
+				NavMeshTileBake3D &tile = tiles[z * tile_x_count + x];
+				tile.hash = hash_murmur3_buffer(projected_obstruction.vertices.ptr(), projected_obstruction.vertices.size() * sizeof(float), tile.hash);
+				tile.hash = hash_murmur3_one_float(projected_obstruction.elevation, tile.hash);
+				tile.hash = hash_murmur3_one_float(projected_obstruction.height, tile.hash);
+				tile.hash = hash_murmur3_one_32(projected_obstruction.carve, tile.hash);
+			}
+		}
+	}
+
+	// The cache may be read by other bakes and pruned by sync(), so it's only accessed while locked.
+	{
+		MutexLock tile_cache_lock(tile_cache_mutex);
+		const NavMeshTileCache3D *tile_cache = tile_caches.getptr(p_navigation_mesh->get_instance_id());
+
+		// Only tiles that have no up to date bake result are baked again.
+		for (uint32_t i = 0; i < tiles.size(); i++) {
+			NavMeshTileBake3D &tile = tiles[i];
+			if (tile.triangles.is_empty() || !tile.rect.has_area()) {
+				continue;
+			}
+
+			// Snap the height range to the cell grid so that all tiles quantize heights the same way.
+			if (has_baking_aabb) {
+				tile.min_height = baking_aabb.position.y;
+				tile.max_height = baking_aabb.position.y + baking_aabb.size.y;
+			} else {
+				tile.min_height = Math::floor(tile.min_height / cfg.ch) * cfg.ch;
+				tile.max_height = Math::ceil(tile.max_height / cfg.ch) * cfg.ch + cfg.ch;
+			}
+			tile.hash = hash_murmur3_one_float(tile.min_height, tile.hash);
+			tile.hash = hash_fmix32(hash_murmur3_one_float(tile.max_height, tile.hash));
+
+			const NavMeshTile3D *cached_tile = tile_cache ? tile_cache->tiles.getptr(tile.coords) : nullptr;
+			if (cached_tile && cached_tile->hash == tile.hash) {
+				continue;
+			}
+			batch.dirty_tiles.push_back(i);
+		}
+	}
+
+	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_SAMPLE_PARTITIONING;
+
+	batch.tiles = &tiles;
+	// Async bakes already run on the pool, waiting there for a nested group task could starve it,
+	// so tiles are only baked in parallel when called from outside of the pool.
+	if (use_threads && batch.dirty_tiles.size() > 1 && WorkerThreadPool::get_singleton()->get_thread_index() == -1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&_generator_bake_tile, &batch, batch.dirty_tiles.size(), -1, true, SNAME("NavMeshGeneratorBakeTiles3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < batch.dirty_tiles.size(); i++) {
+			_generator_bake_tile(&batch, i);
+		}
+	}
+
+	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_CONVERTING_NATIVE_NAVMESH; // step #10
+
+	// Swap the newly baked tiles into the cache and merge all tiles into the navigation mesh.
+	HashMap<Vector2i, NavMeshTile3D> baked_tiles;
+	for (uint32_t dirty_tile_index : batch.dirty_tiles) {
+		NavMeshTileBake3D &tile = tiles[dirty_tile_index];
+		if (!tile.baked) {
+			continue;
+		}
+		NavMeshTile3D &baked_tile = baked_tiles[tile.coords];
+		baked_tile.hash = tile.hash;
+		baked_tile.vertices = tile.vertices;
+		baked_tile.polygons = tile.polygons;
+	}
+	baked_tile_count.add(baked_tiles.size());
+
+	{
+		MutexLock tile_cache_lock(tile_cache_mutex);
+		NavMeshTileCache3D &tile_cache = tile_caches[p_navigation_mesh->get_instance_id()];
+		for (const NavMeshTileBake3D &tile : tiles) {
+			if (tile.triangles.is_empty() || !tile.rect.has_area() || baked_tiles.has(tile.coords)) {
+				continue;
+			}
+			const NavMeshTile3D *cached_tile = tile_cache.tiles.getptr(tile.coords);
+			if (cached_tile && cached_tile->hash == tile.hash) {
+				baked_tiles[tile.coords] = *cached_tile;
+			}
+		}
+		tile_cache.tiles = baked_tiles;
+	}
+
+	// Merge from the local copy, the tile data is shared with the cache and isn't copied.
+	LocalVector<const NavMeshTile3D *> merged_tiles;
+	for (const NavMeshTileBake3D &tile : tiles) {
+		const NavMeshTile3D *baked_tile = baked_tiles.getptr(tile.coords);
+		if (baked_tile) {
+			merged_tiles.push_back(baked_tile);
+		}
+	}
+
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	generator_merge_tiles(merged_tiles, tile_size, cfg.cs, MAX(cfg.walkableClimb, 1) * cfg.ch, nav_vertices, nav_polygons);
+
+	p_navigation_mesh->set_data(nav_vertices, nav_polygons);
+
+	p_generator_task->bake_state = NavMeshBakeState::BAKE_STATE_BAKE_FINISHED; // step #12
+}
+
+// Returns true if the vertex lies on a tile edge, with p_axis 0 for edges at a constant X and 1 for edges at a constant Z.
+// r_line identifies the edge line, r_position is the position of the vertex along it.
+static bool _generator_get_seam_line(const Vector3 &p_vertex, int p_axis, float p_tile_size, float p_epsilon, Vector2i &r_line, float &r_position) {
+	const float coord = p_axis == 0 ? p_vertex.x : p_vertex.z;
+	const int line = (int)Math::round(coord / p_tile_size);
+	if (Math::abs(coord - line * p_tile_size) > p_epsilon) {
+		return false;
+	}
+	r_line = Vector2i(p_axis, line);
+	r_position = p_axis == 0 ? p_vertex.z : p_vertex.x;
+	return true;
+}
+
+// Returns the index of the sorted seam position closest to p_position.
+static int _generator_find_seam_position(const LocalVector<float> &p_positions, float p_position) {
+	int low = 0;
+	int high = (int)p_positions.size() - 1;
+	while (low < high) {
+		const int middle = (low + high) / 2;
+		if (p_positions[middle] < p_position) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	if (low > 0 && p_position - p_positions[low - 1] < p_positions[low] - p_position) {
+		return low - 1;
+	}
+	return low;
+}
+
+void NavMeshGenerator3D::generator_merge_tiles(const LocalVector<const NavMeshTile3D *> &p_tiles, float p_tile_size, float p_cell_size, float p_max_climb, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	// Neighboring tiles are baked on their own, so the vertices they place on their shared edge don't match:
+	// each side samples its detail mesh differently, and heights differ on uneven ground.
+	// Every polygon edge on a tile edge (seam) is split at the seam vertices of all tiles, and seam vertices
+	// at the same spot that are within climbing height of each other are welded, so the polygons on both
+	// sides of a seam share their edges and the region connects them.
+	const float seam_epsilon = p_cell_size * 0.25f;
+
+	HashMap<Vector2i, LocalVector<float>> seam_positions;
+	for (const NavMeshTile3D *tile : p_tiles) {
+		for (const Vector3 &vertex : tile->vertices) {
+			for (int axis = 0; axis < 2; axis++) {
+				Vector2i line;
+				float position;
+				if (_generator_get_seam_line(vertex, axis, p_tile_size, seam_epsilon, line, position)) {
+					seam_positions[line].push_back(position);
+				}
+			}
+		}
+	}
+	for (KeyValue<Vector2i, LocalVector<float>> &E : seam_positions) {
+		LocalVector<float> &positions = E.value;
+		positions.sort();
+		uint32_t position_count = 0;
+		for (uint32_t i = 0; i < positions.size(); i++) {
+			if (position_count == 0 || positions[i] - positions[position_count - 1] > seam_epsilon) {
+				positions[position_count++] = positions[i];
+			}
+		}
+		positions.resize(position_count);
+	}
+
+	HashMap<Vector3, int> vertex_to_index;
+	HashMap<Vector3i, LocalVector<int>> seam_vertex_to_indices;
+
+	for (const NavMeshTile3D *tile : p_tiles) {
+		LocalVector<Vector3> tile_vertices;
+		tile_vertices.resize(tile->vertices.size());
+		for (int i = 0; i < tile->vertices.size(); i++) {
+			tile_vertices[i] = tile->vertices[i];
+		}
+
+		// Split the seam edges at the seam vertices of the other tiles.
+		LocalVector<LocalVector<int>> tile_polygons;
+		tile_polygons.resize(tile->polygons.size());
+		for (int i = 0; i < tile->polygons.size(); i++) {
+			const Vector<int> &polygon = tile->polygons[i];
+			LocalVector<int> &split_polygon = tile_polygons[i];
+			for (int j = 0; j < polygon.size(); j++) {
+				split_polygon.push_back(polygon[j]);
+
+				const Vector3 vertex_a = tile_vertices[polygon[j]];
+				const Vector3 vertex_b = tile_vertices[polygon[(j + 1) % polygon.size()]];
+				for (int axis = 0; axis < 2; axis++) {
+					Vector2i line_a, line_b;
+					float position_a, position_b;
+					if (!_generator_get_seam_line(vertex_a, axis, p_tile_size, seam_epsilon, line_a, position_a) || !_generator_get_seam_line(vertex_b, axis, p_tile_size, seam_epsilon, line_b, position_b) || line_a != line_b) {
+						continue;
+					}
+
+					const LocalVector<float> &positions = seam_positions[line_a];
+					const int index_a = _generator_find_seam_position(positions, position_a);
+					const int index_b = _generator_find_seam_position(positions, position_b);
+					const int step = index_a < index_b ? 1 : -1;
+					for (int k = index_a + step; k != index_b && index_a != index_b; k += step) {
+						Vector3 split_vertex = vertex_a.lerp(vertex_b, (positions[k] - position_a) / (position_b - position_a));
+						if (axis == 0) {
+							split_vertex.z = positions[k];
+						} else {
+							split_vertex.x = positions[k];
+						}
+						split_polygon.push_back(tile_vertices.size());
+						tile_vertices.push_back(split_vertex);
+					}
+					break;
+				}
+			}
+		}
+
+		LocalVector<int> tile_index_to_index;
+		tile_index_to_index.resize(tile_vertices.size());
+		for (uint32_t i = 0; i < tile_vertices.size(); i++) {
+			const Vector3 &vertex = tile_vertices[i];
+
+			Vector3i seam_key;
+			bool on_seam = false;
+			for (int axis = 0; axis < 2 && !on_seam; axis++) {
+				Vector2i line;
+				float position;
+				if (_generator_get_seam_line(vertex, axis, p_tile_size, seam_epsilon, line, position)) {
+					seam_key = Vector3i(line.x, line.y, _generator_find_seam_position(seam_positions[line], position));
+					on_seam = true;
+				}
+			}
+
+			if (on_seam) {
+				LocalVector<int> &seam_indices = seam_vertex_to_indices[seam_key];
+				int index = -1;
+				for (int seam_index : seam_indices) {
+					if (Math::abs(r_vertices[seam_index].y - vertex.y) <= p_max_climb) {
+						index = seam_index;
+						break;
+					}
+				}
+				if (index == -1) {
+					index = r_vertices.size();
+					seam_indices.push_back(index);
+					r_vertices.push_back(vertex);
+				}
+				tile_index_to_index[i] = index;
+				continue;
+			}
+
+			int *existing_index_ptr = vertex_to_index.getptr(vertex);
+			if (!existing_index_ptr) {
+				int new_index = r_vertices.size();
+				tile_index_to_index[i] = new_index;
+				vertex_to_index[vertex] = new_index;
+				r_vertices.push_back(vertex);
+			} else {
+				tile_index_to_index[i] = *existing_index_ptr;
+			}
+		}
+
+		for (const LocalVector<int> &tile_polygon : tile_polygons) {
+			// Welding can collapse neighboring vertices of a polygon into one.
+			Vector<int> nav_indices;
+			for (int tile_index : tile_polygon) {
+				const int index = tile_index_to_index[tile_index];
+				if (nav_indices.is_empty() || nav_indices[nav_indices.size() - 1] != index) {
+					nav_indices.push_back(index);
+				}
+			}
+			if (nav_indices.size() > 1 && nav_indices[0] == nav_indices[nav_indices.size() - 1]) {
+				nav_indices.resize(nav_indices.size() - 1);
+			}
+			if (nav_indices.size() >= 3) {
+				r_polygons.push_back(nav_indices);
+			}
+		}
+	}
+}
+
 bool NavMeshGenerator3D::generator_emit_callback(const Callable &p_callback) {
 	ERR_FAIL_COND_V(!p_callback.is_valid(), false);
 
@@ -33,6 +33,7 @@
 #include "core/object/class_db.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/templates/rid_owner.h"
+#include "core/templates/safe_refcount.h"
 #include "servers/navigation_3d/navigation_server_3d.h"
 
 class Node;
@@ -97,9 +98,27 @@ private:
 
 	static HashMap<Ref<NavigationMesh>, NavMeshGeneratorTask3D *> baking_navmeshes;
 
+	struct NavMeshTile3D {
+		// Hash of the bake settings and all source geometry overlapping the tile when it was baked.
+		uint32_t hash = 0;
+		Vector<Vector3> vertices;
+		Vector<Vector<int>> polygons;
+	};
+
+	struct NavMeshTileCache3D {
+		HashMap<Vector2i, NavMeshTile3D> tiles;
+	};
+
+	// Last baked tiles of navigation meshes with a tile size, so that a rebake only needs to bake the tiles that changed.
+	static Mutex tile_cache_mutex;
+	static HashMap<ObjectID, NavMeshTileCache3D> tile_caches;
+	static SafeNumeric<uint32_t> baked_tile_count;
+
 	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
 	static void generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node);
 	static void generator_bake_from_source_geometry_data(NavMeshGeneratorTask3D *p_generator_task);
+	static void generator_bake_tiles(NavMeshGeneratorTask3D *p_generator_task, const Vector<float> &p_source_geometry_vertices, const Vector<int> &p_source_geometry_indices, const Vector<NavigationMeshSourceGeometryData3D::ProjectedObstruction> &p_projected_obstructions);
+	static void generator_merge_tiles(const LocalVector<const NavMeshTile3D *> &p_tiles, float p_tile_size, float p_cell_size, float p_max_climb, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
 
 	static bool generator_emit_callback(const Callable &p_callback);
 
@@ -107,6 +126,8 @@ public:
 	static NavMeshGenerator3D *get_singleton();
 
 	static void sync();
+	// Returns the number of tiles baked since the last call.
+	static uint32_t take_baked_tile_count();
 	static void cleanup();
 	static void finish();
 
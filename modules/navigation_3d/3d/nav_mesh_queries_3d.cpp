@@ -41,6 +41,120 @@ using namespace Nav3D;
 
 #define THREE_POINTS_CROSS_PRODUCT(m_a, m_b, m_c) (((m_c) - (m_a)).cross((m_b) - (m_a)))
 
+static _FORCE_INLINE_ real_t _aabb_distance_squared_to_point(const AABB &p_aabb, const Vector3 &p_point) {
+	return p_point.clamp(p_aabb.position, p_aabb.position + p_aabb.size).distance_squared_to(p_point);
+}
+
+// Visits the polygons of the BVH in leaves that are not farther away than `p_max_distance_squared`, nearest nodes first.
+// `p_node_distance_squared` returns a lower bound of the squared distance to anything inside a node box.
+// The visitor is expected to lower `p_max_distance_squared` as it finds closer polygons.
+template <typename NodeDistance, typename Visitor>
+static void _polygon_bvh_visit(const PolygonBVH &p_bvh, NodeDistance p_node_distance_squared, const real_t &p_max_distance_squared, Visitor p_visitor) {
+	if (p_bvh.nodes.is_empty()) {
+		return;
+	}
+
+	// The tree is split at the median, so its depth stays far below the size of the stack.
+	uint32_t node_stack[64];
+	uint32_t node_stack_size = 0;
+	node_stack[node_stack_size++] = 0;
+
+	while (node_stack_size > 0) {
+		const PolygonBVHNode &node = p_bvh.nodes[node_stack[--node_stack_size]];
+		if (p_node_distance_squared(node.aabb) > p_max_distance_squared) {
+			continue;
+		}
+
+		if (node.count > 0) {
+			for (uint32_t i = node.first; i < node.first + node.count; i++) {
+				p_visitor(*p_bvh.polygons[i], p_bvh.polygon_ids[i]);
+			}
+			continue;
+		}
+
+		ERR_FAIL_COND(node_stack_size + 2 > 64);
+		const real_t first_distance = p_node_distance_squared(p_bvh.nodes[node.first].aabb);
+		const real_t second_distance = p_node_distance_squared(p_bvh.nodes[node.first + 1].aabb);
+		// Push the farther child first so that the nearer one is visited first.
+		if (first_distance <= second_distance) {
+			node_stack[node_stack_size++] = node.first + 1;
+			node_stack[node_stack_size++] = node.first;
+		} else {
+			node_stack[node_stack_size++] = node.first;
+			node_stack[node_stack_size++] = node.first + 1;
+		}
+	}
+}
+
+// Returns the squared distance from `p_point` to the polygon, and the closest point and unnormalized plane normal of the polygon.
+static real_t _polygon_get_closest_point(const Polygon &p_polygon, const Vector3 &p_point, Vector3 &r_closest_point, Vector3 &r_normal) {
+	const LocalVector<Vector3> &vertices = p_polygon.vertices;
+	const Vector3 plane_normal = (vertices[1] - vertices[0]).cross(vertices[2] - vertices[0]);
+	r_normal = plane_normal;
+
+	Vector3 closest_on_polygon;
+	real_t closest = FLT_MAX;
+	bool inside = true;
+	Vector3 previous = vertices[vertices.size() - 1];
+	for (uint32_t point_id = 0; point_id < vertices.size(); ++point_id) {
+		Vector3 edge = vertices[point_id] - previous;
+		Vector3 to_point = p_point - previous;
+		Vector3 edge_to_point_normal = edge.cross(to_point);
+		bool clockwise = edge_to_point_normal.dot(plane_normal) > 0;
+		// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
+		if (!clockwise) {
+			inside = false;
+			real_t point_projected_on_edge = edge.dot(to_point);
+			real_t edge_square = edge.length_squared();
+
+			if (point_projected_on_edge > edge_square) {
+				real_t distance = vertices[point_id].distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = vertices[point_id];
+					closest = distance;
+				}
+			} else if (point_projected_on_edge < 0.f) {
+				real_t distance = previous.distance_squared_to(p_point);
+				if (distance < closest) {
+					closest_on_polygon = previous;
+					closest = distance;
+				}
+			} else {
+				// If we project on this edge, this will be the closest point.
+				real_t percent = point_projected_on_edge / edge_square;
+				closest_on_polygon = previous + percent * edge;
+				break;
+			}
+		}
+		previous = vertices[point_id];
+	}
+
+	if (inside) {
+		Vector3 plane_normalized = plane_normal.normalized();
+		real_t distance = plane_normalized.dot(p_point - vertices[0]);
+		r_closest_point = p_point - plane_normalized * distance;
+		return distance * distance;
+	}
+
+	r_closest_point = closest_on_polygon;
+	return closest_on_polygon.distance_squared_to(p_point);
+}
+
+// Calls `p_visitor` with every internal and external connection that leaves the polygon.
+template <typename Visitor>
+static void _polygon_visit_connections(const NavMapIteration3D &p_map_iteration, uint32_t p_polygon_id, const Polygon &p_polygon, Visitor p_visitor) {
+	const LocalVector<LocalVector<Connection>> &internal_connections = p_polygon.owner->get_internal_connections();
+	if (p_polygon.id < internal_connections.size()) {
+		for (const Connection &connection : internal_connections[p_polygon.id]) {
+			p_visitor(connection);
+		}
+	}
+
+	for (const Connection &connection : p_map_iteration.polygon_external_connections.get_polygon_connections(p_polygon_id)) {
+		p_visitor(connection);
+	}
+}
+
 bool NavMeshQueries3D::emit_callback(const Callable &p_callback) {
 	ERR_FAIL_COND_V(!p_callback.is_valid(), false);
 
@@ -150,130 +264,151 @@ void NavMeshQueries3D::map_query_path(NavMap3D *map, const Ref<NavigationPathQue
 	ERR_FAIL_COND(p_query_parameters.is_null());
 	ERR_FAIL_COND(p_query_result.is_null());
 
-	using namespace NavigationDefaults3D;
-
 	NavMeshQueries3D::NavMeshPathQueryTask3D query_task;
-	query_task.start_position = p_query_parameters->get_start_position();
-	query_task.target_position = p_query_parameters->get_target_position();
-	query_task.navigation_layers = p_query_parameters->get_navigation_layers();
+	query_task_set_parameters(query_task, p_query_parameters);
 	query_task.callback = p_callback;
 
+	map->query_path(query_task);
+
+	query_task_get_result(query_task, p_query_result);
+
+	if (query_task.callback.is_valid()) {
+		if (emit_callback(query_task.callback)) {
+			query_task.status = NavMeshPathQueryTask3D::TaskStatus::CALLBACK_DISPATCHED;
+		} else {
+			query_task.status = NavMeshPathQueryTask3D::TaskStatus::CALLBACK_FAILED;
+		}
+	}
+}
+
+void NavMeshQueries3D::map_query_path_batch(NavMap3D *p_map, const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const LocalVector<uint32_t> &p_query_indices) {
+	ERR_FAIL_NULL(p_map);
+
+	LocalVector<NavMeshPathQueryTask3D> query_tasks;
+	query_tasks.resize(p_query_indices.size());
+	for (uint32_t i = 0; i < p_query_indices.size(); i++) {
+		query_task_set_parameters(query_tasks[i], p_query_parameters[p_query_indices[i]]);
+	}
+
+	p_map->query_path_batch(query_tasks);
+
+	for (uint32_t i = 0; i < p_query_indices.size(); i++) {
+		query_task_get_result(query_tasks[i], p_query_results[p_query_indices[i]]);
+	}
+}
+
+void NavMeshQueries3D::query_task_set_parameters(NavMeshPathQueryTask3D &r_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters) {
+	using namespace NavigationDefaults3D;
+
+	r_query_task.start_position = p_query_parameters->get_start_position();
+	r_query_task.target_position = p_query_parameters->get_target_position();
+	r_query_task.navigation_layers = p_query_parameters->get_navigation_layers();
+
 	const TypedArray<RID> &_excluded_regions = p_query_parameters->get_excluded_regions();
 	const TypedArray<RID> &_included_regions = p_query_parameters->get_included_regions();
 
 	uint32_t _excluded_region_count = _excluded_regions.size();
 	uint32_t _included_region_count = _included_regions.size();
 
-	query_task.exclude_regions = _excluded_region_count > 0;
-	query_task.include_regions = _included_region_count > 0;
+	r_query_task.exclude_regions = _excluded_region_count > 0;
+	r_query_task.include_regions = _included_region_count > 0;
 
-	if (query_task.exclude_regions) {
-		query_task.excluded_regions.resize(_excluded_region_count);
+	if (r_query_task.exclude_regions) {
+		r_query_task.excluded_regions.resize(_excluded_region_count);
 		for (uint32_t i = 0; i < _excluded_region_count; i++) {
-			query_task.excluded_regions[i] = _excluded_regions[i];
+			r_query_task.excluded_regions[i] = _excluded_regions[i];
 		}
 	}
 
-	if (query_task.include_regions) {
-		query_task.included_regions.resize(_included_region_count);
+	if (r_query_task.include_regions) {
+		r_query_task.included_regions.resize(_included_region_count);
 		for (uint32_t i = 0; i < _included_region_count; i++) {
-			query_task.included_regions[i] = _included_regions[i];
+			r_query_task.included_regions[i] = _included_regions[i];
 		}
 	}
 
 	switch (p_query_parameters->get_pathfinding_algorithm()) {
 		case NavigationPathQueryParameters3D::PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR: {
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathfindingAlgorithm - fallback to default");
-			query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
+			r_query_task.pathfinding_algorithm = PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR;
 		} break;
 	}
 
 	switch (p_query_parameters->get_path_postprocessing()) {
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED;
 		} break;
 		case NavigationPathQueryParameters3D::PathPostProcessing::PATH_POSTPROCESSING_NONE: {
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_NONE;
 		} break;
 		default: {
 			WARN_PRINT("No match for used PathPostProcessing - fallback to default");
-			query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
+			r_query_task.path_postprocessing = PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL;
 		} break;
 	}
 
-	query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
-	query_task.simplify_path = p_query_parameters->get_simplify_path();
-	query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
-	query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
-	query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
-	query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
-	query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
-	query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
-
-	map->query_path(query_task);
+	r_query_task.metadata_flags = (int64_t)p_query_parameters->get_metadata_flags();
+	r_query_task.simplify_path = p_query_parameters->get_simplify_path();
+	r_query_task.simplify_epsilon = p_query_parameters->get_simplify_epsilon();
+	r_query_task.path_return_max_length = p_query_parameters->get_path_return_max_length();
+	r_query_task.path_return_max_radius = p_query_parameters->get_path_return_max_radius();
+	r_query_task.path_search_max_polygons = p_query_parameters->get_path_search_max_polygons();
+	r_query_task.path_search_max_distance = p_query_parameters->get_path_search_max_distance();
+	r_query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+}
 
+void NavMeshQueries3D::query_task_get_result(const NavMeshPathQueryTask3D &p_query_task, Ref<NavigationPathQueryResult3D> p_query_result) {
 	p_query_result->set_data(
-			query_task.path_points,
-			query_task.path_meta_point_types,
-			query_task.path_meta_point_rids,
-			query_task.path_meta_point_owners);
-	p_query_result->set_path_length(query_task.path_length);
-
-	if (query_task.callback.is_valid()) {
-		if (emit_callback(query_task.callback)) {
-			query_task.status = NavMeshPathQueryTask3D::TaskStatus::CALLBACK_DISPATCHED;
-		} else {
-			query_task.status = NavMeshPathQueryTask3D::TaskStatus::CALLBACK_FAILED;
-		}
-	}
+			p_query_task.path_points,
+			p_query_task.path_meta_point_types,
+			p_query_task.path_meta_point_rids,
+			p_query_task.path_meta_point_owners);
+	p_query_result->set_path_length(p_query_task.path_length);
 }
 
 void NavMeshQueries3D::_query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
-	real_t begin_d = FLT_MAX;
-	real_t end_d = FLT_MAX;
-
-	const LocalVector<Ref<NavRegionIteration3D>> &regions = p_map_iteration.region_iterations;
-
-	for (const Ref<NavRegionIteration3D> &region : regions) {
-		if (!_query_task_is_connection_owner_usable(p_query_task, region.ptr())) {
-			continue;
-		}
-
-		// Find the initial poly and the end poly on this map.
-		for (const Polygon &p : region->get_navmesh_polygons()) {
-			// Only consider the polygon if it in a region with compatible layers.
-			if ((p_query_task.navigation_layers & p.owner->get_navigation_layers()) == 0) {
-				continue;
-			}
-
-			// For each face check the distance between the origin/destination.
-			for (uint32_t point_id = 2; point_id < p.vertices.size(); point_id++) {
-				const Face3 face(p.vertices[0], p.vertices[point_id - 1], p.vertices[point_id]);
+	_query_task_find_closest_polygon(p_query_task, p_map_iteration, p_query_task.start_position, p_query_task.begin_polygon, p_query_task.begin_position);
+	_query_task_find_closest_polygon(p_query_task, p_map_iteration, p_query_task.target_position, p_query_task.end_polygon, p_query_task.end_position);
+}
 
-				Vector3 point = face.get_closest_point_to(p_query_task.start_position);
-				real_t distance_to_point = point.distance_to(p_query_task.start_position);
-				if (distance_to_point < begin_d) {
-					begin_d = distance_to_point;
-					p_query_task.begin_polygon = &p;
-					p_query_task.begin_position = point;
+void NavMeshQueries3D::_query_task_find_closest_polygon(const NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration, const Vector3 &p_point, const Polygon *&r_polygon, Vector3 &r_position) {
+	real_t closest_distance_squared = FLT_MAX;
+	uint32_t closest_polygon_id = UINT32_MAX;
+
+	_polygon_bvh_visit(
+			p_map_iteration.polygon_bvh,
+			[&p_point](const AABB &p_aabb) { return _aabb_distance_squared_to_point(p_aabb, p_point); },
+			closest_distance_squared,
+			[&](const Polygon &p_polygon, uint32_t p_polygon_id) {
+				// Only consider the polygon if it is in a usable region with compatible layers.
+				if ((p_query_task.navigation_layers & p_polygon.owner->get_navigation_layers()) == 0) {
+					return;
+				}
+				if (!_query_task_is_connection_owner_usable(p_query_task, p_polygon.owner)) {
+					return;
 				}
 
-				point = face.get_closest_point_to(p_query_task.target_position);
-				distance_to_point = point.distance_to(p_query_task.target_position);
-				if (distance_to_point < end_d) {
-					end_d = distance_to_point;
-					p_query_task.end_polygon = &p;
-					p_query_task.end_position = point;
+				// For each face check the distance to the point.
+				for (uint32_t point_id = 2; point_id < p_polygon.vertices.size(); point_id++) {
+					const Face3 face(p_polygon.vertices[0], p_polygon.vertices[point_id - 1], p_polygon.vertices[point_id]);
+
+					const Vector3 point = face.get_closest_point_to(p_point);
+					const real_t distance_squared = point.distance_squared_to(p_point);
+					// Ties go to the lowest map polygon id, the same polygon that a scan over all regions would pick.
+					if (distance_squared < closest_distance_squared || (distance_squared == closest_distance_squared && p_polygon_id < closest_polygon_id)) {
+						closest_distance_squared = distance_squared;
+						closest_polygon_id = p_polygon_id;
+						r_polygon = &p_polygon;
+						r_position = point;
+					}
 				}
-			}
-		}
-	}
+			});
 }
 
 void NavMeshQueries3D::_query_task_search_polygon_connections(NavMeshPathQueryTask3D &p_query_task, const Connection &p_connection, uint32_t p_least_cost_id, const NavigationPoly &p_least_cost_poly, real_t p_poly_enter_cost, const Vector3 &p_end_point) {
@@ -293,8 +428,18 @@ void NavMeshQueries3D::_query_task_search_polygon_connections(NavMeshPathQueryTa
 	Vector3 new_entry = Geometry3D::get_closest_point_to_segment(p_least_cost_poly.entry, p_connection.pathway_start, p_connection.pathway_end);
 	real_t new_traveled_distance = p_least_cost_poly.entry.distance_to(new_entry) * poly_travel_cost + p_poly_enter_cost + p_least_cost_poly.traveled_distance;
 
+	const uint32_t neighbor_poly_id = p_query_task.path_query_slot->poly_to_id[p_connection.polygon];
+
+	// Stay inside the clusters that the hierarchical search passed through.
+	if (p_query_task.hierarchy_polygon_clusters) {
+		const uint32_t neighbor_cluster = (*p_query_task.hierarchy_polygon_clusters)[neighbor_poly_id];
+		if (p_query_task.path_query_slot->hierarchy_cluster_stamps[neighbor_cluster] != p_query_task.path_query_slot->hierarchy_stamp) {
+			return;
+		}
+	}
+
 	// Check if the neighbor polygon has already been processed.
-	NavigationPoly &neighbor_poly = navigation_polys[p_query_task.path_query_slot->poly_to_id[p_connection.polygon]];
+	NavigationPoly &neighbor_poly = navigation_polys[neighbor_poly_id];
 	if (new_traveled_distance < neighbor_poly.traveled_distance) {
 		// Add the polygon to the heap of polygons to traverse next.
 		neighbor_poly.back_navigation_poly_id = p_least_cost_id;
@@ -350,7 +495,7 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 	bool is_reachable = true;
 	real_t poly_enter_cost = 0.0;
 
-	const HashMap<const NavBaseIteration3D *, LocalVector<LocalVector<Nav3D::Connection>>> &navbases_polygons_external_connections = p_map_iteration.navbases_polygons_external_connections;
+	const PolygonConnections &polygon_external_connections = p_map_iteration.polygon_external_connections;
 
 	// True if we reached the max polygon search count or distance from the begin position.
 	bool path_search_max_reached = false;
@@ -366,8 +511,6 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 	while (true) {
 		const NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 
-		const NavBaseIteration3D *least_cost_navbase = least_cost_poly.poly->owner;
-
 		processed_polygon_count += 1;
 
 		const uint32_t navbase_local_polygon_id = least_cost_poly.poly->id;
@@ -382,7 +525,7 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 		}
 
 		// Search region external navmesh polygon connections, aka connections to other regions created by outline edge merge or links.
-		for (const Connection &connection : navbases_polygons_external_connections[least_cost_navbase][navbase_local_polygon_id]) {
+		for (const Connection &connection : polygon_external_connections.get_polygon_connections(least_cost_id)) {
 			_query_task_search_polygon_connections(p_query_task, connection, least_cost_id, least_cost_poly, poly_enter_cost, end_point);
 		}
 
@@ -511,6 +654,201 @@ void NavMeshQueries3D::_query_task_build_path_corridor(NavMeshPathQueryTask3D &p
 	}
 }
 
+void NavMeshQueries3D::_query_task_get_path_cache_key(const NavMeshPathQueryTask3D &p_query_task, PathCacheKey &r_key) {
+	r_key.begin_polygon = p_query_task.begin_polygon;
+	r_key.end_polygon = p_query_task.end_polygon;
+	r_key.begin_cell = (p_query_task.begin_position / PATH_CACHE_CELL_SIZE).floor();
+	r_key.end_cell = (p_query_task.end_position / PATH_CACHE_CELL_SIZE).floor();
+	r_key.navigation_layers = p_query_task.navigation_layers;
+	r_key.path_search_max_polygons = p_query_task.path_search_max_polygons;
+	r_key.path_search_max_distance = p_query_task.path_search_max_distance;
+	if (p_query_task.exclude_regions) {
+		r_key.excluded_regions = p_query_task.excluded_regions;
+	}
+	if (p_query_task.include_regions) {
+		r_key.included_regions = p_query_task.included_regions;
+	}
+}
+
+bool NavMeshQueries3D::_query_task_load_cached_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration, const PathCacheKey &p_key) {
+	LocalVector<NavigationPoly> &navigation_polys = p_query_task.path_query_slot->path_corridor;
+
+	MutexLock lock(p_map_iteration.path_cache_mutex);
+
+	const LocalVector<NavigationPoly> *cached_corridor = p_map_iteration.path_cache.getptr(p_key);
+	if (!cached_corridor) {
+		return false;
+	}
+
+	// The cached corridor runs from the end polygon back to the begin polygon, each polygon leading back to the next one.
+	for (uint32_t i = 0; i < cached_corridor->size(); i++) {
+		navigation_polys[i] = (*cached_corridor)[i];
+	}
+
+	// The cached route started from a slightly different position inside the begin polygon.
+	NavigationPoly &begin_navigation_poly = navigation_polys[cached_corridor->size() - 1];
+	begin_navigation_poly.entry = p_query_task.begin_position;
+	begin_navigation_poly.back_navigation_edge_pathway_start = p_query_task.begin_position;
+	begin_navigation_poly.back_navigation_edge_pathway_end = p_query_task.begin_position;
+
+	p_query_task.least_cost_id = 0;
+	return true;
+}
+
+void NavMeshQueries3D::_query_task_store_cached_path_corridor(const NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration, const PathCacheKey &p_key) {
+	const LocalVector<NavigationPoly> &navigation_polys = p_query_task.path_query_slot->path_corridor;
+
+	LocalVector<NavigationPoly> corridor;
+	for (int np_id = p_query_task.least_cost_id; np_id != -1; np_id = navigation_polys[np_id].back_navigation_poly_id) {
+		corridor.push_back(navigation_polys[np_id]);
+		NavigationPoly &navigation_poly = corridor[corridor.size() - 1];
+		navigation_poly.traversable_poly_index = UINT32_MAX;
+		if (navigation_poly.back_navigation_poly_id != -1) {
+			navigation_poly.back_navigation_poly_id = corridor.size();
+		}
+	}
+
+	MutexLock lock(p_map_iteration.path_cache_mutex);
+
+	if (p_map_iteration.path_cache.size() >= (uint32_t)PATH_CACHE_SIZE && !p_map_iteration.path_cache.has(p_key)) {
+		p_map_iteration.path_cache.remove(p_map_iteration.path_cache.begin());
+	}
+	p_map_iteration.path_cache.insert(p_key, corridor);
+}
+
+bool NavMeshQueries3D::_query_task_build_hierarchy_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
+	const Hierarchy &hierarchy = p_map_iteration.hierarchy;
+	if (hierarchy.clusters.is_empty()) {
+		return false;
+	}
+
+	PathQuerySlot *path_query_slot = p_query_task.path_query_slot;
+
+	const uint32_t begin_cluster_id = hierarchy.polygon_clusters[path_query_slot->poly_to_id[p_query_task.begin_polygon]];
+	const uint32_t end_cluster_id = hierarchy.polygon_clusters[path_query_slot->poly_to_id[p_query_task.end_polygon]];
+	if (begin_cluster_id == end_cluster_id) {
+		// Nothing to gain, the corridor search stays inside the cluster anyway.
+		return false;
+	}
+
+	const Vector3 begin_point = p_query_task.begin_position;
+	const Vector3 end_point = p_query_task.end_position;
+
+	// Heap of entrances to travel next.
+	Heap<HierarchyNode *, HierarchyNodeTravelCostGreaterThan, HierarchyNodeHeapIndexer>
+			&traversable_nodes = path_query_slot->traversable_hierarchy_nodes;
+	traversable_nodes.clear();
+
+	LocalVector<HierarchyNode> &hierarchy_nodes = path_query_slot->hierarchy_nodes;
+	for (HierarchyNode &node : hierarchy_nodes) {
+		node.reset();
+	}
+
+	// Leave the begin cluster through any of its entrances.
+	const HierarchyCluster &begin_cluster = hierarchy.clusters[begin_cluster_id];
+	for (uint32_t entrance_id : begin_cluster.entrances_out) {
+		const HierarchyEntrance &entrance = hierarchy.entrances[entrance_id];
+		const NavBaseIteration3D *to_owner = hierarchy.clusters[entrance.to_cluster].owner;
+		if (!_query_task_is_connection_owner_usable(p_query_task, to_owner)) {
+			continue;
+		}
+
+		HierarchyNode &node = hierarchy_nodes[entrance_id];
+		node.traveled_distance = begin_point.distance_to(entrance.position) * begin_cluster.owner->get_travel_cost();
+		if (to_owner != begin_cluster.owner) {
+			node.traveled_distance += to_owner->get_enter_cost();
+		}
+		node.distance_to_destination = entrance.position.distance_to(end_point) * to_owner->get_travel_cost();
+		traversable_nodes.push(&node);
+	}
+
+	// This is an implementation of the A* algorithm over the cluster entrances.
+	real_t end_travel_cost = FLT_MAX;
+	int end_node_id = -1;
+
+	while (!traversable_nodes.is_empty()) {
+		HierarchyNode *least_cost_node = traversable_nodes.pop();
+		if (least_cost_node->total_travel_cost() >= end_travel_cost) {
+			break;
+		}
+
+		const uint32_t least_cost_id = least_cost_node - hierarchy_nodes.ptr();
+		const HierarchyEntrance &least_cost_entrance = hierarchy.entrances[least_cost_id];
+		const HierarchyCluster &cluster = hierarchy.clusters[least_cost_entrance.to_cluster];
+
+		if (least_cost_entrance.to_cluster == end_cluster_id) {
+			const real_t travel_cost = least_cost_node->traveled_distance + least_cost_entrance.position.distance_to(end_point) * cluster.owner->get_travel_cost();
+			if (travel_cost < end_travel_cost) {
+				end_travel_cost = travel_cost;
+				end_node_id = least_cost_id;
+			}
+			continue;
+		}
+
+		const uint32_t entrances_out_count = cluster.entrances_out.size();
+		const real_t *entrance_costs = cluster.entrance_costs.ptr() + least_cost_entrance.to_cluster_entrance_index * entrances_out_count;
+
+		for (uint32_t out_index = 0; out_index < entrances_out_count; out_index++) {
+			if (entrance_costs[out_index] == FLT_MAX) {
+				continue;
+			}
+
+			const uint32_t entrance_id = cluster.entrances_out[out_index];
+			const HierarchyEntrance &entrance = hierarchy.entrances[entrance_id];
+			const NavBaseIteration3D *to_owner = hierarchy.clusters[entrance.to_cluster].owner;
+			if (!_query_task_is_connection_owner_usable(p_query_task, to_owner)) {
+				continue;
+			}
+
+			real_t new_traveled_distance = least_cost_node->traveled_distance + entrance_costs[out_index];
+			if (to_owner != cluster.owner) {
+				new_traveled_distance += to_owner->get_enter_cost();
+			}
+
+			HierarchyNode &node = hierarchy_nodes[entrance_id];
+			if (new_traveled_distance < node.traveled_distance) {
+				node.back_node_id = least_cost_id;
+				node.traveled_distance = new_traveled_distance;
+				node.distance_to_destination = entrance.position.distance_to(end_point) * to_owner->get_travel_cost();
+
+				if (node.traversable_node_index != traversable_nodes.INVALID_INDEX) {
+					traversable_nodes.shift(node.traversable_node_index);
+				} else {
+					traversable_nodes.push(&node);
+				}
+			}
+		}
+	}
+
+	traversable_nodes.clear();
+
+	if (end_node_id == -1) {
+		// The end cluster is not reachable, leave finding the closest reachable polygon to the corridor search.
+		return false;
+	}
+
+	// Mark the clusters along the found entrances, the corridor search will not leave them.
+	LocalVector<uint32_t> &cluster_stamps = path_query_slot->hierarchy_cluster_stamps;
+	path_query_slot->hierarchy_stamp++;
+	if (path_query_slot->hierarchy_stamp == 0) {
+		for (uint32_t &cluster_stamp : cluster_stamps) {
+			cluster_stamp = 0;
+		}
+		path_query_slot->hierarchy_stamp = 1;
+	}
+	const uint32_t stamp = path_query_slot->hierarchy_stamp;
+
+	cluster_stamps[begin_cluster_id] = stamp;
+	for (int node_id = end_node_id; node_id != -1; node_id = hierarchy_nodes[node_id].back_node_id) {
+		const HierarchyEntrance &entrance = hierarchy.entrances[node_id];
+		cluster_stamps[entrance.from_cluster] = stamp;
+		cluster_stamps[entrance.to_cluster] = stamp;
+	}
+
+	p_query_task.hierarchy_polygon_clusters = &hierarchy.polygon_clusters;
+	return true;
+}
+
 void NavMeshQueries3D::query_task_map_iteration_get_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration) {
 	p_query_task.path_clear();
 
@@ -530,7 +868,49 @@ void NavMeshQueries3D::query_task_map_iteration_get_path(NavMeshPathQueryTask3D
 		return;
 	}
 
-	_query_task_build_path_corridor(p_query_task, p_map_iteration);
+	Nav3D::PathCacheKey path_cache_key;
+	if (p_map_iteration.use_path_cache) {
+		_query_task_get_path_cache_key(p_query_task, path_cache_key);
+		if (_query_task_load_cached_path_corridor(p_query_task, p_map_iteration, path_cache_key)) {
+			p_query_task.path_cache_status = NavMeshPathQueryTask3D::PATH_CACHE_HIT;
+		} else {
+			p_query_task.path_cache_status = NavMeshPathQueryTask3D::PATH_CACHE_MISS;
+		}
+	}
+
+	if (p_query_task.path_cache_status != NavMeshPathQueryTask3D::PATH_CACHE_HIT) {
+		const Polygon *requested_end_polygon = p_query_task.end_polygon;
+
+		if (_query_task_build_hierarchy_corridor(p_query_task, p_map_iteration)) {
+			const Polygon *begin_polygon = p_query_task.begin_polygon;
+			const Polygon *end_polygon = p_query_task.end_polygon;
+			const Vector3 begin_position = p_query_task.begin_position;
+			const Vector3 end_position = p_query_task.end_position;
+
+			_query_task_build_path_corridor(p_query_task, p_map_iteration);
+			p_query_task.hierarchy_polygon_clusters = nullptr;
+
+			// The corridor restricted to the hierarchical search clusters may miss the end polygon, e.g. due to the
+			// approximated entrance costs. Search again without restriction in that case.
+			if (p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FINISHED || p_query_task.end_polygon != end_polygon) {
+				p_query_task.path_clear();
+				p_query_task.status = NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED;
+				p_query_task.begin_polygon = begin_polygon;
+				p_query_task.end_polygon = end_polygon;
+				p_query_task.begin_position = begin_position;
+				p_query_task.end_position = end_position;
+
+				_query_task_build_path_corridor(p_query_task, p_map_iteration);
+			}
+		} else {
+			_query_task_build_path_corridor(p_query_task, p_map_iteration);
+		}
+
+		// Only complete routes are cached, a partial route depends on the exact target position.
+		if (p_query_task.path_cache_status == NavMeshPathQueryTask3D::PATH_CACHE_MISS && p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_STARTED && p_query_task.end_polygon == requested_end_polygon) {
+			_query_task_store_cached_path_corridor(p_query_task, p_map_iteration, path_cache_key);
+		}
+	}
 
 	if (p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FINISHED || p_query_task.status == NavMeshPathQueryTask3D::TaskStatus::QUERY_FAILED) {
 		_query_task_process_path_result_limits(p_query_task);
@@ -878,67 +1258,97 @@ void NavMeshQueries3D::_query_task_post_process_nopostprocessing(NavMeshPathQuer
 }
 
 Vector3 NavMeshQueries3D::map_iteration_get_closest_point_to_segment(const NavMapIteration3D &p_map_iteration, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) {
-	bool use_collision = p_use_collision;
+	const PolygonBVH &polygon_bvh = p_map_iteration.polygon_bvh;
+
 	Vector3 closest_point;
 	real_t closest_point_distance = FLT_MAX;
-
-	const LocalVector<Ref<NavRegionIteration3D>> &regions = p_map_iteration.region_iterations;
-	for (const Ref<NavRegionIteration3D> &region : regions) {
-		for (const Polygon &polygon : region->get_navmesh_polygons()) {
-			// For each face check the distance to the segment.
-			for (uint32_t point_id = 2; point_id < polygon.vertices.size(); point_id += 1) {
-				const Face3 face(polygon.vertices[0], polygon.vertices[point_id - 1], polygon.vertices[point_id]);
-				Vector3 intersection_point;
-				if (face.intersects_segment(p_from, p_to, &intersection_point)) {
-					const real_t d = p_from.distance_to(intersection_point);
-					if (!use_collision) {
-						closest_point = intersection_point;
-						use_collision = true;
-						closest_point_distance = d;
-					} else if (closest_point_distance > d) {
-						closest_point = intersection_point;
-						closest_point_distance = d;
+	real_t closest_point_distance_squared = FLT_MAX;
+	uint32_t closest_polygon_id = UINT32_MAX;
+
+	// A face that intersects the segment always wins over the distance to any other face, so look for the closest intersection first.
+	_polygon_bvh_visit(
+			polygon_bvh,
+			[&p_from, &p_to](const AABB &p_aabb) { return p_aabb.intersects_segment(p_from, p_to) ? 0.0 : Math::INF; },
+			closest_point_distance_squared,
+			[&](const Polygon &p_polygon, uint32_t p_polygon_id) {
+				for (uint32_t point_id = 2; point_id < p_polygon.vertices.size(); point_id += 1) {
+					const Face3 face(p_polygon.vertices[0], p_polygon.vertices[point_id - 1], p_polygon.vertices[point_id]);
+					Vector3 intersection_point;
+					if (face.intersects_segment(p_from, p_to, &intersection_point)) {
+						const real_t d = p_from.distance_to(intersection_point);
+						if (d < closest_point_distance || (d == closest_point_distance && p_polygon_id < closest_polygon_id)) {
+							closest_point = intersection_point;
+							closest_point_distance = d;
+							closest_polygon_id = p_polygon_id;
+						}
 					}
 				}
-				// If segment does not itersect face, check the distance from segment's endpoints.
-				else if (!use_collision) {
+			});
+
+	if (closest_polygon_id != UINT32_MAX || p_use_collision) {
+		return closest_point;
+	}
+
+	// Any point on the segment is at most half its length away from its middle, which gives a lower bound of the distance to a node box.
+	const Vector3 segment_middle = (p_from + p_to) * 0.5;
+	const real_t segment_half_length = p_from.distance_to(p_to) * 0.5;
+
+	_polygon_bvh_visit(
+			polygon_bvh,
+			[&segment_middle, segment_half_length](const AABB &p_aabb) {
+				const real_t distance = MAX(Math::sqrt(_aabb_distance_squared_to_point(p_aabb, segment_middle)) - segment_half_length, (real_t)0.0);
+				return distance * distance;
+			},
+			closest_point_distance_squared,
+			[&](const Polygon &p_polygon, uint32_t p_polygon_id) {
+				Vector3 polygon_closest_point;
+				real_t polygon_closest_point_distance = FLT_MAX;
+
+				// For each face check the distance from segment's endpoints.
+				for (uint32_t point_id = 2; point_id < p_polygon.vertices.size(); point_id += 1) {
+					const Face3 face(p_polygon.vertices[0], p_polygon.vertices[point_id - 1], p_polygon.vertices[point_id]);
+
 					const Vector3 p_from_closest = face.get_closest_point_to(p_from);
 					const real_t d_p_from = p_from.distance_to(p_from_closest);
-					if (closest_point_distance > d_p_from) {
-						closest_point = p_from_closest;
-						closest_point_distance = d_p_from;
+					if (polygon_closest_point_distance > d_p_from) {
+						polygon_closest_point = p_from_closest;
+						polygon_closest_point_distance = d_p_from;
 					}
 
 					const Vector3 p_to_closest = face.get_closest_point_to(p_to);
 					const real_t d_p_to = p_to.distance_to(p_to_closest);
-					if (closest_point_distance > d_p_to) {
-						closest_point = p_to_closest;
-						closest_point_distance = d_p_to;
+					if (polygon_closest_point_distance > d_p_to) {
+						polygon_closest_point = p_to_closest;
+						polygon_closest_point_distance = d_p_to;
 					}
 				}
-			}
-			// Finally, check for a case when shortest distance is between some point located on a face's edge and some point located on a line segment.
-			if (!use_collision) {
-				for (uint32_t point_id = 0; point_id < polygon.vertices.size(); point_id += 1) {
+
+				// Finally, check for a case when shortest distance is between some point located on a face's edge and some point located on a line segment.
+				for (uint32_t point_id = 0; point_id < p_polygon.vertices.size(); point_id += 1) {
 					Vector3 a, b;
 
 					Geometry3D::get_closest_points_between_segments(
 							p_from,
 							p_to,
-							polygon.vertices[point_id],
-							polygon.vertices[(point_id + 1) % polygon.vertices.size()],
+							p_polygon.vertices[point_id],
+							p_polygon.vertices[(point_id + 1) % p_polygon.vertices.size()],
 							a,
 							b);
 
 					const real_t d = a.distance_to(b);
-					if (d < closest_point_distance) {
-						closest_point_distance = d;
-						closest_point = b;
+					if (d < polygon_closest_point_distance) {
+						polygon_closest_point_distance = d;
+						polygon_closest_point = b;
 					}
 				}
-			}
-		}
-	}
+
+				if (polygon_closest_point_distance < closest_point_distance || (polygon_closest_point_distance == closest_point_distance && p_polygon_id < closest_polygon_id)) {
+					closest_point = polygon_closest_point;
+					closest_point_distance = polygon_closest_point_distance;
+					closest_point_distance_squared = polygon_closest_point_distance * polygon_closest_point_distance;
+					closest_polygon_id = p_polygon_id;
+				}
+			});
 
 	return closest_point;
 }
@@ -961,73 +1371,25 @@ RID NavMeshQueries3D::map_iteration_get_closest_point_owner(const NavMapIteratio
 ClosestPointQueryResult NavMeshQueries3D::map_iteration_get_closest_point_info(const NavMapIteration3D &p_map_iteration, const Vector3 &p_point) {
 	ClosestPointQueryResult result;
 	real_t closest_point_distance_squared = FLT_MAX;
-
-	const LocalVector<Ref<NavRegionIteration3D>> &regions = p_map_iteration.region_iterations;
-	for (const Ref<NavRegionIteration3D> &region : regions) {
-		for (const Polygon &polygon : region->get_navmesh_polygons()) {
-			Vector3 plane_normal = (polygon.vertices[1] - polygon.vertices[0]).cross(polygon.vertices[2] - polygon.vertices[0]);
-			Vector3 closest_on_polygon;
-			real_t closest = FLT_MAX;
-			bool inside = true;
-			Vector3 previous = polygon.vertices[polygon.vertices.size() - 1];
-			for (uint32_t point_id = 0; point_id < polygon.vertices.size(); ++point_id) {
-				Vector3 edge = polygon.vertices[point_id] - previous;
-				Vector3 to_point = p_point - previous;
-				Vector3 edge_to_point_pormal = edge.cross(to_point);
-				bool clockwise = edge_to_point_pormal.dot(plane_normal) > 0;
-				// If we are not clockwise, the point will never be inside the polygon and so the closest point will be on an edge.
-				if (!clockwise) {
-					inside = false;
-					real_t point_projected_on_edge = edge.dot(to_point);
-					real_t edge_square = edge.length_squared();
-
-					if (point_projected_on_edge > edge_square) {
-						real_t distance = polygon.vertices[point_id].distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = polygon.vertices[point_id];
-							closest = distance;
-						}
-					} else if (point_projected_on_edge < 0.f) {
-						real_t distance = previous.distance_squared_to(p_point);
-						if (distance < closest) {
-							closest_on_polygon = previous;
-							closest = distance;
-						}
-					} else {
-						// If we project on this edge, this will be the closest point.
-						real_t percent = point_projected_on_edge / edge_square;
-						closest_on_polygon = previous + percent * edge;
-						break;
-					}
-				}
-				previous = polygon.vertices[point_id];
-			}
-
-			if (inside) {
-				Vector3 plane_normalized = plane_normal.normalized();
-				real_t distance = plane_normalized.dot(p_point - polygon.vertices[0]);
-				real_t distance_squared = distance * distance;
-				if (distance_squared < closest_point_distance_squared) {
+	uint32_t closest_polygon_id = UINT32_MAX;
+
+	_polygon_bvh_visit(
+			p_map_iteration.polygon_bvh,
+			[&p_point](const AABB &p_aabb) { return _aabb_distance_squared_to_point(p_aabb, p_point); },
+			closest_point_distance_squared,
+			[&](const Polygon &p_polygon, uint32_t p_polygon_id) {
+				Vector3 point;
+				Vector3 normal;
+				const real_t distance_squared = _polygon_get_closest_point(p_polygon, p_point, point, normal);
+				// Ties go to the lowest map polygon id, the same polygon that a scan over all regions would pick.
+				if (distance_squared < closest_point_distance_squared || (distance_squared == closest_point_distance_squared && p_polygon_id < closest_polygon_id)) {
 					closest_point_distance_squared = distance_squared;
-					result.point = p_point - plane_normalized * distance;
-					result.normal = plane_normal;
-					result.owner = polygon.owner->get_self();
-
-					if (Math::is_zero_approx(distance)) {
-						break;
-					}
+					closest_polygon_id = p_polygon_id;
+					result.point = point;
+					result.normal = normal;
+					result.owner = p_polygon.owner->get_self();
 				}
-			} else {
-				real_t distance = closest_on_polygon.distance_squared_to(p_point);
-				if (distance < closest_point_distance_squared) {
-					closest_point_distance_squared = distance;
-					result.point = closest_on_polygon;
-					result.normal = plane_normal;
-					result.owner = polygon.owner->get_self();
-				}
-			}
-		}
-	}
+			});
 
 	return result;
 }
@@ -1094,6 +1456,212 @@ Vector3 NavMeshQueries3D::map_iteration_get_random_point(const NavMapIteration3D
 	}
 }
 
+Vector3 NavMeshQueries3D::map_iteration_get_flow_direction(const NavMapIteration3D &p_map_iteration, const Vector3 &p_target_position, const Vector3 &p_position, uint32_t p_navigation_layers) {
+	// Flow fields only filter polygons by navigation layers, the other task parameters stay unused.
+	NavMeshPathQueryTask3D query_task;
+	query_task.navigation_layers = p_navigation_layers;
+
+	const Polygon *polygon = nullptr;
+	Vector3 position;
+	_query_task_find_closest_polygon(query_task, p_map_iteration, p_position, polygon, position);
+	if (!polygon) {
+		return Vector3();
+	}
+
+	const Polygon *target_polygon = nullptr;
+	Vector3 target_position;
+	_query_task_find_closest_polygon(query_task, p_map_iteration, p_target_position, target_polygon, target_position);
+	if (!target_polygon) {
+		return Vector3();
+	}
+
+	if (!p_map_iteration.flow_field_graph_built.is_set()) {
+		MutexLock graph_lock(p_map_iteration.flow_field_graph_mutex);
+		if (!p_map_iteration.flow_field_graph_built.is_set()) {
+			_map_iteration_build_flow_field_graph(p_map_iteration, p_map_iteration.flow_field_graph);
+			p_map_iteration.flow_field_graph_built.set();
+		}
+	}
+	const FlowFieldGraph &graph = p_map_iteration.flow_field_graph;
+
+	FlowFieldKey flow_field_key;
+	flow_field_key.target_polygon = target_polygon;
+	flow_field_key.navigation_layers = p_navigation_layers;
+
+	// The cache lock only covers the lookup, evicted flow fields stay alive for the queries still using them.
+	Ref<FlowField> flow_field;
+	{
+		MutexLock lock(p_map_iteration.flow_fields_mutex);
+		const Ref<FlowField> *cached_flow_field = p_map_iteration.flow_fields.getptr(flow_field_key);
+		if (cached_flow_field) {
+			flow_field = *cached_flow_field;
+		} else {
+			if (p_map_iteration.flow_fields.size() >= (uint32_t)FLOW_FIELD_CACHE_SIZE) {
+				p_map_iteration.flow_fields.remove(p_map_iteration.flow_fields.begin());
+			}
+			flow_field.instantiate();
+			p_map_iteration.flow_fields.insert(flow_field_key, flow_field);
+		}
+	}
+
+	// All agents that share a target polygon sample the same flow field, only the first one pays for building it.
+	// The routes lead to the target position of that first query, the others only use their own once on the target polygon.
+	if (!flow_field->built.is_set()) {
+		MutexLock build_lock(flow_field->build_mutex);
+		if (!flow_field->built.is_set()) {
+			_map_iteration_build_flow_field(p_map_iteration, query_task, target_polygon, target_position, *flow_field.ptr());
+			flow_field->built.set();
+		}
+	}
+
+	const uint32_t *polygon_offset = p_map_iteration.navbase_polygon_offsets.getptr(polygon->owner);
+	ERR_FAIL_NULL_V(polygon_offset, Vector3());
+	uint32_t polygon_id = *polygon_offset + polygon->id;
+
+	// Follow the exits that the position already reached, e.g. when standing on the edge shared with the next polygon.
+	for (uint32_t i = 0; i < graph.polygons.size(); i++) {
+		if (polygon_id == flow_field->target_polygon_id) {
+			return (target_position - position).normalized();
+		}
+		if (flow_field->polygon_costs[polygon_id] == FLT_MAX) {
+			// The target can not be reached from here.
+			return Vector3();
+		}
+
+		const Vector3 direction = flow_field->polygon_exits[polygon_id] - position;
+		if (!direction.is_zero_approx()) {
+			return direction.normalized();
+		}
+		polygon_id = flow_field->polygon_next_ids[polygon_id];
+	}
+
+	return Vector3();
+}
+
+void NavMeshQueries3D::_map_iteration_build_flow_field_graph(const NavMapIteration3D &p_map_iteration, FlowFieldGraph &r_graph) {
+	r_graph.clear();
+
+	// Map polygon ids follow the same order as the navbase polygon offsets of the map iteration.
+	for (const Ref<NavRegionIteration3D> &region : p_map_iteration.region_iterations) {
+		for (const Polygon &polygon : region->navmesh_polygons) {
+			r_graph.polygons.push_back(&polygon);
+		}
+	}
+	for (const Polygon &polygon : p_map_iteration.navlink_polygons) {
+		r_graph.polygons.push_back(&polygon);
+	}
+
+	const uint32_t polygon_count = r_graph.polygons.size();
+
+	// Count the connections leading into each polygon first, then place them with a counting sort.
+	LocalVector<uint32_t> &incoming_offsets = r_graph.incoming_offsets;
+	incoming_offsets.resize_initialized(polygon_count + 1);
+
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		_polygon_visit_connections(p_map_iteration, polygon_id, *r_graph.polygons[polygon_id], [&](const Connection &p_connection) {
+			const uint32_t *to_polygon_offset = p_map_iteration.navbase_polygon_offsets.getptr(p_connection.polygon->owner);
+			ERR_FAIL_NULL(to_polygon_offset);
+			incoming_offsets[*to_polygon_offset + p_connection.polygon->id + 1]++;
+		});
+	}
+
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		incoming_offsets[polygon_id + 1] += incoming_offsets[polygon_id];
+	}
+
+	const uint32_t connection_count = incoming_offsets[polygon_count];
+	r_graph.incoming_polygon_ids.resize(connection_count);
+	r_graph.incoming_pathway_starts.resize(connection_count);
+	r_graph.incoming_pathway_ends.resize(connection_count);
+
+	LocalVector<uint32_t> incoming_cursors;
+	incoming_cursors.resize(polygon_count);
+	memcpy(incoming_cursors.ptr(), incoming_offsets.ptr(), polygon_count * sizeof(uint32_t));
+
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		_polygon_visit_connections(p_map_iteration, polygon_id, *r_graph.polygons[polygon_id], [&](const Connection &p_connection) {
+			const uint32_t *to_polygon_offset = p_map_iteration.navbase_polygon_offsets.getptr(p_connection.polygon->owner);
+			ERR_FAIL_NULL(to_polygon_offset);
+			const uint32_t incoming_index = incoming_cursors[*to_polygon_offset + p_connection.polygon->id]++;
+			r_graph.incoming_polygon_ids[incoming_index] = polygon_id;
+			r_graph.incoming_pathway_starts[incoming_index] = p_connection.pathway_start;
+			r_graph.incoming_pathway_ends[incoming_index] = p_connection.pathway_end;
+		});
+	}
+}
+
+void NavMeshQueries3D::_map_iteration_build_flow_field(const NavMapIteration3D &p_map_iteration, const NavMeshPathQueryTask3D &p_query_task, const Polygon *p_target_polygon, const Vector3 &p_target_position, FlowField &r_flow_field) {
+	const FlowFieldGraph &graph = p_map_iteration.flow_field_graph;
+	const uint32_t polygon_count = graph.polygons.size();
+
+	LocalVector<NavigationPoly> navigation_polys;
+	navigation_polys.resize(polygon_count);
+	for (NavigationPoly &navigation_poly : navigation_polys) {
+		navigation_poly.reset();
+	}
+
+	const uint32_t *target_polygon_offset = p_map_iteration.navbase_polygon_offsets.getptr(p_target_polygon->owner);
+	if (target_polygon_offset) {
+		r_flow_field.target_polygon_id = *target_polygon_offset + p_target_polygon->id;
+
+		NavigationPoly &target_navigation_poly = navigation_polys[r_flow_field.target_polygon_id];
+		target_navigation_poly.poly = p_target_polygon;
+		target_navigation_poly.entry = p_target_position;
+		target_navigation_poly.traveled_distance = 0.0;
+
+		Heap<NavigationPoly *, NavPolyTravelCostGreaterThan, NavPolyHeapIndexer> traversable_polys;
+		traversable_polys.push(&target_navigation_poly);
+
+		// This is Dijkstra's algorithm from the target backwards along the connections.
+		// The entry of each polygon is the point where it is left towards the target.
+		while (!traversable_polys.is_empty()) {
+			const NavigationPoly *least_cost_poly = traversable_polys.pop();
+			const uint32_t least_cost_id = least_cost_poly - navigation_polys.ptr();
+			const NavBaseIteration3D *least_cost_owner = least_cost_poly->poly->owner;
+
+			for (uint32_t incoming_index = graph.incoming_offsets[least_cost_id]; incoming_index < graph.incoming_offsets[least_cost_id + 1]; incoming_index++) {
+				const uint32_t neighbor_id = graph.incoming_polygon_ids[incoming_index];
+				const Polygon *neighbor_polygon = graph.polygons[neighbor_id];
+				if (!_query_task_is_connection_owner_usable(p_query_task, neighbor_polygon->owner)) {
+					continue;
+				}
+
+				const Vector3 new_entry = Geometry3D::get_closest_point_to_segment(least_cost_poly->entry, graph.incoming_pathway_starts[incoming_index], graph.incoming_pathway_ends[incoming_index]);
+				real_t new_traveled_distance = least_cost_poly->entry.distance_to(new_entry) * least_cost_owner->get_travel_cost() + least_cost_poly->traveled_distance;
+				if (neighbor_polygon->owner != least_cost_owner) {
+					new_traveled_distance += least_cost_owner->get_enter_cost();
+				}
+
+				NavigationPoly &neighbor_poly = navigation_polys[neighbor_id];
+				if (new_traveled_distance < neighbor_poly.traveled_distance) {
+					neighbor_poly.back_navigation_poly_id = least_cost_id;
+					neighbor_poly.traveled_distance = new_traveled_distance;
+					neighbor_poly.entry = new_entry;
+
+					if (neighbor_poly.traversable_poly_index != traversable_polys.INVALID_INDEX) {
+						traversable_polys.shift(neighbor_poly.traversable_poly_index);
+					} else {
+						neighbor_poly.poly = neighbor_polygon;
+						traversable_polys.push(&neighbor_poly);
+					}
+				}
+			}
+		}
+	} else {
+		r_flow_field.target_polygon_id = UINT32_MAX;
+	}
+
+	r_flow_field.polygon_costs.resize(polygon_count);
+	r_flow_field.polygon_exits.resize(polygon_count);
+	r_flow_field.polygon_next_ids.resize(polygon_count);
+	for (uint32_t polygon_id = 0; polygon_id < polygon_count; polygon_id++) {
+		const NavigationPoly &navigation_poly = navigation_polys[polygon_id];
+		r_flow_field.polygon_costs[polygon_id] = navigation_poly.traveled_distance;
+		r_flow_field.polygon_exits[polygon_id] = navigation_poly.entry;
+		r_flow_field.polygon_next_ids[polygon_id] = navigation_poly.back_navigation_poly_id == -1 ? UINT32_MAX : (uint32_t)navigation_poly.back_navigation_poly_id;
+	}
+}
+
 Vector3 NavMeshQueries3D::polygons_get_closest_point_to_segment(const LocalVector<Polygon> &p_polygons, const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) {
 	bool use_collision = p_use_collision;
 	Vector3 closest_point;
@@ -53,6 +53,12 @@ public:
 		bool in_use = false;
 		uint32_t slot_index = 0;
 		AHashMap<const Nav3D::Polygon *, uint32_t> poly_to_id;
+
+		// Hierarchical pathfinding.
+		LocalVector<Nav3D::HierarchyNode> hierarchy_nodes;
+		Heap<Nav3D::HierarchyNode *, Nav3D::HierarchyNodeTravelCostGreaterThan, Nav3D::HierarchyNodeHeapIndexer> traversable_hierarchy_nodes;
+		LocalVector<uint32_t> hierarchy_cluster_stamps;
+		uint32_t hierarchy_stamp = 0;
 	};
 
 	struct NavMeshPathQueryTask3D {
@@ -64,6 +70,12 @@ public:
 			CALLBACK_FAILED,
 		};
 
+		enum PathCacheStatus {
+			PATH_CACHE_UNUSED,
+			PATH_CACHE_HIT,
+			PATH_CACHE_MISS,
+		};
+
 		// Parameters.
 		Vector3 start_position;
 		Vector3 target_position;
@@ -90,6 +102,9 @@ public:
 		const Nav3D::Polygon *begin_polygon = nullptr;
 		const Nav3D::Polygon *end_polygon = nullptr;
 		uint32_t least_cost_id = 0;
+		// Cluster of each map polygon, set when the corridor search is restricted to the clusters found by the hierarchical search.
+		const LocalVector<uint32_t> *hierarchy_polygon_clusters = nullptr;
+		PathCacheStatus path_cache_status = PATH_CACHE_UNUSED;
 
 		// Map.
 		Vector3 map_up;
@@ -139,13 +154,25 @@ public:
 	static RID map_iteration_get_closest_point_owner(const NavMapIteration3D &p_map_iteration, const Vector3 &p_point);
 	static Nav3D::ClosestPointQueryResult map_iteration_get_closest_point_info(const NavMapIteration3D &p_map_iteration, const Vector3 &p_point);
 	static Vector3 map_iteration_get_random_point(const NavMapIteration3D &p_map_iteration, uint32_t p_navigation_layers, bool p_uniformly);
+	static Vector3 map_iteration_get_flow_direction(const NavMapIteration3D &p_map_iteration, const Vector3 &p_target_position, const Vector3 &p_position, uint32_t p_navigation_layers);
+	static void _map_iteration_build_flow_field_graph(const NavMapIteration3D &p_map_iteration, Nav3D::FlowFieldGraph &r_graph);
+	static void _map_iteration_build_flow_field(const NavMapIteration3D &p_map_iteration, const NavMeshPathQueryTask3D &p_query_task, const Nav3D::Polygon *p_target_polygon, const Vector3 &p_target_position, Nav3D::FlowField &r_flow_field);
 
 	static void map_query_path(NavMap3D *map, const Ref<NavigationPathQueryParameters3D> &p_query_parameters, Ref<NavigationPathQueryResult3D> p_query_result, const Callable &p_callback);
+	static void map_query_path_batch(NavMap3D *p_map, const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const LocalVector<uint32_t> &p_query_indices);
+
+	static void query_task_set_parameters(NavMeshPathQueryTask3D &r_query_task, const Ref<NavigationPathQueryParameters3D> &p_query_parameters);
+	static void query_task_get_result(const NavMeshPathQueryTask3D &p_query_task, Ref<NavigationPathQueryResult3D> p_query_result);
 
 	static void query_task_map_iteration_get_path(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
 	static void _query_task_push_back_point_with_metadata(NavMeshPathQueryTask3D &p_query_task, const Vector3 &p_point, const Nav3D::Polygon *p_point_polygon);
 	static void _query_task_find_start_end_positions(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static void _query_task_find_closest_polygon(const NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration, const Vector3 &p_point, const Nav3D::Polygon *&r_polygon, Vector3 &r_position);
 	static void _query_task_build_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static bool _query_task_build_hierarchy_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration);
+	static void _query_task_get_path_cache_key(const NavMeshPathQueryTask3D &p_query_task, Nav3D::PathCacheKey &r_key);
+	static bool _query_task_load_cached_path_corridor(NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration, const Nav3D::PathCacheKey &p_key);
+	static void _query_task_store_cached_path_corridor(const NavMeshPathQueryTask3D &p_query_task, const NavMapIteration3D &p_map_iteration, const Nav3D::PathCacheKey &p_key);
 	static void _query_task_post_process_corridorfunnel(NavMeshPathQueryTask3D &p_query_task);
 	static void _query_task_post_process_edgecentered(NavMeshPathQueryTask3D &p_query_task);
 	static void _query_task_post_process_nopostprocessing(NavMeshPathQueryTask3D &p_query_task);
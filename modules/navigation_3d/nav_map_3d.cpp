@@ -110,6 +110,22 @@ void NavMap3D::set_use_edge_connections(bool p_enabled) {
 	iteration_dirty = true;
 }
 
+void NavMap3D::set_use_hierarchical_pathfinding(bool p_enabled) {
+	if (use_hierarchical_pathfinding == p_enabled) {
+		return;
+	}
+	use_hierarchical_pathfinding = p_enabled;
+	iteration_dirty = true;
+}
+
+void NavMap3D::set_use_path_cache(bool p_enabled) {
+	if (use_path_cache == p_enabled) {
+		return;
+	}
+	use_path_cache = p_enabled;
+	iteration_dirty = true;
+}
+
 void NavMap3D::set_edge_connection_margin(real_t p_edge_connection_margin) {
 	if (edge_connection_margin == p_edge_connection_margin) {
 		return;
@@ -170,6 +186,7 @@ void NavMap3D::query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task
 	p_query_task.map_up = map_iteration.map_up;
 
 	NavMeshQueries3D::query_task_map_iteration_get_path(p_query_task, map_iteration);
+	_count_path_cache_use(p_query_task);
 
 	map_iteration.path_query_slots_mutex.lock();
 	uint32_t used_slot_index = p_query_task.path_query_slot->slot_index;
@@ -180,6 +197,86 @@ void NavMap3D::query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task
 	map_iteration.path_query_slots_semaphore.post();
 }
 
+void NavMap3D::query_path_batch(LocalVector<NavMeshQueries3D::NavMeshPathQueryTask3D> &p_query_tasks) {
+	if (iteration_id == 0 || p_query_tasks.is_empty()) {
+		return;
+	}
+
+	// All queries of the batch use the same map iteration.
+	GET_MAP_ITERATION();
+
+	// Wait for one free slot, then take the other free slots without waiting so concurrent batches can't lock each other out.
+	map_iteration.path_query_slots_semaphore.wait();
+	uint32_t slot_count = 1;
+	while (slot_count < p_query_tasks.size() && map_iteration.path_query_slots_semaphore.try_wait()) {
+		slot_count++;
+	}
+
+	QueryPathBatch batch;
+	batch.map_iteration = &map_iteration;
+	batch.query_tasks = p_query_tasks.ptr();
+	batch.query_task_count = p_query_tasks.size();
+
+	map_iteration.path_query_slots_mutex.lock();
+	for (NavMeshQueries3D::PathQuerySlot &p_path_query_slot : map_iteration.path_query_slots) {
+		if (batch.path_query_slots.size() == slot_count) {
+			break;
+		}
+		if (!p_path_query_slot.in_use) {
+			p_path_query_slot.in_use = true;
+			batch.path_query_slots.push_back(&p_path_query_slot);
+		}
+	}
+	map_iteration.path_query_slots_mutex.unlock();
+
+	if (batch.path_query_slots.size() < slot_count) {
+		map_iteration.path_query_slots_semaphore.post(slot_count - batch.path_query_slots.size());
+		slot_count = batch.path_query_slots.size();
+		ERR_FAIL_COND_MSG(slot_count == 0, "No unused NavMap3D path query slot found! This should never happen :(.");
+	}
+
+	if (slot_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap3D::_query_path_batch_task, &batch, slot_count, -1, true, SNAME("NavMapQueryPathBatch3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_query_path_batch_task(0, &batch);
+	}
+
+	map_iteration.path_query_slots_mutex.lock();
+	for (NavMeshQueries3D::PathQuerySlot *path_query_slot : batch.path_query_slots) {
+		path_query_slot->in_use = false;
+	}
+	map_iteration.path_query_slots_mutex.unlock();
+
+	map_iteration.path_query_slots_semaphore.post(slot_count);
+}
+
+void NavMap3D::_query_path_batch_task(uint32_t p_index, QueryPathBatch *p_batch) {
+	NavMeshQueries3D::PathQuerySlot *path_query_slot = p_batch->path_query_slots[p_index];
+
+	// Every slot keeps taking the next pending query until the batch is done.
+	uint32_t query_task_index = p_batch->next_query_task.postincrement();
+	while (query_task_index < p_batch->query_task_count) {
+		NavMeshQueries3D::NavMeshPathQueryTask3D &query_task = p_batch->query_tasks[query_task_index];
+		query_task.path_query_slot = path_query_slot;
+		query_task.map_up = p_batch->map_iteration->map_up;
+
+		NavMeshQueries3D::query_task_map_iteration_get_path(query_task, *p_batch->map_iteration);
+		_count_path_cache_use(query_task);
+
+		query_task.path_query_slot = nullptr;
+		query_task_index = p_batch->next_query_task.postincrement();
+	}
+}
+
+void NavMap3D::_count_path_cache_use(const NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task) {
+	if (p_query_task.path_cache_status == NavMeshQueries3D::NavMeshPathQueryTask3D::PATH_CACHE_HIT) {
+		path_cache_hit_count.increment();
+	} else if (p_query_task.path_cache_status == NavMeshQueries3D::NavMeshPathQueryTask3D::PATH_CACHE_MISS) {
+		path_cache_miss_count.increment();
+	}
+}
+
 Vector3 NavMap3D::get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const {
 	if (iteration_id == 0) {
 		NAVMAP_ITERATION_ZERO_ERROR_MSG();
@@ -224,6 +321,17 @@ RID NavMap3D::get_closest_point_owner(const Vector3 &p_point) const {
 	return NavMeshQueries3D::map_iteration_get_closest_point_owner(map_iteration, p_point);
 }
 
+Vector3 NavMap3D::get_flow_direction(const Vector3 &p_target_position, const Vector3 &p_position, uint32_t p_navigation_layers) const {
+	if (iteration_id == 0) {
+		NAVMAP_ITERATION_ZERO_ERROR_MSG();
+		return Vector3();
+	}
+
+	GET_MAP_ITERATION_CONST();
+
+	return NavMeshQueries3D::map_iteration_get_flow_direction(map_iteration, p_target_position, p_position, p_navigation_layers);
+}
+
 ClosestPointQueryResult NavMap3D::get_closest_point_info(const Vector3 &p_point) const {
 	GET_MAP_ITERATION_CONST();
 
@@ -368,8 +476,10 @@ void NavMap3D::_build_iteration() {
 	iteration_build.use_edge_connections = get_use_edge_connections();
 	iteration_build.edge_connection_margin = get_edge_connection_margin();
 	iteration_build.link_connection_radius = get_link_connection_radius();
+	iteration_build.use_hierarchical_pathfinding = get_use_hierarchical_pathfinding();
 
 	next_map_iteration.clear();
+	next_map_iteration.use_path_cache = get_use_path_cache();
 
 	next_map_iteration.region_iterations.resize(regions.size());
 	next_map_iteration.link_iterations.resize(links.size());
@@ -433,6 +543,12 @@ void NavMap3D::sync() {
 	performance_data.pm_link_count = links.size();
 	performance_data.pm_obstacle_count = obstacles.size();
 
+	// Path queries may run on other threads, only take away the counts that were read.
+	performance_data.pm_path_cache_hit_count = path_cache_hit_count.get();
+	path_cache_hit_count.sub(performance_data.pm_path_cache_hit_count);
+	performance_data.pm_path_cache_miss_count = path_cache_miss_count.get();
+	path_cache_miss_count.sub(performance_data.pm_path_cache_miss_count);
+
 	_sync_async_tasks();
 
 	_sync_dirty_map_update_requests();
@@ -563,23 +679,23 @@ void NavMap3D::_update_rvo_obstacles_tree_2d() {
 }
 
 void NavMap3D::_update_rvo_agents_tree_2d() {
-	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
-	std::vector<RVO2D::Agent2D *> raw_agents;
-	raw_agents.reserve(active_2d_avoidance_agents.size());
-	for (NavAgent3D *agent : active_2d_avoidance_agents) {
-		raw_agents.push_back(agent->get_rvo_agent_2d());
+	LocalVector<Vector3> positions;
+	positions.resize(active_2d_avoidance_agents.size());
+	for (uint32_t i = 0; i < active_2d_avoidance_agents.size(); i++) {
+		const RVO2D::Vector2 &position = active_2d_avoidance_agents[i]->get_rvo_agent_2d()->position_;
+		positions[i] = Vector3(position.x(), 0.0, position.y());
 	}
-	rvo_simulation_2d.kdTree_->buildAgentTree(raw_agents);
+	avoidance_agent_grid_2d.build(positions);
 }
 
 void NavMap3D::_update_rvo_agents_tree_3d() {
-	// Cannot use LocalVector here as RVO library expects std::vector to build KdTree.
-	std::vector<RVO3D::Agent3D *> raw_agents;
-	raw_agents.reserve(active_3d_avoidance_agents.size());
-	for (NavAgent3D *agent : active_3d_avoidance_agents) {
-		raw_agents.push_back(agent->get_rvo_agent_3d());
+	LocalVector<Vector3> positions;
+	positions.resize(active_3d_avoidance_agents.size());
+	for (uint32_t i = 0; i < active_3d_avoidance_agents.size(); i++) {
+		const RVO3D::Vector3 &position = active_3d_avoidance_agents[i]->get_rvo_agent_3d()->position_;
+		positions[i] = Vector3(position.x(), position.y(), position.z());
 	}
-	rvo_simulation_3d.kdTree_->buildAgentTree(raw_agents);
+	avoidance_agent_grid_3d.build(positions);
 }
 
 void NavMap3D::_update_rvo_simulation() {
@@ -592,15 +708,44 @@ void NavMap3D::_update_rvo_simulation() {
 	}
 }
 
+void NavMap3D::_compute_rvo_agent_neighbors_2d(RVO2D::Agent2D *p_agent) {
+	p_agent->obstacleNeighbors_.clear();
+	const float obstacle_range = p_agent->timeHorizonObst_ * p_agent->maxSpeed_ + p_agent->radius_;
+	rvo_simulation_2d.kdTree_->computeObstacleNeighbors(p_agent, obstacle_range * obstacle_range);
+
+	p_agent->agentNeighbors_.clear();
+	if (p_agent->maxNeighbors_ == 0) {
+		return;
+	}
+
+	// Same results as the kd-tree query: the agent keeps the closest neighbors and shrinks the range once it has enough of them.
+	float range_sq = p_agent->neighborDist_ * p_agent->neighborDist_;
+	avoidance_agent_grid_2d.query(Vector3(p_agent->position_.x(), 0.0, p_agent->position_.y()), range_sq, [&](uint32_t p_index) {
+		p_agent->insertAgentNeighbor(active_2d_avoidance_agents[p_index]->get_rvo_agent_2d(), range_sq);
+	});
+}
+
+void NavMap3D::_compute_rvo_agent_neighbors_3d(RVO3D::Agent3D *p_agent) {
+	p_agent->agentNeighbors_.clear();
+	if (p_agent->maxNeighbors_ == 0) {
+		return;
+	}
+
+	float range_sq = p_agent->neighborDist_ * p_agent->neighborDist_;
+	avoidance_agent_grid_3d.query(Vector3(p_agent->position_.x(), p_agent->position_.y(), p_agent->position_.z()), range_sq, [&](uint32_t p_index) {
+		p_agent->insertAgentNeighbor(active_3d_avoidance_agents[p_index]->get_rvo_agent_3d(), range_sq);
+	});
+}
+
 void NavMap3D::compute_single_avoidance_step_2d(uint32_t index, NavAgent3D **agent) {
-	(*(agent + index))->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
+	_compute_rvo_agent_neighbors_2d((*(agent + index))->get_rvo_agent_2d());
 	(*(agent + index))->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
 	(*(agent + index))->get_rvo_agent_2d()->update(&rvo_simulation_2d);
 	(*(agent + index))->update();
 }
 
 void NavMap3D::compute_single_avoidance_step_3d(uint32_t index, NavAgent3D **agent) {
-	(*(agent + index))->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
+	_compute_rvo_agent_neighbors_3d((*(agent + index))->get_rvo_agent_3d());
 	(*(agent + index))->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
 	(*(agent + index))->get_rvo_agent_3d()->update(&rvo_simulation_3d);
 	(*(agent + index))->update();
@@ -616,7 +761,7 @@ void NavMap3D::step(double p_delta_time) {
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
 			for (NavAgent3D *agent : active_2d_avoidance_agents) {
-				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
+				_compute_rvo_agent_neighbors_2d(agent->get_rvo_agent_2d());
 				agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
 				agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
 				agent->update();
@@ -630,7 +775,7 @@ void NavMap3D::step(double p_delta_time) {
 			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
 		} else {
 			for (NavAgent3D *agent : active_3d_avoidance_agents) {
-				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
+				_compute_rvo_agent_neighbors_3d(agent->get_rvo_agent_3d());
 				agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
 				agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
 				agent->update();
@@ -37,10 +37,10 @@
 
 #include "core/math/math_defs.h"
 #include "core/object/worker_thread_pool.h"
+#include "servers/nav_agent_grid.h"
 #include "servers/navigation_3d/navigation_constants_3d.h"
 
 #include <KdTree2d.h>
-#include <KdTree3d.h>
 #include <RVOSimulator2d.h>
 #include <RVOSimulator3d.h>
 
@@ -71,6 +71,14 @@ class NavMap3D : public NavRid3D {
 	/// This value is used to limit how far links search to find polygons to connect to.
 	real_t link_connection_radius = NavigationDefaults3D::LINK_CONNECTION_RADIUS;
 
+	/// Build polygon clusters to speed up long path queries.
+	bool use_hierarchical_pathfinding = false;
+
+	/// Reuse the polygon corridors of earlier path queries with nearby start and target positions.
+	bool use_path_cache = false;
+	SafeNumeric<uint32_t> path_cache_hit_count;
+	SafeNumeric<uint32_t> path_cache_miss_count;
+
 	bool map_settings_dirty = true;
 
 	/// Map regions
@@ -87,6 +95,10 @@ class NavMap3D : public NavRid3D {
 	LocalVector<NavAgent3D *> active_2d_avoidance_agents;
 	LocalVector<NavAgent3D *> active_3d_avoidance_agents;
 
+	/// Grids used instead of the RVO kd-trees to find the avoidance agent neighbors.
+	NavAgentGrid avoidance_agent_grid_2d;
+	NavAgentGrid avoidance_agent_grid_3d;
+
 	/// dirty flag when one of the agent's arrays are modified
 	bool agents_dirty = true;
 
@@ -151,6 +163,16 @@ class NavMap3D : public NavRid3D {
 	bool iteration_building = false;
 	bool iteration_ready = false;
 
+	struct QueryPathBatch {
+		NavMapIteration3D *map_iteration = nullptr;
+		LocalVector<NavMeshQueries3D::PathQuerySlot *> path_query_slots;
+		NavMeshQueries3D::NavMeshPathQueryTask3D *query_tasks = nullptr;
+		uint32_t query_task_count = 0;
+		SafeNumeric<uint32_t> next_query_task;
+	};
+	void _query_path_batch_task(uint32_t p_index, QueryPathBatch *p_batch);
+	void _count_path_cache_use(const NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task);
+
 	void _build_iteration();
 	void _sync_iteration();
 
@@ -193,16 +215,28 @@ public:
 		return link_connection_radius;
 	}
 
+	void set_use_hierarchical_pathfinding(bool p_enabled);
+	bool get_use_hierarchical_pathfinding() const {
+		return use_hierarchical_pathfinding;
+	}
+
+	void set_use_path_cache(bool p_enabled);
+	bool get_use_path_cache() const {
+		return use_path_cache;
+	}
+
 	Nav3D::PointKey get_point_key(const Vector3 &p_pos) const;
 	const Vector3 &get_merge_rasterizer_cell_size() const;
 
 	void query_path(NavMeshQueries3D::NavMeshPathQueryTask3D &p_query_task);
+	void query_path_batch(LocalVector<NavMeshQueries3D::NavMeshPathQueryTask3D> &p_query_tasks);
 
 	Vector3 get_closest_point_to_segment(const Vector3 &p_from, const Vector3 &p_to, const bool p_use_collision) const;
 	Vector3 get_closest_point(const Vector3 &p_point) const;
 	Vector3 get_closest_point_normal(const Vector3 &p_point) const;
 	Nav3D::ClosestPointQueryResult get_closest_point_info(const Vector3 &p_point) const;
 	RID get_closest_point_owner(const Vector3 &p_point) const;
+	Vector3 get_flow_direction(const Vector3 &p_target_position, const Vector3 &p_position, uint32_t p_navigation_layers) const;
 
 	void add_region(NavRegion3D *p_region);
 	void remove_region(NavRegion3D *p_region);
@@ -249,6 +283,8 @@ public:
 	int get_pm_edge_connection_count() const { return performance_data.pm_edge_connection_count; }
 	int get_pm_edge_free_count() const { return performance_data.pm_edge_free_count; }
 	int get_pm_obstacle_count() const { return performance_data.pm_obstacle_count; }
+	int get_pm_path_cache_hit_count() const { return performance_data.pm_path_cache_hit_count; }
+	int get_pm_path_cache_miss_count() const { return performance_data.pm_path_cache_miss_count; }
 
 	int get_region_connections_count(NavRegion3D *p_region) const;
 	Vector3 get_region_connection_pathway_start(NavRegion3D *p_region, int p_connection_id) const;
@@ -285,6 +321,8 @@ private:
 	void _update_rvo_obstacles_tree_2d();
 	void _update_rvo_agents_tree_2d();
 	void _update_rvo_agents_tree_3d();
+	void _compute_rvo_agent_neighbors_2d(RVO2D::Agent2D *p_agent);
+	void _compute_rvo_agent_neighbors_3d(RVO3D::Agent3D *p_agent);
 
 	void _update_merge_rasterizer_cell_dimensions();
 };
@@ -30,11 +30,16 @@
 
 #pragma once
 
+#include "core/math/aabb.h"
 #include "core/math/vector3.h"
+#include "core/math/vector3i.h"
 #include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/hashfuncs.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/span.h"
 #include "servers/navigation_3d/navigation_constants_3d.h"
 
 class NavBaseIteration3D;
@@ -171,6 +176,252 @@ struct NavPolyHeapIndexer {
 	}
 };
 
+struct HierarchyEntrance {
+	/// Cluster that this entrance leaves from.
+	uint32_t from_cluster = UINT32_MAX;
+
+	/// Cluster that this entrance leads to.
+	uint32_t to_cluster = UINT32_MAX;
+
+	/// Index of this entrance in the incoming entrances of `to_cluster`.
+	uint32_t to_cluster_entrance_index = UINT32_MAX;
+
+	/// Average position of the connection pathways between both clusters.
+	Vector3 position;
+};
+
+struct HierarchyCluster {
+	/// Navigation region or link that contains all polygons of this cluster.
+	const NavBaseIteration3D *owner = nullptr;
+
+	/// Map polygon ids of the polygons in this cluster.
+	LocalVector<uint32_t> polygons;
+
+	/// Entrances leading into and out of this cluster.
+	LocalVector<uint32_t> entrances_in;
+	LocalVector<uint32_t> entrances_out;
+
+	/// Travel cost from each incoming entrance (rows) to each outgoing entrance (columns) through the cluster.
+	/// FLT_MAX if the outgoing entrance can not be reached from the incoming entrance inside the cluster.
+	LocalVector<real_t> entrance_costs;
+};
+
+struct Hierarchy {
+	/// Cluster of each map polygon, indexed by map polygon id.
+	LocalVector<uint32_t> polygon_clusters;
+
+	LocalVector<HierarchyCluster> clusters;
+	LocalVector<HierarchyEntrance> entrances;
+
+	void clear() {
+		polygon_clusters.clear();
+		clusters.clear();
+		entrances.clear();
+	}
+};
+
+struct HierarchyNode {
+	/// Index in the heap of traversable entrances.
+	uint32_t traversable_node_index = UINT32_MAX;
+
+	/// Entrance crossed before this one, or -1 when reached from the begin polygon.
+	int back_node_id = -1;
+
+	/// The distance traveled until now (g cost).
+	real_t traveled_distance = FLT_MAX;
+	/// The distance to the destination (h cost).
+	real_t distance_to_destination = 0.0;
+
+	/// The total travel cost (f cost).
+	real_t total_travel_cost() const {
+		return traveled_distance + distance_to_destination;
+	}
+
+	void reset() {
+		traversable_node_index = UINT32_MAX;
+		back_node_id = -1;
+		traveled_distance = FLT_MAX;
+		distance_to_destination = 0.0;
+	}
+};
+
+struct HierarchyNodeTravelCostGreaterThan {
+	// Returns `true` if the travel cost of `a` is higher than that of `b`.
+	bool operator()(const HierarchyNode *p_node_a, const HierarchyNode *p_node_b) const {
+		real_t f_cost_a = p_node_a->total_travel_cost();
+		real_t f_cost_b = p_node_b->total_travel_cost();
+
+		if (f_cost_a != f_cost_b) {
+			return f_cost_a > f_cost_b;
+		} else {
+			return p_node_a->distance_to_destination > p_node_b->distance_to_destination;
+		}
+	}
+};
+
+struct HierarchyNodeHeapIndexer {
+	void operator()(HierarchyNode *p_node, uint32_t p_heap_index) const {
+		p_node->traversable_node_index = p_heap_index;
+	}
+};
+
+struct PolygonBVHNode {
+	AABB aabb;
+
+	/// First child node for inner nodes, the second child follows it. First entry in the polygon list for leaves.
+	uint32_t first = 0;
+
+	/// Number of polygons in a leaf, 0 for inner nodes.
+	uint32_t count = 0;
+};
+
+struct PolygonBVH {
+	/// Nodes of the tree, the root is the first node.
+	LocalVector<PolygonBVHNode> nodes;
+
+	/// Polygons referenced by the leaves, with their map polygon ids.
+	LocalVector<const Polygon *> polygons;
+	LocalVector<uint32_t> polygon_ids;
+
+	void clear() {
+		nodes.clear();
+		polygons.clear();
+		polygon_ids.clear();
+	}
+};
+
+struct PolygonConnections {
+	/// Start of the connections of each map polygon, with one extra entry for the end of the last polygon.
+	LocalVector<uint32_t> offsets;
+
+	/// Connections of all polygons, grouped by the polygon they leave from.
+	LocalVector<Connection> connections;
+
+	_FORCE_INLINE_ Span<Connection> get_polygon_connections(uint32_t p_polygon_id) const {
+		if (p_polygon_id + 1 >= offsets.size()) {
+			return Span<Connection>();
+		}
+		return Span<Connection>(connections.ptr() + offsets[p_polygon_id], offsets[p_polygon_id + 1] - offsets[p_polygon_id]);
+	}
+
+	void clear() {
+		offsets.clear();
+		connections.clear();
+	}
+};
+
+struct FlowFieldKey {
+	/// Flow fields are shared by every target position on the same polygon, only the direction on the target polygon itself points at the exact target.
+	const Polygon *target_polygon = nullptr;
+	uint32_t navigation_layers = 0;
+
+	static uint32_t hash(const FlowFieldKey &p_key) {
+		uint32_t h = hash_murmur3_one_64((uint64_t)p_key.target_polygon);
+		h = hash_murmur3_one_32(p_key.navigation_layers, h);
+		return hash_fmix32(h);
+	}
+
+	bool operator==(const FlowFieldKey &p_key) const {
+		return target_polygon == p_key.target_polygon && navigation_layers == p_key.navigation_layers;
+	}
+};
+
+struct FlowFieldGraph {
+	/// Polygon of each map polygon id.
+	LocalVector<const Polygon *> polygons;
+
+	/// Connections leading into each map polygon. The connections into polygon `i` are stored from `incoming_offsets[i]` to `incoming_offsets[i + 1]`.
+	LocalVector<uint32_t> incoming_offsets;
+	LocalVector<uint32_t> incoming_polygon_ids;
+	LocalVector<Vector3> incoming_pathway_starts;
+	LocalVector<Vector3> incoming_pathway_ends;
+
+	void clear() {
+		polygons.clear();
+		incoming_offsets.clear();
+		incoming_polygon_ids.clear();
+		incoming_pathway_starts.clear();
+		incoming_pathway_ends.clear();
+	}
+};
+
+class FlowField : public RefCounted {
+public:
+	/// Held while the flow field is built, so queries for the same target wait for it without blocking other targets.
+	Mutex build_mutex;
+	SafeFlag built;
+
+	/// Travel cost from each map polygon to the target, FLT_MAX if the target can not be reached from the polygon.
+	LocalVector<real_t> polygon_costs;
+
+	/// Point on the connection pathway where each map polygon is left towards the target.
+	LocalVector<Vector3> polygon_exits;
+
+	/// Map polygon id of the polygon entered through the exit of each map polygon.
+	LocalVector<uint32_t> polygon_next_ids;
+
+	/// Map polygon id of the target polygon.
+	uint32_t target_polygon_id = UINT32_MAX;
+};
+
+struct PathCacheKey {
+	const Polygon *begin_polygon = nullptr;
+	const Polygon *end_polygon = nullptr;
+	/// Cells of PATH_CACHE_CELL_SIZE that contain the start and end positions on the navigation mesh.
+	Vector3i begin_cell;
+	Vector3i end_cell;
+	uint32_t navigation_layers = 0;
+	int path_search_max_polygons = 0;
+	float path_search_max_distance = 0.0;
+	LocalVector<RID> excluded_regions;
+	LocalVector<RID> included_regions;
+
+	static uint32_t hash(const PathCacheKey &p_key) {
+		uint32_t h = hash_murmur3_one_64((uint64_t)p_key.begin_polygon);
+		h = hash_murmur3_one_64((uint64_t)p_key.end_polygon, h);
+		h = hash_murmur3_one_32(p_key.begin_cell.x, h);
+		h = hash_murmur3_one_32(p_key.begin_cell.y, h);
+		h = hash_murmur3_one_32(p_key.begin_cell.z, h);
+		h = hash_murmur3_one_32(p_key.end_cell.x, h);
+		h = hash_murmur3_one_32(p_key.end_cell.y, h);
+		h = hash_murmur3_one_32(p_key.end_cell.z, h);
+		h = hash_murmur3_one_32(p_key.navigation_layers, h);
+		h = hash_murmur3_one_32(p_key.path_search_max_polygons, h);
+		h = hash_murmur3_one_float(p_key.path_search_max_distance, h);
+		for (const RID &region : p_key.excluded_regions) {
+			h = hash_murmur3_one_64(region.get_id(), h);
+		}
+		h = hash_murmur3_one_32(p_key.excluded_regions.size(), h);
+		for (const RID &region : p_key.included_regions) {
+			h = hash_murmur3_one_64(region.get_id(), h);
+		}
+		return hash_fmix32(h);
+	}
+
+	bool operator==(const PathCacheKey &p_key) const {
+		if (begin_polygon != p_key.begin_polygon || end_polygon != p_key.end_polygon || begin_cell != p_key.begin_cell || end_cell != p_key.end_cell) {
+			return false;
+		}
+		if (navigation_layers != p_key.navigation_layers || path_search_max_polygons != p_key.path_search_max_polygons || path_search_max_distance != p_key.path_search_max_distance) {
+			return false;
+		}
+		if (excluded_regions.size() != p_key.excluded_regions.size() || included_regions.size() != p_key.included_regions.size()) {
+			return false;
+		}
+		for (uint32_t i = 0; i < excluded_regions.size(); i++) {
+			if (excluded_regions[i] != p_key.excluded_regions[i]) {
+				return false;
+			}
+		}
+		for (uint32_t i = 0; i < included_regions.size(); i++) {
+			if (included_regions[i] != p_key.included_regions[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
 struct ClosestPointQueryResult {
 	Vector3 point;
 	Vector3 normal;
@@ -192,6 +443,8 @@ struct PerformanceData {
 	int pm_edge_connection_count = 0;
 	int pm_edge_free_count = 0;
 	int pm_obstacle_count = 0;
+	int pm_path_cache_hit_count = 0;
+	int pm_path_cache_miss_count = 0;
 
 	void reset() {
 		pm_region_count = 0;
@@ -203,6 +456,8 @@ struct PerformanceData {
 		pm_edge_connection_count = 0;
 		pm_edge_free_count = 0;
 		pm_obstacle_count = 0;
+		pm_path_cache_hit_count = 0;
+		pm_path_cache_miss_count = 0;
 	}
 };
 
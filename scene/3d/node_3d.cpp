@@ -103,11 +103,47 @@ void Node3D::_propagate_transform_changed_deferred() {
 	}
 }
 
+void Node3D::_invalidate_transform_propagation() const {
+	if (is_inside_tree()) {
+		get_tree()->xform_propagation_epoch.increment();
+	}
+}
+
+void Node3D::_invalidate_transform_propagation_upwards() const {
+	if (!is_inside_tree()) {
+		return;
+	}
+	if (is_group_processing()) {
+		_invalidate_transform_propagation();
+		return;
+	}
+
+	// Only the nodes marked by the current propagation on the way down to this one assumed it dirty.
+	// A marked node has its whole subtree marked, so nothing above the first unmarked one can be marked.
+	const uint64_t epoch = get_tree()->xform_propagation_epoch.get();
+	for (const Node3D *s = this; s && s->data.propagation_epoch == epoch; s = s->data.top_level ? nullptr : s->data.parent) {
+		s->data.propagation_epoch = 0;
+	}
+}
+
 void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 	if (!is_inside_tree()) {
 		return;
 	}
 
+	// If this node was already reached by a propagation since the last time transform notifications were
+	// flushed (or propagation was otherwise invalidated) and is still dirty, its whole subtree is dirty
+	// and queued for notification too, so there is nothing left to do.
+	// Only done on the main thread, as subtrees can span several process thread groups.
+	if (!is_group_processing()) {
+		const uint64_t epoch = get_tree()->xform_propagation_epoch.get();
+		const uint32_t global_dirty = DIRTY_GLOBAL_TRANSFORM | DIRTY_GLOBAL_INTERPOLATED_TRANSFORM;
+		if (data.propagation_epoch == epoch && (data.dirty.st & global_dirty) == global_dirty) {
+			return;
+		}
+		data.propagation_epoch = epoch;
+	}
+
 	for (uint32_t n = 0; n < data.node3d_children.size(); n++) {
 		Node3D *s = data.node3d_children[n];
 
@@ -117,6 +153,14 @@ void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 		}
 	}
 
+#ifdef TOOLS_ENABLED
+	if (unlikely(data.ignore_notification) && p_origin != this && (!data.gizmos.is_empty() || data.notify_transform) && !is_group_processing()) {
+#else
+	if (unlikely(data.ignore_notification) && p_origin != this && data.notify_transform && !is_group_processing()) {
+#endif
+		data.propagation_ignored = true;
+	}
+
 #ifdef TOOLS_ENABLED
 	if ((!data.gizmos.is_empty() || data.notify_transform) && !data.ignore_notification && !xform_change.in_list()) {
 #else
@@ -171,6 +215,7 @@ void Node3D::_notification(int p_what) {
 
 			_set_dirty_bits(DIRTY_GLOBAL_TRANSFORM | DIRTY_GLOBAL_INTERPOLATED_TRANSFORM); // Global is always dirty upon entering a scene.
 			_notify_dirty();
+			_invalidate_transform_propagation();
 
 			notification(NOTIFICATION_ENTER_WORLD);
 			_update_visibility_parent(true);
@@ -207,6 +252,7 @@ void Node3D::_notification(int p_what) {
 			if (xform_change.in_list()) {
 				get_tree()->xform_change_list.remove(&xform_change);
 			}
+			_invalidate_transform_propagation();
 
 			if (data.parent) {
 				if (data.index_in_parent != UINT32_MAX) {
@@ -914,6 +960,7 @@ void Node3D::add_gizmo(Ref<Node3DGizmo> p_gizmo) {
 		return;
 	}
 	data.gizmos.push_back(p_gizmo);
+	_invalidate_transform_propagation();
 
 	if (p_gizmo.is_valid() && is_inside_world()) {
 		p_gizmo->create();
@@ -991,6 +1038,12 @@ void Node3D::_clear_dirty_bits(uint32_t p_bits) const {
 	} else {
 		data.dirty.st &= ~p_bits;
 	}
+
+	// The interpolated transform is cleaned per node without going through the parent chain,
+	// unlike the global transform, so the subtree can't be assumed dirty anymore.
+	if (p_bits & DIRTY_GLOBAL_INTERPOLATED_TRANSFORM) {
+		_invalidate_transform_propagation_upwards();
+	}
 }
 
 void Node3D::_update_gizmos() {
@@ -1054,6 +1107,7 @@ void Node3D::set_as_top_level(bool p_enabled) {
 		}
 	}
 	data.top_level = p_enabled;
+	_invalidate_transform_propagation();
 	reset_physics_interpolation();
 }
 
@@ -1063,6 +1117,7 @@ void Node3D::set_as_top_level_keep_local(bool p_enabled) {
 		return;
 	}
 	data.top_level = p_enabled;
+	_invalidate_transform_propagation();
 	_propagate_transform_changed(this);
 	reset_physics_interpolation();
 }
@@ -1273,6 +1328,23 @@ Vector3 Node3D::to_global(Vector3 p_local) const {
 void Node3D::set_notify_transform(bool p_enabled) {
 	ERR_THREAD_GUARD;
 	data.notify_transform = p_enabled;
+	if (p_enabled) {
+		// May be dirty without being queued for notification.
+		_invalidate_transform_propagation();
+	}
+}
+
+void Node3D::set_ignore_transform_notification(bool p_ignore) {
+	if (data.ignore_notification && !p_ignore) {
+		// Changes of this node itself were skipped on purpose, but the next propagation must reach it again.
+		_invalidate_transform_propagation_upwards();
+		if (data.propagation_ignored) {
+			// A parent's change was not notified, so marked ancestors can't be trusted either.
+			data.propagation_ignored = false;
+			_invalidate_transform_propagation();
+		}
+	}
+	data.ignore_notification = p_ignore;
 }
 
 bool Node3D::is_transform_notification_enabled() const {
@@ -1297,6 +1369,7 @@ void Node3D::force_update_transform() {
 		return; //nothing to update
 	}
 	get_tree()->xform_change_list.remove(&xform_change);
+	_invalidate_transform_propagation();
 
 	notification(NOTIFICATION_TRANSFORM_CHANGED);
 }
@@ -1554,6 +1627,7 @@ Node3D::Node3D() :
 	data.inside_world = false;
 
 	data.ignore_notification = false;
+	data.propagation_ignored = false;
 	data.notify_local_transform = false;
 	data.notify_transform = false;
 
@@ -133,6 +133,7 @@ private:
 		bool vi_visible : 1;
 
 		bool ignore_notification : 1;
+		bool propagation_ignored : 1; // Reached by a parent's transform propagation while ignoring notifications.
 		bool notify_local_transform : 1;
 		bool notify_transform : 1;
 
@@ -159,6 +160,9 @@ private:
 		LocalVector<Node3D *> node3d_children;
 		uint32_t index_in_parent = UINT32_MAX;
 
+		// SceneTree transform propagation epoch in which this subtree was last marked dirty.
+		mutable uint64_t propagation_epoch = 0;
+
 		ClientPhysicsInterpolationData *client_physics_interpolation_data = nullptr;
 
 #ifdef TOOLS_ENABLED
@@ -182,6 +186,8 @@ private:
 	void _update_gizmos();
 	void _notify_dirty();
 	void _propagate_transform_changed(Node3D *p_origin);
+	void _invalidate_transform_propagation() const;
+	void _invalidate_transform_propagation_upwards() const;
 
 	void _propagate_visibility_changed();
 
@@ -190,7 +196,7 @@ private:
 	void _propagate_transform_changed_deferred();
 
 protected:
-	_FORCE_INLINE_ void set_ignore_transform_notification(bool p_ignore) { data.ignore_notification = p_ignore; }
+	void set_ignore_transform_notification(bool p_ignore);
 
 	_FORCE_INLINE_ void _update_local_transform() const;
 	_FORCE_INLINE_ void _update_rotation_and_scale() const;
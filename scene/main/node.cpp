@@ -54,6 +54,7 @@ STATIC_ASSERT_INCOMPLETE_TYPE(class, Engine);
 #ifdef DEBUG_ENABLED
 SafeNumeric<uint64_t> Node::total_node_count{ 0 };
 #endif
+SafeNumeric<uint64_t> Node::node_path_version_counter{ 0 };
 
 thread_local Node *Node::current_process_thread_group = nullptr;
 
@@ -1450,6 +1451,7 @@ void Node::set_name(const StringName &p_name) {
 		data.parent->_validate_child_name(this, true);
 		bool success = data.parent->data.children.replace_key(old_name, data.name);
 		ERR_FAIL_COND_MSG(!success, "Renaming child in hashtable failed, this is a bug.");
+		_invalidate_node_paths();
 	}
 
 	if (data.unique_name_in_owner && data.owner) {
@@ -1512,14 +1514,14 @@ String Node::adjust_name_casing(const String &p_name) {
 	return p_name;
 }
 
-void Node::_validate_child_name(Node *p_child, bool p_force_human_readable) {
+void Node::_validate_child_name(Node *p_child, bool p_force_human_readable, HashMap<String, String> *r_serial_hints) {
 	/* Make sure the name is unique */
 
 	if (p_force_human_readable) {
 		//this approach to autoset node names is human readable but very slow
 
 		StringName name = p_child->data.name;
-		_generate_serial_child_name(p_child, name);
+		_generate_serial_child_name(p_child, name, r_serial_hints);
 		p_child->data.name = name;
 
 	} else {
@@ -1590,7 +1592,15 @@ String increase_numeric_string(const String &s) {
 	return res;
 }
 
-void Node::_generate_serial_child_name(const Node *p_child, StringName &name) const {
+// Compares two strings of digits by the number they hold.
+static bool _is_numeric_string_less(const String &p_a, const String &p_b) {
+	if (p_a.length() != p_b.length()) {
+		return p_a.length() < p_b.length();
+	}
+	return p_a < p_b;
+}
+
+void Node::_generate_serial_child_name(const Node *p_child, StringName &name, HashMap<String, String> *r_serial_hints) const {
 	if (name == StringName()) {
 		// No name and a new name is needed, create one.
 
@@ -1632,6 +1642,9 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 
 		if (!exists) {
 			name = attempt;
+			if (r_serial_hints && nums.length() > 0) {
+				r_serial_hints->insert(name_string, nums);
+			}
 			return;
 		} else {
 			if (nums.length() == 0) {
@@ -1641,6 +1654,14 @@ void Node::_generate_serial_child_name(const Node *p_child, StringName &name) co
 			} else {
 				nums = increase_numeric_string(nums);
 			}
+
+			// Skip the numbers already given to previous children of the same batch, instead of trying them all again.
+			if (r_serial_hints) {
+				const String *last_nums = r_serial_hints->getptr(name_string);
+				if (last_nums && !_is_numeric_string_less(*last_nums, nums)) {
+					nums = increase_numeric_string(*last_nums);
+				}
+			}
 		}
 	}
 }
@@ -1652,6 +1673,19 @@ Node::InternalMode Node::get_internal_mode() const {
 void Node::_add_child_nocheck(Node *p_child, const StringName &p_name, InternalMode p_internal_mode) {
 	//add a child node quickly, without name validation
 
+	_attach_child_nocheck(p_child, p_name, p_internal_mode);
+
+	if (data.tree) {
+		p_child->_set_tree(data.tree);
+	}
+
+	/* Notify */
+	add_child_notify(p_child);
+	notification(NOTIFICATION_CHILD_ORDER_CHANGED);
+	emit_signal(SNAME("child_order_changed"));
+}
+
+void Node::_attach_child_nocheck(Node *p_child, const StringName &p_name, InternalMode p_internal_mode) {
 	p_child->data.name = p_name;
 	data.children.insert(p_name, p_child);
 
@@ -1677,6 +1711,7 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name, InternalM
 	}
 
 	p_child->data.parent = this;
+	p_child->_invalidate_node_paths();
 
 	if (!data.children_cache_dirty && can_push_back) {
 		data.children_cache.push_back(p_child);
@@ -1685,15 +1720,6 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name, InternalM
 	}
 
 	p_child->notification(NOTIFICATION_PARENTED);
-
-	if (data.tree) {
-		p_child->_set_tree(data.tree);
-	}
-
-	/* Notify */
-	add_child_notify(p_child);
-	notification(NOTIFICATION_CHILD_ORDER_CHANGED);
-	emit_signal(SNAME("child_order_changed"));
 }
 
 void Node::add_child(RequiredParam<Node> rp_child, bool p_force_readable_name, InternalMode p_internal) {
@@ -1701,12 +1727,10 @@ void Node::add_child(RequiredParam<Node> rp_child, bool p_force_readable_name, I
 
 	ERR_THREAD_GUARD
 	EXTRACT_PARAM_OR_FAIL(p_child, rp_child);
-	ERR_FAIL_COND_MSG(p_child == this, vformat("Can't add child '%s' to itself.", p_child->get_name())); // adding to itself!
-	ERR_FAIL_COND_MSG(p_child->data.parent, vformat("Can't add child '%s' to '%s', already has a parent '%s'.", p_child->get_name(), get_name(), p_child->data.parent->get_name())); //Fail if node has a parent
-#ifdef DEBUG_ENABLED
-	ERR_FAIL_COND_MSG(p_child->is_ancestor_of(this), vformat("Can't add child '%s' to '%s' as it would result in a cyclic dependency since '%s' is already a parent of '%s'.", p_child->get_name(), get_name(), p_child->get_name(), get_name()));
-#endif
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, `add_child()` failed. Consider using `add_child.call_deferred(child)` instead.");
+	if (!_can_add_child(p_child)) {
+		return;
+	}
 
 	_validate_child_name(p_child, p_force_readable_name);
 
@@ -1720,6 +1744,74 @@ void Node::add_child(RequiredParam<Node> rp_child, bool p_force_readable_name, I
 	_add_child_nocheck(p_child, p_child->data.name, p_internal);
 }
 
+bool Node::_can_add_child(Node *p_child) const {
+	ERR_FAIL_COND_V_MSG(p_child == this, false, vformat("Can't add child '%s' to itself.", p_child->get_name())); // adding to itself!
+	ERR_FAIL_COND_V_MSG(p_child->data.parent, false, vformat("Can't add child '%s' to '%s', already has a parent '%s'.", p_child->get_name(), get_name(), p_child->data.parent->get_name())); //Fail if node has a parent
+#ifdef DEBUG_ENABLED
+	ERR_FAIL_COND_V_MSG(p_child->is_ancestor_of(this), false, vformat("Can't add child '%s' to '%s' as it would result in a cyclic dependency since '%s' is already a parent of '%s'.", p_child->get_name(), get_name(), p_child->get_name(), get_name()));
+#endif
+	return true;
+}
+
+void Node::add_children(const TypedArray<Node> &p_children, bool p_force_readable_name, InternalMode p_internal) {
+	ERR_FAIL_COND_MSG(data.tree && !Thread::is_main_thread(), "Adding children to a node inside the SceneTree is only allowed from the main thread. Use call_deferred(\"add_children\",nodes).");
+
+	ERR_THREAD_GUARD
+	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, `add_children()` failed. Consider using `add_children.call_deferred(children)` instead.");
+
+	// Attach every child first, so all siblings exist by the time the first one enters the tree
+	// (same as when instantiating a scene), then notify the batch once.
+	LocalVector<Node *> added;
+	added.reserve(p_children.size());
+	// Last serial number given to each readable base name, so many children with the same name don't each walk
+	// through all the numbers taken by the previous ones.
+	HashMap<String, String> serial_hints;
+	for (int i = 0; i < p_children.size(); i++) {
+		Node *child = Object::cast_to<Node>(p_children[i]);
+		ERR_CONTINUE_MSG(!child, "Can't add a null or non-Node child.");
+		if (!_can_add_child(child)) {
+			continue;
+		}
+
+		_validate_child_name(child, p_force_readable_name, &serial_hints);
+		_attach_child_nocheck(child, child->data.name, p_internal);
+		added.push_back(child);
+	}
+
+	if (added.is_empty()) {
+		return;
+	}
+
+	if (data.tree) {
+		// Process group registrations of the whole batch are applied at once.
+		SceneTree *tree = data.tree;
+		tree->_begin_process_group_batch();
+		for (Node *child : added) {
+			// A previous sibling may have moved or freed this one while entering the tree.
+			if (child->data.parent == this && !child->data.tree) {
+				child->_propagate_enter_tree();
+			}
+		}
+		tree->_end_process_group_batch();
+		if (data.ready_notified) {
+			for (Node *child : added) {
+				if (child->data.parent == this && child->data.tree && !child->data.ready_notified) {
+					child->_propagate_ready();
+				}
+			}
+		}
+		tree->tree_changed();
+	}
+
+	for (Node *child : added) {
+		if (child->data.parent == this) {
+			add_child_notify(child);
+		}
+	}
+	notification(NOTIFICATION_CHILD_ORDER_CHANGED);
+	emit_signal(SNAME("child_order_changed"));
+}
+
 void Node::add_sibling(RequiredParam<Node> rp_sibling, bool p_force_readable_name) {
 	ERR_FAIL_COND_MSG(data.tree && !Thread::is_main_thread(), "Adding a sibling to a node inside the SceneTree is only allowed from the main thread. Use call_deferred(\"add_sibling\",node).");
 	EXTRACT_PARAM_OR_FAIL(p_sibling, rp_sibling);
@@ -1738,6 +1830,47 @@ void Node::remove_child(RequiredParam<Node> rp_child) {
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy adding/removing children, `remove_child()` can't be called at this time. Consider using `remove_child.call_deferred(child)` instead.");
 	ERR_FAIL_COND(p_child->data.parent != this);
 
+	_detach_child(p_child);
+
+	notification(NOTIFICATION_CHILD_ORDER_CHANGED);
+	emit_signal(SNAME("child_order_changed"));
+
+	if (data.tree) {
+		p_child->_propagate_after_exit_tree();
+	}
+}
+
+void Node::remove_children(const TypedArray<Node> &p_children) {
+	ERR_FAIL_COND_MSG(data.tree && !Thread::is_main_thread(), "Removing children from a node inside the SceneTree is only allowed from the main thread. Use call_deferred(\"remove_children\",nodes).");
+	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy adding/removing children, `remove_children()` can't be called at this time. Consider using `remove_children.call_deferred(children)` instead.");
+
+	LocalVector<Node *> removed;
+	removed.reserve(p_children.size());
+	for (int i = 0; i < p_children.size(); i++) {
+		Node *child = Object::cast_to<Node>(p_children[i]);
+		ERR_CONTINUE_MSG(!child, "Can't remove a null or non-Node child.");
+		// Also skips duplicates, and children moved away while a previous one exited the tree.
+		ERR_CONTINUE(child->data.parent != this);
+
+		_detach_child(child);
+		removed.push_back(child);
+	}
+
+	if (removed.is_empty()) {
+		return;
+	}
+
+	notification(NOTIFICATION_CHILD_ORDER_CHANGED);
+	emit_signal(SNAME("child_order_changed"));
+
+	if (data.tree) {
+		for (Node *child : removed) {
+			child->_propagate_after_exit_tree();
+		}
+	}
+}
+
+void Node::_detach_child(Node *p_child) {
 	/**
 	 *  Do not change the data.internal_children*cache counters here.
 	 *  Because if nodes are re-added, the indices can remain
@@ -1759,16 +1892,10 @@ void Node::remove_child(RequiredParam<Node> rp_child) {
 	data.children_cache_dirty = true;
 	bool success = data.children.erase(p_child->data.name);
 	ERR_FAIL_COND_MSG(!success, "Children name does not match parent name in hashtable, this is a bug.");
+	p_child->_invalidate_node_paths();
 
 	p_child->data.parent = nullptr;
 	p_child->data.index = -1;
-
-	notification(NOTIFICATION_CHILD_ORDER_CHANGED);
-	emit_signal(SNAME("child_order_changed"));
-
-	if (data.tree) {
-		p_child->_propagate_after_exit_tree();
-	}
 }
 
 void Node::_update_children_cache_impl() const {
@@ -1897,8 +2024,43 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 
 	ERR_FAIL_COND_V_MSG(!data.tree && p_path.is_absolute(), nullptr, "Can't use get_node() with absolute paths from outside the active scene tree.");
 
+	// Single name lookups are as fast as the cache itself, so only cache deeper relative paths.
+	// The cache is only used from the main thread, so concurrent readers never write to it.
+	if (p_path.is_absolute() || p_path.get_name_count() < 2 || !Thread::is_main_thread()) {
+		return _resolve_node_path(p_path);
+	}
+
+	if (data.node_path_cache == nullptr) {
+		data.node_path_cache = memnew((HashMap<NodePath, NodePathCacheEntry>));
+	} else {
+		const NodePathCacheEntry *cached = data.node_path_cache->getptr(p_path);
+		if (cached) {
+			// The entry is valid as long as its scope is still this node or one of its ancestors, and nothing changed below the scope.
+			// The scope is only dereferenced once it was found in the chain, as it may have been freed otherwise.
+			const Node *scope = this;
+			while (scope && scope != cached->scope) {
+				scope = scope->data.parent;
+			}
+			if (scope && scope->data.node_path_version == cached->scope_version) {
+				return cached->node;
+			}
+		} else if (data.node_path_cache->size() >= NODE_PATH_CACHE_MAX_SIZE) {
+			data.node_path_cache->clear();
+		}
+	}
+
+	NodePathCacheEntry entry;
+	entry.node = _resolve_node_path(p_path, &entry.scope);
+	entry.scope_version = entry.scope->data.node_path_version;
+	data.node_path_cache->insert(p_path, entry);
+	return entry.node;
+}
+
+Node *Node::_resolve_node_path(const NodePath &p_path, const Node **r_scope) const {
 	Node *current = nullptr;
 	Node *root = nullptr;
+	// Highest node the resolution depended on, always this node or one of its ancestors.
+	const Node *scope = this;
 
 	if (!p_path.is_absolute()) {
 		current = const_cast<Node *>(this); //start from this
@@ -1918,10 +2080,14 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 
 		} else if (name == SNAME("..")) {
 			if (current == nullptr || !current->data.parent) {
-				return nullptr;
+				current = nullptr;
+				break;
 			}
 
 			next = current->data.parent;
+			if (current == scope) {
+				scope = next;
+			}
 		} else if (current == nullptr) {
 			if (name == root->get_name()) {
 				next = root;
@@ -1931,9 +2097,13 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 			Node **unique = current->data.owned_unique_nodes.getptr(name);
 			if (!unique && current->data.owner) {
 				unique = current->data.owner->data.owned_unique_nodes.getptr(name);
+				if (r_scope && current->data.owner->is_ancestor_of(scope)) {
+					scope = current->data.owner;
+				}
 			}
 			if (!unique) {
-				return nullptr;
+				current = nullptr;
+				break;
 			}
 			next = *unique;
 		} else {
@@ -1942,12 +2112,16 @@ Node *Node::get_node_or_null(const NodePath &p_path) const {
 			if (node) {
 				next = const_cast<Node *>(*node);
 			} else {
-				return nullptr;
+				current = nullptr;
+				break;
 			}
 		}
 		current = next;
 	}
 
+	if (r_scope) {
+		*r_scope = scope;
+	}
 	return current;
 }
 
@@ -2203,6 +2377,7 @@ void Node::_set_owner_nocheck(Node *p_owner) {
 
 	ERR_FAIL_COND(data.owner);
 	data.owner = p_owner;
+	_invalidate_node_paths();
 	data.owner->data.owned.push_back(this);
 	data.OW = data.owner->data.owned.back();
 
@@ -2217,6 +2392,7 @@ void Node::_release_unique_name_in_owner() {
 		return; // Ignore.
 	}
 	data.owner->data.owned_unique_nodes.erase(key);
+	_invalidate_node_paths();
 }
 
 void Node::_acquire_unique_name_in_owner() {
@@ -2231,6 +2407,7 @@ void Node::_acquire_unique_name_in_owner() {
 		return;
 	}
 	data.owner->data.owned_unique_nodes[key] = this;
+	_invalidate_node_paths();
 }
 
 void Node::set_unique_name_in_owner(bool p_enabled) {
@@ -2294,6 +2471,7 @@ void Node::_clean_up_owner() {
 	data.owner->data.owned.erase(data.OW);
 	data.owner = nullptr;
 	data.OW = nullptr;
+	_invalidate_node_paths();
 }
 
 Node *Node::find_common_parent_with(const Node *p_node) const {
@@ -3764,6 +3942,8 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_name"), &Node::get_name);
 	ClassDB::bind_method(D_METHOD("add_child", "node", "force_readable_name", "internal"), &Node::add_child, DEFVAL(false), DEFVAL(0));
 	ClassDB::bind_method(D_METHOD("remove_child", "node"), &Node::remove_child);
+	ClassDB::bind_method(D_METHOD("add_children", "nodes", "force_readable_name", "internal"), &Node::add_children, DEFVAL(false), DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("remove_children", "nodes"), &Node::remove_children);
 	ClassDB::bind_method(D_METHOD("reparent", "new_parent", "keep_global_transform"), &Node::reparent, DEFVAL(true));
 	ClassDB::bind_method(D_METHOD("get_child_count", "include_internal"), &Node::get_child_count, DEFVAL(false)); // Note that the default value bound for include_internal is false, while the method is declared with true. This is because internal nodes are irrelevant for GDSCript.
 	ClassDB::bind_method(D_METHOD("get_children", "include_internal"), &Node::get_children, DEFVAL(false));
@@ -4091,6 +4271,8 @@ Node::Node() {
 #ifdef DEBUG_ENABLED
 	total_node_count.increment();
 #endif
+	data.node_path_version = node_path_version_counter.increment();
+
 	// Default member initializer for bitfield is a C++20 extension, so:
 
 	data.process_mode = PROCESS_MODE_INHERIT;
@@ -4129,6 +4311,9 @@ Node::Node() {
 }
 
 Node::~Node() {
+	if (data.node_path_cache) {
+		memdelete(data.node_path_cache);
+	}
 	data.grouped.clear();
 	data.owned.clear();
 	data.children.clear();
@@ -171,6 +171,13 @@ private:
 		SceneTree::Group *group = nullptr;
 	};
 
+	struct NodePathCacheEntry {
+		Node *node = nullptr;
+		// Highest node the resolution went through, and its node path version at that time.
+		const Node *scope = nullptr;
+		uint64_t scope_version = 0;
+	};
+
 	struct ComparatorByIndex {
 		bool operator()(const Node *p_left, const Node *p_right) const {
 			static const uint32_t order[3] = { 1, 0, 2 };
@@ -204,6 +211,8 @@ private:
 		mutable LocalVector<Node *> children_cache;
 		HashMap<StringName, Node *> owned_unique_nodes;
 		bool unique_name_in_owner = false;
+		mutable HashMap<NodePath, NodePathCacheEntry> *node_path_cache = nullptr; // Resolved relative paths, only used on the main thread.
+		uint64_t node_path_version = 0; // Changes whenever something in this subtree that can affect NodePath resolution changes.
 		InternalMode internal_mode = INTERNAL_MODE_DISABLED;
 		mutable int internal_children_front_count_cache = 0;
 		mutable int internal_children_back_count_cache = 0;
@@ -301,8 +310,8 @@ private:
 
 	void _replace_connections_target(Node *p_new_target);
 
-	void _validate_child_name(Node *p_child, bool p_force_human_readable = false);
-	void _generate_serial_child_name(const Node *p_child, StringName &name) const;
+	void _validate_child_name(Node *p_child, bool p_force_human_readable = false, HashMap<String, String> *r_serial_hints = nullptr);
+	void _generate_serial_child_name(const Node *p_child, StringName &name, HashMap<String, String> *r_serial_hints = nullptr) const;
 
 	void _propagate_reverse_notification(int p_notification);
 	void _propagate_deferred_notification(int p_notification, bool p_reverse);
@@ -341,6 +350,19 @@ private:
 
 	void _clean_up_owner();
 
+	// Source of node path versions. Versions are never reused, so a freed node can't be mistaken for a cache scope.
+	static SafeNumeric<uint64_t> node_path_version_counter;
+	static constexpr uint32_t NODE_PATH_CACHE_MAX_SIZE = 64;
+
+	// Called on any change that can affect NodePath resolution (rename, add/remove child, owner and unique name changes).
+	_FORCE_INLINE_ void _invalidate_node_paths() {
+		const uint64_t version = node_path_version_counter.increment();
+		for (Node *node = this; node; node = node->data.parent) {
+			node->data.node_path_version = version;
+		}
+	}
+	Node *_resolve_node_path(const NodePath &p_path, const Node **r_scope = nullptr) const;
+
 	_FORCE_INLINE_ void _update_children_cache() const {
 		if (unlikely(data.children_cache_dirty)) {
 			_update_children_cache_impl();
@@ -390,6 +412,9 @@ protected:
 	friend class SceneState;
 
 	void _add_child_nocheck(Node *p_child, const StringName &p_name, InternalMode p_internal_mode = INTERNAL_MODE_DISABLED);
+	void _attach_child_nocheck(Node *p_child, const StringName &p_name, InternalMode p_internal_mode);
+	bool _can_add_child(Node *p_child) const;
+	void _detach_child(Node *p_child);
 	void _set_owner_nocheck(Node *p_owner);
 	void _set_name_nocheck(const StringName &p_name);
 
@@ -515,6 +540,8 @@ public:
 	void add_child(RequiredParam<Node> rp_child, bool p_force_readable_name = false, InternalMode p_internal = INTERNAL_MODE_DISABLED);
 	void add_sibling(RequiredParam<Node> rp_sibling, bool p_force_readable_name = false);
 	void remove_child(RequiredParam<Node> rp_child);
+	void add_children(const TypedArray<Node> &p_children, bool p_force_readable_name = false, InternalMode p_internal = INTERNAL_MODE_DISABLED);
+	void remove_children(const TypedArray<Node> &p_children);
 
 	/// Optimal way to iterate the children of this node.
 	/// The caller is responsible to ensure:
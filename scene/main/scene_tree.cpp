@@ -199,6 +199,7 @@ void SceneTree::flush_transform_notifications() {
 		SelfList<Node> *nx = n->next();
 		xform_change_list.remove(n);
 		n = nx;
+		xform_propagation_epoch.increment();
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
 	}
 }
@@ -394,7 +395,9 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 		nodes_removed_on_group_call_lock++;
 	}
 
-	if (p_call_flags & GROUP_CALL_REVERSE) {
+	if (p_call_flags & GROUP_CALL_THREADED && !(p_call_flags & GROUP_CALL_DEFERRED) && !node_threading_disabled && !Node::is_group_processing() && is_current_thread_safe_for_nodes()) {
+		_call_group_threaded(gr_nodes, gr_node_count, p_call_flags & GROUP_CALL_REVERSE, p_function, p_args, p_argcount);
+	} else if (p_call_flags & GROUP_CALL_REVERSE) {
 		for (int i = gr_node_count - 1; i >= 0; i--) {
 			if (nodes_removed_on_group_call_lock && nodes_removed_on_group_call.has(gr_nodes[i])) {
 				continue;
@@ -402,11 +405,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 
 			Node *node = gr_nodes[i];
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
-				Callable::CallError ce;
-				node->callp(p_function, p_args, p_argcount, ce);
-				if (unlikely(ce.error != Callable::CallError::CALL_OK && ce.error != Callable::CallError::CALL_ERROR_INVALID_METHOD)) {
-					ERR_PRINT(vformat("Error calling group method on node \"%s\": %s.", node->get_name(), Variant::get_callable_error_text(Callable(node, p_function), p_args, p_argcount, ce)));
-				}
+				_call_group_node(node, p_function, p_args, p_argcount);
 			} else {
 				MessageQueue::get_singleton()->push_callp(node, p_function, p_args, p_argcount);
 			}
@@ -420,11 +419,7 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 
 			Node *node = gr_nodes[i];
 			if (!(p_call_flags & GROUP_CALL_DEFERRED)) {
-				Callable::CallError ce;
-				node->callp(p_function, p_args, p_argcount, ce);
-				if (unlikely(ce.error != Callable::CallError::CALL_OK && ce.error != Callable::CallError::CALL_ERROR_INVALID_METHOD)) {
-					ERR_PRINT(vformat("Error calling group method on node \"%s\": %s.", node->get_name(), Variant::get_callable_error_text(Callable(node, p_function), p_args, p_argcount, ce)));
-				}
+				_call_group_node(node, p_function, p_args, p_argcount);
 			} else {
 				MessageQueue::get_singleton()->push_callp(node, p_function, p_args, p_argcount);
 			}
@@ -440,6 +435,72 @@ void SceneTree::call_group_flagsp(uint32_t p_call_flags, const StringName &p_gro
 	}
 }
 
+void SceneTree::_call_group_node(Node *p_node, const StringName &p_function, const Variant **p_args, int p_argcount) {
+	Callable::CallError ce;
+	p_node->callp(p_function, p_args, p_argcount, ce);
+	if (unlikely(ce.error != Callable::CallError::CALL_OK && ce.error != Callable::CallError::CALL_ERROR_INVALID_METHOD)) {
+		ERR_PRINT(vformat("Error calling group method on node \"%s\": %s.", p_node->get_name(), Variant::get_callable_error_text(Callable(p_node, p_function), p_args, p_argcount, ce)));
+	}
+}
+
+void SceneTree::_call_group_thread(uint32_t p_index, GroupCallThreaded *p_data) {
+	// Same guard as process groups: the worker thread acts as the owner of the process thread group,
+	// so nodes of that group (and only those) are accessible from it.
+	Node::current_process_thread_group = p_data->owners[p_index];
+	for (Node *node : p_data->nodes[p_index]) {
+		_call_group_node(node, p_data->function, p_data->args, p_data->argcount);
+	}
+	Node::current_process_thread_group = nullptr;
+}
+
+void SceneTree::_call_group_threaded(Node **p_nodes, int p_node_count, bool p_reverse, const StringName &p_function, const Variant **p_args, int p_argcount) {
+	GroupCallThreaded data;
+	data.function = p_function;
+	data.args = p_args;
+	data.argcount = p_argcount;
+
+	HashMap<Node *, uint32_t> owner_indices;
+	LocalVector<Node *> main_thread_nodes;
+
+	for (int i = 0; i < p_node_count; i++) {
+		Node *node = p_nodes[p_reverse ? p_node_count - 1 - i : i];
+		if (nodes_removed_on_group_call_lock && nodes_removed_on_group_call.has(node)) {
+			continue;
+		}
+
+		// Only nodes belonging to a sub-thread process group may be called from another thread,
+		// everything else is called from this thread once the worker threads are done.
+		Node *owner = node->data.process_thread_group_owner;
+		if (owner == nullptr || owner->data.process_thread_group != Node::PROCESS_THREAD_GROUP_SUB_THREAD) {
+			main_thread_nodes.push_back(node);
+			continue;
+		}
+
+		HashMap<Node *, uint32_t>::Iterator E = owner_indices.find(owner);
+		if (!E) {
+			E = owner_indices.insert(owner, data.owners.size());
+			data.owners.push_back(owner);
+			data.nodes.push_back(LocalVector<Node *>());
+		}
+		data.nodes[E->value].push_back(node);
+	}
+
+	if (data.owners.size() == 1) {
+		_call_group_thread(0, &data);
+	} else if (data.owners.size() > 1) {
+		WorkerThreadPool::GroupID id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneTree::_call_group_thread, &data, data.owners.size(), -1, true, SNAME("SceneTreeGroupCall"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(id);
+	}
+
+	for (Node *node : main_thread_nodes) {
+		// Nodes may have been removed by the calls above.
+		if (nodes_removed_on_group_call.has(node)) {
+			continue;
+		}
+		_call_group_node(node, p_function, p_args, p_argcount);
+	}
+}
+
 void SceneTree::notify_group_flags(uint32_t p_call_flags, const StringName &p_group, int p_notification) {
 	Vector<Node *> nodes_copy;
 	{
@@ -721,7 +782,7 @@ bool SceneTree::process(double p_time) {
 	flush_transform_notifications(); // Additional transforms after timers update.
 
 	// This should happen last because any processing that deletes something beforehand might expect the object to be removed in the same frame.
-	_flush_delete_queue();
+	_flush_deferred_budgeted();
 
 	_flush_accessibility_changes();
 
@@ -842,7 +903,8 @@ void SceneTree::process_tweens(double p_delta, bool p_physics) {
 }
 
 void SceneTree::finalize() {
-	_flush_delete_queue();
+	deferred_budget_usec = 0;
+	_flush_deferred_budgeted();
 
 	_flush_ugc();
 
@@ -1348,6 +1410,7 @@ bool SceneTree::ProcessGroupSort::operator()(const ProcessGroup *p_left, const P
 
 void SceneTree::_remove_process_group(Node *p_node) {
 	_THREAD_SAFE_METHOD_
+	_flush_process_group_batch();
 	ProcessGroup *pg = (ProcessGroup *)p_node->data.process_group;
 	ERR_FAIL_NULL(pg);
 	ERR_FAIL_COND(pg->removed);
@@ -1373,6 +1436,8 @@ void SceneTree::_add_process_group(Node *p_node) {
 
 void SceneTree::_remove_node_from_process_group(Node *p_node, Node *p_owner) {
 	_THREAD_SAFE_METHOD_
+	// The node may still be waiting in the batch.
+	_flush_process_group_batch();
 	ProcessGroup *pg = p_owner ? (ProcessGroup *)p_owner->data.process_group : &default_process_group;
 
 	if (p_node->is_processing() || p_node->is_processing_internal()) {
@@ -1390,6 +1455,16 @@ void SceneTree::_add_node_to_process_group(Node *p_node, Node *p_owner) {
 	_THREAD_SAFE_METHOD_
 	ProcessGroup *pg = p_owner ? (ProcessGroup *)p_owner->data.process_group : &default_process_group;
 
+	if (process_group_batch_depth > 0 && Thread::is_main_thread()) {
+		ProcessGroupRegistration registration;
+		registration.group = pg;
+		registration.node = p_node;
+		registration.process = p_node->is_processing() || p_node->is_processing_internal();
+		registration.physics_process = p_node->is_physics_processing() || p_node->is_physics_processing_internal();
+		process_group_batch.push_back(registration);
+		return;
+	}
+
 	if (p_node->is_processing() || p_node->is_processing_internal()) {
 		pg->nodes.push_back(p_node);
 		pg->node_order_dirty = true;
@@ -1401,6 +1476,54 @@ void SceneTree::_add_node_to_process_group(Node *p_node, Node *p_owner) {
 	}
 }
 
+void SceneTree::_begin_process_group_batch() {
+	process_group_batch_depth++;
+}
+
+void SceneTree::_end_process_group_batch() {
+	ERR_FAIL_COND(process_group_batch_depth == 0);
+	process_group_batch_depth--;
+	if (process_group_batch_depth == 0) {
+		_flush_process_group_batch();
+	}
+}
+
+void SceneTree::_flush_process_group_batch() {
+	_THREAD_SAFE_METHOD_
+	if (process_group_batch.is_empty()) {
+		return;
+	}
+
+	// Grow the node lists of each process group once for the whole batch, instead of once per node.
+	HashMap<ProcessGroup *, Vector2i> added_counts;
+	for (const ProcessGroupRegistration &registration : process_group_batch) {
+		Vector2i &count = added_counts[registration.group];
+		count.x += registration.process ? 1 : 0;
+		count.y += registration.physics_process ? 1 : 0;
+	}
+	for (const KeyValue<ProcessGroup *, Vector2i> &E : added_counts) {
+		ProcessGroup *pg = E.key;
+		if (E.value.x > 0) {
+			pg->nodes.reserve(pg->nodes.size() + E.value.x);
+			pg->node_order_dirty = true;
+		}
+		if (E.value.y > 0) {
+			pg->physics_nodes.reserve(pg->physics_nodes.size() + E.value.y);
+			pg->physics_node_order_dirty = true;
+		}
+	}
+
+	for (const ProcessGroupRegistration &registration : process_group_batch) {
+		if (registration.process) {
+			registration.group->nodes.push_back(registration.node);
+		}
+		if (registration.physics_process) {
+			registration.group->physics_nodes.push_back(registration.node);
+		}
+	}
+	process_group_batch.clear();
+}
+
 void SceneTree::_call_input_pause(const StringName &p_group, CallInputType p_call_type, const Ref<InputEvent> &p_input, Viewport *p_viewport) {
 	Vector<Node *> nodes_copy;
 	{
@@ -1616,6 +1739,138 @@ void SceneTree::queue_delete(RequiredParam<Object> rp_object) {
 	delete_queue.push_back(p_object->get_instance_id());
 }
 
+void SceneTree::_call_budgeted(const Callable &p_callable) {
+	Callable::CallError ce;
+	Variant ret;
+	p_callable.callp(nullptr, 0, ret, ce);
+	if (ce.error != Callable::CallError::CALL_OK) {
+		ERR_PRINT("Error calling budgeted deferred method: " + Variant::get_callable_error_text(p_callable, nullptr, 0, ce) + ".");
+	}
+}
+
+bool SceneTree::_pop_budgeted_call(int p_priority, Callable &r_callable) {
+	_THREAD_SAFE_METHOD_
+	List<Callable> &queue = budgeted_calls[p_priority];
+	if (queue.is_empty()) {
+		return false;
+	}
+	r_callable = queue.front()->get();
+	queue.pop_front();
+	return true;
+}
+
+bool SceneTree::_pop_delete_queue(ObjectID &r_id) {
+	_THREAD_SAFE_METHOD_
+	if (delete_queue.is_empty()) {
+		return false;
+	}
+	r_id = delete_queue.front()->get();
+	delete_queue.pop_front();
+	return true;
+}
+
+bool SceneTree::_flush_budgeted_item(int p_queue) {
+	// Queues are, in order: normal priority calls, queued deletions, low priority calls.
+	if (p_queue == 1) {
+		ObjectID id;
+		if (!_pop_delete_queue(id)) {
+			return false;
+		}
+		Object *obj = ObjectDB::get_instance(id);
+		if (obj) {
+			memdelete(obj);
+		}
+		return true;
+	}
+
+	Callable callable;
+	if (!_pop_budgeted_call(p_queue == 0 ? DEFERRED_CALL_PRIORITY_NORMAL : DEFERRED_CALL_PRIORITY_LOW, callable)) {
+		return false;
+	}
+	_call_budgeted(callable);
+	return true;
+}
+
+void SceneTree::_flush_deferred_budgeted() {
+	// Only the items queued before the flush are handled, like in MessageQueue, so a call that queues itself again
+	// runs on the next flush instead of keeping this one busy forever, even without a budget.
+	int high_priority_count = 0;
+	int pending_counts[3] = {};
+	{
+		_THREAD_SAFE_METHOD_
+		high_priority_count = budgeted_calls[DEFERRED_CALL_PRIORITY_HIGH].size();
+		pending_counts[0] = budgeted_calls[DEFERRED_CALL_PRIORITY_NORMAL].size();
+		pending_counts[1] = delete_queue.size();
+		pending_counts[2] = budgeted_calls[DEFERRED_CALL_PRIORITY_LOW].size();
+	}
+
+	// High priority calls are never budgeted. The budgeted queues first get an equal share of the budget each,
+	// and handle at least one item every frame, so a flood in one queue can't starve the others.
+	// What is left of the budget then goes to the queues in order.
+	Callable callable;
+	for (int i = 0; i < high_priority_count && _pop_budgeted_call(DEFERRED_CALL_PRIORITY_HIGH, callable); i++) {
+		_call_budgeted(callable);
+	}
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	const uint64_t share = deferred_budget_usec / 3;
+
+	for (int queue = 0; queue < 3; queue++) {
+		const uint64_t queue_begin = OS::get_singleton()->get_ticks_usec();
+		bool handled_any = false;
+		while (pending_counts[queue] > 0 && (!handled_any || deferred_budget_usec == 0 || OS::get_singleton()->get_ticks_usec() - queue_begin < share)) {
+			if (!_flush_budgeted_item(queue)) {
+				break;
+			}
+			pending_counts[queue]--;
+			handled_any = true;
+		}
+	}
+
+	if (deferred_budget_usec == 0) {
+		return;
+	}
+
+	for (int queue = 0; queue < 3; queue++) {
+		while (pending_counts[queue] > 0 && OS::get_singleton()->get_ticks_usec() - begin < deferred_budget_usec) {
+			if (!_flush_budgeted_item(queue)) {
+				break;
+			}
+			pending_counts[queue]--;
+		}
+	}
+}
+
+void SceneTree::call_deferred_budgeted(const Callable &p_callable, DeferredCallPriority p_priority) {
+	_THREAD_SAFE_METHOD_
+	ERR_FAIL_INDEX(p_priority, DEFERRED_CALL_PRIORITY_MAX);
+	ERR_FAIL_COND(!p_callable.is_valid());
+	budgeted_calls[p_priority].push_back(p_callable);
+}
+
+void SceneTree::set_deferred_budget_msec(double p_msec) {
+	ERR_FAIL_COND(p_msec < 0.0);
+	deferred_budget_usec = uint64_t(p_msec * 1000.0);
+}
+
+double SceneTree::get_deferred_budget_msec() const {
+	return deferred_budget_usec / 1000.0;
+}
+
+int SceneTree::get_deferred_call_backlog() const {
+	_THREAD_SAFE_METHOD_
+	int count = 0;
+	for (const List<Callable> &queue : budgeted_calls) {
+		count += queue.size();
+	}
+	return count;
+}
+
+int SceneTree::get_delete_queue_backlog() const {
+	_THREAD_SAFE_METHOD_
+	return delete_queue.size();
+}
+
 int SceneTree::get_node_count() const {
 	return nodes_in_tree_count;
 }
@@ -1898,6 +2153,11 @@ void SceneTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_physics_interpolation_enabled"), &SceneTree::is_physics_interpolation_enabled);
 
 	ClassDB::bind_method(D_METHOD("queue_delete", "obj"), &SceneTree::queue_delete);
+	ClassDB::bind_method(D_METHOD("call_deferred_budgeted", "callable", "priority"), &SceneTree::call_deferred_budgeted, DEFVAL(DEFERRED_CALL_PRIORITY_NORMAL));
+	ClassDB::bind_method(D_METHOD("set_deferred_budget_msec", "msec"), &SceneTree::set_deferred_budget_msec);
+	ClassDB::bind_method(D_METHOD("get_deferred_budget_msec"), &SceneTree::get_deferred_budget_msec);
+	ClassDB::bind_method(D_METHOD("get_deferred_call_backlog"), &SceneTree::get_deferred_call_backlog);
+	ClassDB::bind_method(D_METHOD("get_delete_queue_backlog"), &SceneTree::get_delete_queue_backlog);
 
 	MethodInfo mi;
 	mi.name = "call_group_flags";
@@ -1950,6 +2210,7 @@ void SceneTree::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "root", PROPERTY_HINT_RESOURCE_TYPE, "Node", PROPERTY_USAGE_NONE), "", "get_root");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "multiplayer_poll"), "set_multiplayer_poll_enabled", "is_multiplayer_poll_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "physics_interpolation"), "set_physics_interpolation_enabled", "is_physics_interpolation_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "deferred_budget_msec", PROPERTY_HINT_RANGE, "0,100,0.01,or_greater,suffix:ms"), "set_deferred_budget_msec", "get_deferred_budget_msec");
 
 	ADD_SIGNAL(MethodInfo("tree_changed"));
 	ADD_SIGNAL(MethodInfo("scene_changed"));
@@ -1966,6 +2227,12 @@ void SceneTree::_bind_methods() {
 	BIND_ENUM_CONSTANT(GROUP_CALL_REVERSE);
 	BIND_ENUM_CONSTANT(GROUP_CALL_DEFERRED);
 	BIND_ENUM_CONSTANT(GROUP_CALL_UNIQUE);
+	BIND_ENUM_CONSTANT(GROUP_CALL_THREADED);
+
+	BIND_ENUM_CONSTANT(DEFERRED_CALL_PRIORITY_HIGH);
+	BIND_ENUM_CONSTANT(DEFERRED_CALL_PRIORITY_NORMAL);
+	BIND_ENUM_CONSTANT(DEFERRED_CALL_PRIORITY_LOW);
+	BIND_ENUM_CONSTANT(DEFERRED_CALL_PRIORITY_MAX);
 }
 
 SceneTree *SceneTree::singleton = nullptr;
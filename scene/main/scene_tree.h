@@ -115,8 +115,26 @@ private:
 
 	ProcessGroup default_process_group;
 
+	// Process group registrations delayed while Node::add_children() brings a batch of nodes into the tree.
+	struct ProcessGroupRegistration {
+		ProcessGroup *group = nullptr;
+		Node *node = nullptr;
+		bool process = false;
+		bool physics_process = false;
+	};
+	LocalVector<ProcessGroupRegistration> process_group_batch;
+	int process_group_batch_depth = 0;
+
 	bool node_threading_disabled = false;
 
+	struct GroupCallThreaded {
+		StringName function;
+		const Variant **args = nullptr;
+		int argcount = 0;
+		LocalVector<Node *> owners;
+		LocalVector<LocalVector<Node *>> nodes; // One bucket per sub-thread process group owner.
+	};
+
 	struct Group {
 		Vector<Node *> nodes;
 		bool changed = false;
@@ -186,6 +204,10 @@ private:
 
 	List<ObjectID> delete_queue;
 
+	// Work spread over several frames, see call_deferred_budgeted().
+	List<Callable> budgeted_calls[3]; // One queue per DeferredCallPriority.
+	uint64_t deferred_budget_usec = 0; // Zero means no budget, everything is flushed every frame.
+
 	uint64_t accessibility_upd_per_sec = 0;
 	bool accessibility_force_update = true;
 	HashSet<ObjectID> accessibility_change_queue;
@@ -240,21 +262,36 @@ private:
 	void _process_groups_thread(uint32_t p_index, bool p_physics);
 	void _process(bool p_physics);
 
+	void _call_group_node(Node *p_node, const StringName &p_function, const Variant **p_args, int p_argcount);
+	void _call_group_thread(uint32_t p_index, GroupCallThreaded *p_data);
+	void _call_group_threaded(Node **p_nodes, int p_node_count, bool p_reverse, const StringName &p_function, const Variant **p_args, int p_argcount);
+
 	void _remove_process_group(Node *p_node);
 	void _add_process_group(Node *p_node);
 	void _remove_node_from_process_group(Node *p_node, Node *p_owner);
 	void _add_node_to_process_group(Node *p_node, Node *p_owner);
+	void _begin_process_group_batch();
+	void _end_process_group_batch();
+	void _flush_process_group_batch();
 
 	void _call_group_flags(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	void _call_group(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
 	void _flush_delete_queue();
+	bool _flush_budgeted_item(int p_queue);
+	void _flush_deferred_budgeted();
+	void _call_budgeted(const Callable &p_callable);
+	bool _pop_budgeted_call(int p_priority, Callable &r_callable);
+	bool _pop_delete_queue(ObjectID &r_id);
 	// Optimization.
 	friend class CanvasItem;
 	friend class Node3D;
 	friend class Viewport;
 
 	SelfList<Node>::List xform_change_list;
+	// Bumped whenever pending transform notifications are delivered or a Node3D changes how it takes part
+	// in transform propagation, so Node3D can skip re-propagating into subtrees that are still dirty.
+	SafeNumeric<uint64_t> xform_propagation_epoch{ 1 };
 
 #ifdef DEBUG_ENABLED // No live editor in release build.
 	friend class LiveEditor;
@@ -291,11 +328,19 @@ public:
 		NOTIFICATION_TRANSFORM_CHANGED = 2000
 	};
 
+	enum DeferredCallPriority {
+		DEFERRED_CALL_PRIORITY_HIGH,
+		DEFERRED_CALL_PRIORITY_NORMAL,
+		DEFERRED_CALL_PRIORITY_LOW,
+		DEFERRED_CALL_PRIORITY_MAX
+	};
+
 	enum GroupCallFlags {
 		GROUP_CALL_DEFAULT = 0,
 		GROUP_CALL_REVERSE = 1,
 		GROUP_CALL_DEFERRED = 2,
 		GROUP_CALL_UNIQUE = 4,
+		GROUP_CALL_THREADED = 8,
 	};
 
 	_FORCE_INLINE_ Window *get_root() const { return root; }
@@ -409,6 +454,12 @@ public:
 
 	void queue_delete(RequiredParam<Object> rp_object);
 
+	void call_deferred_budgeted(const Callable &p_callable, DeferredCallPriority p_priority = DEFERRED_CALL_PRIORITY_NORMAL);
+	void set_deferred_budget_msec(double p_msec);
+	double get_deferred_budget_msec() const;
+	int get_deferred_call_backlog() const;
+	int get_delete_queue_backlog() const;
+
 	Vector<Node *> get_nodes_in_group(const StringName &p_group);
 	Node *get_first_node_in_group(const StringName &p_group);
 	bool has_group(const StringName &p_identifier) const;
@@ -473,3 +524,4 @@ public:
 };
 
 VARIANT_ENUM_CAST(SceneTree::GroupCallFlags);
+VARIANT_ENUM_CAST(SceneTree::DeferredCallPriority);
@@ -30,13 +30,18 @@
 
 #include "navigation_mesh_source_geometry_data_3d.h"
 
+#include "core/object/worker_thread_pool.h"
+#include "scene/resources/3d/primitive_meshes.h"
+
 void NavigationMeshSourceGeometryData3D::set_vertices(const Vector<float> &p_vertices) {
 	RWLockWrite write_lock(geometry_rwlock);
+	_flush_deferred_geometry();
 	vertices = p_vertices;
 	bounds_dirty = true;
 }
 
 const Vector<float> &NavigationMeshSourceGeometryData3D::get_vertices() const {
+	_flush_deferred_geometry_if_needed();
 	RWLockRead read_lock(geometry_rwlock);
 	return vertices;
 }
@@ -44,17 +49,20 @@ const Vector<float> &NavigationMeshSourceGeometryData3D::get_vertices() const {
 void NavigationMeshSourceGeometryData3D::set_indices(const Vector<int> &p_indices) {
 	ERR_FAIL_COND(vertices.size() < p_indices.size());
 	RWLockWrite write_lock(geometry_rwlock);
+	_flush_deferred_geometry();
 	indices = p_indices;
 	bounds_dirty = true;
 }
 
 const Vector<int> &NavigationMeshSourceGeometryData3D::get_indices() const {
+	_flush_deferred_geometry_if_needed();
 	RWLockRead read_lock(geometry_rwlock);
 	return indices;
 }
 
 void NavigationMeshSourceGeometryData3D::append_arrays(const Vector<float> &p_vertices, const Vector<int> &p_indices) {
 	RWLockWrite write_lock(geometry_rwlock);
+	_flush_deferred_geometry();
 
 	const int64_t number_of_vertices_before_merge = vertices.size();
 	const int64_t number_of_indices_before_merge = indices.size();
@@ -70,13 +78,15 @@ void NavigationMeshSourceGeometryData3D::append_arrays(const Vector<float> &p_ve
 
 bool NavigationMeshSourceGeometryData3D::has_data() {
 	RWLockRead read_lock(geometry_rwlock);
-	return vertices.size() && indices.size();
+	// Deferred chunks are never empty, checking them avoids converting the geometry just to answer this.
+	return (vertices.size() && indices.size()) || !deferred_geometry_chunks.is_empty();
 }
 
 void NavigationMeshSourceGeometryData3D::clear() {
 	RWLockWrite write_lock(geometry_rwlock);
 	vertices.clear();
 	indices.clear();
+	_clear_deferred_geometry();
 	_projected_obstructions.clear();
 	bounds_dirty = true;
 }
@@ -87,67 +97,259 @@ void NavigationMeshSourceGeometryData3D::clear_projected_obstructions() {
 	bounds_dirty = true;
 }
 
-void NavigationMeshSourceGeometryData3D::_add_vertex(const Vector3 &p_vec3) {
-	vertices.push_back(p_vec3.x);
-	vertices.push_back(p_vec3.y);
-	vertices.push_back(p_vec3.z);
+bool NavigationMeshSourceGeometryData3D::_get_surface_from_arrays(const Array &p_arrays, bool p_indexed, int p_index_count, GeometryChunk &r_surface) {
+	ERR_FAIL_COND_V(p_arrays.is_empty() || (p_arrays.size() != Mesh::ARRAY_MAX), false);
+
+	Vector<Vector3> mesh_vertices = p_arrays[Mesh::ARRAY_VERTEX];
+	ERR_FAIL_COND_V(mesh_vertices.is_empty(), false);
+
+	if (p_indexed) {
+		Vector<int> mesh_indices = p_arrays[Mesh::ARRAY_INDEX];
+		ERR_FAIL_COND_V(mesh_indices.is_empty() || (mesh_indices.size() != p_index_count), false);
+		r_surface.type = GeometryChunk::TYPE_INDEXED;
+		r_surface.source_indices = mesh_indices;
+	} else {
+		ERR_FAIL_COND_V(mesh_vertices.size() != p_index_count, false);
+		r_surface.type = GeometryChunk::TYPE_TRIANGLES;
+	}
+	r_surface.source_vertices = mesh_vertices;
+	return true;
 }
 
-void NavigationMeshSourceGeometryData3D::_add_mesh(const Ref<Mesh> &p_mesh, const Transform3D &p_xform) {
-	int current_vertex_count;
+void NavigationMeshSourceGeometryData3D::_get_mesh_surfaces(const Ref<Mesh> &p_mesh, LocalVector<GeometryChunk> &r_surfaces) {
 	for (int i = 0; i < p_mesh->get_surface_count(); i++) {
-		current_vertex_count = vertices.size() / 3;
-
 		if (p_mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
 			continue;
 		}
 
-		int index_count = 0;
-		if (p_mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
-			index_count = p_mesh->surface_get_array_index_len(i);
-		} else {
-			index_count = p_mesh->surface_get_array_len(i);
+		const bool indexed = p_mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX;
+		const int index_count = indexed ? p_mesh->surface_get_array_index_len(i) : p_mesh->surface_get_array_len(i);
+		ERR_CONTINUE((index_count == 0 || (index_count % 3) != 0));
+
+		GeometryChunk surface;
+		if (_get_surface_from_arrays(p_mesh->surface_get_arrays(i), indexed, index_count, surface)) {
+			r_surfaces.push_back(surface);
 		}
+	}
+}
 
-		ERR_CONTINUE((index_count == 0 || (index_count % 3) != 0));
+void NavigationMeshSourceGeometryData3D::_get_mesh_surface_snapshots(const Ref<Mesh> &p_mesh, LocalVector<GeometryChunk> &r_surfaces) {
+	const RID mesh_rid = p_mesh->get_rid();
+	for (int i = 0; i < p_mesh->get_surface_count(); i++) {
+		if (p_mesh->surface_get_primitive_type(i) != Mesh::PRIMITIVE_TRIANGLES) {
+			continue;
+		}
+
+		MeshSurfaceSnapshot snapshot;
+		snapshot.indexed = p_mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX;
+		snapshot.index_count = snapshot.indexed ? p_mesh->surface_get_array_index_len(i) : p_mesh->surface_get_array_len(i);
+		ERR_CONTINUE((snapshot.index_count == 0 || (snapshot.index_count % 3) != 0));
+
+		// Only the read back has to happen on this thread, it is the same one that ArrayMesh::surface_get_arrays() does.
+		snapshot.surface_data = RenderingServer::get_singleton()->mesh_get_surface(mesh_rid, i);
+		ERR_CONTINUE(snapshot.surface_data.vertex_count == 0);
+
+		GeometryChunk surface;
+		surface.surface_snapshot = deferred_surface_snapshots.size();
+		deferred_surface_snapshots.push_back(snapshot);
+		r_surfaces.push_back(surface);
+	}
+}
+
+void NavigationMeshSourceGeometryData3D::_decode_surface_snapshot(uint32_t p_index, MeshSurfaceSnapshot *p_snapshots) {
+	MeshSurfaceSnapshot &snapshot = p_snapshots[p_index];
+	const Array arrays = RenderingServer::get_singleton()->mesh_create_arrays_from_surface_data(snapshot.surface_data);
+	_get_surface_from_arrays(arrays, snapshot.indexed, snapshot.index_count, snapshot.surface);
+	snapshot.surface_data = RenderingServer::SurfaceData();
+}
 
-		int face_count = index_count / 3;
+static _FORCE_INLINE_ void _write_vertex(float *p_vertices, int p_index, const Vector3 &p_vertex) {
+	p_vertices[p_index * 3 + 0] = p_vertex.x;
+	p_vertices[p_index * 3 + 1] = p_vertex.y;
+	p_vertices[p_index * 3 + 2] = p_vertex.z;
+}
 
-		Array a = p_mesh->surface_get_arrays(i);
-		ERR_CONTINUE(a.is_empty() || (a.size() != Mesh::ARRAY_MAX));
+void NavigationMeshSourceGeometryData3D::_convert_geometry_chunk(const GeometryChunk &p_chunk, float *r_vertices, int *r_indices) {
+	const Transform3D &xform = p_chunk.xform;
+	const Vector3 *vr = p_chunk.source_vertices.ptr();
+	const int vertex_count = p_chunk.source_vertices.size();
+	const int current_vertex_count = p_chunk.vertex_offset / 3;
 
-		Vector<Vector3> mesh_vertices = a[Mesh::ARRAY_VERTEX];
-		ERR_CONTINUE(mesh_vertices.is_empty());
-		const Vector3 *vr = mesh_vertices.ptr();
+	float *vw = r_vertices + p_chunk.vertex_offset;
+	int *iw = r_indices + p_chunk.index_offset;
 
-		if (p_mesh->surface_get_format(i) & Mesh::ARRAY_FORMAT_INDEX) {
-			Vector<int> mesh_indices = a[Mesh::ARRAY_INDEX];
-			ERR_CONTINUE(mesh_indices.is_empty() || (mesh_indices.size() != index_count));
-			const int *ir = mesh_indices.ptr();
+	switch (p_chunk.type) {
+		case GeometryChunk::TYPE_INDEXED: {
+			const int *ir = p_chunk.source_indices.ptr();
+			const int face_count = p_chunk.source_indices.size() / 3;
 
-			for (int j = 0; j < mesh_vertices.size(); j++) {
-				_add_vertex(p_xform.xform(vr[j]));
+			for (int j = 0; j < vertex_count; j++) {
+				_write_vertex(vw, j, xform.xform(vr[j]));
 			}
 
 			for (int j = 0; j < face_count; j++) {
 				// CCW
-				indices.push_back(current_vertex_count + (ir[j * 3 + 0]));
-				indices.push_back(current_vertex_count + (ir[j * 3 + 2]));
-				indices.push_back(current_vertex_count + (ir[j * 3 + 1]));
+				iw[j * 3 + 0] = current_vertex_count + ir[j * 3 + 0];
+				iw[j * 3 + 1] = current_vertex_count + ir[j * 3 + 2];
+				iw[j * 3 + 2] = current_vertex_count + ir[j * 3 + 1];
 			}
-		} else {
-			ERR_CONTINUE(mesh_vertices.size() != index_count);
-			face_count = mesh_vertices.size() / 3;
+		} break;
+		case GeometryChunk::TYPE_TRIANGLES: {
+			const int face_count = vertex_count / 3;
+
+			for (int j = 0; j < face_count; j++) {
+				_write_vertex(vw, j * 3 + 0, xform.xform(vr[j * 3 + 0]));
+				_write_vertex(vw, j * 3 + 1, xform.xform(vr[j * 3 + 2]));
+				_write_vertex(vw, j * 3 + 2, xform.xform(vr[j * 3 + 1]));
+
+				iw[j * 3 + 0] = current_vertex_count + (j * 3 + 0);
+				iw[j * 3 + 1] = current_vertex_count + (j * 3 + 1);
+				iw[j * 3 + 2] = current_vertex_count + (j * 3 + 2);
+			}
+		} break;
+		case GeometryChunk::TYPE_FACES: {
+			const int face_count = vertex_count / 3;
+
 			for (int j = 0; j < face_count; j++) {
-				_add_vertex(p_xform.xform(vr[j * 3 + 0]));
-				_add_vertex(p_xform.xform(vr[j * 3 + 2]));
-				_add_vertex(p_xform.xform(vr[j * 3 + 1]));
+				_write_vertex(vw, j * 3 + 0, xform.xform(vr[j * 3 + 0]));
+				_write_vertex(vw, j * 3 + 1, xform.xform(vr[j * 3 + 1]));
+				_write_vertex(vw, j * 3 + 2, xform.xform(vr[j * 3 + 2]));
 
-				indices.push_back(current_vertex_count + (j * 3 + 0));
-				indices.push_back(current_vertex_count + (j * 3 + 1));
-				indices.push_back(current_vertex_count + (j * 3 + 2));
+				iw[j * 3 + 0] = current_vertex_count + (j * 3 + 0);
+				iw[j * 3 + 1] = current_vertex_count + (j * 3 + 2);
+				iw[j * 3 + 2] = current_vertex_count + (j * 3 + 1);
+			}
+		} break;
+	}
+}
+
+void NavigationMeshSourceGeometryData3D::_convert_deferred_geometry_chunk(uint32_t p_index, DeferredGeometryFlush *p_flush) {
+	_convert_geometry_chunk(p_flush->chunks[p_index], p_flush->vertices, p_flush->indices);
+}
+
+void NavigationMeshSourceGeometryData3D::_add_geometry_chunk(const GeometryChunk &p_chunk) {
+	deferred_geometry_chunks.push_back(p_chunk);
+	if (!defer_geometry) {
+		_flush_deferred_geometry();
+	}
+}
+
+void NavigationMeshSourceGeometryData3D::_flush_deferred_geometry() {
+	if (deferred_geometry_chunks.is_empty()) {
+		return;
+	}
+
+	// Group tasks would block the pool thread this already runs on when flushed from the bake task, convert serially there.
+	const bool use_threads = defer_geometry_use_threads && WorkerThreadPool::get_singleton()->get_thread_index() == -1;
+
+	if (!deferred_surface_snapshots.is_empty()) {
+		// Every snapshot is decoded once, even when many chunks share its mesh, and before the chunks are sized.
+		if (use_threads && deferred_surface_snapshots.size() > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavigationMeshSourceGeometryData3D::_decode_surface_snapshot, deferred_surface_snapshots.ptr(), deferred_surface_snapshots.size(), -1, true, SNAME("NavMeshSourceGeometryDecode3D"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = 0; i < deferred_surface_snapshots.size(); i++) {
+				_decode_surface_snapshot(i, deferred_surface_snapshots.ptr());
 			}
 		}
+
+		auto resolve_snapshots = [this](LocalVector<GeometryChunk> &r_chunks) {
+			for (GeometryChunk &chunk : r_chunks) {
+				if (chunk.surface_snapshot != UINT32_MAX) {
+					const GeometryChunk &surface = deferred_surface_snapshots[chunk.surface_snapshot].surface;
+					chunk.type = surface.type;
+					chunk.source_vertices = surface.source_vertices;
+					chunk.source_indices = surface.source_indices;
+					chunk.surface_snapshot = UINT32_MAX;
+				}
+			}
+		};
+		resolve_snapshots(deferred_geometry_chunks);
+		// The cached mesh surfaces are resolved as well, in case more instances of their meshes are added after this flush.
+		for (KeyValue<ObjectID, LocalVector<GeometryChunk>> &E : deferred_mesh_surfaces) {
+			resolve_snapshots(E.value);
+		}
+		deferred_surface_snapshots.clear();
+	}
+
+	// Every chunk converts straight into its own range of the final arrays, so they are only grown once
+	// and no intermediate copy of the converted geometry is kept.
+	int64_t vertex_count = vertices.size();
+	int64_t index_count = indices.size();
+	for (GeometryChunk &chunk : deferred_geometry_chunks) {
+		chunk.vertex_offset = vertex_count;
+		chunk.index_offset = index_count;
+		vertex_count += chunk.source_vertices.size() * 3;
+		if (chunk.type == GeometryChunk::TYPE_INDEXED) {
+			index_count += (chunk.source_indices.size() / 3) * 3;
+		} else {
+			index_count += (chunk.source_vertices.size() / 3) * 3;
+		}
+	}
+	vertices.resize(vertex_count);
+	indices.resize(index_count);
+
+	DeferredGeometryFlush flush;
+	flush.chunks = deferred_geometry_chunks.ptr();
+	flush.vertices = vertices.ptrw();
+	flush.indices = indices.ptrw();
+
+	if (use_threads && deferred_geometry_chunks.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavigationMeshSourceGeometryData3D::_convert_deferred_geometry_chunk, &flush, deferred_geometry_chunks.size(), -1, true, SNAME("NavMeshSourceGeometryConvert3D"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (const GeometryChunk &chunk : deferred_geometry_chunks) {
+			_convert_geometry_chunk(chunk, flush.vertices, flush.indices);
+		}
+	}
+
+	deferred_geometry_chunks.clear();
+	bounds_dirty = true;
+}
+
+void NavigationMeshSourceGeometryData3D::_clear_deferred_geometry() {
+	deferred_geometry_chunks.clear();
+	deferred_surface_snapshots.clear();
+	deferred_mesh_surfaces.clear();
+}
+
+void NavigationMeshSourceGeometryData3D::_flush_deferred_geometry_if_needed() const {
+	geometry_rwlock.read_lock();
+	const bool needs_flush = !deferred_geometry_chunks.is_empty();
+	geometry_rwlock.read_unlock();
+
+	if (needs_flush) {
+		NavigationMeshSourceGeometryData3D *self = const_cast<NavigationMeshSourceGeometryData3D *>(this);
+		RWLockWrite write_lock(self->geometry_rwlock);
+		self->_flush_deferred_geometry();
+	}
+}
+
+void NavigationMeshSourceGeometryData3D::_add_mesh(const Ref<Mesh> &p_mesh, const Transform3D &p_xform) {
+	LocalVector<GeometryChunk> mesh_surfaces;
+	const LocalVector<GeometryChunk> *surfaces = &mesh_surfaces;
+
+	if (defer_geometry) {
+		// Meshes shared by many nodes or MultiMesh instances are only read back once.
+		const ObjectID mesh_id = p_mesh->get_instance_id();
+		LocalVector<GeometryChunk> *cached_surfaces = deferred_mesh_surfaces.getptr(mesh_id);
+		if (!cached_surfaces) {
+			cached_surfaces = &deferred_mesh_surfaces.insert(mesh_id, LocalVector<GeometryChunk>())->value;
+			if (Object::cast_to<ArrayMesh>(p_mesh.ptr()) || Object::cast_to<PrimitiveMesh>(p_mesh.ptr())) {
+				_get_mesh_surface_snapshots(p_mesh, *cached_surfaces);
+			} else {
+				_get_mesh_surfaces(p_mesh, *cached_surfaces);
+			}
+		}
+		surfaces = cached_surfaces;
+	} else {
+		_get_mesh_surfaces(p_mesh, mesh_surfaces);
+	}
+
+	for (const GeometryChunk &surface : *surfaces) {
+		GeometryChunk chunk = surface;
+		chunk.xform = p_xform;
+		_add_geometry_chunk(chunk);
 	}
 }
 
@@ -156,42 +358,27 @@ void NavigationMeshSourceGeometryData3D::_add_mesh_array(const Array &p_mesh_arr
 
 	Vector<Vector3> mesh_vertices = p_mesh_array[Mesh::ARRAY_VERTEX];
 	ERR_FAIL_COND(mesh_vertices.is_empty());
-	const Vector3 *vr = mesh_vertices.ptr();
 
 	Vector<int> mesh_indices = p_mesh_array[Mesh::ARRAY_INDEX];
 	ERR_FAIL_COND(mesh_indices.is_empty());
-	const int *ir = mesh_indices.ptr();
-
-	const int face_count = mesh_indices.size() / 3;
-	const int current_vertex_count = vertices.size() / 3;
 
-	for (int j = 0; j < mesh_vertices.size(); j++) {
-		_add_vertex(p_xform.xform(vr[j]));
-	}
-
-	for (int j = 0; j < face_count; j++) {
-		// CCW
-		indices.push_back(current_vertex_count + (ir[j * 3 + 0]));
-		indices.push_back(current_vertex_count + (ir[j * 3 + 2]));
-		indices.push_back(current_vertex_count + (ir[j * 3 + 1]));
-	}
+	GeometryChunk chunk;
+	chunk.type = GeometryChunk::TYPE_INDEXED;
+	chunk.source_vertices = mesh_vertices;
+	chunk.source_indices = mesh_indices;
+	chunk.xform = p_xform;
+	_add_geometry_chunk(chunk);
 }
 
 void NavigationMeshSourceGeometryData3D::_add_faces(const PackedVector3Array &p_faces, const Transform3D &p_xform) {
 	ERR_FAIL_COND(p_faces.is_empty());
 	ERR_FAIL_COND(p_faces.size() % 3 != 0);
-	int face_count = p_faces.size() / 3;
-	int current_vertex_count = vertices.size() / 3;
 
-	for (int j = 0; j < face_count; j++) {
-		_add_vertex(p_xform.xform(p_faces[j * 3 + 0]));
-		_add_vertex(p_xform.xform(p_faces[j * 3 + 1]));
-		_add_vertex(p_xform.xform(p_faces[j * 3 + 2]));
-
-		indices.push_back(current_vertex_count + (j * 3 + 0));
-		indices.push_back(current_vertex_count + (j * 3 + 2));
-		indices.push_back(current_vertex_count + (j * 3 + 1));
-	}
+	GeometryChunk chunk;
+	chunk.type = GeometryChunk::TYPE_FACES;
+	chunk.source_vertices = p_faces;
+	chunk.xform = p_xform;
+	_add_geometry_chunk(chunk);
 }
 
 void NavigationMeshSourceGeometryData3D::add_mesh(const Ref<Mesh> &p_mesh, const Transform3D &p_xform) {
@@ -205,6 +392,7 @@ void NavigationMeshSourceGeometryData3D::add_mesh(const Ref<Mesh> &p_mesh, const
 	}
 #endif
 
+	RWLockWrite write_lock(geometry_rwlock);
 	_add_mesh(p_mesh, root_node_transform * p_xform);
 }
 
@@ -212,14 +400,12 @@ void NavigationMeshSourceGeometryData3D::add_mesh_array(const Array &p_mesh_arra
 	ERR_FAIL_COND(p_mesh_array.size() != Mesh::ARRAY_MAX);
 	RWLockWrite write_lock(geometry_rwlock);
 	_add_mesh_array(p_mesh_array, root_node_transform * p_xform);
-	bounds_dirty = true;
 }
 
 void NavigationMeshSourceGeometryData3D::add_faces(const PackedVector3Array &p_faces, const Transform3D &p_xform) {
 	ERR_FAIL_COND(p_faces.size() % 3 != 0);
 	RWLockWrite write_lock(geometry_rwlock);
 	_add_faces(p_faces, root_node_transform * p_xform);
-	bounds_dirty = true;
 }
 
 void NavigationMeshSourceGeometryData3D::merge(const Ref<NavigationMeshSourceGeometryData3D> &p_other_geometry) {
@@ -232,6 +418,7 @@ void NavigationMeshSourceGeometryData3D::merge(const Ref<NavigationMeshSourceGeo
 	p_other_geometry->get_data(other_vertices, other_indices, other_projected_obstructions);
 
 	RWLockWrite write_lock(geometry_rwlock);
+	_flush_deferred_geometry();
 	const int64_t number_of_vertices_before_merge = vertices.size();
 	const int64_t number_of_indices_before_merge = indices.size();
 
@@ -343,6 +530,7 @@ bool NavigationMeshSourceGeometryData3D::_get(const StringName &p_name, Variant
 
 void NavigationMeshSourceGeometryData3D::set_data(const Vector<float> &p_vertices, const Vector<int> &p_indices, Vector<ProjectedObstruction> &p_projected_obstructions) {
 	RWLockWrite write_lock(geometry_rwlock);
+	_clear_deferred_geometry();
 	vertices = p_vertices;
 	indices = p_indices;
 	_projected_obstructions = p_projected_obstructions;
@@ -350,6 +538,7 @@ void NavigationMeshSourceGeometryData3D::set_data(const Vector<float> &p_vertice
 }
 
 void NavigationMeshSourceGeometryData3D::get_data(Vector<float> &r_vertices, Vector<int> &r_indices, Vector<ProjectedObstruction> &r_projected_obstructions) {
+	_flush_deferred_geometry_if_needed();
 	RWLockRead read_lock(geometry_rwlock);
 	r_vertices = vertices;
 	r_indices = indices;
@@ -357,6 +546,7 @@ void NavigationMeshSourceGeometryData3D::get_data(Vector<float> &r_vertices, Vec
 }
 
 AABB NavigationMeshSourceGeometryData3D::get_bounds() {
+	_flush_deferred_geometry_if_needed();
 	geometry_rwlock.read_lock();
 
 	if (bounds_dirty) {
@@ -395,6 +585,20 @@ AABB NavigationMeshSourceGeometryData3D::get_bounds() {
 	return bounds;
 }
 
+void NavigationMeshSourceGeometryData3D::begin_deferred_geometry(bool p_use_threads) {
+	RWLockWrite write_lock(geometry_rwlock);
+	_flush_deferred_geometry();
+	defer_geometry = true;
+	defer_geometry_use_threads = p_use_threads;
+}
+
+void NavigationMeshSourceGeometryData3D::end_deferred_geometry() {
+	RWLockWrite write_lock(geometry_rwlock);
+	// The collected chunks stay pending until the geometry is first read, usually by the bake task.
+	defer_geometry = false;
+	deferred_mesh_surfaces.clear();
+}
+
 void NavigationMeshSourceGeometryData3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_vertices", "vertices"), &NavigationMeshSourceGeometryData3D::set_vertices);
 	ClassDB::bind_method(D_METHOD("get_vertices"), &NavigationMeshSourceGeometryData3D::get_vertices);
@@ -31,6 +31,8 @@
 #pragma once
 
 #include "core/os/rw_lock.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "scene/resources/mesh.h"
 
 class NavigationMeshSourceGeometryData3D : public Resource {
@@ -43,6 +45,49 @@ class NavigationMeshSourceGeometryData3D : public Resource {
 	AABB bounds;
 	bool bounds_dirty = true;
 
+	struct GeometryChunk {
+		enum Type {
+			TYPE_INDEXED, // Indexed vertices, the face winding is flipped with the indices.
+			TYPE_TRIANGLES, // Non-indexed mesh surface, the face winding is flipped with the vertex order.
+			TYPE_FACES, // Face array, the face winding is flipped with the indices.
+		};
+
+		Type type = TYPE_INDEXED;
+		Vector<Vector3> source_vertices;
+		Vector<int> source_indices;
+		Transform3D xform;
+
+		// Surface snapshot that the source arrays are decoded from when flushing, if any.
+		uint32_t surface_snapshot = UINT32_MAX;
+
+		// Where the converted geometry starts in the final arrays, set when flushing.
+		int64_t vertex_offset = 0;
+		int64_t index_offset = 0;
+	};
+
+	// ArrayMesh and PrimitiveMesh surfaces are read back while parsing, decoding them into arrays is left to the flush.
+	struct MeshSurfaceSnapshot {
+		RenderingServer::SurfaceData surface_data;
+		bool indexed = false;
+		int index_count = 0;
+
+		// The decoded surface, without vertices if decoding failed.
+		GeometryChunk surface;
+	};
+
+	struct DeferredGeometryFlush {
+		const GeometryChunk *chunks = nullptr;
+		float *vertices = nullptr;
+		int *indices = nullptr;
+	};
+
+	// While deferred the added geometry is only collected, it is converted in one go when first read, on worker threads if allowed.
+	bool defer_geometry = false;
+	bool defer_geometry_use_threads = false;
+	LocalVector<GeometryChunk> deferred_geometry_chunks;
+	LocalVector<MeshSurfaceSnapshot> deferred_surface_snapshots;
+	HashMap<ObjectID, LocalVector<GeometryChunk>> deferred_mesh_surfaces;
+
 public:
 	struct ProjectedObstruction;
 
@@ -55,7 +100,17 @@ protected:
 	static void _bind_methods();
 
 private:
-	void _add_vertex(const Vector3 &p_vec3);
+	static bool _get_surface_from_arrays(const Array &p_arrays, bool p_indexed, int p_index_count, GeometryChunk &r_surface);
+	static void _get_mesh_surfaces(const Ref<Mesh> &p_mesh, LocalVector<GeometryChunk> &r_surfaces);
+	void _get_mesh_surface_snapshots(const Ref<Mesh> &p_mesh, LocalVector<GeometryChunk> &r_surfaces);
+	void _decode_surface_snapshot(uint32_t p_index, MeshSurfaceSnapshot *p_snapshots);
+	static void _convert_geometry_chunk(const GeometryChunk &p_chunk, float *r_vertices, int *r_indices);
+	void _convert_deferred_geometry_chunk(uint32_t p_index, DeferredGeometryFlush *p_flush);
+	void _add_geometry_chunk(const GeometryChunk &p_chunk);
+	void _flush_deferred_geometry();
+	void _clear_deferred_geometry();
+	void _flush_deferred_geometry_if_needed() const;
+
 	void _add_mesh(const Ref<Mesh> &p_mesh, const Transform3D &p_xform);
 	void _add_mesh_array(const Array &p_array, const Transform3D &p_xform);
 	void _add_faces(const PackedVector3Array &p_faces, const Transform3D &p_xform);
@@ -105,5 +160,10 @@ public:
 
 	AABB get_bounds();
 
+	// Used by the navigation mesh generator while parsing the scene tree.
+	// Meshes are read back when added but their vertices are only transformed when the geometry is first read.
+	void begin_deferred_geometry(bool p_use_threads);
+	void end_deferred_geometry();
+
 	~NavigationMeshSourceGeometryData3D() { clear(); }
 };
@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*  nav_agent_grid.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/math_funcs.h"
+#include "core/math/vector3.h"
+#include "core/templates/local_vector.h"
+
+// This file contains NavAgentGrid which is used by both 2D and 3D navigation.
+
+/**
+ * A uniform grid used instead of the RVO kd-tree to find the neighbors of the avoidance agents.
+ * Agents are sorted by cell on the XZ plane, with their positions stored next to each other for the distance checks.
+ * The Y axis is only part of the distances, 2D agents are added with a Y of zero.
+ */
+class NavAgentGrid {
+	float origin_x = 0.0;
+	float origin_z = 0.0;
+	float cell_size = 1.0;
+	int32_t width = 0;
+	int32_t depth = 0;
+
+	/// Start of each cell in the agent arrays, with one extra entry for the end of the last cell.
+	LocalVector<uint32_t> cell_offsets;
+
+	/// Index of each agent in the positions given to build().
+	LocalVector<uint32_t> indices;
+	LocalVector<float> positions_x;
+	LocalVector<float> positions_y;
+	LocalVector<float> positions_z;
+
+public:
+	bool is_empty() const { return indices.is_empty(); }
+
+	void build(const LocalVector<Vector3> &p_positions) {
+		indices.clear();
+		positions_x.clear();
+		positions_y.clear();
+		positions_z.clear();
+		cell_offsets.clear();
+		width = 0;
+		depth = 0;
+
+		const uint32_t agent_count = p_positions.size();
+		if (agent_count == 0) {
+			return;
+		}
+
+		float min_x = FLT_MAX, min_z = FLT_MAX;
+		float max_x = -FLT_MAX, max_z = -FLT_MAX;
+		for (const Vector3 &position : p_positions) {
+			min_x = MIN(min_x, (float)position.x);
+			min_z = MIN(min_z, (float)position.z);
+			max_x = MAX(max_x, (float)position.x);
+			max_z = MAX(max_z, (float)position.z);
+		}
+
+		// Size the cells so that each holds a few agents on average, regardless of the neighbor distances.
+		constexpr float AGENTS_PER_CELL = 4.0;
+		const float area = MAX((max_x - min_x) * (max_z - min_z), 1.0f);
+		cell_size = MAX(Math::sqrt(area * AGENTS_PER_CELL / agent_count), 0.01f);
+		origin_x = min_x;
+		origin_z = min_z;
+		width = MIN((int32_t)((max_x - min_x) / cell_size) + 1, 4096);
+		depth = MIN((int32_t)((max_z - min_z) / cell_size) + 1, 4096);
+		cell_size = MAX(cell_size, MAX((max_x - min_x) / width, (max_z - min_z) / depth) * 1.001f);
+
+		const uint32_t cell_count = width * depth;
+		cell_offsets.resize_initialized(cell_count + 1);
+
+		LocalVector<uint32_t> agent_cells;
+		agent_cells.resize(agent_count);
+		for (uint32_t i = 0; i < agent_count; i++) {
+			const int32_t cell_x = CLAMP((int32_t)(((float)p_positions[i].x - origin_x) / cell_size), 0, width - 1);
+			const int32_t cell_z = CLAMP((int32_t)(((float)p_positions[i].z - origin_z) / cell_size), 0, depth - 1);
+			agent_cells[i] = cell_z * width + cell_x;
+			cell_offsets[agent_cells[i] + 1]++;
+		}
+		for (uint32_t i = 0; i < cell_count; i++) {
+			cell_offsets[i + 1] += cell_offsets[i];
+		}
+
+		indices.resize(agent_count);
+		positions_x.resize(agent_count);
+		positions_y.resize(agent_count);
+		positions_z.resize(agent_count);
+
+		LocalVector<uint32_t> cell_fill;
+		cell_fill.resize_initialized(cell_count);
+		for (uint32_t i = 0; i < agent_count; i++) {
+			const uint32_t index = cell_offsets[agent_cells[i]] + cell_fill[agent_cells[i]]++;
+			indices[index] = i;
+			positions_x[index] = p_positions[i].x;
+			positions_y[index] = p_positions[i].y;
+			positions_z[index] = p_positions[i].z;
+		}
+	}
+
+	/**
+	 * Calls p_callback with the index of every agent closer than the range to p_position, nearest cells first.
+	 * The callback may shrink r_range_sq, as the RVO agents do once they have enough neighbors.
+	 */
+	template <typename Callback>
+	void query(const Vector3 &p_position, float &r_range_sq, Callback p_callback) const {
+		if (indices.is_empty()) {
+			return;
+		}
+
+		const float position_x = p_position.x;
+		const float position_y = p_position.y;
+		const float position_z = p_position.z;
+		const int32_t center_x = (int32_t)Math::floor((position_x - origin_x) / cell_size);
+		const int32_t center_z = (int32_t)Math::floor((position_z - origin_z) / cell_size);
+		const int32_t max_ring = (int32_t)Math::ceil(Math::sqrt(r_range_sq) / cell_size) + 1;
+
+		// Visit the cells in rings around the position, nearest first, until no cell of the next ring can be in range.
+		for (int32_t ring = 0; ring <= max_ring; ring++) {
+			if (ring > 0) {
+				const float ring_distance = (ring - 1) * cell_size;
+				if (ring_distance * ring_distance >= r_range_sq) {
+					break;
+				}
+			}
+
+			const int32_t x_begin = MAX(center_x - ring, 0);
+			const int32_t x_end = MIN(center_x + ring, width - 1);
+			const int32_t z_begin = MAX(center_z - ring, 0);
+			const int32_t z_end = MIN(center_z + ring, depth - 1);
+			for (int32_t cell_z = z_begin; cell_z <= z_end; cell_z++) {
+				// Rows at both sides of the ring are visited fully, the other rows only at both ends.
+				const bool edge_row = cell_z == center_z - ring || cell_z == center_z + ring;
+				const int32_t x_step = edge_row ? 1 : 2 * ring;
+				for (int32_t cell_x = edge_row ? x_begin : center_x - ring; cell_x <= x_end; cell_x += x_step) {
+					if (cell_x < x_begin) {
+						continue;
+					}
+
+					const float cell_min_x = origin_x + cell_x * cell_size;
+					const float cell_min_z = origin_z + cell_z * cell_size;
+					const float cell_dx = MAX(MAX(cell_min_x - position_x, position_x - (cell_min_x + cell_size)), 0.0f);
+					const float cell_dz = MAX(MAX(cell_min_z - position_z, position_z - (cell_min_z + cell_size)), 0.0f);
+					if (cell_dx * cell_dx + cell_dz * cell_dz >= r_range_sq) {
+						continue;
+					}
+
+					const uint32_t cell = cell_z * width + cell_x;
+					for (uint32_t i = cell_offsets[cell]; i < cell_offsets[cell + 1]; i++) {
+						const float dx = positions_x[i] - position_x;
+						const float dy = positions_y[i] - position_y;
+						const float dz = positions_z[i] - position_z;
+						if (dx * dx + dy * dy + dz * dz < r_range_sq) {
+							p_callback(indices[i]);
+						}
+					}
+				}
+			}
+
+			if (center_x - ring <= 0 && center_x + ring >= width - 1 && center_z - ring <= 0 && center_z + ring >= depth - 1) {
+				// The ring already covers the whole grid.
+				break;
+			}
+		}
+	}
+};
@@ -73,6 +73,10 @@ constexpr const char *const NAV_MESH_CELL_SIZE_HINT = "0.001,100,0.001,or_greate
 constexpr float EDGE_CONNECTION_MARGIN = 0.25f;
 constexpr float LINK_CONNECTION_RADIUS = 1.0f;
 constexpr int path_search_max_polygons = 4096;
+constexpr int HIERARCHY_CLUSTER_POLYGON_COUNT = 64; // Max polygons grouped into one cluster for hierarchical pathfinding.
+constexpr int FLOW_FIELD_CACHE_SIZE = 8; // Max flow fields kept per map iteration, the oldest is dropped first.
+constexpr int PATH_CACHE_SIZE = 256; // Max path corridors kept per map iteration, the oldest is dropped first.
+constexpr float PATH_CACHE_CELL_SIZE = 1.0f; // Path queries share a cached path corridor when their start and end positions fall into the same cells of this size.
 
 // Agent.
 
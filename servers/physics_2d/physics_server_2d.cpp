@@ -31,6 +31,7 @@
 #include "physics_server_2d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/variant/typed_array.h"
 
 PhysicsServer2D *PhysicsServer2D::singleton = nullptr;
@@ -219,6 +220,63 @@ void PhysicsRayQueryParameters2D::_bind_methods() {
 
 ///////////////////////////////////////////////////////
 
+void PhysicsRayQueryResult2D::resize(int p_ray_count) {
+	results.resize(p_ray_count);
+	collided.resize(p_ray_count);
+}
+
+int PhysicsRayQueryResult2D::get_ray_count() const {
+	return results.size();
+}
+
+bool PhysicsRayQueryResult2D::is_colliding(int p_ray_index) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_ray_index, collided.size(), false);
+	return collided[p_ray_index];
+}
+
+Vector2 PhysicsRayQueryResult2D::get_position(int p_ray_index) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_ray_index, results.size(), Vector2());
+	return collided[p_ray_index] ? results[p_ray_index].position : Vector2();
+}
+
+Vector2 PhysicsRayQueryResult2D::get_normal(int p_ray_index) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_ray_index, results.size(), Vector2());
+	return collided[p_ray_index] ? results[p_ray_index].normal : Vector2();
+}
+
+ObjectID PhysicsRayQueryResult2D::get_collider_id(int p_ray_index) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_ray_index, results.size(), ObjectID());
+	return collided[p_ray_index] ? results[p_ray_index].collider_id : ObjectID();
+}
+
+RID PhysicsRayQueryResult2D::get_collider_rid(int p_ray_index) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_ray_index, results.size(), RID());
+	return collided[p_ray_index] ? results[p_ray_index].rid : RID();
+}
+
+Object *PhysicsRayQueryResult2D::get_collider(int p_ray_index) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_ray_index, results.size(), nullptr);
+	return collided[p_ray_index] ? ObjectDB::get_instance(results[p_ray_index].collider_id) : nullptr;
+}
+
+int PhysicsRayQueryResult2D::get_collider_shape(int p_ray_index) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_ray_index, results.size(), 0);
+	return collided[p_ray_index] ? results[p_ray_index].shape : 0;
+}
+
+void PhysicsRayQueryResult2D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_ray_count"), &PhysicsRayQueryResult2D::get_ray_count);
+	ClassDB::bind_method(D_METHOD("is_colliding", "ray_index"), &PhysicsRayQueryResult2D::is_colliding);
+	ClassDB::bind_method(D_METHOD("get_position", "ray_index"), &PhysicsRayQueryResult2D::get_position);
+	ClassDB::bind_method(D_METHOD("get_normal", "ray_index"), &PhysicsRayQueryResult2D::get_normal);
+	ClassDB::bind_method(D_METHOD("get_collider_id", "ray_index"), &PhysicsRayQueryResult2D::get_collider_id);
+	ClassDB::bind_method(D_METHOD("get_collider_rid", "ray_index"), &PhysicsRayQueryResult2D::get_collider_rid);
+	ClassDB::bind_method(D_METHOD("get_collider", "ray_index"), &PhysicsRayQueryResult2D::get_collider);
+	ClassDB::bind_method(D_METHOD("get_collider_shape", "ray_index"), &PhysicsRayQueryResult2D::get_collider_shape);
+}
+
+///////////////////////////////////////////////////////
+
 void PhysicsPointQueryParameters2D::set_exclude(const TypedArray<RID> &p_exclude) {
 	parameters.exclude.clear();
 	for (int i = 0; i < p_exclude.size(); i++) {
@@ -357,6 +415,181 @@ Dictionary PhysicsDirectSpaceState2D::_intersect_ray(RequiredParam<PhysicsRayQue
 	return d;
 }
 
+int PhysicsDirectSpaceState2D::_intersect_rays(const TypedArray<PhysicsRayQueryParameters2D> &p_ray_queries, RequiredParam<PhysicsRayQueryResult2D> rp_result) {
+	EXTRACT_PARAM_OR_FAIL_V(p_result, rp_result, 0);
+
+	int count = p_ray_queries.size();
+
+	LocalVector<RayParameters> parameters;
+	parameters.resize(count);
+	for (int i = 0; i < count; i++) {
+		Ref<PhysicsRayQueryParameters2D> ray_query = p_ray_queries[i];
+		ERR_FAIL_COND_V(ray_query.is_null(), 0);
+		parameters[i] = ray_query->get_parameters();
+	}
+
+	p_result->resize(count);
+	return intersect_rays(parameters.ptr(), count, p_result->get_results_ptr(), p_result->get_collided_ptr());
+}
+
+int PhysicsDirectSpaceState2D::intersect_rays(const RayParameters *p_parameters, int p_count, RayResult *r_results, bool *r_collided) {
+	if (p_count <= 0) {
+		return 0;
+	}
+
+	QueryBatch batch;
+	batch.type = QUERY_BATCH_RAYS;
+	batch.rays = p_parameters;
+	batch.ray_results = r_results;
+	batch.ray_collided = r_collided;
+	for (int i = 0; i < p_count; i++) {
+		r_collided[i] = false;
+	}
+	_run_query_batch(batch, p_count);
+
+	int hits = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_collided[i]) {
+			hits++;
+		}
+	}
+	return hits;
+}
+
+int PhysicsDirectSpaceState2D::intersect_shapes(const ShapeParameters *p_parameters, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	if (p_count <= 0) {
+		return 0;
+	}
+
+	QueryBatch batch;
+	batch.type = QUERY_BATCH_SHAPES;
+	batch.shapes = p_parameters;
+	batch.shape_results = r_results;
+	batch.shape_result_max = p_result_max;
+	batch.shape_result_counts = r_result_counts;
+	for (int i = 0; i < p_count; i++) {
+		r_result_counts[i] = 0;
+	}
+	_run_query_batch(batch, p_count);
+
+	int total = 0;
+	for (int i = 0; i < p_count; i++) {
+		total += r_result_counts[i];
+	}
+	return total;
+}
+
+int PhysicsDirectSpaceState2D::cast_motions(const ShapeParameters *p_parameters, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	if (p_count <= 0) {
+		return 0;
+	}
+
+	QueryBatch batch;
+	batch.type = QUERY_BATCH_MOTIONS;
+	batch.shapes = p_parameters;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+	for (int i = 0; i < p_count; i++) {
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+	}
+	_run_query_batch(batch, p_count);
+
+	int hits = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_closest_unsafe[i] < 1.0) {
+			hits++;
+		}
+	}
+	return hits;
+}
+
+void PhysicsDirectSpaceState2D::_run_query_batch_chunk(const QueryBatch &p_batch, uint32_t p_from, uint32_t p_to) {
+	for (uint32_t i = p_from; i < p_to; i++) {
+		const uint32_t query = p_batch.order[i];
+		switch (p_batch.type) {
+			case QUERY_BATCH_RAYS: {
+				p_batch.ray_collided[query] = intersect_ray(p_batch.rays[query], p_batch.ray_results[query]);
+			} break;
+			case QUERY_BATCH_SHAPES: {
+				p_batch.shape_result_counts[query] = intersect_shape(p_batch.shapes[query], p_batch.shape_results + query * p_batch.shape_result_max, p_batch.shape_result_max);
+			} break;
+			case QUERY_BATCH_MOTIONS: {
+				cast_motion(p_batch.shapes[query], p_batch.closest_safe[query], p_batch.closest_unsafe[query]);
+			} break;
+		}
+	}
+}
+
+void PhysicsDirectSpaceState2D::_query_batch_task(uint32_t p_chunk, QueryBatch *p_batch) {
+	const uint32_t from = p_chunk * QUERY_BATCH_CHUNK_SIZE;
+	_run_query_batch_chunk(*p_batch, from, MIN(from + QUERY_BATCH_CHUNK_SIZE, p_batch->order.size()));
+}
+
+static uint32_t _spread_morton_bits_2d(uint32_t p_value) {
+	// Interleaves the lower 16 bits with one zero bit each.
+	p_value &= 0xffff;
+	p_value = (p_value | (p_value << 8)) & 0x00ff00ff;
+	p_value = (p_value | (p_value << 4)) & 0x0f0f0f0f;
+	p_value = (p_value | (p_value << 2)) & 0x33333333;
+	p_value = (p_value | (p_value << 1)) & 0x55555555;
+	return p_value;
+}
+
+void PhysicsDirectSpaceState2D::_run_query_batch(QueryBatch &p_batch, int p_count) {
+	p_batch.order.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		p_batch.order[i] = i;
+	}
+
+	const uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+	if (chunk_count > 1) {
+		// Order the queries along a Morton curve over the bounds of the batch, so that each chunk covers a compact region
+		// and its queries keep visiting the same broadphase nodes and colliders.
+		LocalVector<Vector2> positions;
+		positions.resize(p_count);
+		Rect2 bounds;
+		for (int i = 0; i < p_count; i++) {
+			if (p_batch.type == QUERY_BATCH_RAYS) {
+				positions[i] = (p_batch.rays[i].from + p_batch.rays[i].to) * 0.5;
+			} else {
+				positions[i] = p_batch.shapes[i].transform.get_origin() + p_batch.shapes[i].motion * 0.5;
+			}
+			if (i == 0) {
+				bounds.position = positions[i];
+			} else {
+				bounds.expand_to(positions[i]);
+			}
+		}
+
+		struct SortKey {
+			uint32_t code = 0;
+			uint32_t index = 0;
+			bool operator<(const SortKey &p_other) const { return code == p_other.code ? index < p_other.index : code < p_other.code; }
+		};
+
+		LocalVector<SortKey> keys;
+		keys.resize(p_count);
+		const Vector2 scale = Vector2(65535.0, 65535.0) / bounds.size.maxf(CMP_EPSILON);
+		for (int i = 0; i < p_count; i++) {
+			const Vector2 cell = (positions[i] - bounds.position) * scale;
+			keys[i].code = _spread_morton_bits_2d((uint32_t)cell.x) | (_spread_morton_bits_2d((uint32_t)cell.y) << 1);
+			keys[i].index = i;
+		}
+		keys.sort();
+		for (int i = 0; i < p_count; i++) {
+			p_batch.order[i] = keys[i].index;
+		}
+	}
+
+	if (_begin_query_batch(p_batch) && chunk_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &PhysicsDirectSpaceState2D::_query_batch_task, &p_batch, chunk_count, -1, true, SNAME("Physics2DQueryBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_run_query_batch_chunk(p_batch, 0, p_count);
+	}
+}
+
 TypedArray<Dictionary> PhysicsDirectSpaceState2D::_intersect_point(RequiredParam<PhysicsPointQueryParameters2D> rp_point_query, int p_max_results) {
 	EXTRACT_PARAM_OR_FAIL_V(p_point_query, rp_point_query, TypedArray<Dictionary>());
 
@@ -462,6 +695,7 @@ PhysicsDirectSpaceState2D::PhysicsDirectSpaceState2D() {
 void PhysicsDirectSpaceState2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "parameters", "max_results"), &PhysicsDirectSpaceState2D::_intersect_point, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState2D::_intersect_ray);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "result"), &PhysicsDirectSpaceState2D::_intersect_rays);
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState2D::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState2D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState2D::_collide_shape, DEFVAL(32));
@@ -645,6 +879,9 @@ void PhysicsServer2D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer2D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer2D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer2D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_save_state", "space"), &PhysicsServer2D::space_save_state);
+	ClassDB::bind_method(D_METHOD("space_restore_state", "space", "state"), &PhysicsServer2D::space_restore_state);
+	ClassDB::bind_method(D_METHOD("space_get_state_hash", "space"), &PhysicsServer2D::space_get_state_hash);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer2D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer2D::area_set_space);
@@ -811,6 +1048,7 @@ void PhysicsServer2D::_bind_methods() {
 	BIND_ENUM_CONSTANT(SPACE_PARAM_BODY_TIME_TO_SLEEP);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONSTRAINT_DEFAULT_BIAS);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_SOLVER_ITERATIONS);
+	BIND_ENUM_CONSTANT(SPACE_PARAM_DETERMINISTIC);
 
 	BIND_ENUM_CONSTANT(SHAPE_WORLD_BOUNDARY);
 	BIND_ENUM_CONSTANT(SHAPE_SEPARATION_RAY);
@@ -896,6 +1134,8 @@ void PhysicsServer2D::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_ACTIVE_OBJECTS);
 	BIND_ENUM_CONSTANT(INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(INFO_SLEEPING_OBJECTS);
+	BIND_ENUM_CONSTANT(INFO_SLEEPING_COLLISION_PAIRS);
 }
 
 PhysicsServer2D::PhysicsServer2D() {
@@ -917,6 +1157,7 @@ PhysicsServer2D::PhysicsServer2D() {
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/solver/contact_max_allowed_penetration", PROPERTY_HINT_RANGE, "0.01,10,0.01,or_greater"), 0.3);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/solver/default_contact_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.8);
 	GLOBAL_DEF(PropertyInfo(Variant::FLOAT, "physics/2d/solver/default_constraint_bias", PROPERTY_HINT_RANGE, "0,1,0.01"), 0.2);
+	GLOBAL_DEF("physics/2d/solver/deterministic", false);
 }
 
 PhysicsServer2D::~PhysicsServer2D() {
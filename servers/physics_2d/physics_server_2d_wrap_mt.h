@@ -128,6 +128,18 @@ public:
 		return physics_server_2d->space_get_contact_count(p_space);
 	}
 
+	virtual uint32_t space_get_state_hash(RID p_space) const override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), 0);
+		return physics_server_2d->space_get_state_hash(p_space);
+	}
+
+	virtual Vector<uint8_t> space_save_state(RID p_space) const override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), Vector<uint8_t>());
+		return physics_server_2d->space_save_state(p_space);
+	}
+
+	FUNC2(space_restore_state, RID, const Vector<uint8_t> &);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
@@ -31,6 +31,7 @@
 #include "physics_server_3d.h"
 
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/variant/typed_array.h"
 
 void PhysicsServer3DRenderingServerHandler::set_vertex(int p_vertex_id, const Vector3 &p_vertex) {
@@ -237,6 +238,69 @@ void PhysicsRayQueryParameters3D::_bind_methods() {
 
 ///////////////////////////////////////////////////////
 
+void PhysicsRayQueryResult3D::resize(int p_ray_count) {
+	results.resize(p_ray_count);
+	collided.resize(p_ray_count);
+}
+
+int PhysicsRayQueryResult3D::get_ray_count() const {
+	return results.size();
+}
+
+bool PhysicsRayQueryResult3D::is_colliding(int p_ray_index) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_ray_index, collided.size(), false);
+	return collided[p_ray_index];
+}
+
+Vector3 PhysicsRayQueryResult3D::get_position(int p_ray_index) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_ray_index, results.size(), Vector3());
+	return collided[p_ray_index] ? results[p_ray_index].position : Vector3();
+}
+
+Vector3 PhysicsRayQueryResult3D::get_normal(int p_ray_index) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_ray_index, results.size(), Vector3());
+	return collided[p_ray_index] ? results[p_ray_index].normal : Vector3();
+}
+
+int PhysicsRayQueryResult3D::get_face_index(int p_ray_index) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_ray_index, results.size(), -1);
+	return collided[p_ray_index] ? results[p_ray_index].face_index : -1;
+}
+
+ObjectID PhysicsRayQueryResult3D::get_collider_id(int p_ray_index) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_ray_index, results.size(), ObjectID());
+	return collided[p_ray_index] ? results[p_ray_index].collider_id : ObjectID();
+}
+
+RID PhysicsRayQueryResult3D::get_collider_rid(int p_ray_index) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_ray_index, results.size(), RID());
+	return collided[p_ray_index] ? results[p_ray_index].rid : RID();
+}
+
+Object *PhysicsRayQueryResult3D::get_collider(int p_ray_index) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_ray_index, results.size(), nullptr);
+	return collided[p_ray_index] ? ObjectDB::get_instance(results[p_ray_index].collider_id) : nullptr;
+}
+
+int PhysicsRayQueryResult3D::get_collider_shape(int p_ray_index) const {
+	ERR_FAIL_UNSIGNED_INDEX_V((uint32_t)p_ray_index, results.size(), 0);
+	return collided[p_ray_index] ? results[p_ray_index].shape : 0;
+}
+
+void PhysicsRayQueryResult3D::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_ray_count"), &PhysicsRayQueryResult3D::get_ray_count);
+	ClassDB::bind_method(D_METHOD("is_colliding", "ray_index"), &PhysicsRayQueryResult3D::is_colliding);
+	ClassDB::bind_method(D_METHOD("get_position", "ray_index"), &PhysicsRayQueryResult3D::get_position);
+	ClassDB::bind_method(D_METHOD("get_normal", "ray_index"), &PhysicsRayQueryResult3D::get_normal);
+	ClassDB::bind_method(D_METHOD("get_face_index", "ray_index"), &PhysicsRayQueryResult3D::get_face_index);
+	ClassDB::bind_method(D_METHOD("get_collider_id", "ray_index"), &PhysicsRayQueryResult3D::get_collider_id);
+	ClassDB::bind_method(D_METHOD("get_collider_rid", "ray_index"), &PhysicsRayQueryResult3D::get_collider_rid);
+	ClassDB::bind_method(D_METHOD("get_collider", "ray_index"), &PhysicsRayQueryResult3D::get_collider);
+	ClassDB::bind_method(D_METHOD("get_collider_shape", "ray_index"), &PhysicsRayQueryResult3D::get_collider_shape);
+}
+
+///////////////////////////////////////////////////////
+
 Ref<PhysicsRayQueryParameters3D> PhysicsRayQueryParameters3D::create(Vector3 p_from, Vector3 p_to, uint32_t p_mask, const TypedArray<RID> &p_exclude) {
 	Ref<PhysicsRayQueryParameters3D> params;
 	params.instantiate();
@@ -382,6 +446,181 @@ Dictionary PhysicsDirectSpaceState3D::_intersect_ray(RequiredParam<PhysicsRayQue
 	return d;
 }
 
+int PhysicsDirectSpaceState3D::_intersect_rays(const TypedArray<PhysicsRayQueryParameters3D> &p_ray_queries, RequiredParam<PhysicsRayQueryResult3D> rp_result) {
+	EXTRACT_PARAM_OR_FAIL_V(p_result, rp_result, 0);
+
+	int count = p_ray_queries.size();
+
+	LocalVector<RayParameters> parameters;
+	parameters.resize(count);
+	for (int i = 0; i < count; i++) {
+		Ref<PhysicsRayQueryParameters3D> ray_query = p_ray_queries[i];
+		ERR_FAIL_COND_V(ray_query.is_null(), 0);
+		parameters[i] = ray_query->get_parameters();
+	}
+
+	p_result->resize(count);
+	return intersect_rays(parameters.ptr(), count, p_result->get_results_ptr(), p_result->get_collided_ptr());
+}
+
+int PhysicsDirectSpaceState3D::intersect_rays(const RayParameters *p_parameters, int p_count, RayResult *r_results, bool *r_collided) {
+	if (p_count <= 0) {
+		return 0;
+	}
+
+	QueryBatch batch;
+	batch.type = QUERY_BATCH_RAYS;
+	batch.rays = p_parameters;
+	batch.ray_results = r_results;
+	batch.ray_collided = r_collided;
+	for (int i = 0; i < p_count; i++) {
+		r_collided[i] = false;
+	}
+	_run_query_batch(batch, p_count);
+
+	int hits = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_collided[i]) {
+			hits++;
+		}
+	}
+	return hits;
+}
+
+int PhysicsDirectSpaceState3D::intersect_shapes(const ShapeParameters *p_parameters, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts) {
+	if (p_count <= 0) {
+		return 0;
+	}
+
+	QueryBatch batch;
+	batch.type = QUERY_BATCH_SHAPES;
+	batch.shapes = p_parameters;
+	batch.shape_results = r_results;
+	batch.shape_result_max = p_result_max;
+	batch.shape_result_counts = r_result_counts;
+	for (int i = 0; i < p_count; i++) {
+		r_result_counts[i] = 0;
+	}
+	_run_query_batch(batch, p_count);
+
+	int total = 0;
+	for (int i = 0; i < p_count; i++) {
+		total += r_result_counts[i];
+	}
+	return total;
+}
+
+int PhysicsDirectSpaceState3D::cast_motions(const ShapeParameters *p_parameters, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe) {
+	if (p_count <= 0) {
+		return 0;
+	}
+
+	QueryBatch batch;
+	batch.type = QUERY_BATCH_MOTIONS;
+	batch.shapes = p_parameters;
+	batch.closest_safe = r_closest_safe;
+	batch.closest_unsafe = r_closest_unsafe;
+	for (int i = 0; i < p_count; i++) {
+		r_closest_safe[i] = 1.0;
+		r_closest_unsafe[i] = 1.0;
+	}
+	_run_query_batch(batch, p_count);
+
+	int hits = 0;
+	for (int i = 0; i < p_count; i++) {
+		if (r_closest_unsafe[i] < 1.0) {
+			hits++;
+		}
+	}
+	return hits;
+}
+
+void PhysicsDirectSpaceState3D::_run_query_batch_chunk(const QueryBatch &p_batch, uint32_t p_from, uint32_t p_to) {
+	for (uint32_t i = p_from; i < p_to; i++) {
+		const uint32_t query = p_batch.order[i];
+		switch (p_batch.type) {
+			case QUERY_BATCH_RAYS: {
+				p_batch.ray_collided[query] = intersect_ray(p_batch.rays[query], p_batch.ray_results[query]);
+			} break;
+			case QUERY_BATCH_SHAPES: {
+				p_batch.shape_result_counts[query] = intersect_shape(p_batch.shapes[query], p_batch.shape_results + query * p_batch.shape_result_max, p_batch.shape_result_max);
+			} break;
+			case QUERY_BATCH_MOTIONS: {
+				cast_motion(p_batch.shapes[query], p_batch.closest_safe[query], p_batch.closest_unsafe[query]);
+			} break;
+		}
+	}
+}
+
+void PhysicsDirectSpaceState3D::_query_batch_task(uint32_t p_chunk, QueryBatch *p_batch) {
+	const uint32_t from = p_chunk * QUERY_BATCH_CHUNK_SIZE;
+	_run_query_batch_chunk(*p_batch, from, MIN(from + QUERY_BATCH_CHUNK_SIZE, p_batch->order.size()));
+}
+
+static uint32_t _spread_morton_bits_3d(uint32_t p_value) {
+	// Interleaves the lower 10 bits with two zero bits each.
+	p_value &= 0x3ff;
+	p_value = (p_value | (p_value << 16)) & 0x30000ff;
+	p_value = (p_value | (p_value << 8)) & 0x300f00f;
+	p_value = (p_value | (p_value << 4)) & 0x30c30c3;
+	p_value = (p_value | (p_value << 2)) & 0x9249249;
+	return p_value;
+}
+
+void PhysicsDirectSpaceState3D::_run_query_batch(QueryBatch &p_batch, int p_count) {
+	p_batch.order.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		p_batch.order[i] = i;
+	}
+
+	const uint32_t chunk_count = (p_count + QUERY_BATCH_CHUNK_SIZE - 1) / QUERY_BATCH_CHUNK_SIZE;
+	if (chunk_count > 1) {
+		// Order the queries along a Morton curve over the bounds of the batch, so that each chunk covers a compact region
+		// and its queries keep visiting the same broadphase nodes and colliders.
+		LocalVector<Vector3> positions;
+		positions.resize(p_count);
+		AABB bounds;
+		for (int i = 0; i < p_count; i++) {
+			if (p_batch.type == QUERY_BATCH_RAYS) {
+				positions[i] = (p_batch.rays[i].from + p_batch.rays[i].to) * 0.5;
+			} else {
+				positions[i] = p_batch.shapes[i].transform.origin + p_batch.shapes[i].motion * 0.5;
+			}
+			if (i == 0) {
+				bounds.position = positions[i];
+			} else {
+				bounds.expand_to(positions[i]);
+			}
+		}
+
+		struct SortKey {
+			uint32_t code = 0;
+			uint32_t index = 0;
+			bool operator<(const SortKey &p_other) const { return code == p_other.code ? index < p_other.index : code < p_other.code; }
+		};
+
+		LocalVector<SortKey> keys;
+		keys.resize(p_count);
+		const Vector3 scale = Vector3(1023.0, 1023.0, 1023.0) / bounds.size.maxf(CMP_EPSILON);
+		for (int i = 0; i < p_count; i++) {
+			const Vector3 cell = (positions[i] - bounds.position) * scale;
+			keys[i].code = _spread_morton_bits_3d((uint32_t)cell.x) | (_spread_morton_bits_3d((uint32_t)cell.y) << 1) | (_spread_morton_bits_3d((uint32_t)cell.z) << 2);
+			keys[i].index = i;
+		}
+		keys.sort();
+		for (int i = 0; i < p_count; i++) {
+			p_batch.order[i] = keys[i].index;
+		}
+	}
+
+	if (_begin_query_batch(p_batch) && chunk_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &PhysicsDirectSpaceState3D::_query_batch_task, &p_batch, chunk_count, -1, true, SNAME("Physics3DQueryBatch"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_run_query_batch_chunk(p_batch, 0, p_count);
+	}
+}
+
 TypedArray<Dictionary> PhysicsDirectSpaceState3D::_intersect_point(RequiredParam<PhysicsPointQueryParameters3D> rp_point_query, int p_max_results) {
 	EXTRACT_PARAM_OR_FAIL_V(p_point_query, rp_point_query, TypedArray<Dictionary>());
 
@@ -487,6 +726,7 @@ PhysicsDirectSpaceState3D::PhysicsDirectSpaceState3D() {
 void PhysicsDirectSpaceState3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("intersect_point", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_point, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("intersect_ray", "parameters"), &PhysicsDirectSpaceState3D::_intersect_ray);
+	ClassDB::bind_method(D_METHOD("intersect_rays", "parameters", "result"), &PhysicsDirectSpaceState3D::_intersect_rays);
 	ClassDB::bind_method(D_METHOD("intersect_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_intersect_shape, DEFVAL(32));
 	ClassDB::bind_method(D_METHOD("cast_motion", "parameters"), &PhysicsDirectSpaceState3D::_cast_motion);
 	ClassDB::bind_method(D_METHOD("collide_shape", "parameters", "max_results"), &PhysicsDirectSpaceState3D::_collide_shape, DEFVAL(32));
@@ -667,6 +907,119 @@ bool PhysicsServer3D::_body_test_motion(RID p_body, RequiredParam<PhysicsTestMot
 	return body_test_motion(p_body, p_parameters->get_parameters(), result_ptr);
 }
 
+TypedArray<bool> PhysicsServer3D::_body_motion_batch(const TypedArray<RID> &p_bodies, const TypedArray<PhysicsTestMotionParameters3D> &p_parameters, const TypedArray<PhysicsTestMotionResult3D> &p_results, int p_max_slides) {
+	TypedArray<bool> collided;
+	ERR_FAIL_COND_V_MSG(p_bodies.size() != p_parameters.size(), collided, "The bodies and parameters arrays must have the same size.");
+	ERR_FAIL_COND_V_MSG(!p_results.is_empty() && p_results.size() != p_bodies.size(), collided, "The results array must be empty or have the same size as the bodies array.");
+
+	LocalVector<MotionQuery> queries;
+	queries.resize(p_bodies.size());
+	for (uint32_t i = 0; i < queries.size(); i++) {
+		Ref<PhysicsTestMotionParameters3D> parameters = p_parameters[i];
+		ERR_FAIL_COND_V_MSG(parameters.is_null(), collided, vformat("The motion parameters at index %d are null.", i));
+		queries[i].body = p_bodies[i];
+		queries[i].parameters = parameters->get_parameters();
+	}
+
+	if (p_max_slides > 0) {
+		body_slide_motion_batch(queries.ptr(), queries.size(), p_max_slides);
+	} else {
+		body_test_motion_batch(queries.ptr(), queries.size());
+	}
+
+	collided.resize(queries.size());
+	for (uint32_t i = 0; i < queries.size(); i++) {
+		collided[i] = queries[i].collided;
+		if (p_results.is_empty()) {
+			continue;
+		}
+		Ref<PhysicsTestMotionResult3D> result = p_results[i];
+		if (result.is_valid()) {
+			*result->get_result_ptr() = queries[i].result;
+		}
+	}
+	return collided;
+}
+
+TypedArray<bool> PhysicsServer3D::_body_test_motion_batch(const TypedArray<RID> &p_bodies, const TypedArray<PhysicsTestMotionParameters3D> &p_parameters, const TypedArray<PhysicsTestMotionResult3D> &p_results) {
+	return _body_motion_batch(p_bodies, p_parameters, p_results, 0);
+}
+
+TypedArray<bool> PhysicsServer3D::_body_slide_motion_batch(const TypedArray<RID> &p_bodies, const TypedArray<PhysicsTestMotionParameters3D> &p_parameters, const TypedArray<PhysicsTestMotionResult3D> &p_results, int p_max_slides) {
+	ERR_FAIL_COND_V(p_max_slides < 1, TypedArray<bool>());
+	return _body_motion_batch(p_bodies, p_parameters, p_results, p_max_slides);
+}
+
+void PhysicsServer3D::body_test_motion_batch(MotionQuery *r_queries, int p_count) {
+	for (int i = 0; i < p_count; i++) {
+		MotionQuery &query = r_queries[i];
+		query.collided = body_test_motion(query.body, query.parameters, &query.result);
+	}
+}
+
+void PhysicsServer3D::body_slide_motion_batch(MotionQuery *r_queries, int p_count, int p_max_slides) {
+	ERR_FAIL_COND(p_count < 0);
+	ERR_FAIL_COND(p_max_slides < 1);
+
+	// Each round tests the remaining motion of all bodies that are still sliding as one batch,
+	// so servers that run batches in parallel also do so for every round.
+	LocalVector<Vector3> travels;
+	LocalVector<Vector3> motions;
+	travels.resize(p_count);
+	motions.resize(p_count);
+	for (int i = 0; i < p_count; i++) {
+		travels[i] = Vector3();
+		motions[i] = r_queries[i].parameters.motion;
+		r_queries[i].result = MotionResult();
+		r_queries[i].collided = false;
+	}
+
+	LocalVector<MotionQuery> round;
+	LocalVector<int> round_indices;
+	for (int slide = 0; slide < p_max_slides; slide++) {
+		round.clear();
+		round_indices.clear();
+		for (int i = 0; i < p_count; i++) {
+			if (motions[i].is_zero_approx()) {
+				continue;
+			}
+			MotionQuery query;
+			query.body = r_queries[i].body;
+			query.parameters = r_queries[i].parameters;
+			query.parameters.from.origin += travels[i];
+			query.parameters.motion = motions[i];
+			round.push_back(query);
+			round_indices.push_back(i);
+		}
+
+		if (round.is_empty()) {
+			break;
+		}
+
+		body_test_motion_batch(round.ptr(), round.size());
+
+		for (uint32_t j = 0; j < round.size(); j++) {
+			const int i = round_indices[j];
+			const MotionQuery &query = round[j];
+			travels[i] += query.result.travel;
+			if (!query.collided || query.result.collision_count == 0) {
+				motions[i] = Vector3();
+				continue;
+			}
+
+			// Keep the latest collision, and slide the rest of the motion along it.
+			r_queries[i].result = query.result;
+			r_queries[i].collided = true;
+			motions[i] = query.result.remainder.slide(query.result.collisions[0].normal);
+		}
+	}
+
+	for (int i = 0; i < p_count; i++) {
+		r_queries[i].result.travel = travels[i];
+		r_queries[i].result.remainder = motions[i];
+	}
+}
+
 RID PhysicsServer3D::shape_create(ShapeType p_shape) {
 	switch (p_shape) {
 		case SHAPE_WORLD_BOUNDARY:
@@ -721,6 +1074,8 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("space_set_param", "space", "param", "value"), &PhysicsServer3D::space_set_param);
 	ClassDB::bind_method(D_METHOD("space_get_param", "space", "param"), &PhysicsServer3D::space_get_param);
 	ClassDB::bind_method(D_METHOD("space_get_direct_state", "space"), &PhysicsServer3D::space_get_direct_state);
+	ClassDB::bind_method(D_METHOD("space_save_state", "space"), &PhysicsServer3D::space_save_state);
+	ClassDB::bind_method(D_METHOD("space_restore_state", "space", "state"), &PhysicsServer3D::space_restore_state);
 
 	ClassDB::bind_method(D_METHOD("area_create"), &PhysicsServer3D::area_create);
 	ClassDB::bind_method(D_METHOD("area_set_space", "area", "space"), &PhysicsServer3D::area_set_space);
@@ -841,6 +1196,8 @@ void PhysicsServer3D::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("body_set_ray_pickable", "body", "enable"), &PhysicsServer3D::body_set_ray_pickable);
 
 	ClassDB::bind_method(D_METHOD("body_test_motion", "body", "parameters", "result"), &PhysicsServer3D::_body_test_motion, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("body_test_motion_batch", "bodies", "parameters", "results"), &PhysicsServer3D::_body_test_motion_batch, DEFVAL(TypedArray<PhysicsTestMotionResult3D>()));
+	ClassDB::bind_method(D_METHOD("body_slide_motion_batch", "bodies", "parameters", "results", "max_slides"), &PhysicsServer3D::_body_slide_motion_batch, DEFVAL(TypedArray<PhysicsTestMotionResult3D>()), DEFVAL(4));
 
 	ClassDB::bind_method(D_METHOD("body_get_direct_state", "body"), &PhysicsServer3D::body_get_direct_state);
 
@@ -1114,6 +1471,8 @@ void PhysicsServer3D::_bind_methods() {
 	BIND_ENUM_CONSTANT(INFO_ACTIVE_OBJECTS);
 	BIND_ENUM_CONSTANT(INFO_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(INFO_ISLAND_COUNT);
+	BIND_ENUM_CONSTANT(INFO_SLEEPING_OBJECTS);
+	BIND_ENUM_CONSTANT(INFO_SLEEPING_COLLISION_PAIRS);
 
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_RECYCLE_RADIUS);
 	BIND_ENUM_CONSTANT(SPACE_PARAM_CONTACT_MAX_SEPARATION);
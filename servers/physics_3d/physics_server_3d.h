@@ -119,6 +119,7 @@ public:
 };
 
 class PhysicsRayQueryParameters3D;
+class PhysicsRayQueryResult3D;
 class PhysicsPointQueryParameters3D;
 class PhysicsShapeQueryParameters3D;
 
@@ -127,6 +128,7 @@ class PhysicsDirectSpaceState3D : public Object {
 
 private:
 	Dictionary _intersect_ray(RequiredParam<PhysicsRayQueryParameters3D> rp_ray_query);
+	int _intersect_rays(const TypedArray<PhysicsRayQueryParameters3D> &p_ray_queries, RequiredParam<PhysicsRayQueryResult3D> rp_result);
 	TypedArray<Dictionary> _intersect_point(RequiredParam<PhysicsPointQueryParameters3D> rp_point_query, int p_max_results = 32);
 	TypedArray<Dictionary> _intersect_shape(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query, int p_max_results = 32);
 	Vector<real_t> _cast_motion(RequiredParam<PhysicsShapeQueryParameters3D> rp_shape_query);
@@ -163,6 +165,8 @@ public:
 	};
 
 	virtual bool intersect_ray(const RayParameters &p_parameters, RayResult &r_result) = 0;
+	// Runs p_count ray queries at once, r_collided[i] tells whether r_results[i] holds a hit. Returns the number of hits.
+	int intersect_rays(const RayParameters *p_parameters, int p_count, RayResult *r_results, bool *r_collided);
 
 	struct ShapeResult {
 		RID rid;
@@ -208,9 +212,50 @@ public:
 	virtual bool collide_shape(const ShapeParameters &p_parameters, Vector3 *r_results, int p_result_max, int &r_result_count) = 0;
 	virtual bool rest_info(const ShapeParameters &p_parameters, ShapeRestInfo *r_info) = 0;
 
+	// Runs p_count shape queries at once. The results of query i start at r_results[i * p_result_max] and r_result_counts[i] of them are set.
+	// Returns the total number of results.
+	int intersect_shapes(const ShapeParameters *p_parameters, int p_count, ShapeResult *r_results, int p_result_max, int *r_result_counts);
+	// Runs p_count motion casts at once, without rest info. Returns the number of casts that hit something before the end of their motion.
+	int cast_motions(const ShapeParameters *p_parameters, int p_count, real_t *r_closest_safe, real_t *r_closest_unsafe);
+
 	virtual Vector3 get_closest_point_to_object_volume(RID p_object, const Vector3 p_point) const = 0;
 
 	PhysicsDirectSpaceState3D();
+
+protected:
+	static constexpr uint32_t QUERY_BATCH_CHUNK_SIZE = 64;
+
+	enum QueryBatchType {
+		QUERY_BATCH_RAYS,
+		QUERY_BATCH_SHAPES,
+		QUERY_BATCH_MOTIONS,
+	};
+
+	struct QueryBatch {
+		QueryBatchType type = QUERY_BATCH_RAYS;
+		const RayParameters *rays = nullptr;
+		const ShapeParameters *shapes = nullptr;
+		// Query indices, sorted so that queries close to each other in space end up in the same chunk.
+		LocalVector<uint32_t> order;
+
+		RayResult *ray_results = nullptr;
+		bool *ray_collided = nullptr;
+		ShapeResult *shape_results = nullptr;
+		int shape_result_max = 0;
+		int *shape_result_counts = nullptr;
+		real_t *closest_safe = nullptr;
+		real_t *closest_unsafe = nullptr;
+	};
+
+	// Called on the calling thread before the chunks of a batch run. Backends that can answer queries from several threads
+	// at once prepare for it here and return true, so the chunks run on the WorkerThreadPool.
+	virtual bool _begin_query_batch(const QueryBatch &p_batch) { return false; }
+	// Runs the queries at positions [p_from, p_to) of p_batch.order. By default, through intersect_ray(), intersect_shape() and cast_motion().
+	virtual void _run_query_batch_chunk(const QueryBatch &p_batch, uint32_t p_from, uint32_t p_to);
+
+private:
+	void _query_batch_task(uint32_t p_chunk, QueryBatch *p_batch);
+	void _run_query_batch(QueryBatch &p_batch, int p_count);
 };
 
 class PhysicsServer3DRenderingServerHandler : public Object {
@@ -239,6 +284,9 @@ class PhysicsServer3D : public Object {
 	static PhysicsServer3D *singleton;
 
 	virtual bool _body_test_motion(RID p_body, RequiredParam<PhysicsTestMotionParameters3D> rp_parameters, const Ref<PhysicsTestMotionResult3D> &p_result = Ref<PhysicsTestMotionResult3D>());
+	TypedArray<bool> _body_motion_batch(const TypedArray<RID> &p_bodies, const TypedArray<PhysicsTestMotionParameters3D> &p_parameters, const TypedArray<PhysicsTestMotionResult3D> &p_results, int p_max_slides);
+	TypedArray<bool> _body_test_motion_batch(const TypedArray<RID> &p_bodies, const TypedArray<PhysicsTestMotionParameters3D> &p_parameters, const TypedArray<PhysicsTestMotionResult3D> &p_results);
+	TypedArray<bool> _body_slide_motion_batch(const TypedArray<RID> &p_bodies, const TypedArray<PhysicsTestMotionParameters3D> &p_parameters, const TypedArray<PhysicsTestMotionResult3D> &p_results, int p_max_slides);
 
 protected:
 	static void _bind_methods();
@@ -311,6 +359,9 @@ public:
 	virtual Vector<Vector3> space_get_contacts(RID p_space) const = 0;
 	virtual int space_get_contact_count(RID p_space) const = 0;
 
+	virtual Vector<uint8_t> space_save_state(RID p_space) const = 0;
+	virtual void space_restore_state(RID p_space, const Vector<uint8_t> &p_state) = 0;
+
 	//missing space parameters
 
 	/* AREA API */
@@ -572,6 +623,21 @@ public:
 
 	virtual bool body_test_motion(RID p_body, const MotionParameters &p_parameters, MotionResult *r_result = nullptr) = 0;
 
+	struct MotionQuery {
+		RID body;
+		MotionParameters parameters;
+		MotionResult result;
+		bool collided = false;
+	};
+
+	// Runs independent motion tests, which servers may process in parallel.
+	// None of the bodies are moved, so every test sees the same state of the space.
+	virtual void body_test_motion_batch(MotionQuery *r_queries, int p_count);
+
+	// Moves each query's motion along the surfaces it hits, up to p_max_slides times, running each round of tests as a batch.
+	// The result holds the total travel, the motion left over, and the last collision. None of the bodies are moved.
+	void body_slide_motion_batch(MotionQuery *r_queries, int p_count, int p_max_slides = 4);
+
 	/* SOFT BODY */
 
 	virtual RID soft_body_create() = 0;
@@ -823,7 +889,9 @@ public:
 	enum ProcessInfo {
 		INFO_ACTIVE_OBJECTS,
 		INFO_COLLISION_PAIRS,
-		INFO_ISLAND_COUNT
+		INFO_ISLAND_COUNT,
+		INFO_SLEEPING_OBJECTS,
+		INFO_SLEEPING_COLLISION_PAIRS
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
@@ -869,6 +937,32 @@ public:
 	TypedArray<RID> get_exclude() const;
 };
 
+class PhysicsRayQueryResult3D : public RefCounted {
+	GDCLASS(PhysicsRayQueryResult3D, RefCounted);
+
+	LocalVector<PhysicsDirectSpaceState3D::RayResult> results;
+	LocalVector<bool> collided;
+
+protected:
+	static void _bind_methods();
+
+public:
+	void resize(int p_ray_count);
+	PhysicsDirectSpaceState3D::RayResult *get_results_ptr() { return results.ptr(); }
+	bool *get_collided_ptr() { return collided.ptr(); }
+
+	int get_ray_count() const;
+	bool is_colliding(int p_ray_index) const;
+
+	Vector3 get_position(int p_ray_index) const;
+	Vector3 get_normal(int p_ray_index) const;
+	int get_face_index(int p_ray_index) const;
+	ObjectID get_collider_id(int p_ray_index) const;
+	RID get_collider_rid(int p_ray_index) const;
+	Object *get_collider(int p_ray_index) const;
+	int get_collider_shape(int p_ray_index) const;
+};
+
 class PhysicsPointQueryParameters3D : public RefCounted {
 	GDCLASS(PhysicsPointQueryParameters3D, RefCounted);
 
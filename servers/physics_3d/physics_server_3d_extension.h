@@ -247,6 +247,20 @@ public:
 	EXBIND1RC(Vector<Vector3>, space_get_contacts, RID)
 	EXBIND1RC(int, space_get_contact_count, RID)
 
+	// Optional, extensions that do not support state saving keep the defaults.
+	GDVIRTUAL1RC(Vector<uint8_t>, _space_save_state, RID)
+	virtual Vector<uint8_t> space_save_state(RID p_space) const override {
+		Vector<uint8_t> ret;
+		GDVIRTUAL_CALL(_space_save_state, p_space, ret);
+		return ret;
+	}
+
+	GDVIRTUAL2(_space_restore_state, RID, const Vector<uint8_t> &)
+	virtual void space_restore_state(RID p_space, const Vector<uint8_t> &p_state) override {
+		ERR_FAIL_COND_MSG(!GDVIRTUAL_IS_OVERRIDDEN(_space_restore_state), "Restoring the space state is not supported by this physics server.");
+		GDVIRTUAL_CALL(_space_restore_state, p_space, p_state);
+	}
+
 	/* AREA API */
 
 	//EXBIND0RID(area);
@@ -135,6 +135,13 @@ public:
 		return physics_server_3d->space_get_contact_count(p_space);
 	}
 
+	virtual Vector<uint8_t> space_save_state(RID p_space) const override {
+		ERR_FAIL_COND_V(!Thread::is_main_thread(), Vector<uint8_t>());
+		return physics_server_3d->space_save_state(p_space);
+	}
+
+	FUNC2(space_restore_state, RID, const Vector<uint8_t> &);
+
 	/* AREA API */
 
 	//FUNC0RID(area);
@@ -276,6 +283,11 @@ public:
 		return physics_server_3d->body_test_motion(p_body, p_parameters, r_result);
 	}
 
+	void body_test_motion_batch(MotionQuery *r_queries, int p_count) override {
+		ERR_FAIL_COND(!Thread::is_main_thread());
+		physics_server_3d->body_test_motion_batch(r_queries, p_count);
+	}
+
 	// this function only works on physics process, errors and returns null otherwise
 	PhysicsDirectBodyState3D *body_get_direct_state(RID p_body) override {
 		ERR_FAIL_COND_V(!Thread::is_main_thread(), nullptr);
@@ -65,6 +65,15 @@ public:
 	}
 };
 
+class WeightedAStar2D : public AStar2D {
+public:
+	// Connections between ids of the same parity cost twice their length, so the cheapest paths are not the shortest ones.
+	real_t _compute_cost(int64_t p_from, int64_t p_to) {
+		real_t cost = get_point_position(p_from).distance_to(get_point_position(p_to));
+		return (p_from + p_to) % 2 == 0 ? cost * 2 : cost;
+	}
+};
+
 TEST_CASE("[AStar3D] ABC path") {
 	ABCX abcx;
 	Vector<int64_t> path = abcx.get_id_path(ABCX::A, ABCX::C);
@@ -84,6 +93,95 @@ TEST_CASE("[AStar3D] ABCX path") {
 	CHECK(path[3] == ABCX::C);
 }
 
+TEST_CASE("[AStar3D] Bidirectional search") {
+	ABCX abcx;
+	abcx.set_bidirectional_search_enabled(true);
+	Vector<int64_t> path = abcx.get_id_path(ABCX::X, ABCX::C);
+	REQUIRE(path.size() == 4);
+	CHECK(path[0] == ABCX::X);
+	CHECK(path[1] == ABCX::A);
+	CHECK(path[2] == ABCX::B);
+	CHECK(path[3] == ABCX::C);
+
+	// Random graphs with one-way connections and disabled points.
+	AStar3D a;
+	Math::seed(0);
+	for (int i = 0; i < 200; i++) {
+		a.clear();
+		for (int j = 0; j < 20; j++) {
+			a.add_point(j, Vector3(Math::rand() % 8, Math::rand() % 8, 0));
+		}
+		for (int j = 0; j < 50; j++) {
+			int u = Math::rand() % 20;
+			int v = Math::rand() % 20;
+			if (u != v) {
+				a.connect_points(u, v, Math::rand() % 2 == 1);
+			}
+		}
+		a.set_point_disabled(Math::rand() % 20);
+
+		int from = Math::rand() % 20;
+		int to = Math::rand() % 20;
+
+		a.set_bidirectional_search_enabled(false);
+		Vector<int64_t> expected = a.get_id_path(from, to);
+		a.set_bidirectional_search_enabled(true);
+		Vector<int64_t> bidirectional = a.get_id_path(from, to);
+
+		REQUIRE(expected.is_empty() == bidirectional.is_empty());
+		real_t expected_cost = 0;
+		real_t bidirectional_cost = 0;
+		for (int j = 1; j < expected.size(); j++) {
+			expected_cost += a.get_point_position(expected[j - 1]).distance_to(a.get_point_position(expected[j]));
+		}
+		for (int j = 1; j < bidirectional.size(); j++) {
+			CHECK(a.are_points_connected(bidirectional[j - 1], bidirectional[j], false));
+			bidirectional_cost += a.get_point_position(bidirectional[j - 1]).distance_to(a.get_point_position(bidirectional[j]));
+		}
+		CHECK(bidirectional_cost == doctest::Approx(expected_cost));
+	}
+}
+
+TEST_CASE("[AStar2D] Bidirectional search") {
+	// Random graphs with one-way connections and disabled points, using the costs of the AStar2D subclass.
+	WeightedAStar2D a;
+	Math::seed(1);
+	for (int i = 0; i < 200; i++) {
+		a.clear();
+		for (int j = 0; j < 20; j++) {
+			a.add_point(j, Vector2(Math::rand() % 8, Math::rand() % 8));
+		}
+		for (int j = 0; j < 50; j++) {
+			int u = Math::rand() % 20;
+			int v = Math::rand() % 20;
+			if (u != v) {
+				a.connect_points(u, v, Math::rand() % 2 == 1);
+			}
+		}
+		a.set_point_disabled(Math::rand() % 20);
+
+		int from = Math::rand() % 20;
+		int to = Math::rand() % 20;
+
+		a.set_bidirectional_search_enabled(false);
+		Vector<int64_t> expected = a.get_id_path(from, to);
+		a.set_bidirectional_search_enabled(true);
+		Vector<int64_t> bidirectional = a.get_id_path(from, to);
+
+		REQUIRE(expected.is_empty() == bidirectional.is_empty());
+		real_t expected_cost = 0;
+		real_t bidirectional_cost = 0;
+		for (int j = 1; j < expected.size(); j++) {
+			expected_cost += a._compute_cost(expected[j - 1], expected[j]);
+		}
+		for (int j = 1; j < bidirectional.size(); j++) {
+			CHECK(a.are_points_connected(bidirectional[j - 1], bidirectional[j], false));
+			bidirectional_cost += a._compute_cost(bidirectional[j - 1], bidirectional[j]);
+		}
+		CHECK(bidirectional_cost == doctest::Approx(expected_cost));
+	}
+}
+
 TEST_CASE("[AStar3D] Add/Remove") {
 	AStar3D a;
 
@@ -31,6 +31,8 @@
 #pragma once
 
 #include "core/object/class_db.h"
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
 #include "scene/main/node.h"
 #include "scene/resources/packed_scene.h"
 
@@ -105,6 +107,43 @@ public:
 	}
 };
 
+// Counts the group calls it receives, and how many of them came from another thread than the main one.
+class TestGroupCallNode : public Node {
+	GDCLASS(TestGroupCallNode, Node);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("count_call"), &TestGroupCallNode::count_call);
+	}
+
+public:
+	SafeNumeric<uint32_t> *call_count = nullptr;
+	SafeNumeric<uint32_t> *worker_thread_call_count = nullptr;
+
+	void count_call() {
+		call_count->increment();
+		if (Thread::get_caller_id() != Thread::get_main_id()) {
+			worker_thread_call_count->increment();
+		}
+	}
+};
+
+// Queues itself again with SceneTree::call_deferred_budgeted() every time it's called.
+class TestRequeueNode : public Node {
+	GDCLASS(TestRequeueNode, Node);
+
+public:
+	int call_count = 0;
+	bool requeue_enabled = true;
+
+	void requeue() {
+		call_count++;
+		if (requeue_enabled) {
+			get_tree()->call_deferred_budgeted(callable_mp(this, &TestRequeueNode::requeue));
+		}
+	}
+};
+
 TEST_CASE("[SceneTree][Node] Testing node operations with a very simple scene tree") {
 	Node *node = memnew(Node);
 
@@ -913,4 +952,325 @@ TEST_CASE("[SceneTree][Node] Test the process priority") {
 	memdelete(node4);
 }
 
+TEST_CASE("[SceneTree][Node] Threaded group calls") {
+	GDREGISTER_CLASS(TestGroupCallNode);
+
+	SafeNumeric<uint32_t> call_count;
+	SafeNumeric<uint32_t> worker_thread_call_count;
+
+	TestGroupCallNode *main_node = memnew(TestGroupCallNode);
+	TestGroupCallNode *group_a = memnew(TestGroupCallNode);
+	TestGroupCallNode *group_b = memnew(TestGroupCallNode);
+	TestGroupCallNode *child_a = memnew(TestGroupCallNode);
+	TestGroupCallNode *child_b = memnew(TestGroupCallNode);
+
+	group_a->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+	group_b->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+	group_a->add_child(child_a);
+	group_b->add_child(child_b);
+
+	SceneTree::get_singleton()->get_root()->add_child(main_node);
+	SceneTree::get_singleton()->get_root()->add_child(group_a);
+	SceneTree::get_singleton()->get_root()->add_child(group_b);
+
+	TestGroupCallNode *nodes[] = { main_node, group_a, group_b, child_a, child_b };
+	for (TestGroupCallNode *n : nodes) {
+		n->call_count = &call_count;
+		n->worker_thread_call_count = &worker_thread_call_count;
+		n->add_to_group("threaded");
+	}
+
+	SUBCASE("Nodes of sub-thread groups should be called from worker threads, and every node only once") {
+		SceneTree::get_singleton()->call_group_flags(SceneTree::GROUP_CALL_THREADED, "threaded", "count_call");
+		CHECK_EQ(call_count.get(), 5u);
+		// Everything but main_node belongs to one of the two sub-thread groups.
+		CHECK_EQ(worker_thread_call_count.get(), 4u);
+	}
+
+	SUBCASE("Reverse threaded calls should also reach all nodes") {
+		SceneTree::get_singleton()->call_group_flags(SceneTree::GROUP_CALL_THREADED | SceneTree::GROUP_CALL_REVERSE, "threaded", "count_call");
+		CHECK_EQ(call_count.get(), 5u);
+		CHECK_EQ(worker_thread_call_count.get(), 4u);
+	}
+
+	SUBCASE("Calls without the threaded flag should stay on the main thread") {
+		SceneTree::get_singleton()->call_group("threaded", "count_call");
+		CHECK_EQ(call_count.get(), 5u);
+		CHECK_EQ(worker_thread_call_count.get(), 0u);
+	}
+
+	memdelete(main_node);
+	memdelete(group_a);
+	memdelete(group_b);
+}
+
+TEST_CASE("[SceneTree][Node] Cached node path resolution") {
+	Node *root = memnew(Node);
+	Node *a = memnew(Node);
+	Node *b = memnew(Node);
+	Node *c = memnew(Node);
+	a->set_name("A");
+	b->set_name("B");
+	c->set_name("C");
+	root->add_child(a);
+	a->add_child(b);
+	b->add_child(c);
+	SceneTree::get_singleton()->get_root()->add_child(root);
+
+	CHECK_EQ(root->get_node_or_null(NodePath("A/B/C")), c);
+	// Resolve again, this time from the cache.
+	CHECK_EQ(root->get_node_or_null(NodePath("A/B/C")), c);
+
+	SUBCASE("Renaming a node on the path should invalidate the cache") {
+		b->set_name("Renamed");
+		CHECK_EQ(root->get_node_or_null(NodePath("A/B/C")), nullptr);
+		CHECK_EQ(root->get_node_or_null(NodePath("A/Renamed/C")), c);
+	}
+
+	SUBCASE("Moving a node should invalidate the cache") {
+		b->remove_child(c);
+		CHECK_EQ(root->get_node_or_null(NodePath("A/B/C")), nullptr);
+		a->add_child(c);
+		CHECK_EQ(root->get_node_or_null(NodePath("A/C")), c);
+		CHECK_EQ(root->get_node_or_null(NodePath("A/B/C")), nullptr);
+	}
+
+	SUBCASE("Moving an ancestor should invalidate paths going up") {
+		CHECK_EQ(c->get_node_or_null(NodePath("../..")), a);
+		a->remove_child(b);
+		root->add_child(b);
+		CHECK_EQ(c->get_node_or_null(NodePath("../..")), root);
+	}
+
+	SUBCASE("Changes outside of the resolved subtree should keep paths valid") {
+		Node *d = memnew(Node);
+		d->set_name("D");
+		root->add_child(d);
+		CHECK_EQ(root->get_node_or_null(NodePath("A/B/C")), c);
+		CHECK_EQ(b->get_node_or_null(NodePath("C/..")), b);
+		d->set_name("E");
+		CHECK_EQ(b->get_node_or_null(NodePath("C/..")), b);
+	}
+
+	SUBCASE("Freeing a node should invalidate the cache") {
+		memdelete(c);
+		CHECK_EQ(root->get_node_or_null(NodePath("A/B/C")), nullptr);
+	}
+
+	SUBCASE("Adding a previously missing node should invalidate the cache") {
+		CHECK_EQ(root->get_node_or_null(NodePath("A/B/D")), nullptr);
+		Node *d = memnew(Node);
+		d->set_name("D");
+		b->add_child(d);
+		CHECK_EQ(root->get_node_or_null(NodePath("A/B/D")), d);
+	}
+
+	SUBCASE("Unique names should be invalidated when the unique node changes") {
+		c->set_owner(root);
+		c->set_unique_name_in_owner(true);
+		CHECK_EQ(a->get_node_or_null(NodePath("../%C")), c);
+		c->set_unique_name_in_owner(false);
+		CHECK_EQ(a->get_node_or_null(NodePath("../%C")), nullptr);
+	}
+
+	memdelete(root);
+}
+
+TEST_CASE("[SceneTree][Node] Budgeted deferred calls and deletions") {
+	SceneTree *tree = SceneTree::get_singleton();
+	Node *node = memnew(Node);
+	tree->get_root()->add_child(node);
+
+	SUBCASE("Budgeted calls should be made at the end of the frame") {
+		tree->call_deferred_budgeted(Callable(node, "set_meta").bind("high", true), SceneTree::DEFERRED_CALL_PRIORITY_HIGH);
+		tree->call_deferred_budgeted(Callable(node, "set_meta").bind("normal", true));
+		tree->call_deferred_budgeted(Callable(node, "set_meta").bind("low", true), SceneTree::DEFERRED_CALL_PRIORITY_LOW);
+		CHECK_EQ(tree->get_deferred_call_backlog(), 3);
+
+		tree->process(0);
+
+		CHECK_EQ(tree->get_deferred_call_backlog(), 0);
+		CHECK(bool(node->get_meta("high", false)));
+		CHECK(bool(node->get_meta("normal", false)));
+		CHECK(bool(node->get_meta("low", false)));
+	}
+
+	SUBCASE("Queued deletions should be counted as backlog") {
+		Node *child = memnew(Node);
+		node->add_child(child);
+		ObjectID child_id = child->get_instance_id();
+		child->queue_free();
+		CHECK_EQ(tree->get_delete_queue_backlog(), 1);
+
+		tree->set_deferred_budget_msec(1000.0);
+		// Physics frames delete everything that is queued, budget or not.
+		tree->physics_process(0);
+		CHECK_EQ(tree->get_delete_queue_backlog(), 0);
+		CHECK_EQ(ObjectDB::get_instance(child_id), nullptr);
+		tree->set_deferred_budget_msec(0.0);
+	}
+
+	SUBCASE("Calls queued during a flush should wait for the next one") {
+		TestRequeueNode *requeue_node = memnew(TestRequeueNode);
+		node->add_child(requeue_node);
+		tree->call_deferred_budgeted(callable_mp(requeue_node, &TestRequeueNode::requeue));
+
+		// Without a budget, the queue used to be flushed until it was empty, which never happens here.
+		tree->process(0);
+		CHECK_EQ(requeue_node->call_count, 1);
+		CHECK_EQ(tree->get_deferred_call_backlog(), 1);
+
+		tree->process(0);
+		CHECK_EQ(requeue_node->call_count, 2);
+
+		// Let the last queued call run before the node is freed.
+		requeue_node->requeue_enabled = false;
+		tree->process(0);
+		CHECK_EQ(requeue_node->call_count, 3);
+		CHECK_EQ(tree->get_deferred_call_backlog(), 0);
+	}
+
+	SUBCASE("Queued deletions should still happen when calls saturate the budget") {
+		Node *child = memnew(Node);
+		node->add_child(child);
+		ObjectID child_id = child->get_instance_id();
+		child->queue_free();
+
+		for (int i = 0; i < 1000; i++) {
+			tree->call_deferred_budgeted(Callable(node, "set_meta").bind("normal", i));
+		}
+		tree->call_deferred_budgeted(Callable(node, "set_meta").bind("low", true), SceneTree::DEFERRED_CALL_PRIORITY_LOW);
+
+		// A budget this small is spent after the first call.
+		tree->set_deferred_budget_msec(0.001);
+		tree->process(0);
+		tree->set_deferred_budget_msec(0.0);
+
+		CHECK_EQ(tree->get_delete_queue_backlog(), 0);
+		CHECK_EQ(ObjectDB::get_instance(child_id), nullptr);
+		CHECK(bool(node->get_meta("low", false)));
+		CHECK_GT(tree->get_deferred_call_backlog(), 0);
+
+		tree->process(0);
+		CHECK_EQ(tree->get_deferred_call_backlog(), 0);
+	}
+
+	memdelete(node);
+}
+
+TEST_CASE("[SceneTree][Node] Adding and removing children in bulk") {
+	Node *parent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	TypedArray<Node> children;
+	for (int i = 0; i < 8; i++) {
+		Node *child = memnew(Node);
+		child->set_name("Child");
+		children.push_back(child);
+	}
+
+	parent->add_children(children);
+
+	SUBCASE("Children should be added in order, with unique names, inside the tree") {
+		CHECK_EQ(parent->get_child_count(), 8);
+		for (int i = 0; i < 8; i++) {
+			Node *child = Object::cast_to<Node>(children[i]);
+			CHECK_EQ(parent->get_child(i), child);
+			CHECK(child->is_inside_tree());
+			CHECK(child->is_ready());
+		}
+		CHECK(parent->get_node_or_null(NodePath("Child")) != nullptr);
+	}
+
+	SUBCASE("Children that already have a parent should be skipped") {
+		Node *extra = memnew(Node);
+		TypedArray<Node> again;
+		again.push_back(children[0]);
+		again.push_back(extra);
+		ERR_PRINT_OFF;
+		parent->add_children(again);
+		ERR_PRINT_ON;
+		CHECK_EQ(parent->get_child_count(), 9);
+		CHECK_EQ(parent->get_child(8), extra);
+	}
+
+	SUBCASE("Children should be removed without being freed") {
+		TypedArray<Node> to_remove;
+		to_remove.push_back(children[1]);
+		to_remove.push_back(children[3]);
+		parent->remove_children(to_remove);
+		CHECK_EQ(parent->get_child_count(), 6);
+		for (int i = 0; i < to_remove.size(); i++) {
+			Node *child = Object::cast_to<Node>(to_remove[i]);
+			CHECK_EQ(child->get_parent(), nullptr);
+			CHECK_FALSE(child->is_inside_tree());
+			memdelete(child);
+		}
+		CHECK_EQ(parent->get_child(1), Object::cast_to<Node>(children[2]));
+	}
+
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][Node] Adding children in bulk with readable names and processing") {
+	GDREGISTER_CLASS(TestNode);
+
+	Node *parent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	SUBCASE("Children with the same name should get consecutive readable names") {
+		TypedArray<Node> children;
+		for (int i = 0; i < 100; i++) {
+			Node *child = memnew(Node);
+			child->set_name("Child");
+			children.push_back(child);
+		}
+		parent->add_children(children, true);
+
+		CHECK_EQ(Object::cast_to<Node>(children[0])->get_name(), StringName("Child"));
+		for (int i = 1; i < children.size(); i++) {
+			CHECK_EQ(Object::cast_to<Node>(children[i])->get_name(), StringName("Child" + itos(i + 1)));
+		}
+
+		// Names taken before the batch are still skipped.
+		TypedArray<Node> more;
+		for (int i = 0; i < 2; i++) {
+			Node *child = memnew(Node);
+			child->set_name("Child");
+			more.push_back(child);
+		}
+		parent->add_children(more, true);
+		CHECK_EQ(Object::cast_to<Node>(more[0])->get_name(), StringName("Child101"));
+		CHECK_EQ(Object::cast_to<Node>(more[1])->get_name(), StringName("Child102"));
+	}
+
+	SUBCASE("Processing children should be processed once the batch is added") {
+		TypedArray<Node> children;
+		for (int i = 0; i < 16; i++) {
+			TestNode *child = memnew(TestNode);
+			child->set_process(true);
+			child->set_physics_process(i % 2 == 0);
+			children.push_back(child);
+		}
+		parent->add_children(children);
+
+		SceneTree::get_singleton()->process(0);
+		SceneTree::get_singleton()->physics_process(0);
+		for (int i = 0; i < children.size(); i++) {
+			TestNode *child = Object::cast_to<TestNode>(children[i]);
+			CHECK_EQ(child->process_counter, 1);
+			CHECK_EQ(child->physics_process_counter, i % 2 == 0 ? 1 : 0);
+		}
+
+		// Stopping processing removes the nodes from the process group again.
+		for (int i = 0; i < children.size(); i++) {
+			Object::cast_to<TestNode>(children[i])->set_process(false);
+		}
+		SceneTree::get_singleton()->process(0);
+		CHECK_EQ(Object::cast_to<TestNode>(children[0])->process_counter, 1);
+	}
+
+	memdelete(parent);
+}
+
 } // namespace TestNode
@@ -0,0 +1,119 @@
+/**************************************************************************/
+/*  test_node_3d.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "scene/3d/node_3d.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNode3D {
+
+class TransformNotifiedNode3D : public Node3D {
+	GDCLASS(TransformNotifiedNode3D, Node3D);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_TRANSFORM_CHANGED) {
+			transform_changed_count++;
+		}
+	}
+
+public:
+	int transform_changed_count = 0;
+
+	void set_ignore_notification(bool p_ignore) { set_ignore_transform_notification(p_ignore); }
+};
+
+TEST_CASE("[SceneTree][Node3D] Transform propagation") {
+	Node3D *parent = memnew(Node3D);
+	Node3D *middle = memnew(Node3D);
+	TransformNotifiedNode3D *child = memnew(TransformNotifiedNode3D);
+	parent->add_child(middle);
+	middle->add_child(child);
+	child->set_notify_transform(true);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+	SceneTree::get_singleton()->flush_transform_notifications();
+	child->transform_changed_count = 0;
+
+	SUBCASE("Repeated changes should be notified once per flush") {
+		parent->set_position(Vector3(1, 0, 0));
+		parent->set_position(Vector3(2, 0, 0));
+		middle->set_position(Vector3(0, 1, 0));
+		CHECK_EQ(child->get_global_position(), Vector3(2, 1, 0));
+		parent->set_position(Vector3(3, 0, 0));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK_EQ(child->transform_changed_count, 1);
+		CHECK_EQ(child->get_global_position(), Vector3(3, 1, 0));
+
+		parent->set_position(Vector3(4, 0, 0));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK_EQ(child->transform_changed_count, 2);
+		CHECK_EQ(child->get_global_position(), Vector3(4, 1, 0));
+	}
+
+	SUBCASE("Changes after enabling notifications should be notified") {
+		child->set_notify_transform(false);
+		parent->set_position(Vector3(1, 0, 0));
+		child->set_notify_transform(true);
+		parent->set_position(Vector3(2, 0, 0));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK_EQ(child->transform_changed_count, 1);
+	}
+
+	SUBCASE("Changes after ignoring notifications should be notified") {
+		child->set_ignore_notification(true);
+		parent->set_position(Vector3(1, 0, 0));
+		child->set_ignore_notification(false);
+		parent->set_position(Vector3(2, 0, 0));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK_EQ(child->transform_changed_count, 1);
+		CHECK_EQ(child->get_global_position(), Vector3(2, 0, 0));
+	}
+
+	SUBCASE("Top level nodes should not be affected by their parent") {
+		child->set_as_top_level(true);
+		SceneTree::get_singleton()->flush_transform_notifications();
+		child->transform_changed_count = 0;
+		parent->set_position(Vector3(1, 0, 0));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK_EQ(child->transform_changed_count, 0);
+
+		child->set_as_top_level(false);
+		parent->set_position(Vector3(2, 0, 0));
+		SceneTree::get_singleton()->flush_transform_notifications();
+		CHECK(child->transform_changed_count > 0);
+	}
+
+	memdelete(parent);
+}
+
+} // namespace TestNode3D
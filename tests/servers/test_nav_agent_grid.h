@@ -0,0 +1,165 @@
+/**************************************************************************/
+/*  test_nav_agent_grid.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "servers/nav_agent_grid.h"
+
+#include "core/math/random_pcg.h"
+#include "core/templates/pair.h"
+#include "tests/test_macros.h"
+
+namespace TestNavAgentGrid {
+
+// Keeps the closest neighbors in the same way as the RVO agents do, shrinking the range once there are enough of them.
+static void insert_neighbor(LocalVector<Pair<float, uint32_t>> &r_neighbors, uint32_t p_max_neighbors, float p_distance_sq, uint32_t p_index, float &r_range_sq) {
+	if (p_distance_sq >= r_range_sq) {
+		return;
+	}
+	if (r_neighbors.size() < p_max_neighbors) {
+		r_neighbors.push_back(Pair<float, uint32_t>(p_distance_sq, p_index));
+	}
+	uint32_t i = r_neighbors.size() - 1;
+	while (i != 0 && p_distance_sq < r_neighbors[i - 1].first) {
+		r_neighbors[i] = r_neighbors[i - 1];
+		i--;
+	}
+	r_neighbors[i] = Pair<float, uint32_t>(p_distance_sq, p_index);
+	if (r_neighbors.size() == p_max_neighbors) {
+		r_range_sq = r_neighbors[r_neighbors.size() - 1].first;
+	}
+}
+
+static Vector<uint32_t> get_neighbors_brute_force(const LocalVector<Vector3> &p_positions, uint32_t p_agent, uint32_t p_max_neighbors, float p_neighbor_distance) {
+	LocalVector<Pair<float, uint32_t>> neighbors;
+	float range_sq = p_neighbor_distance * p_neighbor_distance;
+	for (uint32_t i = 0; i < p_positions.size(); i++) {
+		if (i != p_agent) {
+			insert_neighbor(neighbors, p_max_neighbors, (float)p_positions[p_agent].distance_squared_to(p_positions[i]), i, range_sq);
+		}
+	}
+
+	Vector<uint32_t> indices;
+	for (const Pair<float, uint32_t> &neighbor : neighbors) {
+		indices.push_back(neighbor.second);
+	}
+	indices.sort();
+	return indices;
+}
+
+static Vector<uint32_t> get_neighbors_from_grid(const NavAgentGrid &p_grid, const LocalVector<Vector3> &p_positions, uint32_t p_agent, uint32_t p_max_neighbors, float p_neighbor_distance) {
+	LocalVector<Pair<float, uint32_t>> neighbors;
+	float range_sq = p_neighbor_distance * p_neighbor_distance;
+	p_grid.query(p_positions[p_agent], range_sq, [&](uint32_t p_index) {
+		if (p_index != p_agent) {
+			insert_neighbor(neighbors, p_max_neighbors, (float)p_positions[p_agent].distance_squared_to(p_positions[p_index]), p_index, range_sq);
+		}
+	});
+
+	Vector<uint32_t> indices;
+	for (const Pair<float, uint32_t> &neighbor : neighbors) {
+		indices.push_back(neighbor.second);
+	}
+	indices.sort();
+	return indices;
+}
+
+static void check_neighbors_match(const LocalVector<Vector3> &p_positions) {
+	NavAgentGrid grid;
+	grid.build(p_positions);
+
+	const uint32_t max_neighbors_values[] = { 1, 10, 1000 };
+	const float neighbor_distance_values[] = { 0.5, 5.0, 50.0, 5000.0 };
+	for (uint32_t max_neighbors : max_neighbors_values) {
+		for (float neighbor_distance : neighbor_distance_values) {
+			uint32_t mismatches = 0;
+			for (uint32_t i = 0; i < p_positions.size(); i++) {
+				if (get_neighbors_from_grid(grid, p_positions, i, max_neighbors, neighbor_distance) != get_neighbors_brute_force(p_positions, i, max_neighbors, neighbor_distance)) {
+					mismatches++;
+				}
+			}
+			CHECK_MESSAGE(mismatches == 0, vformat("Neighbors should match for %d max neighbors within %f.", max_neighbors, neighbor_distance));
+		}
+	}
+}
+
+TEST_CASE("[NavAgentGrid] Empty grid") {
+	NavAgentGrid grid;
+	grid.build(LocalVector<Vector3>());
+	CHECK(grid.is_empty());
+
+	float range_sq = 100.0;
+	uint32_t visited = 0;
+	grid.query(Vector3(), range_sq, [&](uint32_t p_index) { visited++; });
+	CHECK(visited == 0);
+}
+
+TEST_CASE("[NavAgentGrid] Neighbors should match a brute force search in random crowds") {
+	RandomPCG rng(4242);
+	LocalVector<Vector3> positions;
+
+	SUBCASE("Spread out crowd") {
+		for (uint32_t i = 0; i < 500; i++) {
+			positions.push_back(Vector3(rng.random(-100.0f, 100.0f), 0.0, rng.random(-100.0f, 100.0f)));
+		}
+		check_neighbors_match(positions);
+	}
+
+	SUBCASE("Clustered crowd with outliers") {
+		for (uint32_t cluster = 0; cluster < 5; cluster++) {
+			const Vector3 center = Vector3(rng.random(-1000.0f, 1000.0f), 0.0, rng.random(-1000.0f, 1000.0f));
+			for (uint32_t i = 0; i < 100; i++) {
+				positions.push_back(center + Vector3(rng.random(-2.0f, 2.0f), 0.0, rng.random(-2.0f, 2.0f)));
+			}
+		}
+		positions.push_back(Vector3(-5000.0, 0.0, 3.0));
+		positions.push_back(Vector3(5000.0, 0.0, -3.0));
+		check_neighbors_match(positions);
+	}
+
+	SUBCASE("Agents sharing the same position") {
+		for (uint32_t i = 0; i < 50; i++) {
+			positions.push_back(Vector3(1.0, 0.0, 1.0));
+		}
+		for (uint32_t i = 0; i < 50; i++) {
+			positions.push_back(Vector3(rng.random(0.0f, 3.0f), 0.0, rng.random(0.0f, 3.0f)));
+		}
+		check_neighbors_match(positions);
+	}
+
+	SUBCASE("Crowd on several floors") {
+		for (uint32_t i = 0; i < 500; i++) {
+			positions.push_back(Vector3(rng.random(-50.0f, 50.0f), rng.random(0, 3) * 4.0, rng.random(-50.0f, 50.0f)));
+		}
+		check_neighbors_match(positions);
+	}
+}
+
+} // namespace TestNavAgentGrid
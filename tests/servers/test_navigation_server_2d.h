@@ -688,6 +688,48 @@ TEST_SUITE("[Navigation2D]") {
 			CHECK_NE(query_result->get_path_owner_ids().size(), 0);
 		}
 
+		SUBCASE("Batched queries should yield the same results as single queries") {
+			TypedArray<NavigationPathQueryParameters2D> batch_parameters;
+			TypedArray<NavigationPathQueryResult2D> batch_results;
+			for (int i = 0; i < 16; i++) {
+				Ref<NavigationPathQueryParameters2D> query_parameters;
+				query_parameters.instantiate();
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector2(0, 0).lerp(Vector2(10, 10), i / 16.0));
+				query_parameters->set_target_position(i % 2 == 0 ? Vector2(10, 10) : Vector2(0, 0));
+				Ref<NavigationPathQueryResult2D> query_result;
+				query_result.instantiate();
+				batch_parameters.push_back(query_parameters);
+				batch_results.push_back(query_result);
+			}
+			navigation_server->query_path_batch(batch_parameters, batch_results);
+
+			for (int i = 0; i < batch_parameters.size(); i++) {
+				Ref<NavigationPathQueryResult2D> query_result;
+				query_result.instantiate();
+				navigation_server->query_path(batch_parameters[i], query_result);
+				const Ref<NavigationPathQueryResult2D> batch_result = batch_results[i];
+				CHECK_NE(batch_result->get_path().size(), 0);
+				CHECK_EQ(batch_result->get_path(), query_result->get_path());
+				CHECK_EQ(batch_result->get_path_rids(), query_result->get_path_rids());
+			}
+		}
+
+		SUBCASE("Flow field directions should lead agents to the target") {
+			const Vector2 target_position = Vector2(300, 300);
+			CHECK_EQ(navigation_server->map_get_flow_direction(map, target_position, Vector2(-300, -300), 2), Vector2());
+
+			// Walk around the obstruction in the middle of the map by following the flow field.
+			Vector2 position = Vector2(-300, -300);
+			for (int i = 0; i < 200 && position.distance_to(target_position) > 10.0; i++) {
+				const Vector2 direction = navigation_server->map_get_flow_direction(map, target_position, position);
+				CHECK(direction.is_normalized());
+				position += direction * 10.0;
+			}
+			CHECK_LE(position.distance_to(target_position), 10.0);
+			CHECK_EQ(navigation_server->map_get_flow_direction(map, target_position, target_position), Vector2());
+		}
+
 		SUBCASE("Elaborate query with 'EDGECENTERED' post-processing should yield non-empty result") {
 			Ref<NavigationPathQueryParameters2D> query_parameters;
 			query_parameters.instantiate();
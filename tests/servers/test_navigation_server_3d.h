@@ -156,6 +156,13 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_EQ(navigation_server->map_get_use_edge_connections(map), !initial_use_edge_connections);
 		}
 
+		SUBCASE("Hierarchical pathfinding should be disabled by default") {
+			CHECK_FALSE(navigation_server->map_get_use_hierarchical_pathfinding(map));
+			navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			CHECK(navigation_server->map_get_use_hierarchical_pathfinding(map));
+		}
+
 		SUBCASE("'ProcessInfo' should report map iff active") {
 			navigation_server->map_set_active(map, true);
 			navigation_server->physics_process(0.0); // Give server some cycles to commit.
@@ -416,6 +423,56 @@ TEST_SUITE("[Navigation3D]") {
 		navigation_server->free_rid(map);
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should make agents avoid each other in a spread out crowd") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+
+		// Far away agents spread the avoidance agent grid over a large area.
+		LocalVector<RID> crowd;
+		for (int i = 0; i < 100; i++) {
+			RID agent = navigation_server->agent_create();
+			navigation_server->agent_set_map(agent, map);
+			navigation_server->agent_set_avoidance_enabled(agent, true);
+			navigation_server->agent_set_position(agent, Vector3(100.0 + (i % 10) * 10.0, 0, 100.0 + (i / 10) * 10.0));
+			crowd.push_back(agent);
+		}
+
+		RID agent_1 = navigation_server->agent_create();
+		navigation_server->agent_set_map(agent_1, map);
+		navigation_server->agent_set_avoidance_enabled(agent_1, true);
+		navigation_server->agent_set_position(agent_1, Vector3(0, 0, 0));
+		navigation_server->agent_set_radius(agent_1, 1);
+		navigation_server->agent_set_velocity(agent_1, Vector3(1, 0, 0));
+		CallableMock agent_1_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_1, callable_mp(&agent_1_avoidance_callback_mock, &CallableMock::function1));
+
+		RID agent_2 = navigation_server->agent_create();
+		navigation_server->agent_set_map(agent_2, map);
+		navigation_server->agent_set_avoidance_enabled(agent_2, true);
+		navigation_server->agent_set_position(agent_2, Vector3(2.5, 0, 0.5));
+		navigation_server->agent_set_radius(agent_2, 1);
+		navigation_server->agent_set_velocity(agent_2, Vector3(-1, 0, 0));
+		CallableMock agent_2_avoidance_callback_mock;
+		navigation_server->agent_set_avoidance_callback(agent_2, callable_mp(&agent_2_avoidance_callback_mock, &CallableMock::function1));
+
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(agent_1_avoidance_callback_mock.function1_calls, 1);
+		CHECK_EQ(agent_2_avoidance_callback_mock.function1_calls, 1);
+		Vector3 agent_1_safe_velocity = agent_1_avoidance_callback_mock.function1_latest_arg0;
+		Vector3 agent_2_safe_velocity = agent_2_avoidance_callback_mock.function1_latest_arg0;
+		CHECK_MESSAGE(agent_1_safe_velocity.z < 0, "agent 1 should move a bit to the side so that it avoids agent 2");
+		CHECK_MESSAGE(agent_2_safe_velocity.z > 0, "agent 2 should move a bit to the side so that it avoids agent 1");
+
+		for (const RID &agent : crowd) {
+			navigation_server->free_rid(agent);
+		}
+		navigation_server->free_rid(agent_2);
+		navigation_server->free_rid(agent_1);
+		navigation_server->free_rid(map);
+	}
+
 	TEST_CASE("[NavigationServer3D] Server should make agents avoid dynamic obstacles when avoidance enabled") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
 
@@ -610,6 +667,25 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_EQ(indices[0] + 4, indices[6]);
 		}
 
+		SUBCASE("Parsed geometry should match geometry added directly in the same order") {
+			Ref<BoxMesh> box_mesh = memnew(BoxMesh);
+			MeshInstance3D *box_instance = memnew(MeshInstance3D);
+			box_instance->set_mesh(box_mesh);
+			box_instance->set_position(Vector3(3.0, 1.0, -2.0));
+			node_3d->add_child(box_instance);
+
+			navigation_server->parse_source_geometry_data(navigation_mesh, source_geometry, node_3d);
+
+			Ref<NavigationMeshSourceGeometryData3D> direct_geometry = memnew(NavigationMeshSourceGeometryData3D);
+			direct_geometry->add_mesh(plane_mesh, mesh_instance->get_global_transform());
+			direct_geometry->add_mesh(box_mesh, box_instance->get_global_transform());
+
+			CHECK(source_geometry->get_vertices() == direct_geometry->get_vertices());
+			CHECK(source_geometry->get_indices() == direct_geometry->get_indices());
+
+			memdelete(box_instance);
+		}
+
 		memdelete(mesh_instance);
 		memdelete(node_3d);
 	}
@@ -665,6 +741,173 @@ TEST_SUITE("[Navigation3D]") {
 		memdelete(node_3d);
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should find closest points across many regions") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(10.0, 0.001, 10.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		REQUIRE_NE(navigation_mesh->get_polygon_count(), 0);
+
+		RID map = navigation_server->map_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+
+		// A row of regions 20 units apart.
+		LocalVector<RID> regions;
+		for (int i = 0; i < 8; i++) {
+			RID region = navigation_server->region_create();
+			navigation_server->region_set_use_async_iterations(region, false);
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_transform(region, Transform3D(Basis(), Vector3(i * 20.0, 0.0, 0.0)));
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			regions.push_back(region);
+		}
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		CHECK_EQ(navigation_server->map_get_closest_point_owner(map, Vector3(101.0, 3.0, 1.0)), regions[5]);
+		CHECK(navigation_server->map_get_closest_point(map, Vector3(101.0, 3.0, 1.0)).is_equal_approx(Vector3(101.0, navigation_server->map_get_closest_point(map, Vector3(101.0, 3.0, 1.0)).y, 1.0)));
+		CHECK_EQ(navigation_server->map_get_closest_point_owner(map, Vector3(500.0, 0.0, 0.0)), regions[7]);
+
+		// The segment passes above all regions and crosses the navigation mesh of region 3.
+		const Vector3 intersection = navigation_server->map_get_closest_point_to_segment(map, Vector3(-30.0, 5.25, 0.0), Vector3(150.0, -4.75, 0.0), true);
+		CHECK_GT(intersection.x, 55.0);
+		CHECK_LT(intersection.x, 65.0);
+		// The segment misses the navigation mesh, the closest point is on the edge of region 0.
+		const Vector3 closest = navigation_server->map_get_closest_point_to_segment(map, Vector3(-30.0, 0.0, 0.0), Vector3(-30.0, 0.0, 10.0), false);
+		CHECK_LT(closest.x, -3.0);
+
+		for (const RID &region : regions) {
+			navigation_server->free_rid(region);
+		}
+		navigation_server->free_rid(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should bake navigation mesh in tiles") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_tile_size(5.0);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(20.0, 0.001, 20.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		CHECK_NE(navigation_mesh->get_polygon_count(), 0);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Paths should cross tile edges") {
+			Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(-8, 0, -8), Vector3(8, 0, 8), true);
+			REQUIRE_NE(path.size(), 0);
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(8, path[path.size() - 1].y, 8)));
+		}
+
+		SUBCASE("Rebaking unchanged source geometry should yield the same navigation mesh") {
+			const Vector<Vector3> vertices = navigation_mesh->get_vertices();
+			const int polygon_count = navigation_mesh->get_polygon_count();
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+			CHECK_EQ(navigation_mesh->get_vertices(), vertices);
+			CHECK_EQ(navigation_mesh->get_polygon_count(), polygon_count);
+		}
+
+		SUBCASE("Rebaking should only bake the tiles whose source geometry changed") {
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_BAKED_TILE_COUNT), 0);
+
+			// A box in the middle of the tile between (0, 0) and (5, 5), far enough from its edges to stay out of the borders of the neighboring tiles.
+			Array box_arr;
+			box_arr.resize(RS::ARRAY_MAX);
+			BoxMesh::create_mesh_array(box_arr, Vector3(1.0, 1.0, 1.0));
+			source_geometry->add_mesh_array(box_arr, Transform3D(Basis(), Vector3(2.5, 0.5, 2.5)));
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+			navigation_server->physics_process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_BAKED_TILE_COUNT), 1);
+		}
+
+		navigation_server->free_rid(region);
+		navigation_server->free_rid(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should connect tiles baked on uneven ground") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_tile_size(5.0);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		// Gently rolling terrain, so that neighboring tiles place different vertices on their shared edges.
+		PackedVector3Array faces;
+		for (int z = -10; z < 10; z++) {
+			for (int x = -10; x < 10; x++) {
+				Vector3 corners[4];
+				for (int i = 0; i < 4; i++) {
+					const float corner_x = x + (i & 1);
+					const float corner_z = z + (i >> 1);
+					corners[i] = Vector3(corner_x, 0.25 * Math::sin(corner_x * 0.9) + 0.2 * Math::cos(corner_z * 0.7), corner_z);
+				}
+				faces.push_back(corners[0]);
+				faces.push_back(corners[1]);
+				faces.push_back(corners[2]);
+				faces.push_back(corners[1]);
+				faces.push_back(corners[3]);
+				faces.push_back(corners[2]);
+			}
+		}
+		source_geometry->add_faces(faces, Transform3D());
+
+		// A wall crossing the tile edges at x = 0 and z = 0 and 5, so the only way around it crosses a seam next to it.
+		Vector<Vector3> obstruction_vertices;
+		obstruction_vertices.push_back(Vector3(-1.0, 0.0, -2.0));
+		obstruction_vertices.push_back(Vector3(1.0, 0.0, -2.0));
+		obstruction_vertices.push_back(Vector3(1.0, 0.0, 12.0));
+		obstruction_vertices.push_back(Vector3(-1.0, 0.0, 12.0));
+		source_geometry->add_projected_obstruction(obstruction_vertices, -1.0, 3.0, true);
+
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		REQUIRE_NE(navigation_mesh->get_polygon_count(), 0);
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		const Vector3 start = Vector3(-4.0, 0.0, 4.0);
+		const Vector3 end = Vector3(4.0, 0.0, 4.0);
+		Vector<Vector3> path = navigation_server->map_get_path(map, start, end, true);
+		REQUIRE_NE(path.size(), 0);
+		const Vector3 path_end = path[path.size() - 1];
+		CHECK(Vector2(path_end.x, path_end.z).is_equal_approx(Vector2(end.x, end.z)));
+
+		// The path has to go around the south end of the wall.
+		bool passed_wall = false;
+		for (const Vector3 &point : path) {
+			passed_wall = passed_wall || point.z < -2.0;
+		}
+		CHECK(passed_wall);
+
+		navigation_server->free_rid(region);
+		navigation_server->free_rid(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
 	// This test case does not check precise values on purpose - to not be too sensitivte.
 	TEST_CASE("[NavigationServer3D] Server should respond to queries against valid map properly") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -698,6 +941,20 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_NE(navigation_server->map_get_path(map, Vector3(0, 0, 0), Vector3(10, 0, 10), false).size(), 0);
 		}
 
+		SUBCASE("Flow field directions should lead agents to the target") {
+			const Vector3 target_position = navigation_server->map_get_closest_point(map, Vector3(3, 0, 3));
+			CHECK_EQ(navigation_server->map_get_flow_direction(map, target_position, Vector3(-3, 0, -3), 2), Vector3());
+
+			Vector3 position = navigation_server->map_get_closest_point(map, Vector3(-3, 0, -3));
+			for (int i = 0; i < 50 && position.distance_to(target_position) > 0.5; i++) {
+				const Vector3 direction = navigation_server->map_get_flow_direction(map, target_position, position);
+				CHECK(direction.is_normalized());
+				position += direction * 0.5;
+			}
+			CHECK_LE(position.distance_to(target_position), 0.5);
+			CHECK_EQ(navigation_server->map_get_flow_direction(map, target_position, target_position), Vector3());
+		}
+
 		SUBCASE("'map_get_closest_point_to_segment' with 'use_collision' should return default if segment doesn't intersect map") {
 			CHECK_EQ(navigation_server->map_get_closest_point_to_segment(map, Vector3(1, 2, 1), Vector3(1, 1, 1), true), Vector3());
 		}
@@ -716,6 +973,33 @@ TEST_SUITE("[Navigation3D]") {
 			CHECK_NE(query_result->get_path_owner_ids().size(), 0);
 		}
 
+		SUBCASE("Batched queries should yield the same results as single queries") {
+			TypedArray<NavigationPathQueryParameters3D> batch_parameters;
+			TypedArray<NavigationPathQueryResult3D> batch_results;
+			for (int i = 0; i < 16; i++) {
+				Ref<NavigationPathQueryParameters3D> query_parameters;
+				query_parameters.instantiate();
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector3(0, 0, 0).lerp(Vector3(10, 0, 10), i / 16.0));
+				query_parameters->set_target_position(i % 2 == 0 ? Vector3(10, 0, 10) : Vector3(0, 0, 0));
+				Ref<NavigationPathQueryResult3D> query_result;
+				query_result.instantiate();
+				batch_parameters.push_back(query_parameters);
+				batch_results.push_back(query_result);
+			}
+			navigation_server->query_path_batch(batch_parameters, batch_results);
+
+			for (int i = 0; i < batch_parameters.size(); i++) {
+				Ref<NavigationPathQueryResult3D> query_result;
+				query_result.instantiate();
+				navigation_server->query_path(batch_parameters[i], query_result);
+				const Ref<NavigationPathQueryResult3D> batch_result = batch_results[i];
+				CHECK_NE(batch_result->get_path().size(), 0);
+				CHECK_EQ(batch_result->get_path(), query_result->get_path());
+				CHECK_EQ(batch_result->get_path_rids(), query_result->get_path_rids());
+			}
+		}
+
 		SUBCASE("Elaborate query with 'EDGECENTERED' post-processing should yield non-empty result") {
 			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
 			query_parameters->set_map(map);
@@ -803,6 +1087,152 @@ TEST_SUITE("[Navigation3D]") {
 		navigation_server->physics_process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should find long paths with hierarchical pathfinding") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A grid of 1x1 quads, split by a wall that can only be passed near one border.
+		const int grid_size = 48;
+		const int wall_x = grid_size / 2;
+		Ref<NavigationMesh> navigation_mesh;
+		navigation_mesh.instantiate();
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= grid_size; z++) {
+			for (int x = 0; x <= grid_size; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < grid_size; z++) {
+			for (int x = 0; x < grid_size; x++) {
+				if (x == wall_x && z > 2) {
+					continue;
+				}
+				const int vertex = z * (grid_size + 1) + x;
+				Vector<int> polygon = { vertex, vertex + 1, vertex + grid_size + 2, vertex + grid_size + 1 };
+				navigation_mesh->add_polygon(polygon);
+			}
+		}
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		Ref<NavigationPathQueryParameters3D> query_parameters;
+		query_parameters.instantiate();
+		query_parameters->set_map(map);
+		query_parameters->set_start_position(Vector3(1.5, 0, grid_size - 1.5));
+		query_parameters->set_target_position(Vector3(grid_size - 1.5, 0, grid_size - 1.5));
+		query_parameters->set_path_search_max_polygons(0);
+
+		Ref<NavigationPathQueryResult3D> flat_query_result;
+		flat_query_result.instantiate();
+		navigation_server->query_path(query_parameters, flat_query_result);
+		REQUIRE_NE(flat_query_result->get_path().size(), 0);
+
+		navigation_server->map_set_use_hierarchical_pathfinding(map, true);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Path should reach the target around the wall") {
+			Ref<NavigationPathQueryResult3D> query_result;
+			query_result.instantiate();
+			navigation_server->query_path(query_parameters, query_result);
+			const Vector<Vector3> path = query_result->get_path();
+			REQUIRE_NE(path.size(), 0);
+			CHECK(path[path.size() - 1].is_equal_approx(query_parameters->get_target_position()));
+			CHECK_LE(query_result->get_path_length(), flat_query_result->get_path_length() * 1.1);
+		}
+
+		SUBCASE("Query with non-matching navigation layer mask should yield empty result") {
+			query_parameters->set_navigation_layers(2);
+			Ref<NavigationPathQueryResult3D> query_result;
+			query_result.instantiate();
+			navigation_server->query_path(query_parameters, query_result);
+			CHECK_EQ(query_result->get_path().size(), 0);
+		}
+
+		navigation_server->free_rid(region);
+		navigation_server->free_rid(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
+	TEST_CASE("[NavigationServer3D] Server should reuse cached path corridors") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+
+		// A grid of 1x1 quads, split by a wall that can only be passed near one border.
+		const int grid_size = 16;
+		const int wall_x = grid_size / 2;
+		Ref<NavigationMesh> navigation_mesh;
+		navigation_mesh.instantiate();
+		Vector<Vector3> vertices;
+		for (int z = 0; z <= grid_size; z++) {
+			for (int x = 0; x <= grid_size; x++) {
+				vertices.push_back(Vector3(x, 0, z));
+			}
+		}
+		navigation_mesh->set_vertices(vertices);
+		for (int z = 0; z < grid_size; z++) {
+			for (int x = 0; x < grid_size; x++) {
+				if (x == wall_x && z > 2) {
+					continue;
+				}
+				const int vertex = z * (grid_size + 1) + x;
+				Vector<int> polygon = { vertex, vertex + 1, vertex + grid_size + 2, vertex + grid_size + 1 };
+				navigation_mesh->add_polygon(polygon);
+			}
+		}
+
+		RID map = navigation_server->map_create();
+		RID region = navigation_server->region_create();
+		navigation_server->map_set_active(map, true);
+		navigation_server->map_set_use_async_iterations(map, false);
+		navigation_server->region_set_use_async_iterations(region, false);
+		navigation_server->region_set_map(region, map);
+		navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+		CHECK_FALSE(navigation_server->map_get_use_path_cache(map));
+		navigation_server->map_set_use_path_cache(map, true);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		CHECK(navigation_server->map_get_use_path_cache(map));
+
+		Ref<NavigationPathQueryParameters3D> query_parameters;
+		query_parameters.instantiate();
+		query_parameters->set_map(map);
+		query_parameters->set_start_position(Vector3(1.5, 0, grid_size - 1.5));
+		query_parameters->set_target_position(Vector3(grid_size - 1.5, 0, grid_size - 1.5));
+
+		Ref<NavigationPathQueryResult3D> first_query_result;
+		first_query_result.instantiate();
+		navigation_server->query_path(query_parameters, first_query_result);
+		REQUIRE_NE(first_query_result->get_path().size(), 0);
+
+		Ref<NavigationPathQueryResult3D> second_query_result;
+		second_query_result.instantiate();
+		navigation_server->query_path(query_parameters, second_query_result);
+		CHECK_EQ(second_query_result->get_path(), first_query_result->get_path());
+
+		// A start position inside the same polygon and cache cell reuses the corridor but keeps its own start point.
+		query_parameters->set_start_position(Vector3(1.25, 0, grid_size - 1.25));
+		Ref<NavigationPathQueryResult3D> moved_query_result;
+		moved_query_result.instantiate();
+		navigation_server->query_path(query_parameters, moved_query_result);
+		const Vector<Vector3> moved_path = moved_query_result->get_path();
+		REQUIRE_NE(moved_path.size(), 0);
+		CHECK(moved_path[0].is_equal_approx(query_parameters->get_start_position()));
+		CHECK(moved_path[moved_path.size() - 1].is_equal_approx(query_parameters->get_target_position()));
+
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_CACHE_HIT_COUNT), 2);
+		CHECK_EQ(navigation_server->get_process_info(NavigationServer3D::INFO_PATH_CACHE_MISS_COUNT), 1);
+
+		navigation_server->free_rid(region);
+		navigation_server->free_rid(map);
+		navigation_server->physics_process(0.0); // Give server some cycles to commit.
+	}
+
 	// FIXME: The race condition mentioned below is actually a problem and fails on CI (GH-90613).
 	/*
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
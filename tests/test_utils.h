@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include "core/os/memory.h"
+
 class String;
 
 namespace TestUtils {
@@ -37,4 +39,30 @@ namespace TestUtils {
 String get_data_path(const String &p_file);
 String get_executable_dir();
 String get_temp_path(const String &p_suffix);
+
+// Creates and initializes a server of a specific backend for the duration of a test,
+// for tests that don't run with the servers set up for the scene tree.
+template <typename T>
+class ScopedServer {
+	T *server = nullptr;
+
+public:
+	T *get() const { return server; }
+	T *operator->() const { return server; }
+
+	template <typename... Args>
+	explicit ScopedServer(Args... p_args) {
+		server = memnew(T(p_args...));
+		server->init();
+	}
+
+	ScopedServer(const ScopedServer &) = delete;
+	ScopedServer &operator=(const ScopedServer &) = delete;
+
+	~ScopedServer() {
+		server->finish();
+		memdelete(server);
+	}
+};
+
 } // namespace TestUtils